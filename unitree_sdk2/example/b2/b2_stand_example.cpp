@@ -138,13 +138,10 @@ void Custom::Init()
     while(queryMotionStatus())
     {
         std::cout << "Try to deactivate the motion control-related service." << std::endl;
-        int32_t ret = msc.ReleaseMode(); 
-        if (ret == 0) {
-            std::cout << "ReleaseMode succeeded." << std::endl;
-        } else {
+        int32_t ret = msc.ReleaseModeAndWait(10000000);
+        if (ret != 0) {
             std::cout << "ReleaseMode failed. Error code: " << ret << std::endl;
         }
-        sleep(5);
     }
 }
 
@@ -0,0 +1,90 @@
+/*
+ * Clock read benchmark.
+ *
+ * Cost per call of the library clock and time string functions against
+ * the header inline vdso clock, the calibrated tsc clock and the per-thread
+ * cached log timestamp.
+ *
+ * usage:
+ *   clock_benchmark [calls]
+ */
+#include <unitree/common/time/fast_clock.hpp>
+#include <iostream>
+#include <iomanip>
+
+using namespace unitree::common;
+
+template<typename Func>
+static void Run(const std::string& name, int64_t count, Func func)
+{
+    volatile uint64_t sink = 0;
+
+    //warm up caches and the cached timestamp
+    for (int64_t i=0; i<count/10; i++)
+    {
+        sink = sink + func();
+    }
+
+    int64_t begin = GetCurrentMonotonicTimeNanosecond();
+    for (int64_t i=0; i<count; i++)
+    {
+        sink = sink + func();
+    }
+    int64_t elapsed = GetCurrentMonotonicTimeNanosecond() - begin;
+
+    std::cout << std::left << std::setw(36) << name << std::right
+        << std::fixed << std::setprecision(1) << std::setw(10) << (double)elapsed / count << " ns/call" << std::endl;
+}
+
+int main(int argc, const char** argv)
+{
+    int64_t count = argc > 1 ? atoll(argv[1]) : 2000000;
+
+    TscClock* tsc = TscClock::Instance();
+    bool calibrated = tsc->Calibrate();
+
+    std::cout << "invariant counter: " << (TscClock::HasInvariantCounter() ? "yes" : "no")
+        << ", calibrated: " << (calibrated ? "yes" : "no");
+    if (calibrated)
+    {
+        std::cout << ", frequency: " << tsc->GetFrequency() / 1000 << " kHz"
+            << ", offset to CLOCK_MONOTONIC: "
+            << (int64_t)(GetTscMonotonicTimeNanosecond() - GetFastMonotonicTimeNanosecond()) << " ns";
+    }
+    std::cout << std::endl;
+
+    Run("GetCurrentMonotonicTimeNanosecond", count, []()
+    {
+        return GetCurrentMonotonicTimeNanosecond();
+    });
+
+    Run("GetFastMonotonicTimeNanosecond", count, []()
+    {
+        return GetFastMonotonicTimeNanosecond();
+    });
+
+    Run("GetTscMonotonicTimeNanosecond", count, []()
+    {
+        return GetTscMonotonicTimeNanosecond();
+    });
+
+    Run("TscClock::ReadCounter", count, []()
+    {
+        return TscClock::ReadCounter();
+    });
+
+    Run("GetTimeMillisecondString", count / 10, []()
+    {
+        return (uint64_t)GetTimeMillisecondString().size();
+    });
+
+    Run("GetCachedTimeMillisecondString", count, []()
+    {
+        return (uint64_t)GetCachedTimeMillisecondString()[0];
+    });
+
+    std::cout << "library: " << GetTimeMillisecondString()
+        << "  cached: " << GetCachedTimeMillisecondString() << std::endl;
+
+    return 0;
+}
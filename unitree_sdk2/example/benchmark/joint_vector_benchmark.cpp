@@ -0,0 +1,133 @@
+/*
+ * Joint vector benchmark.
+ *
+ * Per tick cost of moving joint state out of LowState_ and joint command
+ * into LowCmd_: the per joint accessor loops the examples used against
+ * the fixed size JointLayout pack/unpack kernels, for each robot layout.
+ *
+ * usage:
+ *   joint_vector_benchmark [iterations]
+ */
+#include <unitree/robot/joint/joint_vector.hpp>
+#include <unitree/common/time/time_tool.hpp>
+#include <iostream>
+#include <iomanip>
+
+using namespace unitree::common;
+using namespace unitree::robot;
+
+/*
+ * keep the compiler from hoisting the work out of the loop
+ */
+template<typename T>
+static inline void Clobber(T& t)
+{
+    __asm__ __volatile__("" : : "g"(&t) : "memory");
+}
+
+template<typename Func>
+static double Run(int64_t iterations, Func func)
+{
+    func();
+
+    int64_t begin = GetCurrentMonotonicTimeNanosecond();
+    for (int64_t i=0; i<iterations; i++)
+    {
+        func();
+    }
+    int64_t elapsed = GetCurrentMonotonicTimeNanosecond() - begin;
+
+    return (double)elapsed / iterations;
+}
+
+template<typename LAYOUT>
+static void Bench(const std::string& name, int64_t iterations)
+{
+    const size_t n = LAYOUT::NUMBER;
+
+    typename LAYOUT::LowState lowstate;
+    typename LAYOUT::LowCmd lowcmd;
+    typename LAYOUT::State state;
+    typename LAYOUT::Command command;
+
+    for (size_t i=0; i<n; i++)
+    {
+        lowstate.motor_state()[i].q() = 0.1f * i;
+        lowstate.motor_state()[i].dq() = 0.01f * i;
+        lowstate.motor_state()[i].ddq() = 0.001f * i;
+        lowstate.motor_state()[i].tau_est() = 0.5f * i;
+
+        command.q[i] = 0.2f * i;
+        command.dq[i] = 0.02f * i;
+        command.kp[i] = 60.0f;
+        command.kd[i] = 1.5f;
+        command.tau[i] = 0.0f;
+    }
+
+    double scalarPack = Run(iterations, [&]()
+    {
+        Clobber(lowstate);
+        for (size_t i=0; i<n; i++)
+        {
+            state.q.at(i) = lowstate.motor_state().at(i).q();
+            state.dq.at(i) = lowstate.motor_state().at(i).dq();
+            state.ddq.at(i) = lowstate.motor_state().at(i).ddq();
+            state.tau.at(i) = lowstate.motor_state().at(i).tau_est();
+        }
+        Clobber(state);
+    });
+
+    double kernelPack = Run(iterations, [&]()
+    {
+        Clobber(lowstate);
+        LAYOUT::Pack(lowstate, state);
+        Clobber(state);
+    });
+
+    double scalarUnpack = Run(iterations, [&]()
+    {
+        Clobber(command);
+        for (size_t i=0; i<n; i++)
+        {
+            lowcmd.motor_cmd().at(i).q() = command.q.at(i);
+            lowcmd.motor_cmd().at(i).dq() = command.dq.at(i);
+            lowcmd.motor_cmd().at(i).kp() = command.kp.at(i);
+            lowcmd.motor_cmd().at(i).kd() = command.kd.at(i);
+            lowcmd.motor_cmd().at(i).tau() = command.tau.at(i);
+        }
+        Clobber(lowcmd);
+    });
+
+    double kernelUnpack = Run(iterations, [&]()
+    {
+        Clobber(command);
+        LAYOUT::Unpack(command, lowcmd);
+        Clobber(lowcmd);
+    });
+
+    bool ok = true;
+    for (size_t i=0; i<n; i++)
+    {
+        ok = ok && state.tau[i] == lowstate.motor_state()[i].tau_est() && lowcmd.motor_cmd()[i].kp() == command.kp[i];
+    }
+
+    std::cout << std::left << std::setw(8) << name << std::right << std::setw(4) << n << " joints"
+        << std::fixed << std::setprecision(1)
+        << "  pack " << std::setw(7) << scalarPack << " -> " << std::setw(6) << kernelPack << " ns"
+        << "  unpack " << std::setw(7) << scalarUnpack << " -> " << std::setw(6) << kernelUnpack << " ns"
+        << (ok ? "" : "  (mismatch)") << std::endl;
+}
+
+int main(int argc, const char** argv)
+{
+    int64_t iterations = argc > 1 ? atoll(argv[1]) : 1000000;
+
+    std::cout << "per tick, accessor loop -> JointLayout kernel" << std::endl;
+
+    Bench<G1JointLayout>("G1", iterations);
+    Bench<H1_2JointLayout>("H1_2", iterations);
+    Bench<H1JointLayout>("H1", iterations);
+    Bench<Go2JointLayout>("Go2", iterations);
+
+    return 0;
+}
@@ -0,0 +1,203 @@
+/*
+ * Json benchmark.
+ *
+ * Compares the Any/JsonMap json functions with the arena backed
+ * JsonDocument on parse, serialize and copy of one document, and the
+ * Jsonize path with the direct struct binding on small rpc messages.
+ *
+ * usage:
+ *   json_benchmark [file.json] [iterations]
+ *
+ * Without a file a params.json like document is generated: nested objects
+ * of gains and limits plus float arrays.
+ */
+#include <unitree/common/json/json_binding.hpp>
+#include <unitree/robot/go2/public/jsonize_type.hpp>
+#include <unitree/robot/g1/audio/g1_audio_api.hpp>
+#include <unitree/common/time/time_tool.hpp>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+
+using namespace unitree::common;
+using namespace unitree::robot;
+
+static std::string MakeDocument()
+{
+    std::ostringstream os;
+    os << "{\"name\":\"g1_params\",\"version\":3,\"joints\":[";
+
+    for (int32_t i=0; i<29; i++)
+    {
+        if (i > 0)
+        {
+            os << ",";
+        }
+
+        os << "{\"id\":" << i << ",\"name\":\"joint_" << i << "\",\"kp\":" << 60.0 + i * 0.5
+            << ",\"kd\":" << 1.5 + i * 0.01 << ",\"limit\":[" << -2.5 + i * 0.01 << "," << 2.5 - i * 0.01
+            << "],\"enabled\":" << (i % 3 ? "true" : "false") << "}";
+    }
+
+    os << "],\"trajectory\":[";
+    for (int32_t i=0; i<512; i++)
+    {
+        if (i > 0)
+        {
+            os << ",";
+        }
+
+        os << std::setprecision(9) << (i * 0.0123456789);
+    }
+
+    os << "]}";
+
+    return os.str();
+}
+
+template<typename Func>
+static void Run(const std::string& name, int64_t iterations, Func func)
+{
+    func();
+
+    int64_t begin = GetCurrentMonotonicTimeNanosecond();
+    for (int64_t i=0; i<iterations; i++)
+    {
+        func();
+    }
+    int64_t elapsed = GetCurrentMonotonicTimeNanosecond() - begin;
+
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(2)
+        << std::setw(10) << elapsed / 1e3 / iterations << " us/op" << std::endl;
+}
+
+int main(int argc, const char** argv)
+{
+    std::string content;
+
+    if (argc > 1)
+    {
+        std::ifstream file(argv[1]);
+        if (!file)
+        {
+            std::cout << "open file failed: " << argv[1] << std::endl;
+            return 1;
+        }
+
+        std::stringstream ss;
+        ss << file.rdbuf();
+        content = ss.str();
+    }
+    else
+    {
+        content = MakeDocument();
+    }
+
+    int64_t iterations = argc > 2 ? atoll(argv[2]) : 2000;
+
+    JsonDocument doc;
+    if (!doc.Parse(content))
+    {
+        std::cout << "parse failed: " << doc.GetError() << std::endl;
+        return 1;
+    }
+
+    Any any = FromJsonString(content);
+
+    std::cout << "document bytes:" << content.size() << " arena bytes:" << doc.GetArena().GetSize() << std::endl;
+
+    Run("parse Any", iterations, [&]() {
+        Any a = FromJsonString(content);
+    });
+
+    Run("parse JsonDocument", iterations, [&]() {
+        JsonDocument d;
+        d.Parse(content);
+    });
+
+    Run("parse JsonDocument reuse", iterations, [&]() {
+        doc.Parse(content);
+    });
+
+    Run("parse JsonDocument to Any", iterations, [&]() {
+        JsonDocument d;
+        d.Parse(content);
+        Any a;
+        d.ToAny(a);
+    });
+
+    Run("serialize Any", iterations, [&]() {
+        std::string s = ToJsonString(any);
+    });
+
+    Run("serialize JsonDocument", iterations, [&]() {
+        std::string s = doc.ToString();
+    });
+
+    Run("copy JsonMap", iterations, [&]() {
+        Any a(any);
+    });
+
+    Run("move JsonDocument", iterations, [&]() {
+        JsonDocument d(std::move(doc));
+        doc = std::move(d);
+    });
+
+    /*
+     * small rpc messages
+     */
+    g1::TtsMakerParameter tts;
+    tts.index = 12;
+    tts.speaker_id = 1;
+    tts.text = "hello, this is unitree g1";
+
+    go2::JsonizePathPoint point;
+    point.timeFromStart = 0.1f;
+    point.x = 1.25f;
+    point.y = -0.5f;
+    point.yaw = 0.785398f;
+    point.vx = 0.3f;
+
+    std::string pointString = ToJsonString(point);
+    std::string intString = "{\"data\":500}";
+    std::string buffer;
+
+    Run("encode tts Jsonize", iterations, [&]() {
+        std::string s = ToJsonString(tts);
+    });
+
+    Run("encode tts direct", iterations, [&]() {
+        ToJsonStringDirect(tts, buffer);
+    });
+
+    Run("encode path point Jsonize", iterations, [&]() {
+        std::string s = ToJsonString(point);
+    });
+
+    Run("encode path point direct", iterations, [&]() {
+        ToJsonStringDirect(point, buffer);
+    });
+
+    Run("decode path point Jsonize", iterations, [&]() {
+        go2::JsonizePathPoint p;
+        FromJsonString(pointString, p);
+    });
+
+    Run("decode path point direct", iterations, [&]() {
+        go2::JsonizePathPoint p;
+        FromJsonStringDirect(pointString, p);
+    });
+
+    Run("decode data int Jsonize", iterations, [&]() {
+        go2::JsonizeDataInt d;
+        FromJsonString(intString, d);
+    });
+
+    Run("decode data int direct", iterations, [&]() {
+        go2::JsonizeDataInt d;
+        FromJsonStringDirect(intString, d);
+    });
+
+    return 0;
+}
@@ -0,0 +1,91 @@
+/*
+ * Queue contention benchmark.
+ *
+ * Producers Put shared_ptr messages, as the dds reader queue does, and
+ * consumers Get them with a timeout; reports throughput of BlockQueue and
+ * MpmcQueue for a few producer/consumer mixes.
+ *
+ * usage:
+ *   queue_benchmark [messages per producer] [queue size]
+ */
+#include <unitree/common/block_queue.hpp>
+#include <unitree/common/mpmc_queue.hpp>
+#include <unitree/common/time/time_tool.hpp>
+#include <iostream>
+#include <iomanip>
+#include <thread>
+
+using namespace unitree::common;
+
+typedef std::shared_ptr<int64_t> MsgPtr;
+
+template<typename Queue>
+static void Run(const std::string& name, int32_t producers, int32_t consumers, int64_t count, uint64_t size)
+{
+    Queue queue(size);
+    std::atomic<int64_t> received(0);
+    std::atomic<int64_t> sum(0);
+    int64_t total = count * producers;
+
+    std::vector<std::thread> threads;
+    int64_t begin = GetCurrentMonotonicTimeNanosecond();
+
+    for (int32_t i=0; i<consumers; i++)
+    {
+        threads.emplace_back([&]()
+        {
+            MsgPtr msgPtr;
+            while (received.load(std::memory_order_relaxed) < total)
+            {
+                if (queue.Get(msgPtr, 1000))
+                {
+                    sum.fetch_add(*msgPtr, std::memory_order_relaxed);
+                    received.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    for (int32_t i=0; i<producers; i++)
+    {
+        threads.emplace_back([&]()
+        {
+            for (int64_t n=0; n<count; n++)
+            {
+                MsgPtr msgPtr(new int64_t(n));
+                while (!queue.Put(msgPtr))
+                {
+                    sched_yield();
+                }
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    int64_t elapsed = GetCurrentMonotonicTimeNanosecond() - begin;
+    bool ok = sum.load() == producers * (count * (count - 1) / 2);
+
+    std::cout << std::left << std::setw(14) << name << producers << "p/" << consumers << "c" << std::right
+        << std::fixed << std::setprecision(1) << std::setw(10) << (double)elapsed / total << " ns/msg"
+        << (ok ? "" : "  (lost messages)") << std::endl;
+}
+
+int main(int argc, const char** argv)
+{
+    int64_t count = argc > 1 ? atoll(argv[1]) : 200000;
+    uint64_t size = argc > 2 ? atoll(argv[2]) : 1024;
+
+    const int32_t mixes[][2] = { { 1, 1 }, { 4, 1 }, { 1, 4 }, { 4, 4 } };
+
+    for (const auto& mix : mixes)
+    {
+        Run<BlockQueue<MsgPtr>>("BlockQueue", mix[0], mix[1], count, size);
+        Run<MpmcQueue<MsgPtr>>("MpmcQueue", mix[0], mix[1], count, size);
+    }
+
+    return 0;
+}
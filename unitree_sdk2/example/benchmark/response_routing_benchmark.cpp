@@ -0,0 +1,207 @@
+/*
+ * Response routing benchmark.
+ *
+ * All clients of a service share one response topic. This benchmark runs
+ * real clients, a RoutedClient with routing off (broadcast) or on
+ * (routed), and reports the cpu each process spends on the calls of its
+ * own and on responses addressed to others.
+ *
+ * A routed client keeps the ClientStub of ClientBase, so an idle routed
+ * process still takes every response there and adds its filtered reader on
+ * top. The idle numbers show that cost; they are not expected to improve.
+ *
+ * usage:
+ *   response_routing_benchmark server
+ *   response_routing_benchmark caller <broadcast|routed> [calls]
+ *   response_routing_benchmark idle <broadcast|routed> [seconds]
+ *
+ * Start one server, any number of idle processes and one caller, then
+ * compare the cpu per foreign response reported by the idle processes.
+ */
+#include <unitree/robot/server/server.hpp>
+#include <unitree/robot/client/routed_client.hpp>
+#include <unitree/common/time/time_tool.hpp>
+#include <unitree/common/time/sleep.hpp>
+#include <algorithm>
+#include <iostream>
+
+#define SERVICE_NAME "routing_bench"
+#define API_ID_ECHO 1001
+
+using namespace unitree::robot;
+using namespace unitree::common;
+
+class EchoServer : public Server
+{
+public:
+    EchoServer() : Server(SERVICE_NAME), mCallCount(0)
+    {}
+
+    void Init()
+    {
+        SetApiVersion("1.0.0.0");
+        UT_ROBOT_SERVER_REG_API_HANDLER_NO_LEASE(API_ID_ECHO, &EchoServer::Echo);
+    }
+
+    uint64_t GetCallCount() const
+    {
+        return mCallCount;
+    }
+
+private:
+    int32_t Echo(const std::string& parameter, std::string& data)
+    {
+        mCallCount++;
+        data = parameter;
+        return 0;
+    }
+
+private:
+    std::atomic<uint64_t> mCallCount;
+};
+
+class EchoClient : public RoutedClient
+{
+public:
+    EchoClient() : RoutedClient(SERVICE_NAME)
+    {}
+
+    void Init()
+    {
+        SetApiVersion("1.0.0.0");
+        UT_ROBOT_CLIENT_REG_API_NO_PROI(API_ID_ECHO);
+    }
+
+    int32_t Echo(const std::string& parameter, std::string& data)
+    {
+        return Call(API_ID_ECHO, parameter, data);
+    }
+};
+
+static int RunServer()
+{
+    EchoServer server;
+    server.Init();
+    server.Start(false);
+
+    while (true)
+    {
+        uint64_t calls = server.GetCallCount();
+        Sleep(10);
+        std::cout << "server calls/s:" << (server.GetCallCount() - calls) / 10.0 << std::endl;
+    }
+
+    return 0;
+}
+
+static void InitClient(EchoClient& client, bool routed)
+{
+    client.Init();
+    client.SetTimeout(1.0f);
+
+    if (routed)
+    {
+        client.EnableResponseRouting();
+    }
+}
+
+static int RunCaller(bool routed, int64_t calls)
+{
+    EchoClient client;
+    InitClient(client, routed);
+
+    std::string parameter(64, 'x'), data;
+    std::vector<int64_t> latency;
+    latency.reserve(calls);
+
+    uint64_t errors = 0;
+    uint64_t cpuBegin = GetCurrentCpuTimeNanosecond();
+    int64_t begin = GetCurrentMonotonicTimeNanosecond();
+
+    for (int64_t i=0; i<calls; i++)
+    {
+        int64_t t0 = GetCurrentMonotonicTimeNanosecond();
+
+        if (client.Echo(parameter, data) != 0)
+        {
+            errors++;
+        }
+
+        latency.push_back(GetCurrentMonotonicTimeNanosecond() - t0);
+    }
+
+    int64_t elapsed = GetCurrentMonotonicTimeNanosecond() - begin;
+    uint64_t cpu = GetCurrentCpuTimeNanosecond() - cpuBegin;
+
+    std::sort(latency.begin(), latency.end());
+
+    std::cout << (routed ? "routed" : "broadcast")
+        << " calls:" << calls
+        << " errors:" << errors
+        << " calls/s:" << (calls * 1e9 / elapsed)
+        << " p50(us):" << latency[latency.size() / 2] / 1000.0
+        << " p99(us):" << latency[latency.size() * 99 / 100] / 1000.0
+        << " cpu/call(us):" << (cpu / 1000.0 / calls) << std::endl;
+
+    return 0;
+}
+
+static int RunIdle(bool routed, int64_t seconds)
+{
+    EchoClient client;
+    InitClient(client, routed);
+
+    /*
+     * the foreign responses are counted by a separate plain subscription,
+     * which costs the same in both modes
+     */
+    std::atomic<uint64_t> foreign(0);
+    std::string recvChannelName = ROBOT_SDK_CHANNEL_PREFIX + SERVICE_NAME + ROBOT_SDK_CHANNEL_SUFFIX_SERVER;
+    ChannelPtr<Response> channelPtr = ChannelFactory::Instance()->CreateRecvChannel<Response>(recvChannelName, [&foreign](const void*) {
+        foreign++;
+    });
+
+    uint64_t cpuBegin = GetCurrentCpuTimeNanosecond();
+    Sleep(seconds);
+    uint64_t cpu = GetCurrentCpuTimeNanosecond() - cpuBegin;
+
+    uint64_t rejected = routed ? client.GetRoutedStub()->GetRejectCount() : 0;
+
+    std::cout << (routed ? "routed" : "broadcast")
+        << " seconds:" << seconds
+        << " foreign responses:" << foreign.load()
+        << " rejected by filter:" << rejected
+        << " cpu(ms):" << cpu / 1e6
+        << " cpu/foreign response(us):" << (foreign ? cpu / 1e3 / foreign : 0.0) << std::endl;
+
+    return 0;
+}
+
+int main(int argc, const char** argv)
+{
+    if (argc < 2)
+    {
+        std::cout << "usage: " << argv[0] << " server | caller <broadcast|routed> [calls] | idle <broadcast|routed> [seconds]" << std::endl;
+        return 1;
+    }
+
+    ChannelFactory::Instance()->Init(0);
+
+    std::string mode = argv[1];
+    bool routed = (argc > 2 && std::string(argv[2]) == "routed");
+
+    if (mode == "server")
+    {
+        return RunServer();
+    }
+    else if (mode == "caller")
+    {
+        return RunCaller(routed, argc > 3 ? atoll(argv[3]) : 100000);
+    }
+    else if (mode == "idle")
+    {
+        return RunIdle(routed, argc > 3 ? atoll(argv[3]) : 30);
+    }
+
+    return 1;
+}
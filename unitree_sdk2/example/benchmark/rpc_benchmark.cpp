@@ -0,0 +1,415 @@
+/*
+ * Rpc benchmark.
+ *
+ * Stands up a Server with echo, json, binary and lease checked apis and
+ * drives it from concurrent callers, in one process or across processes.
+ *
+ * usage:
+ *   rpc_benchmark all    [key=value ...]   server and callers in-process
+ *   rpc_benchmark server [key=value ...]   server only
+ *   rpc_benchmark client [key=value ...]   callers only
+ *
+ * keys:
+ *   api=echo|json|binary|lease   api to call                 (echo)
+ *   callers=1,4,16,64            concurrent callers to run   (1,4,16,64)
+ *   calls=N                      calls per caller            (2000)
+ *   size=N                       binary payload bytes        (65536)
+ *   workers=N                    server executor workers, 0 uses the
+ *                                server stub thread          (0)
+ *
+ * Each caller owns a Client, except for the lease api where all callers
+ * share the client holding the lease. That client takes the lease of the
+ * ExecutorServer with EnableTrafficLease, so its calls renew the lease and
+ * explicit renewals are skipped. Reported cpu per call is the process cpu
+ * time, which includes the server in "all" mode. The lease api prints the
+ * client renewal counters, and in "all" mode the server lease counters.
+ */
+#include <unitree/robot/server/server_executor.hpp>
+#include <unitree/robot/client/routed_client.hpp>
+#include <unitree/common/json/jsonize.hpp>
+#include <unitree/common/time/time_tool.hpp>
+#include <unitree/common/time/sleep.hpp>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <thread>
+
+#define SERVICE_NAME "rpc_bench"
+
+#define API_ID_ECHO     1001
+#define API_ID_JSON     1002
+#define API_ID_BINARY   1003
+#define API_ID_LEASE    1004
+
+using namespace unitree::robot;
+using namespace unitree::common;
+
+class BenchParameter : public Jsonize
+{
+public:
+    BenchParameter() :
+        seq(0)
+    {}
+
+    void fromJson(JsonMap& json)
+    {
+        FromJson(json["seq"], seq);
+        FromJson(json["name"], name);
+        FromJson(json["values"], values);
+    }
+
+    void toJson(JsonMap& json) const
+    {
+        ToJson(seq, json["seq"]);
+        ToJson(name, json["name"]);
+        ToJson(values, json["values"]);
+    }
+
+public:
+    int32_t seq;
+    std::string name;
+    std::vector<float> values;
+};
+
+class BenchServer : public ExecutorServer
+{
+public:
+    BenchServer() : ExecutorServer(SERVICE_NAME), mCallCount(0)
+    {}
+
+    void Init()
+    {
+        SetApiVersion("1.0.0.0");
+
+        UT_ROBOT_SERVER_REG_API_HANDLER_NO_LEASE(API_ID_ECHO, &BenchServer::Echo);
+        UT_ROBOT_SERVER_REG_API_HANDLER_NO_LEASE(API_ID_JSON, &BenchServer::Json);
+        UT_ROBOT_SERVER_REG_API_BINARY_HANDLER_NO_LEASE(API_ID_BINARY, &BenchServer::Binary);
+        UT_ROBOT_SERVER_REG_API_HANDLER(API_ID_LEASE, &BenchServer::Echo, true);
+    }
+
+    uint64_t GetCallCount() const
+    {
+        return mCallCount;
+    }
+
+private:
+    int32_t Echo(const std::string& parameter, std::string& data)
+    {
+        mCallCount++;
+        data = parameter;
+        return 0;
+    }
+
+    int32_t Json(const std::string& parameter, std::string& data)
+    {
+        mCallCount++;
+
+        BenchParameter param;
+        FromJsonString(parameter, param);
+        param.seq++;
+        data = ToJsonString(param);
+
+        return 0;
+    }
+
+    int32_t Binary(const std::vector<uint8_t>& parameter, std::vector<uint8_t>& data)
+    {
+        mCallCount++;
+        data = parameter;
+        return 0;
+    }
+
+private:
+    std::atomic<uint64_t> mCallCount;
+};
+
+class BenchClient : public RoutedClient
+{
+public:
+    explicit BenchClient() : RoutedClient(SERVICE_NAME)
+    {}
+
+    void Init()
+    {
+        SetApiVersion("1.0.0.0");
+
+        UT_ROBOT_CLIENT_REG_API_NO_PROI(API_ID_ECHO);
+        UT_ROBOT_CLIENT_REG_API_NO_PROI(API_ID_JSON);
+        UT_ROBOT_CLIENT_REG_API_NO_PROI(API_ID_BINARY);
+        UT_ROBOT_CLIENT_REG_API_NO_PROI(API_ID_LEASE);
+    }
+
+    int32_t Echo(int32_t apiId, const std::string& parameter, std::string& data)
+    {
+        return Call(apiId, parameter, data);
+    }
+
+    int32_t Binary(const std::vector<uint8_t>& parameter, std::vector<uint8_t>& data)
+    {
+        return Call(API_ID_BINARY, parameter, data);
+    }
+};
+
+using BenchClientPtr = std::shared_ptr<BenchClient>;
+
+class BenchConfig
+{
+public:
+    BenchConfig() :
+        mApi("echo"), mCallers({1, 4, 16, 64}), mCalls(2000), mSize(65536), mWorkers(0)
+    {}
+
+    void Parse(int argc, const char** argv)
+    {
+        for (int i=2; i<argc; i++)
+        {
+            std::string arg = argv[i];
+            size_t pos = arg.find('=');
+            if (pos == std::string::npos)
+            {
+                continue;
+            }
+
+            std::string key = arg.substr(0, pos);
+            std::string value = arg.substr(pos + 1);
+
+            if (key == "api")
+            {
+                mApi = value;
+            }
+            else if (key == "callers")
+            {
+                mCallers.clear();
+
+                std::stringstream ss(value);
+                std::string item;
+                while (std::getline(ss, item, ','))
+                {
+                    mCallers.push_back(atoi(item.c_str()));
+                }
+            }
+            else if (key == "calls")
+            {
+                mCalls = atoll(value.c_str());
+            }
+            else if (key == "size")
+            {
+                mSize = atoll(value.c_str());
+            }
+            else if (key == "workers")
+            {
+                mWorkers = atoi(value.c_str());
+            }
+        }
+    }
+
+public:
+    std::string mApi;
+    std::vector<int32_t> mCallers;
+    int64_t mCalls;
+    int64_t mSize;
+    int32_t mWorkers;
+};
+
+static std::shared_ptr<BenchServer> StartServer(const BenchConfig& config)
+{
+    std::shared_ptr<BenchServer> server(new BenchServer());
+    server->Init();
+    server->StartLease(1.0f);
+
+    if (config.mWorkers > 0)
+    {
+        ServerExecutorConfig executorConfig(config.mWorkers);
+        server->Start(executorConfig);
+    }
+    else
+    {
+        server->Start(false);
+    }
+
+    return server;
+}
+
+static int64_t Percentile(const std::vector<int64_t>& sorted, double p)
+{
+    if (sorted.empty())
+    {
+        return 0;
+    }
+
+    size_t index = std::min(sorted.size() - 1, (size_t)(sorted.size() * p));
+    return sorted[index];
+}
+
+static void RunCallers(const BenchConfig& config, int32_t callers)
+{
+    bool lease = (config.mApi == "lease");
+    int32_t clientNumber = lease ? 1 : callers;
+
+    std::vector<BenchClientPtr> clients;
+    for (int32_t i=0; i<clientNumber; i++)
+    {
+        BenchClientPtr client(new BenchClient());
+        client->Init();
+        client->SetTimeout(1.0f);
+        clients.push_back(client);
+    }
+
+    if (lease)
+    {
+        clients[0]->EnableTrafficLease();
+        clients[0]->WaitLeaseApplied();
+    }
+
+    BenchParameter param;
+    param.name = "benchmark";
+    param.values.assign(16, 0.5f);
+    std::string jsonParameter = ToJsonString(param);
+    std::string echoParameter(64, 'x');
+    std::vector<uint8_t> binaryParameter(config.mSize, 0x5a);
+
+    std::vector<std::vector<int64_t>> latency(callers);
+    std::atomic<uint64_t> errors(0);
+
+    auto callerFunc = [&](int32_t index) {
+        BenchClient& client = *clients[index % clientNumber];
+        std::vector<int64_t>& samples = latency[index];
+        samples.reserve(config.mCalls);
+
+        std::string data;
+        std::vector<uint8_t> binaryData;
+
+        for (int64_t i=0; i<config.mCalls; i++)
+        {
+            int64_t t0 = GetCurrentMonotonicTimeNanosecond();
+            int32_t ret = 0;
+
+            if (config.mApi == "json")
+            {
+                ret = client.Echo(API_ID_JSON, jsonParameter, data);
+            }
+            else if (config.mApi == "binary")
+            {
+                ret = client.Binary(binaryParameter, binaryData);
+            }
+            else if (lease)
+            {
+                ret = client.Echo(API_ID_LEASE, echoParameter, data);
+            }
+            else
+            {
+                ret = client.Echo(API_ID_ECHO, echoParameter, data);
+            }
+
+            samples.push_back(GetCurrentMonotonicTimeNanosecond() - t0);
+
+            if (ret != 0)
+            {
+                errors++;
+            }
+        }
+    };
+
+    uint64_t cpuBegin = GetCurrentCpuTimeNanosecond();
+    int64_t begin = GetCurrentMonotonicTimeNanosecond();
+
+    std::vector<std::thread> threads;
+    for (int32_t i=0; i<callers; i++)
+    {
+        threads.emplace_back(callerFunc, i);
+    }
+
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    int64_t elapsed = GetCurrentMonotonicTimeNanosecond() - begin;
+    uint64_t cpu = GetCurrentCpuTimeNanosecond() - cpuBegin;
+
+    std::vector<int64_t> all;
+    for (auto& samples : latency)
+    {
+        all.insert(all.end(), samples.begin(), samples.end());
+    }
+
+    std::sort(all.begin(), all.end());
+
+    std::cout << std::fixed << std::setprecision(1)
+        << std::setw(6) << config.mApi
+        << " callers:" << std::setw(3) << callers
+        << " calls:" << all.size()
+        << " errors:" << errors.load()
+        << " calls/s:" << (all.size() * 1e9 / elapsed)
+        << " p50(us):" << Percentile(all, 0.50) / 1e3
+        << " p99(us):" << Percentile(all, 0.99) / 1e3
+        << " p999(us):" << Percentile(all, 0.999) / 1e3
+        << " cpu/call(us):" << (all.empty() ? 0.0 : cpu / 1e3 / all.size())
+        << std::endl;
+
+    if (lease)
+    {
+        std::cout << "client lease renewal:" << clients[0]->GetLeaseRenewalCount()
+            << " skip:" << clients[0]->GetLeaseRenewalSkipCount() << std::endl;
+    }
+}
+
+int main(int argc, const char** argv)
+{
+    if (argc < 2)
+    {
+        std::cout << "usage: " << argv[0] << " all|server|client [api=echo|json|binary|lease] [callers=1,4,16,64] [calls=N] [size=N] [workers=N]" << std::endl;
+        return 1;
+    }
+
+    std::string mode = argv[1];
+
+    BenchConfig config;
+    config.Parse(argc, argv);
+
+    ChannelFactory::Instance()->Init(0);
+
+    std::shared_ptr<BenchServer> server;
+    if (mode == "all" || mode == "server")
+    {
+        server = StartServer(config);
+    }
+
+    if (mode == "server")
+    {
+        while (true)
+        {
+            uint64_t calls = server->GetCallCount();
+            uint64_t cpu = GetCurrentCpuTimeNanosecond();
+
+            Sleep(5);
+
+            calls = server->GetCallCount() - calls;
+            cpu = GetCurrentCpuTimeNanosecond() - cpu;
+
+            std::cout << "server calls/s:" << calls / 5.0
+                << " cpu/call(us):" << (calls ? cpu / 1e3 / calls : 0.0) << std::endl;
+        }
+    }
+
+    for (int32_t callers : config.mCallers)
+    {
+        if (callers > 0)
+        {
+            RunCallers(config, callers);
+        }
+    }
+
+    LeaseStatistics leaseStatistics;
+    if (server && config.mApi == "lease" && server->GetLeaseStatistics(leaseStatistics))
+    {
+        std::cout << "lease acquire:" << leaseStatistics.mAcquireCount
+            << " accept:" << leaseStatistics.mAcceptCount
+            << " renew:" << leaseStatistics.mRenewCount
+            << " renewal:" << leaseStatistics.mRenewalCount
+            << " expire:" << leaseStatistics.mExpireCount
+            << " deny:" << leaseStatistics.mDenyCount << std::endl;
+    }
+
+    return 0;
+}
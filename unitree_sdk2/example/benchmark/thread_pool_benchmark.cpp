@@ -0,0 +1,125 @@
+/*
+ * Thread pool benchmark.
+ *
+ * Compares ThreadPool with WorkStealingThreadPool on bursts of small
+ * tasks, and splitting a point cloud like workload by hand into pool
+ * tasks with ParallelFor.
+ *
+ * usage:
+ *   thread_pool_benchmark [threads] [burst]
+ */
+#include <unitree/common/thread/thread_pool.hpp>
+#include <unitree/common/thread/work_stealing_pool.hpp>
+#include <unitree/common/time/time_tool.hpp>
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+
+using namespace unitree::common;
+
+static void Report(const std::string& name, int64_t elapsed, int64_t count)
+{
+    std::cout << std::left << std::setw(32) << name << std::right << std::fixed << std::setprecision(1)
+        << std::setw(10) << (double)elapsed / count << " ns/task" << std::endl;
+}
+
+static void WaitDone(std::atomic<int64_t>& done, int64_t count)
+{
+    while (done.load(std::memory_order_acquire) < count)
+    {
+        sched_yield();
+    }
+}
+
+/*
+ * filter a slice of points, a few hundred nanoseconds of work
+ */
+static void FilterPoints(const std::vector<float>& points, std::vector<float>& out, int64_t begin, int64_t end)
+{
+    for (int64_t i=begin; i<end; i++)
+    {
+        float v = points[i];
+        out[i] = (std::fabs(v) < 10.0f) ? std::sqrt(v * v + 1.0f) : 0.0f;
+    }
+}
+
+int main(int argc, const char** argv)
+{
+    uint32_t threads = argc > 1 ? atoi(argv[1]) : 4;
+    int64_t burst = argc > 2 ? atoll(argv[2]) : 200000;
+
+    std::vector<float> points(burst * 16);
+    std::vector<float> out(points.size());
+    for (size_t i=0; i<points.size(); i++)
+    {
+        points[i] = (float)((i * 7919) % 2000) / 100.0f - 10.0f;
+    }
+
+    {
+        ThreadPool pool(threads, UT_QUEUE_MAX_LEN);
+        std::atomic<int64_t> done(0);
+
+        int64_t begin = GetCurrentMonotonicTimeNanosecond();
+        for (int64_t i=0; i<burst; i++)
+        {
+            pool.AddTask([&done]() -> int32_t
+            {
+                done.fetch_add(1, std::memory_order_release);
+                return 0;
+            });
+        }
+        WaitDone(done, burst);
+        Report("ThreadPool empty task", GetCurrentMonotonicTimeNanosecond() - begin, burst);
+
+        done = 0;
+        begin = GetCurrentMonotonicTimeNanosecond();
+        for (int64_t i=0; i<burst; i++)
+        {
+            pool.AddTask([&, i]() -> int32_t
+            {
+                FilterPoints(points, out, i * 16, i * 16 + 16);
+                done.fetch_add(1, std::memory_order_release);
+                return 0;
+            });
+        }
+        WaitDone(done, burst);
+        Report("ThreadPool filter task", GetCurrentMonotonicTimeNanosecond() - begin, burst);
+
+        pool.Quit();
+    }
+
+    {
+        WorkStealingThreadPool pool(threads);
+        std::atomic<int64_t> done(0);
+
+        int64_t begin = GetCurrentMonotonicTimeNanosecond();
+        for (int64_t i=0; i<burst; i++)
+        {
+            pool.AddTask([&done]() { done.fetch_add(1, std::memory_order_release); });
+        }
+        WaitDone(done, burst);
+        Report("WorkStealing empty task", GetCurrentMonotonicTimeNanosecond() - begin, burst);
+
+        done = 0;
+        begin = GetCurrentMonotonicTimeNanosecond();
+        for (int64_t i=0; i<burst; i++)
+        {
+            pool.AddTask([&, i]()
+            {
+                FilterPoints(points, out, i * 16, i * 16 + 16);
+                done.fetch_add(1, std::memory_order_release);
+            });
+        }
+        WaitDone(done, burst);
+        Report("WorkStealing filter task", GetCurrentMonotonicTimeNanosecond() - begin, burst);
+
+        begin = GetCurrentMonotonicTimeNanosecond();
+        pool.ParallelForRange(0, (int64_t)points.size(), 16, [&](int64_t b, int64_t e)
+        {
+            FilterPoints(points, out, b, e);
+        });
+        Report("WorkStealing ParallelFor", GetCurrentMonotonicTimeNanosecond() - begin, burst);
+    }
+
+    return 0;
+}
@@ -562,22 +562,11 @@ void playAudioOnRobot(const std::vector<uint8_t>& audio_data) {
 
     std::string stream_id = std::to_string(unitree::common::GetCurrentTimeMillisecond());
     
-    const size_t CHUNK_SIZE = 96000;  // 3 seconds
-    size_t offset = 0;
-    
-    while (offset < audio_data.size()) {
-        size_t remaining = audio_data.size() - offset;
-        size_t chunk_size = std::min(CHUNK_SIZE, remaining);
-        
-        std::vector<uint8_t> chunk(
-            audio_data.begin() + offset,
-            audio_data.begin() + offset + chunk_size
-        );
-        
-        g_audio_client->PlayStream("burmese", stream_id, chunk);
-        unitree::common::Sleep(1);
-        offset += chunk_size;
-    }
+    // Chunks of 3 seconds are sent in order, each one as soon as the
+    // previous chunk is accepted by the robot.
+    unitree::robot::ChunkedTransferPtr transfer =
+        g_audio_client->PlayStreamAsync("burmese", stream_id, audio_data);
+    transfer->Wait();
     
     g_audio_client->PlayStop(stream_id);
 }
@@ -1,19 +1,21 @@
 #include <cmath>
 #include <memory>
-#include <mutex>
-#include <shared_mutex>
+#include <stdexcept>
 
 #include "gamepad.hpp"
 
 // DDS
+#include <unitree/common/latest_value.hpp>
 #include <unitree/robot/channel/channel_publisher.hpp>
 #include <unitree/robot/channel/channel_subscriber.hpp>
+#include <unitree/robot/joint/joint_vector.hpp>
 
 // IDL
 #include <unitree/idl/hg/IMUState_.hpp>
 #include <unitree/idl/hg/LowCmd_.hpp>
 #include <unitree/idl/hg/LowState_.hpp>
 #include <unitree/robot/b2/motion_switcher/motion_switcher_client.hpp>
+#include <unitree/robot/client/client_startup.hpp>
 
 static const std::string HG_CMD_TOPIC = "rt/lowcmd";
 static const std::string HG_IMU_TORSO = "rt/secondary_imu";
@@ -23,29 +25,6 @@ using namespace unitree::common;
 using namespace unitree::robot;
 using namespace unitree_hg::msg::dds_;
 
-template <typename T>
-class DataBuffer {
- public:
-  void SetData(const T &newData) {
-    std::unique_lock<std::shared_mutex> lock(mutex);
-    data = std::make_shared<T>(newData);
-  }
-
-  std::shared_ptr<const T> GetData() {
-    std::shared_lock<std::shared_mutex> lock(mutex);
-    return data ? data : nullptr;
-  }
-
-  void Clear() {
-    std::unique_lock<std::shared_mutex> lock(mutex);
-    data = nullptr;
-  }
-
- private:
-  std::shared_ptr<T> data;
-  std::shared_mutex mutex;
-};
-
 const int G1_NUM_MOTOR = 29;
 struct ImuState {
   std::array<float, 3> rpy = {};
@@ -158,9 +137,9 @@ class G1Example {
   Gamepad gamepad_;
   REMOTE_DATA_RX rx_;
 
-  DataBuffer<MotorState> motor_state_buffer_;
-  DataBuffer<MotorCommand> motor_command_buffer_;
-  DataBuffer<ImuState> imu_state_buffer_;
+  LatestValue<MotorState> motor_state_buffer_;
+  LatestValue<MotorCommand> motor_command_buffer_;
+  LatestValue<ImuState> imu_state_buffer_;
 
   ChannelPublisherPtr<LowCmd_> lowcmd_publisher_;
   ChannelSubscriberPtr<LowState_> lowstate_subscriber_;
@@ -179,25 +158,44 @@ class G1Example {
         mode_machine_(0) {
     ChannelFactory::Instance()->Init(0, networkInterface);
 
-    // try to shutdown motion control-related service
+    // client and channels are created concurrently, so their discovery
+    // waits overlap
+    ClientStartup startup;
+
     msc_ = std::make_shared<unitree::robot::b2::MotionSwitcherClient>();
     msc_->SetTimeout(5.0f);
-    msc_->Init();
-    std::string form, name;
-    while (msc_->CheckMode(form, name), !name.empty()) {
-      if (msc_->ReleaseMode())
-        std::cout << "Failed to switch to Release Mode\n";
-      sleep(5);
-    }
+    startup.AddClient("init", "motion_switcher", *msc_);
 
     // create publisher
     lowcmd_publisher_.reset(new ChannelPublisher<LowCmd_>(HG_CMD_TOPIC));
-    lowcmd_publisher_->InitChannel();
+    startup.Add("init", "lowcmd", [this]() { lowcmd_publisher_->InitChannel(); });
     // create subscriber
     lowstate_subscriber_.reset(new ChannelSubscriber<LowState_>(HG_STATE_TOPIC));
-    lowstate_subscriber_->InitChannel(std::bind(&G1Example::LowStateHandler, this, std::placeholders::_1), 1);
+    startup.Add("init", "lowstate", [this]() {
+      lowstate_subscriber_->InitChannel(std::bind(&G1Example::LowStateHandler, this, std::placeholders::_1), 1);
+    });
     imutorso_subscriber_.reset(new ChannelSubscriber<IMUState_>(HG_IMU_TORSO));
-    imutorso_subscriber_->InitChannel(std::bind(&G1Example::imuTorsoHandler, this, std::placeholders::_1), 1);
+    startup.Add("init", "imu_torso", [this]() {
+      imutorso_subscriber_->InitChannel(std::bind(&G1Example::imuTorsoHandler, this, std::placeholders::_1), 1);
+    });
+
+    // try to shutdown motion control-related service
+    startup.Add("release", "motion_switcher", [this]() {
+      int32_t ret = 0;
+      for (int retry = 0; retry < 3; ++retry) {
+        ret = msc_->ReleaseModeAndWait(10000000);
+        if (ret == 0) return;
+        std::cout << "Failed to switch to Release Mode, error code: " << ret << "\n";
+      }
+      throw std::runtime_error("release mode failed, error code: " + std::to_string(ret));
+    });
+
+    bool started = startup.Run();
+    std::cout << startup.ToString();
+    if (!started) {
+      std::cout << "[ERROR] startup failed" << std::endl;
+      exit(1);
+    }
     // create threads
     command_writer_ptr_ = CreateRecurrentThreadEx("command_writer", UT_CPU_ID_NONE, 2000, &G1Example::LowCommandWriter, this);
     control_thread_ptr_ = CreateRecurrentThreadEx("control", UT_CPU_ID_NONE, 2000, &G1Example::Control, this);
@@ -219,9 +217,9 @@ class G1Example {
 
     // get motor state
     MotorState ms_tmp;
+    PackMotorState<G1_NUM_MOTOR>(low_state.motor_state(), ms_tmp.q.data(),
+                                 ms_tmp.dq.data());
     for (int i = 0; i < G1_NUM_MOTOR; ++i) {
-      ms_tmp.q.at(i) = low_state.motor_state()[i].q();
-      ms_tmp.dq.at(i) = low_state.motor_state()[i].dq();
       if (low_state.motor_state()[i].motorstate() && i <= RightAnkleRoll)
         std::cout << "[ERROR] motor " << i << " with code " << low_state.motor_state()[i].motorstate() << "\n";
     }
@@ -286,16 +284,12 @@ class G1Example {
     dds_low_command.mode_pr() = static_cast<uint8_t>(mode_pr_);
     dds_low_command.mode_machine() = mode_machine_;
 
-    const std::shared_ptr<const MotorCommand> mc = motor_command_buffer_.GetData();
+    const LatestSnapshot<MotorCommand> mc = motor_command_buffer_.GetData();
     if (mc) {
-      for (size_t i = 0; i < G1_NUM_MOTOR; i++) {
-        dds_low_command.motor_cmd().at(i).mode() = 1;  // 1:Enable, 0:Disable
-        dds_low_command.motor_cmd().at(i).tau() = mc->tau_ff.at(i);
-        dds_low_command.motor_cmd().at(i).q() = mc->q_target.at(i);
-        dds_low_command.motor_cmd().at(i).dq() = mc->dq_target.at(i);
-        dds_low_command.motor_cmd().at(i).kp() = mc->kp.at(i);
-        dds_low_command.motor_cmd().at(i).kd() = mc->kd.at(i);
-      }
+      FillMotorCmdMode<G1_NUM_MOTOR>(dds_low_command.motor_cmd(), 1);  // 1:Enable, 0:Disable
+      UnpackMotorCmd<G1_NUM_MOTOR>(dds_low_command.motor_cmd(), mc->q_target.data(),
+                                   mc->dq_target.data(), mc->kp.data(),
+                                   mc->kd.data(), mc->tau_ff.data());
 
       dds_low_command.crc() = Crc32Core((uint32_t *)&dds_low_command, (sizeof(dds_low_command) >> 2) - 1);
       lowcmd_publisher_->Write(dds_low_command);
@@ -304,7 +298,7 @@ class G1Example {
 
   void Control() {
     MotorCommand motor_command_tmp;
-    const std::shared_ptr<const MotorState> ms = motor_state_buffer_.GetData();
+    const LatestSnapshot<MotorState> ms = motor_state_buffer_.GetData();
 
     for (int i = 0; i < G1_NUM_MOTOR; ++i) {
       motor_command_tmp.tau_ff.at(i) = 0.0;
@@ -0,0 +1,199 @@
+/**
+ * @file g1_arm_coroutine_example.cpp
+ * @brief G1 arm motion sequencing with coroutines
+ *
+ * The namaste motion of namaste.cpp written as coroutine behaviours on one
+ * CoExecutor thread: the pose sequence, a publisher sending the arm
+ * command on every tick and a monitor printing the tracking error all run
+ * concurrently without a thread or a sleep each. Requires C++20.
+ */
+
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <mutex>
+
+#include <unitree/common/coroutine/co_executor.hpp>
+#include <unitree/idl/hg/LowCmd_.hpp>
+#include <unitree/idl/hg/LowState_.hpp>
+#include <unitree/robot/channel/channel_publisher.hpp>
+#include <unitree/robot/channel/channel_subscriber.hpp>
+
+using namespace unitree::common;
+using namespace unitree::robot;
+using namespace unitree_hg::msg::dds_;
+
+static const std::string kTopicArmSDK = "rt/arm_sdk";
+static const std::string kTopicState = "rt/lowstate";
+
+constexpr int kNotUsedJoint = 29;
+constexpr int kNumArmJoints = 14;
+constexpr uint64_t kTickMicrosec = 20000;
+
+// left arm 15..21, right arm 22..28
+static const std::array<int, kNumArmJoints> kArmJoints = {
+    15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28};
+
+static const std::array<float, kNumArmJoints> kNamastePose = {
+    0.8f, -0.3f, 0.4f,  1.2f, 0.0f, 0.3f, 0.0f,
+    0.8f, 0.3f,  -0.4f, 1.2f, 0.0f, 0.3f, 0.0f};
+
+typedef std::array<float, kNumArmJoints> ArmPose;
+
+class ArmBehaviours {
+ public:
+  explicit ArmBehaviours(CoExecutor &exec) : exec_(exec) {
+    publisher_.reset(new ChannelPublisher<LowCmd_>(kTopicArmSDK));
+    publisher_->InitChannel();
+
+    subscriber_.reset(new ChannelSubscriber<LowState_>(kTopicState));
+    subscriber_->InitChannel(
+        std::bind(&ArmBehaviours::LowStateHandler, this, std::placeholders::_1),
+        1);
+  }
+
+  // move the arms to the namaste pose, hold, and return
+  CoTask<void> Namaste() {
+    bool ok = co_await exec_.WaitUntil([this]() { return HasState(); },
+                                       2000000);
+    if (!ok) {
+      std::cout << "no lowstate received" << std::endl;
+      done_ = true;
+      co_return;
+    }
+
+    ArmPose init = GetArmPose();
+    target_ = init;
+
+    co_await RampWeight(0.f, 1.f, 1.f);
+    co_await MoveTo(init, kNamastePose, 3.f);
+    std::cout << "Namaste pose reached" << std::endl;
+
+    co_await exec_.SleepFor(2000000);
+
+    co_await MoveTo(kNamastePose, init, 3.f);
+    co_await RampWeight(1.f, 0.f, 1.f);
+    std::cout << "Returned to initial position" << std::endl;
+
+    done_ = true;
+  }
+
+  // send the current target on every tick, once the sequence started
+  CoTask<void> Publish() {
+    while (!done_) {
+      co_await exec_.NextTick();
+      if (!started_) {
+        continue;
+      }
+
+      LowCmd_ msg;
+      msg.motor_cmd().at(kNotUsedJoint).q(weight_);
+      for (int j = 0; j < kNumArmJoints; ++j) {
+        auto &cmd = msg.motor_cmd().at(kArmJoints[j]);
+        cmd.q(target_[j]);
+        cmd.dq(0.f);
+        cmd.kp(60.f);
+        cmd.kd(1.5f);
+        cmd.tau(0.f);
+      }
+      publisher_->Write(msg);
+    }
+  }
+
+  // report the largest tracking error once per second
+  CoTask<void> Monitor() {
+    while (!done_) {
+      co_await exec_.SleepFor(1000000);
+      if (!started_) {
+        continue;
+      }
+
+      ArmPose pose = GetArmPose();
+      float error = 0.f;
+      for (int j = 0; j < kNumArmJoints; ++j) {
+        error = std::max(error, std::fabs(pose[j] - target_[j]));
+      }
+      std::cout << "max tracking error: " << error << " rad" << std::endl;
+    }
+  }
+
+  bool IsDone() const { return done_; }
+
+ private:
+  CoTask<void> MoveTo(ArmPose from, ArmPose to, float duration) {
+    int steps = duration * 1e6f / kTickMicrosec;
+    for (int i = 1; i <= steps; ++i) {
+      float ratio = static_cast<float>(i) / steps;
+      float smooth = ratio * ratio * (3.f - 2.f * ratio);
+      for (int j = 0; j < kNumArmJoints; ++j) {
+        target_[j] = from[j] + (to[j] - from[j]) * smooth;
+      }
+      co_await exec_.NextTick();
+    }
+  }
+
+  CoTask<void> RampWeight(float from, float to, float duration) {
+    started_ = true;
+    int steps = duration * 1e6f / kTickMicrosec;
+    for (int i = 1; i <= steps; ++i) {
+      weight_ = from + (to - from) * i / steps;
+      co_await exec_.NextTick();
+    }
+  }
+
+  void LowStateHandler(const void *message) {
+    const LowState_ *low_state = (const LowState_ *)message;
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    for (int j = 0; j < kNumArmJoints; ++j) {
+      arm_pose_[j] = low_state->motor_state()[kArmJoints[j]].q();
+    }
+    has_state_ = true;
+  }
+
+  bool HasState() {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    return has_state_;
+  }
+
+  ArmPose GetArmPose() {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    return arm_pose_;
+  }
+
+  CoExecutor &exec_;
+  ChannelPublisherPtr<LowCmd_> publisher_;
+  ChannelSubscriberPtr<LowState_> subscriber_;
+
+  std::mutex state_mutex_;
+  ArmPose arm_pose_{};
+  bool has_state_ = false;
+
+  // touched only by coroutines on the executor thread
+  ArmPose target_{};
+  float weight_ = 0.f;
+  bool started_ = false;
+  std::atomic<bool> done_{false};
+};
+
+int main(int argc, char const *argv[]) {
+  if (argc < 2) {
+    std::cout << "Usage: " << argv[0] << " <network_interface>" << std::endl;
+    return -1;
+  }
+
+  ChannelFactory::Instance()->Init(0, argv[1]);
+
+  CoExecutor exec("arm_behaviours", UT_CPU_ID_NONE, kTickMicrosec);
+  ArmBehaviours behaviours(exec);
+
+  exec.Spawn(behaviours.Namaste());
+  exec.Spawn(behaviours.Publish());
+  exec.Spawn(behaviours.Monitor());
+
+  while (!behaviours.IsDone()) {
+    usleep(100000);
+  }
+
+  exec.Quit();
+  return 0;
+}
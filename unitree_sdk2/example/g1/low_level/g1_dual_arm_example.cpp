@@ -2,12 +2,12 @@
 
 #include <cmath>
 #include <memory>
-#include <mutex>
-#include <shared_mutex>
 
 // DDS
+#include <unitree/common/latest_value.hpp>
 #include <unitree/robot/channel/channel_publisher.hpp>
 #include <unitree/robot/channel/channel_subscriber.hpp>
+#include <unitree/robot/joint/joint_vector.hpp>
 
 // IDL
 #include <unitree/idl/hg/LowCmd_.hpp>
@@ -24,29 +24,6 @@ using namespace unitree::robot;
 
 const int G1_NUM_MOTOR = 29;
 
-template <typename T>
-class DataBuffer {
- public:
-  void SetData(const T &newData) {
-    std::unique_lock<std::shared_mutex> lock(mutex);
-    data = std::make_shared<T>(newData);
-  }
-
-  std::shared_ptr<const T> GetData() {
-    std::shared_lock<std::shared_mutex> lock(mutex);
-    return data ? data : nullptr;
-  }
-
-  void Clear() {
-    std::unique_lock<std::shared_mutex> lock(mutex);
-    data = nullptr;
-  }
-
- private:
-  std::shared_ptr<T> data;
-  std::shared_mutex mutex;
-};
-
 struct ImuState {
   std::array<float, 3> rpy = {};
   std::array<float, 3> omega = {};
@@ -156,9 +133,9 @@ class G1Example {
   uint8_t mode_machine_;
   std::vector<std::vector<double>> frames_data_;
 
-  DataBuffer<MotorState> motor_state_buffer_;
-  DataBuffer<MotorCommand> motor_command_buffer_;
-  DataBuffer<ImuState> imu_state_buffer_;
+  LatestValue<MotorState> motor_state_buffer_;
+  LatestValue<MotorCommand> motor_command_buffer_;
+  LatestValue<ImuState> imu_state_buffer_;
 
   ChannelPublisherPtr<unitree_hg::msg::dds_::LowCmd_> lowcmd_publisher_;
   ChannelSubscriberPtr<unitree_hg::msg::dds_::LowState_> lowstate_subscriber_;
@@ -183,13 +160,10 @@ class G1Example {
     while(queryMotionStatus())
     {
         std::cout << "Try to deactivate the motion control-related service." << std::endl;
-        int32_t ret = msc->ReleaseMode(); 
-        if (ret == 0) {
-            std::cout << "ReleaseMode succeeded." << std::endl;
-        } else {
+        int32_t ret = msc->ReleaseModeAndWait(10000000);
+        if (ret != 0) {
             std::cout << "ReleaseMode failed. Error code: " << ret << std::endl;
         }
-        sleep(5);
     }
 
     loadBehaviorLibrary("motion");
@@ -238,7 +212,7 @@ class G1Example {
   }
 
   void ReportRPY() {
-    const std::shared_ptr<const ImuState> imu_tmp_ptr =
+    const LatestSnapshot<ImuState> imu_tmp_ptr =
         imu_state_buffer_.GetData();
     if (imu_tmp_ptr) {
       std::cout << "rpy: [" << imu_tmp_ptr->rpy.at(0) << ", "
@@ -260,10 +234,8 @@ class G1Example {
 
     // get motor state
     MotorState ms_tmp;
-    for (int i = 0; i < G1_NUM_MOTOR; ++i) {
-      ms_tmp.q.at(i) = low_state.motor_state()[i].q();
-      ms_tmp.dq.at(i) = low_state.motor_state()[i].dq();
-    }
+    PackMotorState<G1_NUM_MOTOR>(low_state.motor_state(), ms_tmp.q.data(),
+                                 ms_tmp.dq.data());
     motor_state_buffer_.SetData(ms_tmp);
 
     // get imu state
@@ -286,17 +258,13 @@ class G1Example {
     dds_low_command.mode_pr() = mode_;
     dds_low_command.mode_machine() = mode_machine_;
 
-    const std::shared_ptr<const MotorCommand> mc =
+    const LatestSnapshot<MotorCommand> mc =
         motor_command_buffer_.GetData();
     if (mc) {
-      for (size_t i = 0; i < G1_NUM_MOTOR; i++) {
-        dds_low_command.motor_cmd().at(i).mode() = 1;  // 1:Enable, 0:Disable
-        dds_low_command.motor_cmd().at(i).tau() = mc->tau_ff.at(i);
-        dds_low_command.motor_cmd().at(i).q() = mc->q_target.at(i);
-        dds_low_command.motor_cmd().at(i).dq() = mc->dq_target.at(i);
-        dds_low_command.motor_cmd().at(i).kp() = mc->kp.at(i);
-        dds_low_command.motor_cmd().at(i).kd() = mc->kd.at(i);
-      }
+      FillMotorCmdMode<G1_NUM_MOTOR>(dds_low_command.motor_cmd(), 1);  // 1:Enable, 0:Disable
+      UnpackMotorCmd<G1_NUM_MOTOR>(dds_low_command.motor_cmd(), mc->q_target.data(),
+                                   mc->dq_target.data(), mc->kp.data(),
+                                   mc->kd.data(), mc->tau_ff.data());
 
       dds_low_command.crc() = Crc32Core((uint32_t *)&dds_low_command,
                                         (sizeof(dds_low_command) >> 2) - 1);
@@ -306,7 +274,7 @@ class G1Example {
 
   void Control() {
     MotorCommand motor_command_tmp;
-    const std::shared_ptr<const MotorState> ms = motor_state_buffer_.GetData();
+    const LatestSnapshot<MotorState> ms = motor_state_buffer_.GetData();
 
     if (ms) {
       time_ += control_dt_;
@@ -13,6 +13,7 @@ int main(int argc, char** argv)
     po::options_description desc("Unitree G1 termination functions testing.");
     desc.add_options()
         ("network,n", po::value<std::string>()->default_value(""), "dds network interface")
+        ("flight,f", po::value<std::string>()->default_value("flight"), "flight recorder dump directory")
     ;
     po::variables_map vm;
     po::store(po::parse_command_line(argc, argv, desc), vm);
@@ -22,20 +23,27 @@ int main(int argc, char** argv)
     // DDS Init
     ChannelFactory::Instance()->Init(0, vm["network"].as<std::string>());
 
+    // Keep the last 5s of lowstate (500Hz) in memory, dumped on termination or `kill -USR1`
+    unitree::common::FlightRecorder recorder(vm["flight"].as<std::string>());
+    auto lowstate_channel = recorder.AddChannel<LowState_>("lowstate", 2500);
+    recorder.InstallSignalTrigger(SIGUSR1);
+    recorder.Start();
+
     auto lowstate_subscriber = std::make_shared<ChannelSubscriber<LowState_>>("rt/lowstate");
     LowState_ lowstate;
-    lowstate_subscriber->InitChannel([&lowstate](const void* message) {
+    lowstate_subscriber->InitChannel([&lowstate, &lowstate_channel](const void* message) {
         lowstate = *(const LowState_*)message;
+        lowstate_channel->Record(lowstate);
     });
 
     std::cout << "Checking terminations..." << std::endl;
 
     while (true)
     {
-        if (g1::bad_orientation(lowstate, 1.0f)) { // Tip the robot over to test bad orientation
+        if (g1::record_termination(recorder, "bad_orientation", g1::bad_orientation, lowstate, 1.0f)) { // Tip the robot over to test bad orientation
             std::cout << "Bad orientation detected!" << std::endl;
         }
-        if (g1::lost_connection(lowstate_subscriber, 1000)) { // Unplug the network cable to test lost connection
+        if (g1::record_termination(recorder, "lost_connection", g1::lost_connection, lowstate_subscriber, 1000)) { // Unplug the network cable to test lost connection
             std::cout << "Lost connection!" << std::endl;
         }
 
@@ -1,12 +1,12 @@
 #include <algorithm>
 #include <cmath>
 #include <memory>
-#include <mutex>
-#include <shared_mutex>
 
 // DDS
+#include <unitree/common/latest_value.hpp>
 #include <unitree/robot/channel/channel_publisher.hpp>
 #include <unitree/robot/channel/channel_subscriber.hpp>
+#include <unitree/robot/joint/joint_vector.hpp>
 
 // IDL
 #include <unitree/idl/hg/LowCmd_.hpp>
@@ -20,29 +20,6 @@ using namespace unitree::robot;
 
 const int H1_NUM_MOTOR = 27;
 
-template <typename T>
-class DataBuffer {
- public:
-  void SetData(const T &newData) {
-    std::unique_lock<std::shared_mutex> lock(mutex);
-    data = std::make_shared<T>(newData);
-  }
-
-  std::shared_ptr<const T> GetData() {
-    std::shared_lock<std::shared_mutex> lock(mutex);
-    return data ? data : nullptr;
-  }
-
-  void Clear() {
-    std::unique_lock<std::shared_mutex> lock(mutex);
-    data = nullptr;
-  }
-
- private:
-  std::shared_ptr<T> data;
-  std::shared_mutex mutex;
-};
-
 struct ImuState {
   std::array<float, 3> rpy = {};
   std::array<float, 3> omega = {};
@@ -171,9 +148,9 @@ class H1Example {
   PRorAB mode_;
   uint8_t mode_machine_;
 
-  DataBuffer<MotorState> motor_state_buffer_;
-  DataBuffer<MotorCommand> motor_command_buffer_;
-  DataBuffer<ImuState> imu_state_buffer_;
+  LatestValue<MotorState> motor_state_buffer_;
+  LatestValue<MotorCommand> motor_command_buffer_;
+  LatestValue<ImuState> imu_state_buffer_;
 
   ChannelPublisherPtr<unitree_hg::msg::dds_::LowCmd_> lowcmd_publisher_;
   ChannelSubscriberPtr<unitree_hg::msg::dds_::LowState_> lowstate_subscriber_;
@@ -209,7 +186,7 @@ class H1Example {
   }
 
   void ReportRPY() {
-    const std::shared_ptr<const ImuState> imu_tmp_ptr =
+    const LatestSnapshot<ImuState> imu_tmp_ptr =
         imu_state_buffer_.GetData();
     if (imu_tmp_ptr) {
       std::cout << "rpy: [" << imu_tmp_ptr->rpy.at(0) << ", "
@@ -231,10 +208,9 @@ class H1Example {
 
     // get motor state
     MotorState ms_tmp;
+    PackMotorState<H1_NUM_MOTOR>(low_state.motor_state(), ms_tmp.q.data(),
+                                 ms_tmp.dq.data());
     for (int i = 0; i < H1_NUM_MOTOR; ++i) {
-      ms_tmp.q.at(i) = low_state.motor_state()[i].q();
-      ms_tmp.dq.at(i) = low_state.motor_state()[i].dq();
-
       if (low_state.motor_state()[i].motorstate())
         std::cout << "[ERROR] motor " << i << " with code "
                   << low_state.motor_state()[i].motorstate() << "\n";
@@ -261,17 +237,13 @@ class H1Example {
     dds_low_command.mode_pr() = mode_;
     dds_low_command.mode_machine() = mode_machine_;
 
-    const std::shared_ptr<const MotorCommand> mc =
+    const LatestSnapshot<MotorCommand> mc =
         motor_command_buffer_.GetData();
     if (mc) {
-      for (size_t i = 0; i < H1_NUM_MOTOR; i++) {
-        dds_low_command.motor_cmd().at(i).mode() = 1;  // 1:Enable, 0:Disable
-        dds_low_command.motor_cmd().at(i).tau() = mc->tau_ff.at(i);
-        dds_low_command.motor_cmd().at(i).q() = mc->q_target.at(i);
-        dds_low_command.motor_cmd().at(i).dq() = mc->dq_target.at(i);
-        dds_low_command.motor_cmd().at(i).kp() = mc->kp.at(i);
-        dds_low_command.motor_cmd().at(i).kd() = mc->kd.at(i);
-      }
+      FillMotorCmdMode<H1_NUM_MOTOR>(dds_low_command.motor_cmd(), 1);  // 1:Enable, 0:Disable
+      UnpackMotorCmd<H1_NUM_MOTOR>(dds_low_command.motor_cmd(), mc->q_target.data(),
+                                   mc->dq_target.data(), mc->kp.data(),
+                                   mc->kd.data(), mc->tau_ff.data());
 
       dds_low_command.crc() = Crc32Core((uint32_t *)&dds_low_command,
                                         (sizeof(dds_low_command) >> 2) - 1);
@@ -283,7 +255,7 @@ class H1Example {
     ReportRPY();
 
     MotorCommand motor_command_tmp;
-    const std::shared_ptr<const MotorState> ms = motor_state_buffer_.GetData();
+    const LatestSnapshot<MotorState> ms = motor_state_buffer_.GetData();
 
     if (ms) {
       time_ += control_dt_;
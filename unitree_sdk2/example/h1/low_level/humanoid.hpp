@@ -1,17 +1,19 @@
 #pragma once
 
+#include <cmath>
 #include <iostream>
 #include <stdint.h>
 #include <string>
 
 #include "unitree/robot/channel/channel_publisher.hpp"
 #include "unitree/robot/channel/channel_subscriber.hpp"
-#include <unitree/common/thread/thread.hpp>
+#include <unitree/common/latest_value.hpp>
+#include <unitree/common/thread/rate_scheduler.hpp>
 #include <unitree/idl/go2/LowCmd_.hpp>
 #include <unitree/idl/go2/LowState_.hpp>
+#include <unitree/robot/joint/joint_vector.hpp>
 
 #include "base_state.h"
-#include "data_buffer.hpp"
 #include "motors.hpp"
 
 #include <unitree/robot/b2/motion_switcher/motion_switcher_client.hpp>
@@ -20,6 +22,10 @@ using namespace unitree::robot::b2;
 static const std::string kTopicLowCommand = "rt/lowcmd";
 static const std::string kTopicLowState = "rt/lowstate";
 
+static const uint32_t kLowStateTrigger = 1;
+static const float kLowStateDt = 0.002f;
+static const uint64_t kTickMicrosec = 2000;
+
 class HumanoidExample {
 public:
   HumanoidExample(const std::string &networkInterface = "") {
@@ -34,22 +40,36 @@ public:
     while(queryMotionStatus())
     {
         std::cout << "Try to deactivate the motion control-related service." << std::endl;
-        int32_t ret = msc->ReleaseMode(); 
-        if (ret == 0) {
-            std::cout << "ReleaseMode succeeded." << std::endl;
-        } else {
+        int32_t ret = msc->ReleaseModeAndWait(10000000);
+        if (ret != 0) {
             std::cout << "ReleaseMode failed. Error code: " << ret << std::endl;
         }
-        sleep(5);
     }
 
     lowcmd_publisher_.reset(
         new unitree::robot::ChannelPublisher<unitree_go::msg::dds_::LowCmd_>(
             kTopicLowCommand));
     lowcmd_publisher_->InitChannel();
-    command_writer_ptr_ = unitree::common::CreateRecurrentThreadEx(
-        "command_writer", UT_CPU_ID_NONE, 2000,
-        &HumanoidExample::LowCommandWriter, this);
+
+    // One RT thread for everything: control runs on every 5th lowstate
+    // sample (10ms), the command is published right after it on the same
+    // sample, and the reports run on the 2ms scheduler tick.
+    scheduler_.reset(new unitree::common::RateScheduler(
+        "control", UT_CPU_ID_NONE, kTickMicrosec,
+        unitree::common::PeriodicThreadAttr::Fifo(80)));
+
+    int control_divider = std::lround(control_dt_ / kLowStateDt);
+    scheduler_->AddTask("control", kLowStateTrigger, control_divider, 0, 1000,
+                        &HumanoidExample::Control, this);
+    scheduler_->AddTask("command_writer", kLowStateTrigger, 1, 1, 200,
+                        &HumanoidExample::LowCommandWriter, this);
+
+    int report_divider = std::lround(report_dt_ * 1e6 / kTickMicrosec);
+    scheduler_->AddTask("report_rpy", UT_RATE_TRIGGER_TICK, report_divider, 2,
+                        0, &HumanoidExample::ReportRPY, this);
+    scheduler_->AddTask("report_timing", UT_RATE_TRIGGER_TICK,
+                        report_divider * 50, 3, 0,
+                        &HumanoidExample::ReportTiming, this);
 
     lowstate_subscriber_.reset(
         new unitree::robot::ChannelSubscriber<unitree_go::msg::dds_::LowState_>(
@@ -58,18 +78,19 @@ public:
         std::bind(&HumanoidExample::LowStateHandler, this,
                   std::placeholders::_1),
         1);
-    int control_period_us = control_dt_ * 1e6;
-    control_thread_ptr_ = unitree::common::CreateRecurrentThreadEx(
-        "control", UT_CPU_ID_NONE, control_period_us, &HumanoidExample::Control,
-        this);
-
-    int report_period_us = report_dt_ * 1e6;
-    report_rpy_ptr_ = unitree::common::CreateRecurrentThreadEx(
-        "report_rpy", UT_CPU_ID_NONE, report_period_us,
-        &HumanoidExample::ReportRPY, this);
+
+    scheduler_->Start();
+    if (scheduler_->GetSchedError() != 0) {
+      std::cout << "RT scheduling not applied: "
+                << strerror(scheduler_->GetSchedError()) << std::endl;
+    }
   }
 
-  ~HumanoidExample() = default;
+  ~HumanoidExample() {
+    // stop triggers before the scheduler goes away
+    lowstate_subscriber_.reset();
+    scheduler_.reset();
+  }
 
   void LowCommandWriter() {
     unitree_go::msg::dds_::LowCmd_ dds_low_command{};
@@ -78,7 +99,7 @@ public:
     dds_low_command.level_flag() = 0xFF;
     dds_low_command.gpio() = 0;
 
-    const std::shared_ptr<const MotorCommand> mc_tmp_ptr =
+    const unitree::common::LatestSnapshot<MotorCommand> mc_tmp_ptr =
         motor_command_buffer_.GetData();
     if (mc_tmp_ptr) {
       for (int i = 0; i < kNumMotors; ++i) {
@@ -87,12 +108,11 @@ public:
         } else {
           dds_low_command.motor_cmd().at(i).mode() = (0x0A);
         }
-        dds_low_command.motor_cmd().at(i).tau() = mc_tmp_ptr->tau_ff.at(i);
-        dds_low_command.motor_cmd().at(i).q() = mc_tmp_ptr->q_ref.at(i);
-        dds_low_command.motor_cmd().at(i).dq() = mc_tmp_ptr->dq_ref.at(i);
-        dds_low_command.motor_cmd().at(i).kp() = mc_tmp_ptr->kp.at(i);
-        dds_low_command.motor_cmd().at(i).kd() = mc_tmp_ptr->kd.at(i);
       }
+      unitree::robot::UnpackMotorCmd<kNumMotors>(
+          dds_low_command.motor_cmd(), mc_tmp_ptr->q_ref.data(),
+          mc_tmp_ptr->dq_ref.data(), mc_tmp_ptr->kp.data(),
+          mc_tmp_ptr->kd.data(), mc_tmp_ptr->tau_ff.data());
       dds_low_command.crc() = Crc32Core((uint32_t *)&dds_low_command,
                                         (sizeof(dds_low_command) >> 2) - 1);
       lowcmd_publisher_->Write(dds_low_command);
@@ -105,11 +125,13 @@ public:
 
     RecordMotorState(low_state);
     RecordBaseState(low_state);
+
+    scheduler_->Trigger(kLowStateTrigger);
   }
 
   void Control() {
     MotorCommand motor_command_tmp;
-    const std::shared_ptr<const MotorState> ms_tmp_ptr =
+    const unitree::common::LatestSnapshot<MotorState> ms_tmp_ptr =
         motor_state_buffer_.GetData();
 
     if (ms_tmp_ptr) {
@@ -146,7 +168,7 @@ public:
   }
 
   void ReportRPY() {
-    const std::shared_ptr<const BaseState> bs_tmp_ptr =
+    const unitree::common::LatestSnapshot<BaseState> bs_tmp_ptr =
         base_state_buffer_.GetData();
     if (bs_tmp_ptr) {
       std::cout << "rpy: [" << bs_tmp_ptr->rpy.at(0) << ", "
@@ -155,13 +177,17 @@ public:
     }
   }
 
+  void ReportTiming() {
+    for (const auto &statistics : scheduler_->GetStatistics()) {
+      std::cout << statistics.ToString() << std::endl;
+    }
+  }
+
 private:
   void RecordMotorState(const unitree_go::msg::dds_::LowState_ &msg) {
     MotorState ms_tmp;
-    for (int i = 0; i < kNumMotors; ++i) {
-      ms_tmp.q.at(i) = msg.motor_state()[i].q();
-      ms_tmp.dq.at(i) = msg.motor_state()[i].dq();
-    }
+    unitree::robot::PackMotorState<kNumMotors>(
+        msg.motor_state(), ms_tmp.q.data(), ms_tmp.dq.data());
 
     motor_state_buffer_.SetData(ms_tmp);
   }
@@ -232,9 +258,9 @@ private:
   unitree::robot::ChannelSubscriberPtr<unitree_go::msg::dds_::LowState_>
       lowstate_subscriber_;
 
-  DataBuffer<MotorState> motor_state_buffer_;
-  DataBuffer<MotorCommand> motor_command_buffer_;
-  DataBuffer<BaseState> base_state_buffer_;
+  unitree::common::LatestValue<MotorState> motor_state_buffer_;
+  unitree::common::LatestValue<MotorCommand> motor_command_buffer_;
+  unitree::common::LatestValue<BaseState> base_state_buffer_;
 
   std::shared_ptr<MotionSwitcherClient> msc;
 
@@ -257,7 +283,5 @@ private:
   float report_dt_ = 0.1f;
 
   // multithreading
-  unitree::common::ThreadPtr command_writer_ptr_;
-  unitree::common::ThreadPtr control_thread_ptr_;
-  unitree::common::ThreadPtr report_rpy_ptr_;
+  unitree::common::RateSchedulerPtr scheduler_;
 };
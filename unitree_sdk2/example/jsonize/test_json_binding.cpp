@@ -0,0 +1,102 @@
+#include <unitree/common/json/json_binding.hpp>
+
+namespace unitree
+{
+namespace common
+{
+class Inner : public Jsonize
+{
+public:
+    Inner() : x(0)
+    {}
+
+    template<typename Binder>
+    void jsonFields(Binder& b)
+    {
+        b("x", x);
+    }
+
+    UT_JSONIZE_FIELDS()
+
+public:
+    int x;
+};
+
+class Outer : public Jsonize
+{
+public:
+    Outer() : b(0)
+    {}
+
+    template<typename Binder>
+    void jsonFields(Binder& binder)
+    {
+        binder("a", a);
+        binder("b", b);
+        binder("c", c);
+    }
+
+    UT_JSONIZE_FIELDS()
+
+public:
+    Inner a;
+    int b;
+    std::vector<Inner> c;
+};
+}
+}
+
+using namespace unitree::common;
+
+static int failed = 0;
+
+static void Check(bool ok, const std::string& name)
+{
+    std::cout << (ok ? "ok   " : "FAIL ") << name << std::endl;
+    failed += !ok;
+}
+
+static bool Parse(const std::string& s, Outer& o)
+{
+    try
+    {
+        FromJsonStringDirect(s, o);
+        return true;
+    }
+    catch (const JsonException& e)
+    {
+        std::cout << "     " << s << ": " << e.what() << std::endl;
+        return false;
+    }
+}
+
+int main()
+{
+    Outer o;
+
+    /*
+     * unknown members of nested objects are skipped
+     */
+    Check(Parse("{\"a\":{\"x\":1,\"unknown\":2},\"b\":3}", o) && o.a.x == 1 && o.b == 3, "nested unknown member before outer member");
+
+    o = Outer();
+    Check(Parse("{\"b\":3,\"a\":{\"x\":1,\"zz\":2}}", o) && o.a.x == 1 && o.b == 3, "nested unknown member last");
+
+    o = Outer();
+    Check(Parse("{\"c\":[{\"q\":{\"x\":9},\"x\":4},{\"x\":5,\"r\":[1]}],\"zz\":0,\"b\":7}", o) &&
+        o.c.size() == 2 && o.c[0].x == 4 && o.c[1].x == 5 && o.b == 7, "unknown members in array of objects");
+
+    o = Outer();
+    Check(Parse("{\"\\u0061\":{\"x\":2,\"long unknown member name\":\"s\"},\"b\":1}", o) && o.a.x == 2 && o.b == 1, "escaped outer key");
+
+    /*
+     * numbers with leading zeros are rejected
+     */
+    Check(!Parse("{\"b\":01}", o), "leading zero");
+    Check(!Parse("{\"b\":-00}", o), "negative leading zero");
+    Check(Parse("{\"b\":0}", o) && o.b == 0, "zero");
+
+    std::cout << (failed ? "FAILED" : "PASSED") << std::endl;
+
+    return failed ? 1 : 0;
+}
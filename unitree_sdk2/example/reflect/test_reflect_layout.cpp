@@ -0,0 +1,30 @@
+#include <unitree/idl/reflect/go2_reflect.hpp>
+#include <unitree/idl/reflect/hg_reflect.hpp>
+#include <unitree/idl/reflect/hg_doubleimu_reflect.hpp>
+#include <unitree/idl/reflect/ros2_reflect.hpp>
+#include <iostream>
+
+using namespace unitree::common;
+
+static int failed = 0;
+
+static void Check(bool (*func)(std::string&), const std::string& name)
+{
+    std::string type;
+    bool ok = func(type);
+
+    std::cout << (ok ? "ok   " : "FAIL ") << name << (ok ? "" : ": " + type) << std::endl;
+    failed += !ok;
+}
+
+int main()
+{
+    Check(&CheckGo2ReflectLayout, "go2");
+    Check(&CheckHgReflectLayout, "hg");
+    Check(&CheckHgDoubleimuReflectLayout, "hg_doubleimu");
+    Check(&CheckRos2ReflectLayout, "ros2");
+
+    std::cout << (failed ? "FAILED" : "PASSED") << std::endl;
+
+    return failed ? 1 : 0;
+}
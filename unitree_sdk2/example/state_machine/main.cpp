@@ -47,9 +47,7 @@ int main(int argc, char const *argv[])
     cfg_file << "param_folder: " << param << std::endl;
     cfg_file.close();
 
-    fs::path log_file_name = log_folder / "log.txt";
-
-    RobotController<ExampleUserController> robot_controller(log_file_name);
+    RobotController<ExampleUserController> robot_controller(log_folder);
     robot_controller.LoadParam(param);
 
     robot_controller.InitDdsModel();
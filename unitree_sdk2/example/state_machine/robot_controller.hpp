@@ -17,10 +17,12 @@
 #include "unitree/idl/go2/LowState_.hpp"
 #include "unitree/idl/go2/LowCmd_.hpp"
 #include "unitree/common/thread/thread.hpp"
+#include "unitree/common/thread/periodic_thread.hpp"
 
 #include "unitree/robot/channel/channel_publisher.hpp"
 #include "unitree/robot/channel/channel_subscriber.hpp"
 #include "unitree/common/time/time_tool.hpp"
+#include "unitree/common/telemetry/telemetry_recorder.hpp"
 
 #include "state_machine.hpp"
 #include "gamepad.hpp"
@@ -39,10 +41,12 @@ class RobotController
 public:
     RobotController() {}
 
-    RobotController(fs::path &log_file_name)
+    RobotController(fs::path &log_folder)
     {
-        // set log file
-        log_file = std::ofstream(log_file_name, std::ios::binary);
+        // set log recorder, one .npy file per log column in log_folder
+        TelemetrySchema schema;
+        USER_CTRL::GetLogSchema(schema);
+        log_recorder.reset(new TelemetryRecorder<LogRecord>(log_folder.string(), schema));
     }
 
     void LoadParam(fs::path &param_folder)
@@ -83,24 +87,35 @@ public:
         Damping();
         ctrl_dt_micro_sec = static_cast<uint64_t>(ctrl.dt * 1000000);
 
-        // Start the control thread
-        control_thread_ptr = CreateRecurrentThreadEx("ctrl", UT_CPU_ID_NONE, ctrl_dt_micro_sec, &RobotController::ControlStep, this);
+        // Start the control thread, on absolute deadlines with SCHED_FIFO when permitted
+        control_thread_ptr = CreatePeriodicThreadEx("ctrl", UT_CPU_ID_NONE, ctrl_dt_micro_sec, PeriodicThreadAttr::Fifo(80), &RobotController::ControlStep, this);
+        if (control_thread_ptr->GetSchedError() != 0)
+        {
+            std::cout << "Control thread runs without RT scheduling: " << strerror(control_thread_ptr->GetSchedError()) << std::endl;
+        }
 
         // Start the lowlevel command thread
         std::this_thread::sleep_for(duration);
         StartSendCmd();
 
-        // keep the main thread alive
-        while (true)
+        // keep the main thread alive, it owns control_thread_ptr and reports its performance
+        for (uint64_t loop_count = 1; ; loop_count++)
         {
             std::this_thread::sleep_for(duration);
+
+            if (loop_count % 10 == 0)
+            {
+                // wake latency, execution time and overruns of the control thread
+                std::cout << "Performance: " << control_thread_ptr->GetStatistics().ToString() << std::endl;
+            }
         }
     }
 
 protected:
     ChannelPublisherPtr<unitree_go::msg::dds_::LowCmd_> lowcmd_publisher;
     ChannelSubscriberPtr<unitree_go::msg::dds_::LowState_> lowstate_subscriber;
-    ThreadPtr low_cmd_write_thread_ptr, control_thread_ptr;
+    ThreadPtr low_cmd_write_thread_ptr;
+    PeriodicThreadPtr control_thread_ptr;
     unitree_go::msg::dds_::LowCmd_ cmd;
     unitree_go::msg::dds_::LowState_ state;
 
@@ -113,11 +128,13 @@ protected:
 
     std::mutex state_mutex, cmd_mutex;
 
-    std::ofstream log_file;
+    typedef typename USER_CTRL::LogRecord LogRecord;
+    TelemetryRecorderPtr<LogRecord> log_recorder;
+    LogRecord log_record;
 
     uint64_t ctrl_dt_micro_sec = 2000;
 
-    std::vector<float> compute_time;
+    uint64_t ctrl_count = 0;
 
 private:
 
@@ -185,7 +202,6 @@ private:
         UpdateStateMachine();
 
         // select control modes according to the state machine
-        auto start = std::chrono::high_resolution_clock::now();
         if (state_machine.state == STATES::STAND)
         {
             Standing();
@@ -209,41 +225,22 @@ private:
             robot_interface.SetCommand(cmd);
         }
 
-        auto stop = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
-        compute_time.push_back(duration.count() / 1000.);
-
         // write log
         WriteLog();
 
-        if (compute_time.size() == 100)
+        if (++ctrl_count % 100 == 0)
         {
-            float sum = 0;
-            for (auto &t : compute_time)
-            {
-                sum += t;
-            }
-            std::cout << "Performance: mean: " << sum / 100
-                      << " ms; max: " << *std::max_element(compute_time.begin(), compute_time.end())
-                      << " ms; min: " << *std::min_element(compute_time.begin(), compute_time.end())
-                      << "ms." << std::endl;
-
-            compute_time.clear();
-
             std::cout << "Current State: " << static_cast<size_t>(state_machine.state) << std::endl;
         }
     }
 
     void WriteLog()
     {
-        if (log_file.is_open())
+        if (log_recorder)
         {
-            auto log = ctrl.GetLog();
-            for (const auto &v : log)
-            {
-                log_file << v << " ";
-            }
-            log_file << std::endl;
+            // copy into the ring only, formatting and file io are done by the recorder thread
+            ctrl.GetLog(log_record);
+            log_recorder->Push(log_record);
         }
     }
 
@@ -6,6 +6,7 @@
 #include "comm.h"
 #include "unitree/idl/go2/LowState_.hpp"
 #include "unitree/idl/go2/LowCmd_.hpp"
+#include "unitree/robot/joint/joint_vector.hpp"
 #include "conversion.hpp"
 
 namespace unitree::common
@@ -38,14 +39,7 @@ namespace unitree::common
             UpdateProjectedGravity();
 
             // motor
-            const std::array<unitree_go::msg::dds_::MotorState_, 20> &motor = state.motor_state();
-            for (size_t i = 0; i < 12; ++i)
-            {
-                const unitree_go::msg::dds_::MotorState_ &m = motor.at(i);
-                jpos.at(i) = m.q();
-                jvel.at(i) = m.dq();
-                tau.at(i) = m.tau_est();
-            }
+            unitree::robot::PackMotorState<12>(state.motor_state(), jpos.data(), jvel.data(), tau.data());
         }
 
         virtual void SetCommand(unitree_go::msg::dds_::LowCmd_ &cmd) = 0;
@@ -91,15 +85,8 @@ namespace unitree::common
 
         void SetCommand(unitree_go::msg::dds_::LowCmd_ &cmd)
         {
-
-            for (int i = 0; i < 12; ++i)
-            {
-                low_cmd.motor_cmd()[i].q() = jpos_des.at(i);
-                low_cmd.motor_cmd()[i].dq() = jvel_des.at(i);
-                low_cmd.motor_cmd()[i].kp() = kp.at(i);
-                low_cmd.motor_cmd()[i].kd() = kd.at(i);
-                low_cmd.motor_cmd()[i].tau() = tau_ff.at(i);
-            }
+            unitree::robot::UnpackMotorCmd<12>(low_cmd.motor_cmd(), jpos_des.data(), jvel_des.data(),
+                                               kp.data(), kd.data(), tau_ff.data());
 
             low_cmd.crc() = crc32_core((uint32_t *)&low_cmd, (sizeof(unitree_go::msg::dds_::LowCmd_)>>2)-1);
             // lowCmd2Dds(low_cmd_raw, cmd);
@@ -6,6 +6,8 @@
 #include <fstream>
 #include <string>
 
+#include "unitree/common/telemetry/telemetry_recorder.hpp"
+
 #include "robot_interface.hpp"
 #include "gamepad.hpp"
 #include "cfg.hpp"
@@ -27,7 +29,9 @@ namespace unitree::common
 
         virtual void Calculate() = 0;
 
-        virtual std::vector<float> GetLog() = 0;
+        // derived controllers also define a trivially copyable LogRecord,
+        // static void GetLogSchema(TelemetrySchema &schema) and
+        // void GetLog(LogRecord &record), which runs on the control thread
 
         float dt, kp, kd;
         std::array<float, 12> init_pos;
@@ -87,28 +91,30 @@ namespace unitree::common
             jpos_des = init_pos;
         }
 
-        std::vector<float> GetLog()
+        struct LogRecord
         {
-            // record input, output and other info into a vector
-            std::vector<float> log;
-            for (int i = 0; i < 3; ++i)
-            {
-                log.push_back(cmd.at(i));
-            }
-            for (int i = 0; i < 12; ++i)
-            {
-                log.push_back(jpos_processed.at(i));
-            }
-            for (int i = 0; i < 12; ++i)
-            {
-                log.push_back(jvel_processed.at(i));
-            }
-            for (int i = 0; i < 12; ++i)
-            {
-                log.push_back(jpos_des.at(i));
-            }
-            
-            return log;
+            std::array<float, 3> cmd;
+            std::array<float, 12> jpos_processed;
+            std::array<float, 12> jvel_processed;
+            std::array<float, 12> jpos_des;
+        };
+
+        static void GetLogSchema(TelemetrySchema &schema)
+        {
+            // one .npy column per member
+            UT_TELEMETRY_COLUMN(schema, LogRecord, cmd);
+            UT_TELEMETRY_COLUMN(schema, LogRecord, jpos_processed);
+            UT_TELEMETRY_COLUMN(schema, LogRecord, jvel_processed);
+            UT_TELEMETRY_COLUMN(schema, LogRecord, jpos_des);
+        }
+
+        void GetLog(LogRecord &record)
+        {
+            // record input, output and other info
+            record.cmd = cmd;
+            record.jpos_processed = jpos_processed;
+            record.jvel_processed = jvel_processed;
+            record.jpos_des = jpos_des;
         }
 
         // cfg
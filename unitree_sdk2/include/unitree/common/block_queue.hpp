@@ -114,7 +114,7 @@ private:
             }
         }
 
-        t = mQueue.front();
+        t = std::move(mQueue.front());
         mQueue.pop_front();
 
         mCurSize--;
@@ -0,0 +1,554 @@
+#ifndef __UT_CO_EXECUTOR_HPP__
+#define __UT_CO_EXECUTOR_HPP__
+
+#include <unitree/common/coroutine/co_task.hpp>
+#include <unitree/common/thread/periodic_thread.hpp>
+#include <unitree/common/thread/work_stealing_pool.hpp>
+#include <linux/futex.h>
+#include <deque>
+#include <queue>
+#include <unordered_set>
+
+namespace unitree
+{
+namespace common
+{
+/*
+ * @brief
+ * @class: CoExecutor
+ *
+ * Drives any number of coroutine behaviours from one thread. A behaviour
+ * is a CoTask<void> given to Spawn; it runs until it awaits one of:
+ *
+ *   co_await exec.NextTick();                      next control tick
+ *   co_await exec.SleepFor(us) / SleepUntil(ns);   timer, CLOCK_MONOTONIC
+ *   ok = co_await exec.WaitUntil(pred, us);        pred() checked each tick
+ *   r = co_await exec.AsyncCall(pool, func);       blocking call on a pool
+ *   co_await otherTask;                            nested CoTask
+ *
+ * and is resumed on the executor thread when that completes, so a waiting
+ * behaviour costs a frame and a list entry, not a thread. The tick is
+ * drift free like PeriodicThread; timers and completions wake the thread
+ * between ticks.
+ *
+ * Awaitables must be used from coroutines running on this executor.
+ * Spawn and Quit may be called from any thread. An exception escaping a
+ * behaviour ends it and is counted by GetErrorCount.
+ */
+class CoExecutor
+{
+public:
+    explicit CoExecutor(const std::string& name, int32_t cpuId, uint64_t tickMicrosec,
+        const PeriodicThreadAttr& attr = PeriodicThreadAttr()) :
+        mTickMicrosec(tickMicrosec), mAttr(attr), mQuit(false), mReady(false), mSchedError(0),
+        mTimerSeq(0), mSignal(0), mTickCount(0), mTaskCount(0), mErrorCount(0), mPendingCallCount(0)
+    {
+        UT_THROW_IF(mTickMicrosec == 0, CommonException, "coroutine executor tick is zero");
+
+        mThreadPtr = CreateThreadEx(name, cpuId, &CoExecutor::ThreadFunc, this);
+
+        mReadyLock.Lock();
+        while (!mReady)
+        {
+            mReadyLock.Wait();
+        }
+        mReadyLock.Unlock();
+    }
+
+    ~CoExecutor()
+    {
+        Quit();
+    }
+
+    CoExecutor(const CoExecutor&) = delete;
+    CoExecutor& operator=(const CoExecutor&) = delete;
+
+    void Spawn(CoTask<void>&& task)
+    {
+        CoTask<void>::Handle handle = task.Release();
+        if (!handle)
+        {
+            return;
+        }
+
+        handle.promise().mDoneFunc = &CoExecutor::OnTaskDone;
+        handle.promise().mDoneArg = this;
+
+        {
+            LockGuard<Mutex> guard(mLock);
+            if (mQuit)
+            {
+                handle.destroy();
+                return;
+            }
+
+            mTasks.insert(handle.address());
+            mReadyQueue.push_back(handle);
+            mTaskCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        Wake();
+    }
+
+    /*
+     * Stop the thread, wait for AsyncCall in flight and destroy the
+     * behaviours still suspended.
+     */
+    void Quit()
+    {
+        {
+            LockGuard<Mutex> guard(mLock);
+            if (mQuit)
+            {
+                return;
+            }
+            mQuit = true;
+        }
+
+        Wake();
+        mThreadPtr->Wait();
+
+        while (mPendingCallCount.load(std::memory_order_acquire) > 0)
+        {
+            usleep(1000);
+        }
+
+        mTickWaiters.clear();
+        mPredicateWaiters.clear();
+        mTimers = TimerQueue();
+
+        LockGuard<Mutex> guard(mLock);
+        mReadyQueue.clear();
+        for (void* address : mTasks)
+        {
+            std::coroutine_handle<>::from_address(address).destroy();
+        }
+        mTasks.clear();
+        mTaskCount.store(0, std::memory_order_relaxed);
+    }
+
+    int32_t GetSchedError() const
+    {
+        return mSchedError;
+    }
+
+    uint64_t GetTickCount() const
+    {
+        return mTickCount.load(std::memory_order_relaxed);
+    }
+
+    /*
+     * behaviours spawned and not yet finished
+     */
+    uint64_t GetTaskCount() const
+    {
+        return mTaskCount.load(std::memory_order_relaxed);
+    }
+
+    uint64_t GetErrorCount() const
+    {
+        return mErrorCount.load(std::memory_order_relaxed);
+    }
+
+    static int64_t Now()
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+    }
+
+public:
+    class TickAwaiter
+    {
+    public:
+        explicit TickAwaiter(CoExecutor* executor) :
+            mExecutor(executor)
+        {}
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle)
+        {
+            mExecutor->mTickWaiters.push_back(handle);
+        }
+
+        void await_resume() const noexcept
+        {}
+
+    private:
+        CoExecutor* mExecutor;
+    };
+
+    class SleepAwaiter
+    {
+    public:
+        SleepAwaiter(CoExecutor* executor, int64_t deadline) :
+            mExecutor(executor), mDeadline(deadline)
+        {}
+
+        bool await_ready() const
+        {
+            return mDeadline <= Now();
+        }
+
+        void await_suspend(std::coroutine_handle<> handle)
+        {
+            mExecutor->mTimers.push(Timer{ mDeadline, mExecutor->mTimerSeq++, handle });
+        }
+
+        void await_resume() const noexcept
+        {}
+
+    private:
+        CoExecutor* mExecutor;
+        int64_t mDeadline;
+    };
+
+    /*
+     * resumes with true once pred() holds, false on timeout
+     */
+    class PredicateAwaiter
+    {
+    public:
+        PredicateAwaiter(CoExecutor* executor, std::function<bool()>&& pred, int64_t deadline) :
+            mExecutor(executor), mPred(std::move(pred)), mDeadline(deadline), mResult(false)
+        {}
+
+        bool await_ready()
+        {
+            mResult = mPred();
+            return mResult;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle)
+        {
+            mHandle = handle;
+            mExecutor->mPredicateWaiters.push_back(this);
+        }
+
+        bool await_resume() const noexcept
+        {
+            return mResult;
+        }
+
+    private:
+        friend class CoExecutor;
+
+        CoExecutor* mExecutor;
+        std::function<bool()> mPred;
+        int64_t mDeadline;
+        bool mResult;
+        std::coroutine_handle<> mHandle;
+    };
+
+    /*
+     * Runs func on a pool worker and resumes with its result on the
+     * executor thread; an exception from func is rethrown at co_await.
+     */
+    template<typename R>
+    class CallAwaiter
+    {
+    public:
+        CallAwaiter(CoExecutor* executor, WorkStealingThreadPool& pool, std::function<R()>&& func) :
+            mExecutor(executor), mPool(pool), mFunc(std::move(func))
+        {}
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle)
+        {
+            CoExecutor* executor = mExecutor;
+            executor->mPendingCallCount.fetch_add(1, std::memory_order_relaxed);
+
+            bool added = mPool.AddTask([this, executor, handle]()
+            {
+                try
+                {
+                    if constexpr (std::is_void<R>::value)
+                    {
+                        mFunc();
+                    }
+                    else
+                    {
+                        mValue.emplace(mFunc());
+                    }
+                }
+                catch (...)
+                {
+                    mException = std::current_exception();
+                }
+
+                executor->Post(handle);
+                executor->mPendingCallCount.fetch_sub(1, std::memory_order_release);
+            });
+
+            if (!added)
+            {
+                executor->mPendingCallCount.fetch_sub(1, std::memory_order_release);
+                UT_THROW(CommonException, "coroutine async call rejected by pool");
+            }
+        }
+
+        R await_resume()
+        {
+            if (mException)
+            {
+                std::rethrow_exception(mException);
+            }
+
+            if constexpr (!std::is_void<R>::value)
+            {
+                return std::move(*mValue);
+            }
+        }
+
+    private:
+        typedef typename std::conditional<std::is_void<R>::value, char, R>::type Value;
+
+        CoExecutor* mExecutor;
+        WorkStealingThreadPool& mPool;
+        std::function<R()> mFunc;
+        std::optional<Value> mValue;
+        std::exception_ptr mException;
+    };
+
+    TickAwaiter NextTick()
+    {
+        return TickAwaiter(this);
+    }
+
+    SleepAwaiter SleepUntil(int64_t monotonicNanosec)
+    {
+        return SleepAwaiter(this, monotonicNanosec);
+    }
+
+    SleepAwaiter SleepFor(uint64_t microsec)
+    {
+        return SleepAwaiter(this, Now() + (int64_t)microsec * 1000);
+    }
+
+    /*
+     * timeoutMicrosec 0 waits without limit
+     */
+    template<typename Pred>
+    PredicateAwaiter WaitUntil(Pred&& pred, uint64_t timeoutMicrosec = 0)
+    {
+        int64_t deadline = timeoutMicrosec > 0 ? Now() + (int64_t)timeoutMicrosec * 1000 : INT64_MAX;
+        return PredicateAwaiter(this, std::function<bool()>(std::forward<Pred>(pred)), deadline);
+    }
+
+    /*
+     * e.g. int32_t ret = co_await exec.AsyncCall(pool, [&]() { return client.Move(vx, vy, vyaw); });
+     */
+    template<typename Func>
+    CallAwaiter<typename std::invoke_result<Func>::type> AsyncCall(WorkStealingThreadPool& pool, Func&& func)
+    {
+        typedef typename std::invoke_result<Func>::type R;
+        return CallAwaiter<R>(this, pool, std::function<R()>(std::forward<Func>(func)));
+    }
+
+private:
+    struct Timer
+    {
+        int64_t mDeadline;
+        uint64_t mSeq;
+        std::coroutine_handle<> mHandle;
+
+        bool operator>(const Timer& other) const
+        {
+            return mDeadline != other.mDeadline ? mDeadline > other.mDeadline : mSeq > other.mSeq;
+        }
+    };
+
+    typedef std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> TimerQueue;
+
+    /*
+     * resume handle on the executor thread, from any thread
+     */
+    void Post(std::coroutine_handle<> handle)
+    {
+        {
+            LockGuard<Mutex> guard(mLock);
+            mReadyQueue.push_back(handle);
+        }
+
+        Wake();
+    }
+
+    static void OnTaskDone(void* arg, std::coroutine_handle<> handle)
+    {
+        /*
+         * the frame is suspended at its final point; destroyed by the
+         * loop once the resume that got here returns
+         */
+        ((CoExecutor*)arg)->mDone.push_back(handle);
+    }
+
+    int32_t ThreadFunc()
+    {
+        mSchedError = SetupThreadSched(mAttr, mTickMicrosec);
+
+        mReadyLock.Lock();
+        mReady = true;
+        mReadyLock.Notify();
+        mReadyLock.Unlock();
+
+        const int64_t period = (int64_t)mTickMicrosec * 1000;
+        int64_t next = Now() + period;
+
+        std::deque<std::coroutine_handle<>> ready;
+        std::vector<std::coroutine_handle<>> tickWaiters;
+        std::vector<PredicateAwaiter*> predicateWaiters;
+
+        while (!mQuit)
+        {
+            uint32_t signal = mSignal.load(std::memory_order_acquire);
+
+            {
+                LockGuard<Mutex> guard(mLock);
+                ready.swap(mReadyQueue);
+            }
+            for (std::coroutine_handle<> handle : ready)
+            {
+                Resume(handle);
+            }
+            ready.clear();
+
+            int64_t now = Now();
+            while (!mTimers.empty() && mTimers.top().mDeadline <= now)
+            {
+                std::coroutine_handle<> handle = mTimers.top().mHandle;
+                mTimers.pop();
+                Resume(handle);
+            }
+
+            if (now >= next)
+            {
+                mTickCount.fetch_add(1, std::memory_order_relaxed);
+
+                next += period;
+                if (now >= next)
+                {
+                    next += ((now - next) / period + 1) * period;
+                }
+
+                /*
+                 * waiters added while resuming wait for the next tick
+                 */
+                tickWaiters.swap(mTickWaiters);
+                for (std::coroutine_handle<> handle : tickWaiters)
+                {
+                    Resume(handle);
+                }
+                tickWaiters.clear();
+
+                predicateWaiters.swap(mPredicateWaiters);
+                for (PredicateAwaiter* awaiter : predicateWaiters)
+                {
+                    awaiter->mResult = awaiter->mPred();
+                    if (awaiter->mResult || awaiter->mDeadline <= now)
+                    {
+                        Resume(awaiter->mHandle);
+                    }
+                    else
+                    {
+                        mPredicateWaiters.push_back(awaiter);
+                    }
+                }
+                predicateWaiters.clear();
+            }
+
+            int64_t deadline = next;
+            if (!mTimers.empty() && mTimers.top().mDeadline < deadline)
+            {
+                deadline = mTimers.top().mDeadline;
+            }
+
+            WaitSignal(signal, deadline);
+        }
+
+        return 0;
+    }
+
+    void Resume(std::coroutine_handle<> handle)
+    {
+        handle.resume();
+
+        for (std::coroutine_handle<> done : mDone)
+        {
+            CoTask<void>::Handle task = CoTask<void>::Handle::from_address(done.address());
+            if (task.promise().mException)
+            {
+                mErrorCount.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            {
+                LockGuard<Mutex> guard(mLock);
+                mTasks.erase(done.address());
+            }
+
+            done.destroy();
+            mTaskCount.fetch_sub(1, std::memory_order_relaxed);
+        }
+        mDone.clear();
+    }
+
+    void WaitSignal(uint32_t signal, int64_t deadline)
+    {
+        struct timespec ts;
+        ts.tv_sec = deadline / 1000000000;
+        ts.tv_nsec = deadline % 1000000000;
+
+        syscall(SYS_futex, (uint32_t*)&mSignal, FUTEX_WAIT_BITSET_PRIVATE, signal, &ts, NULL,
+            FUTEX_BITSET_MATCH_ANY);
+    }
+
+    void Wake()
+    {
+        mSignal.fetch_add(1, std::memory_order_release);
+        syscall(SYS_futex, (uint32_t*)&mSignal, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+    }
+
+private:
+    uint64_t mTickMicrosec;
+    PeriodicThreadAttr mAttr;
+    ThreadPtr mThreadPtr;
+
+    volatile bool mQuit;
+    MutexCond mReadyLock;
+    bool mReady;
+    volatile int32_t mSchedError;
+
+    /*
+     * mReadyQueue and mTasks are shared with other threads under mLock,
+     * the waiter lists belong to the executor thread
+     */
+    Mutex mLock;
+    std::deque<std::coroutine_handle<>> mReadyQueue;
+    std::unordered_set<void*> mTasks;
+
+    std::vector<std::coroutine_handle<>> mTickWaiters;
+    std::vector<PredicateAwaiter*> mPredicateWaiters;
+    TimerQueue mTimers;
+    uint64_t mTimerSeq;
+    std::vector<std::coroutine_handle<>> mDone;
+
+    std::atomic<uint32_t> mSignal;
+    std::atomic<uint64_t> mTickCount;
+    std::atomic<uint64_t> mTaskCount;
+    std::atomic<uint64_t> mErrorCount;
+    std::atomic<uint64_t> mPendingCallCount;
+};
+
+typedef std::shared_ptr<CoExecutor> CoExecutorPtr;
+
+}
+}
+
+#endif//__UT_CO_EXECUTOR_HPP__
@@ -0,0 +1,233 @@
+#ifndef __UT_CO_TASK_HPP__
+#define __UT_CO_TASK_HPP__
+
+/*
+ * C++20, or C++17 with -fcoroutines on GCC 10+
+ */
+#if !defined(__cpp_impl_coroutine) || !__has_include(<coroutine>)
+#error "unitree coroutine module requires compiler coroutine support"
+#endif
+
+#include <unitree/common/exception.hpp>
+#include <coroutine>
+#include <exception>
+#include <optional>
+
+namespace unitree
+{
+namespace common
+{
+/*
+ * @brief
+ * @class: CoPromiseBase
+ *
+ * Common part of CoTask promises. A task started by co_await resumes its
+ * awaiter when done (symmetric transfer, no stack growth); a task handed
+ * to an executor reports completion through mDoneFunc instead.
+ */
+class CoPromiseBase
+{
+public:
+    class FinalAwaiter
+    {
+    public:
+        bool await_ready() noexcept
+        {
+            return false;
+        }
+
+        template<typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+        {
+            CoPromiseBase& promise = handle.promise();
+
+            if (promise.mContinuation)
+            {
+                return promise.mContinuation;
+            }
+
+            if (promise.mDoneFunc != NULL)
+            {
+                promise.mDoneFunc(promise.mDoneArg, handle);
+            }
+
+            return std::noop_coroutine();
+        }
+
+        void await_resume() noexcept
+        {}
+    };
+
+    std::suspend_always initial_suspend() noexcept
+    {
+        return {};
+    }
+
+    FinalAwaiter final_suspend() noexcept
+    {
+        return {};
+    }
+
+    void unhandled_exception()
+    {
+        mException = std::current_exception();
+    }
+
+    void RethrowIfFault()
+    {
+        if (mException)
+        {
+            std::rethrow_exception(mException);
+        }
+    }
+
+public:
+    std::coroutine_handle<> mContinuation;
+    std::exception_ptr mException;
+
+    void (*mDoneFunc)(void*, std::coroutine_handle<>) = NULL;
+    void* mDoneArg = NULL;
+};
+
+template<typename T>
+class CoPromise : public CoPromiseBase
+{
+public:
+    template<typename U>
+    void return_value(U&& u)
+    {
+        mValue.emplace(std::forward<U>(u));
+    }
+
+    T GetValue()
+    {
+        RethrowIfFault();
+        return std::move(*mValue);
+    }
+
+private:
+    std::optional<T> mValue;
+};
+
+template<>
+class CoPromise<void> : public CoPromiseBase
+{
+public:
+    void return_void()
+    {}
+
+    void GetValue()
+    {
+        RethrowIfFault();
+    }
+};
+
+/*
+ * @brief
+ * @class: CoTask
+ *
+ * Lazily started coroutine. co_await a CoTask to run it to completion and
+ * get its value or exception; hand a CoTask<void> to CoExecutor::Spawn to
+ * run it as a top level behaviour. Move only, owns its frame.
+ */
+template<typename T = void>
+class CoTask
+{
+public:
+    class promise_type : public CoPromise<T>
+    {
+    public:
+        CoTask get_return_object()
+        {
+            return CoTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+    };
+
+    typedef std::coroutine_handle<promise_type> Handle;
+
+    CoTask() :
+        mHandle()
+    {}
+
+    explicit CoTask(Handle handle) :
+        mHandle(handle)
+    {}
+
+    CoTask(CoTask&& other) noexcept :
+        mHandle(other.mHandle)
+    {
+        other.mHandle = Handle();
+    }
+
+    CoTask& operator=(CoTask&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (mHandle)
+            {
+                mHandle.destroy();
+            }
+
+            mHandle = other.mHandle;
+            other.mHandle = Handle();
+        }
+
+        return *this;
+    }
+
+    CoTask(const CoTask&) = delete;
+    CoTask& operator=(const CoTask&) = delete;
+
+    ~CoTask()
+    {
+        if (mHandle)
+        {
+            mHandle.destroy();
+        }
+    }
+
+    bool IsValid() const
+    {
+        return (bool)mHandle;
+    }
+
+    bool IsDone() const
+    {
+        return mHandle && mHandle.done();
+    }
+
+    /*
+     * give up ownership of the frame, used by the executor
+     */
+    Handle Release()
+    {
+        Handle handle = mHandle;
+        mHandle = Handle();
+        return handle;
+    }
+
+    bool await_ready() const noexcept
+    {
+        return !mHandle || mHandle.done();
+    }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept
+    {
+        mHandle.promise().mContinuation = caller;
+        return mHandle;
+    }
+
+    T await_resume()
+    {
+        UT_THROW_IF(!mHandle, CommonException, "await an empty coroutine task");
+        return mHandle.promise().GetValue();
+    }
+
+private:
+    Handle mHandle;
+};
+
+}
+}
+
+#endif//__UT_CO_TASK_HPP__
@@ -3,9 +3,11 @@
 
 #include <dds/dds.hpp>
 #include <unitree/common/log/log.hpp>
+#include <unitree/common/log/log_deferred.hpp>
 #include <unitree/common/block_queue.hpp>
+#include <unitree/common/mpmc_queue.hpp>
 #include <unitree/common/thread/thread.hpp>
-#include <unitree/common/time/time_tool.hpp>
+#include <unitree/common/time/fast_clock.hpp>
 #include <unitree/common/time/sleep.hpp>
 #include <unitree/common/dds/dds_exception.hpp>
 #include <unitree/common/dds/dds_callback.hpp>
@@ -186,6 +188,54 @@ public:
         return false;
     }
 
+    /*
+     * Wait until at least one reader is matched, or waitMicrosec elapsed.
+     * Wakes on the publication matched event instead of polling.
+     */
+    bool WaitMatched(int64_t waitMicrosec)
+    {
+        UT_DDS_EXCEPTION_TRY
+        {
+            if (mNative.publication_matched_status().current_count() > 0)
+            {
+                return true;
+            }
+
+            ::dds::core::cond::StatusCondition condition(mNative);
+            condition.enabled_statuses(::dds::core::status::StatusMask::publication_matched());
+
+            ::dds::core::cond::WaitSet waitSet;
+            waitSet += condition;
+
+            int64_t deadline = (int64_t)GetCurrentMonotonicTimeMicrosecond() + waitMicrosec;
+            int64_t remain = waitMicrosec;
+
+            while (remain > 0)
+            {
+                try
+                {
+                    waitSet.wait(::dds::core::Duration::from_microsecs(remain));
+                }
+                catch (const ::dds::core::TimeoutError&)
+                {
+                    break;
+                }
+
+                if (mNative.publication_matched_status().current_count() > 0)
+                {
+                    return true;
+                }
+
+                remain = deadline - (int64_t)GetCurrentMonotonicTimeMicrosecond();
+            }
+
+            return mNative.publication_matched_status().current_count() > 0;
+        }
+        UT_DDS_EXCEPTION_CATCH(mLogger, false)
+
+        return false;
+    }
+
 private:
     void WaitReader(int64_t waitMicrosec)
     {
@@ -320,13 +370,13 @@ private:
             const MSG& m = iter->data();
             if (iter->info().valid())
             {
-                mLastDataAvailableTime = GetCurrentMonotonicTimeNanosecond();
+                mLastDataAvailableTime = GetFastMonotonicTimeNanosecond();
 
                 if (mHasQueue)
                 {
                     if (!mDataQueuePtr->Put(MSG_PTR(new MSG(m)), true))
                     {
-                        LOG_WARNING(mLogger, "earliest mesage was evicted. type:", DdsGetTypeName(MSG));
+                        LOG_DEFERRED_WARNING(mLogger, "earliest mesage was evicted. type:", DdsGetTypeName(MSG));
                     }
                 }
                 else
@@ -353,6 +403,12 @@ template<typename MSG>
 using DdsReaderListenerPtr = std::shared_ptr<DdsReaderListener<MSG>>;
 
 
+/*
+ * @brief: DdsReaderFilter
+ */
+template<typename MSG>
+using DdsReaderFilter = std::function<bool(const MSG&)>;
+
 /*
  * @brief: DdsReader
  */
@@ -375,6 +431,32 @@ public:
         UT_DDS_EXCEPTION_CATCH(mLogger, true)
     }
 
+    /*
+     * Reader on a content filtered view of topic. Samples rejected by filter
+     * are dropped before they reach the reader history and listener.
+     * cyclonedds evaluates the filter on the deserialized sample, so a
+     * rejected sample is still decoded once; only the history insert,
+     * listener, take and copy are saved.
+     */
+    explicit DdsReader(const DdsSubscriberPtr& subscriber, const DdsTopicPtr<MSG>& topic, const DdsReaderQos& qos, const DdsReaderFilter<MSG>& filter) :
+        mNative(__UT_DDS_NULL__)
+    {
+        UT_DDS_EXCEPTION_TRY
+
+        auto readerQos = subscriber->GetNative().default_datareader_qos();
+        qos.CopyToNativeQos(readerQos);
+
+        std::ostringstream os;
+        os << topic->GetNative().name() << "/filter/" << (const void*)this;
+
+        ::dds::topic::ContentFilteredTopic<MSG> filterTopic(topic->GetNative(), os.str(), ::dds::topic::Filter(""));
+        filterTopic.delegate()->filter_function(DdsReaderFilter<MSG>(filter));
+
+        mNative = NATIVE_TYPE(subscriber->GetNative(), filterTopic, readerQos);
+
+        UT_DDS_EXCEPTION_CATCH(mLogger, true)
+    }
+
     ~DdsReader()
     {
         mNative = __UT_DDS_NULL__;
@@ -405,6 +487,200 @@ private:
 template<typename MSG>
 using DdsReaderPtr = std::shared_ptr<DdsReader<MSG>>;
 
+
+/*
+ * @brief: DdsMpmcReaderListener
+ *
+ * DdsReaderListener with the sample queue on a lock-free MpmcQueue.
+ * DdsReaderListener and DdsReader are also instantiated by the prebuilt
+ * library, so they keep BlockQueue and this listener is a separate type.
+ */
+template<typename MSG>
+class DdsMpmcReaderListener : public ::dds::sub::NoOpDataReaderListener<MSG>, DdsLogger
+{
+public:
+    using NATIVE_TYPE = ::dds::sub::DataReaderListener<MSG>;
+    using MSG_PTR = std::shared_ptr<MSG>;
+
+    explicit DdsMpmcReaderListener() :
+        mHasQueue(false), mQuit(false), mMask(::dds::core::status::StatusMask::none()), mLastDataAvailableTime(0)
+    {}
+
+    ~DdsMpmcReaderListener()
+    {
+        if (mHasQueue)
+        {
+            mQuit = true;
+            mDataQueuePtr->Interrupt(false);
+            mDataQueueThreadPtr->Wait();
+        }
+    }
+
+    void SetCallback(const DdsReaderCallback& cb)
+    {
+        if (cb.HasMessageHandler())
+        {
+            mMask |= ::dds::core::status::StatusMask::data_available();
+        }
+
+        mCallbackPtr.reset(new DdsReaderCallback(cb));
+    }
+
+    void SetQueue(int32_t len)
+    {
+        if (len <= 0)
+        {
+            return;
+        }
+
+        mHasQueue = true;
+        mDataQueuePtr.reset(new MpmcQueue<MSG_PTR>(len));
+
+        auto queueThreadFunc = [this]() {
+            while (true)
+            {
+                if (mCallbackPtr && mCallbackPtr->HasMessageHandler())
+                {
+                    break;
+                }
+                else
+                {
+                    MicroSleep(__UT_DDS_WAIT_MATCHED_TIME_SLICE);
+                }
+            }
+            while (!mQuit)
+            {
+                MSG_PTR dataPtr;
+                if (mDataQueuePtr->Get(dataPtr))
+                {
+                    if (dataPtr)
+                    {
+                        mCallbackPtr->OnDataAvailable(dataPtr.get());
+                    }
+                }
+            }
+            return 0;
+        };
+
+        mDataQueueThreadPtr = CreateThreadEx("rlsnr", UT_CPU_ID_NONE, queueThreadFunc);
+    }
+
+    int64_t GetLastDataAvailableTime() const
+    {
+        return mLastDataAvailableTime;
+    }
+
+    NATIVE_TYPE* GetNative() const
+    {
+        return (NATIVE_TYPE*)this;
+    }
+
+    const ::dds::core::status::StatusMask& GetStatusMask() const
+    {
+        return mMask;
+    }
+
+private:
+    void on_data_available(::dds::sub::DataReader<MSG>& reader)
+    {
+        ::dds::sub::LoanedSamples<MSG> samples;
+        samples = reader.take();
+
+        if (samples.length() <= 0)
+        {
+            return;
+        }
+
+        typename ::dds::sub::LoanedSamples<MSG>::const_iterator iter;
+        for (iter=samples.begin(); iter<samples.end(); ++iter)
+        {
+            const MSG& m = iter->data();
+            if (iter->info().valid())
+            {
+                mLastDataAvailableTime = GetFastMonotonicTimeNanosecond();
+
+                if (mHasQueue)
+                {
+                    if (!mDataQueuePtr->Put(MSG_PTR(new MSG(m)), true))
+                    {
+                        LOG_DEFERRED_WARNING(mLogger, "earliest mesage was evicted. type:", DdsGetTypeName(MSG));
+                    }
+                }
+                else
+                {
+                    mCallbackPtr->OnDataAvailable((const void*)&m);
+                }
+            }
+        }
+    }
+
+private:
+    bool mHasQueue;
+    volatile bool mQuit;
+
+    ::dds::core::status::StatusMask mMask;
+    int64_t mLastDataAvailableTime;
+
+    DdsReaderCallbackPtr mCallbackPtr;
+    MpmcQueuePtr<MSG_PTR> mDataQueuePtr;
+    ThreadPtr mDataQueueThreadPtr;
+};
+
+/*
+ * @brief: DdsMpmcReader
+ *
+ * DdsReader whose listener queues samples in a DdsMpmcReaderListener.
+ * For new code that creates its readers directly; DdsTopicChannel keeps
+ * DdsReader.
+ */
+template<typename MSG>
+class DdsMpmcReader : public DdsReader<MSG>
+{
+public:
+    using NATIVE_TYPE = typename DdsReader<MSG>::NATIVE_TYPE;
+
+    explicit DdsMpmcReader(const DdsSubscriberPtr& subscriber, const DdsTopicPtr<MSG>& topic, const DdsReaderQos& qos) :
+        DdsReader<MSG>(subscriber, topic, qos)
+    {}
+
+    explicit DdsMpmcReader(const DdsSubscriberPtr& subscriber, const DdsTopicPtr<MSG>& topic, const DdsReaderQos& qos, const DdsReaderFilter<MSG>& filter) :
+        DdsReader<MSG>(subscriber, topic, qos, filter)
+    {}
+
+    ~DdsMpmcReader()
+    {
+        /*
+         * detach before mListener goes away; the base only closes the
+         * reader after the members of this class are destroyed
+         */
+        NATIVE_TYPE native = this->GetNative();
+        if (native != __UT_DDS_NULL__)
+        {
+            native.listener(nullptr, ::dds::core::status::StatusMask::none());
+        }
+    }
+
+    void SetListener(const DdsReaderCallback& cb, int32_t qlen)
+    {
+        mListener.SetCallback(cb);
+        mListener.SetQueue(qlen);
+
+        NATIVE_TYPE native = this->GetNative();
+        native.listener(mListener.GetNative(), mListener.GetStatusMask());
+    }
+
+    int64_t GetLastDataAvailableTime() const
+    {
+        return mListener.GetLastDataAvailableTime();
+    }
+
+private:
+    DdsMpmcReaderListener<MSG> mListener;
+};
+
+template<typename MSG>
+using DdsMpmcReaderPtr = std::shared_ptr<DdsMpmcReader<MSG>>;
+
 }
 }
 
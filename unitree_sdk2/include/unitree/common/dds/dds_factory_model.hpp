@@ -39,6 +39,13 @@ public:
         channelPtr->SetReader(mSubscriber, mReaderQos, cb, queuelen);
     }
 
+    template<typename MSG>
+    void SetReader(DdsTopicChannelPtr<MSG>& channelPtr, const DdsReaderFilter<MSG>& filter, const std::function<void(const void*)>& handler, int32_t queuelen = 0)
+    {
+        DdsReaderCallback cb(handler);
+        channelPtr->SetReader(mSubscriber, mReaderQos, filter, cb, queuelen);
+    }
+
 private:
     DdsParticipantPtr mParticipant;
     DdsPublisherPtr mPublisher;
@@ -42,7 +42,7 @@ public:
     void SetWriter(const DdsPublisherPtr& publisher, const DdsWriterQos& qos)
     {
         mWriter = DdsWriterPtr<MSG>(new DdsWriter<MSG>(publisher, mTopic, qos));
-        MicroSleep(UT_DDS_WAIT_MATCHED_TIME_MICRO_SEC);
+        mWriter->WaitMatched(UT_DDS_WAIT_MATCHED_TIME_MICRO_SEC);
     }
 
     void SetReader(const DdsSubscriberPtr& subscriber, const DdsReaderQos& qos, const DdsReaderCallback& cb, int32_t queuelen)
@@ -51,6 +51,12 @@ public:
         mReader->SetListener(cb, queuelen);
     }
 
+    void SetReader(const DdsSubscriberPtr& subscriber, const DdsReaderQos& qos, const DdsReaderFilter<MSG>& filter, const DdsReaderCallback& cb, int32_t queuelen)
+    {
+        mReader = DdsReaderPtr<MSG>(new DdsReader<MSG>(subscriber, mTopic, qos, filter));
+        mReader->SetListener(cb, queuelen);
+    }
+
     DdsWriterPtr<MSG> GetWriter() const
     {
         return mWriter;
@@ -0,0 +1,730 @@
+#ifndef __UT_JSON_BINDING_HPP__
+#define __UT_JSON_BINDING_HPP__
+
+#include <unitree/common/json/json_value.hpp>
+#include <type_traits>
+
+/*
+ * Define fromJson/toJson of a Jsonize type from its field table, so the
+ * fields are declared once:
+ *
+ *   class Point : public common::Jsonize
+ *   {
+ *   public:
+ *       template<typename Binder>
+ *       void jsonFields(Binder& b)
+ *       {
+ *           b("x", x);
+ *           b("y", y);
+ *       }
+ *
+ *       UT_JSONIZE_FIELDS()
+ *
+ *       float x, y;
+ *   };
+ */
+#define UT_JSONIZE_FIELDS()                                         \
+    void fromJson(unitree::common::JsonMap& json)                   \
+    {                                                               \
+        unitree::common::JsonMapFieldReader reader(json);           \
+        jsonFields(reader);                                         \
+    }                                                               \
+    void toJson(unitree::common::JsonMap& json) const               \
+    {                                                               \
+        unitree::common::JsonMapFieldWriter writer(json);           \
+        unitree::common::VisitJsonFields(*this, writer);            \
+    }
+
+namespace unitree
+{
+namespace common
+{
+/*
+ * Field table of const object. Binders used on const objects only read
+ * the fields.
+ */
+template<typename T, typename Binder>
+void VisitJsonFields(const T& t, Binder& b)
+{
+    const_cast<T&>(t).jsonFields(b);
+}
+
+class JsonFieldProbe
+{
+public:
+    template<typename F>
+    void operator()(const char*, F&)
+    {}
+};
+
+template<typename T, typename = void>
+struct HasJsonFields : std::false_type
+{};
+
+template<typename T>
+struct HasJsonFields<T, decltype(std::declval<T&>().jsonFields(std::declval<JsonFieldProbe&>()))> : std::true_type
+{};
+
+template<typename T>
+struct IsJsonVector : std::false_type
+{};
+
+template<typename E, typename A>
+struct IsJsonVector<std::vector<E,A>> : std::true_type
+{};
+
+template<typename T>
+struct IsJsonStringMap : std::false_type
+{};
+
+template<typename E, typename C, typename A>
+struct IsJsonStringMap<std::map<std::string,E,C,A>> : std::true_type
+{};
+
+template<typename T>
+struct JsonBindingUnsupported : std::false_type
+{};
+
+/*
+ * @brief
+ * @class: JsonMapFieldReader
+ * Binder reading fields from JsonMap. Missing and null members keep the
+ * field value.
+ */
+class JsonMapFieldReader
+{
+public:
+    explicit JsonMapFieldReader(JsonMap& json) :
+        mJson(json)
+    {}
+
+    template<typename F>
+    void operator()(const char* name, F& field)
+    {
+        auto iter = mJson.find(name);
+        if (iter != mJson.end() && !iter->second.Empty())
+        {
+            FromJson(iter->second, field);
+        }
+    }
+
+private:
+    JsonMap& mJson;
+};
+
+/*
+ * @brief
+ * @class: JsonMapFieldWriter
+ */
+class JsonMapFieldWriter
+{
+public:
+    explicit JsonMapFieldWriter(JsonMap& json) :
+        mJson(json)
+    {}
+
+    template<typename F>
+    void operator()(const char* name, const F& field)
+    {
+        ToJson(field, mJson[name]);
+    }
+
+private:
+    JsonMap& mJson;
+};
+
+/*
+ * @brief
+ * @class: JsonBindingReader
+ *
+ * Parses json text straight into bound fields, without a value tree.
+ * Members are matched against the field table of the target type, unknown
+ * members are skipped, missing and null members keep the field value.
+ * Strings without escapes are assigned from the input directly, so a small
+ * message allocates only for string fields longer than the small string
+ * buffer. Jsonize types without field table, Any and JsonMap fields take
+ * the JsonDocument path.
+ */
+class JsonBindingReader
+{
+public:
+    explicit JsonBindingReader(const char* s, size_t len) :
+        mBegin(s), mPtr(s), mEnd(s + len)
+    {}
+
+    template<typename T>
+    void ReadRoot(T& t)
+    {
+        SkipSpace();
+        Read(t);
+        SkipSpace();
+
+        if (mPtr != mEnd)
+        {
+            Fail("unexpected trailing characters");
+        }
+    }
+
+    template<typename T>
+    void Read(T& value)
+    {
+        if (IsNull())
+        {
+            mPtr += 4;
+            return;
+        }
+
+        if constexpr (std::is_same<T,bool>::value)
+        {
+            ReadBool(value);
+        }
+        else if constexpr (std::is_integral<T>::value || std::is_floating_point<T>::value)
+        {
+            ReadNumber(value);
+        }
+        else if constexpr (std::is_same<T,std::string>::value)
+        {
+            ReadString(value);
+        }
+        else if constexpr (IsJsonVector<T>::value)
+        {
+            ReadVector(value);
+        }
+        else if constexpr (IsJsonStringMap<T>::value)
+        {
+            ReadMap(value);
+        }
+        else if constexpr (HasJsonFields<T>::value)
+        {
+            ReadObject(value);
+        }
+        else if constexpr (std::is_base_of<Jsonize,T>::value || std::is_same<T,Any>::value || std::is_same<T,JsonMap>::value ||
+            std::is_same<T,JsonArray>::value)
+        {
+            ReadAny(value);
+        }
+        else
+        {
+            static_assert(JsonBindingUnsupported<T>::value, "type has no json binding");
+        }
+    }
+
+    /*
+     * Binder call of a field whose name matched the current member.
+     */
+    template<typename F>
+    void operator()(const char* name, F& field)
+    {
+        if (!mMatched && strlen(name) == mKeyLen && memcmp(name, mKey, mKeyLen) == 0)
+        {
+            mMatched = true;
+            Read(field);
+        }
+    }
+
+private:
+    [[noreturn]] void Fail(const char* desc)
+    {
+        UT_THROW(JsonException, std::string(desc) + " at offset " + std::to_string(mPtr - mBegin));
+    }
+
+    void SkipSpace()
+    {
+        while (mPtr < mEnd && (*mPtr == ' ' || *mPtr == '\t' || *mPtr == '\n' || *mPtr == '\r'))
+        {
+            mPtr++;
+        }
+    }
+
+    bool IsNull() const
+    {
+        return mEnd - mPtr >= 4 && memcmp(mPtr, "null", 4) == 0;
+    }
+
+    void Expect(char c)
+    {
+        SkipSpace();
+        if (mPtr >= mEnd || *mPtr != c)
+        {
+            Fail("unexpected character");
+        }
+
+        mPtr++;
+    }
+
+    /*
+     * Consume ',' and return true, or consume close and return false.
+     */
+    bool Next(char close)
+    {
+        SkipSpace();
+        if (mPtr < mEnd && *mPtr == ',')
+        {
+            mPtr++;
+            SkipSpace();
+            return true;
+        }
+
+        Expect(close);
+        return false;
+    }
+
+    bool Empty(char close)
+    {
+        SkipSpace();
+        if (mPtr < mEnd && *mPtr == close)
+        {
+            mPtr++;
+            return true;
+        }
+
+        return false;
+    }
+
+    void ReadBool(bool& value)
+    {
+        if (mEnd - mPtr >= 4 && memcmp(mPtr, "true", 4) == 0)
+        {
+            value = true;
+            mPtr += 4;
+        }
+        else if (mEnd - mPtr >= 5 && memcmp(mPtr, "false", 5) == 0)
+        {
+            value = false;
+            mPtr += 5;
+        }
+        else
+        {
+            double d = 0;
+            ReadNumber(d);
+            value = (d != 0);
+        }
+    }
+
+    template<typename T>
+    void ReadNumber(T& value)
+    {
+        if (mPtr >= mEnd)
+        {
+            Fail("unexpected end of input");
+        }
+
+        JsonValue number;
+        const char* desc = ReadJsonNumber(mPtr, mEnd, number);
+        if (desc != NULL)
+        {
+            Fail(desc);
+        }
+
+        if constexpr (std::is_integral<T>::value)
+        {
+            value = number.GetType() == UT_JSON_TYPE_UINT ? (T)number.GetUint64() : (T)number.GetInt64();
+        }
+        else
+        {
+            value = (T)number.GetDouble();
+        }
+    }
+
+    void ReadString(std::string& value)
+    {
+        const char* data;
+        size_t len;
+
+        Expect('"');
+        const char* desc = ReadJsonString(mPtr, mEnd, value, data, len);
+        if (desc != NULL)
+        {
+            Fail(desc);
+        }
+
+        if (data != value.data())
+        {
+            value.assign(data, len);
+        }
+    }
+
+    template<typename E, typename A>
+    void ReadVector(std::vector<E,A>& value)
+    {
+        Expect('[');
+        value.clear();
+
+        if (Empty(']'))
+        {
+            return;
+        }
+
+        do
+        {
+            value.emplace_back();
+            Read(value.back());
+        }
+        while (Next(']'));
+    }
+
+    template<typename E, typename C, typename A>
+    void ReadMap(std::map<std::string,E,C,A>& value)
+    {
+        Expect('{');
+        value.clear();
+
+        if (Empty('}'))
+        {
+            return;
+        }
+
+        do
+        {
+            ReadKey();
+            Read(value[std::string(mKey, mKeyLen)]);
+        }
+        while (Next('}'));
+    }
+
+    template<typename T>
+    void ReadObject(T& value)
+    {
+        /*
+         * members of a nested object reuse the key and match state of the
+         * member that contains it; restore them for the enclosing binder.
+         */
+        const char* key = mKey;
+        size_t keyLen = mKeyLen;
+        bool matched = mMatched;
+
+        Expect('{');
+
+        if (!Empty('}'))
+        {
+            do
+            {
+                ReadKey();
+
+                mMatched = false;
+                value.jsonFields(*this);
+
+                if (!mMatched)
+                {
+                    SkipValue(0);
+                }
+            }
+            while (Next('}'));
+        }
+
+        mKey = key;
+        mKeyLen = keyLen;
+        mMatched = matched;
+    }
+
+    void ReadKey()
+    {
+        Expect('"');
+
+        const char* desc = ReadJsonString(mPtr, mEnd, mKeyBuffer, mKey, mKeyLen);
+        if (desc != NULL)
+        {
+            Fail(desc);
+        }
+
+        Expect(':');
+        SkipSpace();
+    }
+
+    template<typename T>
+    void ReadAny(T& value)
+    {
+        const char* begin = mPtr;
+        SkipValue(0);
+
+        JsonDocument doc;
+        if (!doc.Parse(begin, mPtr - begin))
+        {
+            Fail("invalid value");
+        }
+
+        Any a;
+        doc.ToAny(a);
+
+        if constexpr (std::is_same<T,Any>::value)
+        {
+            value = a;
+        }
+        else
+        {
+            FromJson(a, value);
+        }
+    }
+
+    void SkipValue(int32_t depth)
+    {
+        if (depth > UT_JSON_MAX_DEPTH)
+        {
+            Fail("nesting too deep");
+        }
+
+        SkipSpace();
+        if (mPtr >= mEnd)
+        {
+            Fail("unexpected end of input");
+        }
+
+        switch (*mPtr)
+        {
+        case '{':
+            mPtr++;
+            if (!Empty('}'))
+            {
+                do
+                {
+                    ReadKey();
+                    SkipValue(depth + 1);
+                }
+                while (Next('}'));
+            }
+            break;
+        case '[':
+            mPtr++;
+            if (!Empty(']'))
+            {
+                do
+                {
+                    SkipValue(depth + 1);
+                }
+                while (Next(']'));
+            }
+            break;
+        case '"':
+        {
+            const char* data;
+            size_t len;
+
+            mPtr++;
+            const char* desc = ReadJsonString(mPtr, mEnd, mKeyBuffer, data, len);
+            if (desc != NULL)
+            {
+                Fail(desc);
+            }
+            break;
+        }
+        case 't':
+        case 'f':
+        {
+            bool b;
+            ReadBool(b);
+            break;
+        }
+        case 'n':
+            if (!IsNull())
+            {
+                Fail("invalid literal");
+            }
+            mPtr += 4;
+            break;
+        default:
+        {
+            double d;
+            ReadNumber(d);
+        }
+        }
+    }
+
+private:
+    const char* mBegin;
+    const char* mPtr;
+    const char* mEnd;
+
+    const char* mKey = NULL;
+    size_t mKeyLen = 0;
+    bool mMatched = false;
+    std::string mKeyBuffer;
+};
+
+/*
+ * @brief
+ * @class: JsonBindingWriter
+ *
+ * Writes bound fields straight into a string. Floats and doubles use the
+ * shortest text that reads back to the same value.
+ */
+class JsonBindingWriter
+{
+public:
+    explicit JsonBindingWriter(std::string& s) :
+        mString(s), mFirst(true)
+    {}
+
+    template<typename T>
+    void Write(const T& value)
+    {
+        if constexpr (std::is_same<T,bool>::value)
+        {
+            mString.append(value ? "true" : "false");
+        }
+        else if constexpr (std::is_integral<T>::value)
+        {
+            WriteInteger(value);
+        }
+        else if constexpr (std::is_same<T,float>::value)
+        {
+            WriteJsonFloat(value, mString);
+        }
+        else if constexpr (std::is_floating_point<T>::value)
+        {
+            WriteJsonDouble((double)value, mString);
+        }
+        else if constexpr (std::is_same<T,std::string>::value)
+        {
+            WriteJsonString(value.data(), value.size(), mString);
+        }
+        else if constexpr (IsJsonVector<T>::value)
+        {
+            mString.push_back('[');
+            for (size_t i=0; i<value.size(); i++)
+            {
+                if (i > 0)
+                {
+                    mString.push_back(',');
+                }
+
+                Write(value[i]);
+            }
+            mString.push_back(']');
+        }
+        else if constexpr (IsJsonStringMap<T>::value)
+        {
+            mString.push_back('{');
+            for (auto iter = value.begin(); iter != value.end(); ++iter)
+            {
+                if (iter != value.begin())
+                {
+                    mString.push_back(',');
+                }
+
+                WriteJsonString(iter->first.data(), iter->first.size(), mString);
+                mString.push_back(':');
+                Write(iter->second);
+            }
+            mString.push_back('}');
+        }
+        else if constexpr (HasJsonFields<T>::value)
+        {
+            bool first = mFirst;
+
+            mFirst = true;
+            mString.push_back('{');
+            VisitJsonFields(value, *this);
+            mString.push_back('}');
+
+            mFirst = first;
+        }
+        else if constexpr (std::is_base_of<Jsonize,T>::value || std::is_same<T,JsonMap>::value || std::is_same<T,JsonArray>::value)
+        {
+            Any a;
+            ToJson(value, a);
+            WriteAny(a);
+        }
+        else if constexpr (std::is_same<T,Any>::value)
+        {
+            WriteAny(value);
+        }
+        else
+        {
+            static_assert(JsonBindingUnsupported<T>::value, "type has no json binding");
+        }
+    }
+
+    template<typename F>
+    void operator()(const char* name, const F& field)
+    {
+        if (!mFirst)
+        {
+            mString.push_back(',');
+        }
+
+        mFirst = false;
+
+        WriteJsonString(name, strlen(name), mString);
+        mString.push_back(':');
+        Write(field);
+    }
+
+private:
+    template<typename T>
+    void WriteInteger(T value)
+    {
+        char buf[24];
+        char* end = buf + sizeof(buf);
+        char* p = end;
+
+        bool negative = value < 0;
+        uint64_t u = negative ? (uint64_t)0 - (uint64_t)value : (uint64_t)value;
+
+        do
+        {
+            *--p = (char)('0' + u % 10);
+            u /= 10;
+        }
+        while (u > 0);
+
+        if (negative)
+        {
+            *--p = '-';
+        }
+
+        mString.append(p, end - p);
+    }
+
+    void WriteAny(const Any& a)
+    {
+        JsonArena arena;
+        JsonValue value;
+        AnyToJsonValue(a, value, arena);
+        WriteJson(value, mString);
+    }
+
+private:
+    std::string& mString;
+    bool mFirst;
+};
+
+/*
+ * Parse into a bound type without Any tree. Throws JsonException.
+ */
+template<typename T>
+void FromJsonStringDirect(const char* s, size_t len, T& t)
+{
+    JsonBindingReader reader(s, len);
+    reader.ReadRoot(t);
+}
+
+template<typename T>
+void FromJsonStringDirect(const std::string& s, T& t)
+{
+    FromJsonStringDirect(s.data(), s.size(), t);
+}
+
+/*
+ * Write a bound type into s. s is cleared first; reusing one string keeps
+ * its capacity, so repeated writes do not allocate.
+ */
+template<typename T>
+void ToJsonStringDirect(const T& t, std::string& s)
+{
+    s.clear();
+    JsonBindingWriter writer(s);
+    writer.Write(t);
+}
+
+template<typename T>
+std::string ToJsonStringDirect(const T& t)
+{
+    std::string s;
+    ToJsonStringDirect(t, s);
+    return s;
+}
+
+}
+}
+
+#endif//__UT_JSON_BINDING_HPP__
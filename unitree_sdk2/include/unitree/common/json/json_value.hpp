@@ -0,0 +1,1724 @@
+#ifndef __UT_JSON_VALUE_HPP__
+#define __UT_JSON_VALUE_HPP__
+
+#include <unitree/common/json/jsonize.hpp>
+#include <cinttypes>
+#include <cmath>
+
+namespace unitree
+{
+namespace common
+{
+enum
+{
+    UT_JSON_TYPE_NULL   = 0,
+    UT_JSON_TYPE_BOOL   = 1,
+    UT_JSON_TYPE_INT    = 2,
+    UT_JSON_TYPE_UINT   = 3,
+    UT_JSON_TYPE_DOUBLE = 4,
+    UT_JSON_TYPE_STRING = 5,
+    UT_JSON_TYPE_ARRAY  = 6,
+    UT_JSON_TYPE_OBJECT = 7
+};
+
+/*
+ * @brief  first chunk size of json arena. chunks double up to max size.
+ */
+const size_t UT_JSON_ARENA_CHUNK_SIZE       = 4096;
+const size_t UT_JSON_ARENA_CHUNK_MAX_SIZE   = 1048576;
+
+/*
+ * @brief  strings shorter than this are stored inside the value.
+ */
+const size_t UT_JSON_INLINE_STRING_SIZE     = 16;
+
+/*
+ * @brief  max nesting depth accepted by parser.
+ */
+const int32_t UT_JSON_MAX_DEPTH             = 512;
+
+/*
+ * @brief
+ * @class: JsonArena
+ *
+ * Bump allocator of one json document. Memory is released all at once when
+ * the arena is cleared or destroyed; values in it have no destructors.
+ */
+class JsonArena
+{
+public:
+    explicit JsonArena(size_t chunkSize = UT_JSON_ARENA_CHUNK_SIZE) :
+        mChunkSize(chunkSize), mPtr(NULL), mEnd(NULL), mSize(0)
+    {}
+
+    ~JsonArena()
+    {
+        Clear();
+    }
+
+    JsonArena(const JsonArena&) = delete;
+    JsonArena& operator=(const JsonArena&) = delete;
+
+    JsonArena(JsonArena&& other) noexcept :
+        mChunkSize(other.mChunkSize), mPtr(other.mPtr), mEnd(other.mEnd), mSize(other.mSize),
+        mChunkList(std::move(other.mChunkList))
+    {
+        other.mPtr = other.mEnd = NULL;
+        other.mSize = 0;
+        other.mChunkList.clear();
+    }
+
+    JsonArena& operator=(JsonArena&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Clear();
+
+            mChunkSize = other.mChunkSize;
+            mPtr = other.mPtr;
+            mEnd = other.mEnd;
+            mSize = other.mSize;
+            mChunkList = std::move(other.mChunkList);
+
+            other.mPtr = other.mEnd = NULL;
+            other.mSize = 0;
+            other.mChunkList.clear();
+        }
+
+        return *this;
+    }
+
+    void* Allocate(size_t size)
+    {
+        size = (size + 7) & ~(size_t)7;
+
+        if (size > (size_t)(mEnd - mPtr))
+        {
+            Grow(size);
+        }
+
+        void* p = mPtr;
+        mPtr += size;
+
+        return p;
+    }
+
+    void Clear()
+    {
+        for (char* chunk : mChunkList)
+        {
+            free(chunk);
+        }
+
+        mChunkList.clear();
+        mPtr = mEnd = NULL;
+        mSize = 0;
+    }
+
+    /*
+     * Drop all values but keep the largest chunk for reuse.
+     */
+    void Reset()
+    {
+        if (mChunkList.empty())
+        {
+            return;
+        }
+
+        char* last = mChunkList.back();
+        size_t lastSize = mEnd - last;
+
+        mChunkList.pop_back();
+        for (char* chunk : mChunkList)
+        {
+            free(chunk);
+        }
+
+        mChunkList.clear();
+        mChunkList.push_back(last);
+        mPtr = last;
+        mSize = lastSize;
+    }
+
+    /*
+     * bytes reserved from system
+     */
+    size_t GetSize() const
+    {
+        return mSize;
+    }
+
+private:
+    void Grow(size_t size)
+    {
+        size_t chunkSize = std::max(mChunkSize, size);
+
+        char* chunk = (char*)malloc(chunkSize);
+        if (chunk == NULL)
+        {
+            throw std::bad_alloc();
+        }
+
+        mChunkList.push_back(chunk);
+        mPtr = chunk;
+        mEnd = chunk + chunkSize;
+        mSize += chunkSize;
+
+        mChunkSize = std::min(mChunkSize * 2, std::max(UT_JSON_ARENA_CHUNK_MAX_SIZE, mChunkSize));
+    }
+
+private:
+    size_t mChunkSize;
+    char* mPtr;
+    char* mEnd;
+    size_t mSize;
+    std::vector<char*> mChunkList;
+};
+
+/*
+ * 10^n for 0 <= n <= 22, exact in double.
+ */
+inline double JsonPow10(int32_t n)
+{
+    static const double pow10[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    return pow10[n];
+}
+
+class JsonMember;
+
+/*
+ * @brief
+ * @class: JsonValue
+ *
+ * 24 byte json node. Numbers, bools and strings shorter than 16 bytes are
+ * stored inline, longer strings, array items and object members live in
+ * the arena of the document. Values are move-only: moving leaves the
+ * source null, copying is not allowed because storage is owned by the
+ * arena, not by the value.
+ */
+class JsonValue
+{
+public:
+    JsonValue() :
+        mSize(0), mType(UT_JSON_TYPE_NULL), mInline(false)
+    {
+        mData.mUint = 0;
+    }
+
+    JsonValue(const JsonValue&) = delete;
+    JsonValue& operator=(const JsonValue&) = delete;
+
+    JsonValue(JsonValue&& other) noexcept :
+        mData(other.mData), mSize(other.mSize), mType(other.mType), mInline(other.mInline)
+    {
+        other.Reset();
+    }
+
+    JsonValue& operator=(JsonValue&& other) noexcept
+    {
+        if (this != &other)
+        {
+            mData = other.mData;
+            mSize = other.mSize;
+            mType = other.mType;
+            mInline = other.mInline;
+            other.Reset();
+        }
+
+        return *this;
+    }
+
+    uint8_t GetType() const
+    {
+        return mType;
+    }
+
+    bool IsNull() const
+    {
+        return mType == UT_JSON_TYPE_NULL;
+    }
+
+    bool IsBool() const
+    {
+        return mType == UT_JSON_TYPE_BOOL;
+    }
+
+    bool IsInteger() const
+    {
+        return mType == UT_JSON_TYPE_INT || mType == UT_JSON_TYPE_UINT;
+    }
+
+    bool IsNumber() const
+    {
+        return IsInteger() || mType == UT_JSON_TYPE_DOUBLE;
+    }
+
+    bool IsDouble() const
+    {
+        return mType == UT_JSON_TYPE_DOUBLE;
+    }
+
+    bool IsString() const
+    {
+        return mType == UT_JSON_TYPE_STRING;
+    }
+
+    bool IsArray() const
+    {
+        return mType == UT_JSON_TYPE_ARRAY;
+    }
+
+    bool IsObject() const
+    {
+        return mType == UT_JSON_TYPE_OBJECT;
+    }
+
+    bool GetBool() const
+    {
+        CheckType(IsBool(), "bool");
+        return mData.mBool;
+    }
+
+    int64_t GetInt64() const
+    {
+        CheckType(IsNumber(), "number");
+        return mType == UT_JSON_TYPE_INT ? mData.mInt : (mType == UT_JSON_TYPE_UINT ? (int64_t)mData.mUint : (int64_t)mData.mDouble);
+    }
+
+    uint64_t GetUint64() const
+    {
+        CheckType(IsNumber(), "number");
+        return mType == UT_JSON_TYPE_UINT ? mData.mUint : (mType == UT_JSON_TYPE_INT ? (uint64_t)mData.mInt : (uint64_t)mData.mDouble);
+    }
+
+    double GetDouble() const
+    {
+        CheckType(IsNumber(), "number");
+        return mType == UT_JSON_TYPE_DOUBLE ? mData.mDouble : (mType == UT_JSON_TYPE_INT ? (double)mData.mInt : (double)mData.mUint);
+    }
+
+    /*
+     * Null terminated string.
+     */
+    const char* GetString() const
+    {
+        CheckType(IsString(), "string");
+        return mInline ? mData.mInlineString : mData.mString;
+    }
+
+    size_t GetStringLength() const
+    {
+        CheckType(IsString(), "string");
+        return mSize;
+    }
+
+    std::string GetStdString() const
+    {
+        return std::string(GetString(), GetStringLength());
+    }
+
+    /*
+     * Item number of array, member number of object.
+     */
+    size_t Size() const
+    {
+        return (IsArray() || IsObject()) ? mSize : 0;
+    }
+
+    const JsonValue& operator[](size_t index) const
+    {
+        CheckType(IsArray() && index < mSize, "array item");
+        return ((const JsonValue*)mData.mContainer.mPtr)[index];
+    }
+
+    const JsonValue* Begin() const
+    {
+        return IsArray() ? (const JsonValue*)mData.mContainer.mPtr : NULL;
+    }
+
+    const JsonValue* End() const
+    {
+        return IsArray() ? (const JsonValue*)mData.mContainer.mPtr + mSize : NULL;
+    }
+
+    inline const JsonMember* MemberBegin() const;
+    inline const JsonMember* MemberEnd() const;
+
+    /*
+     * Member of object, or NULL.
+     */
+    inline const JsonValue* Find(const char* name, size_t len) const;
+
+    const JsonValue* Find(const std::string& name) const
+    {
+        return Find(name.data(), name.size());
+    }
+
+    /*
+     * Member of object, or a null value.
+     */
+    const JsonValue& operator[](const std::string& name) const
+    {
+        const JsonValue* value = Find(name);
+        return value ? *value : Null();
+    }
+
+    void SetNull()
+    {
+        Reset();
+    }
+
+    void SetBool(bool value)
+    {
+        Reset();
+        mType = UT_JSON_TYPE_BOOL;
+        mData.mBool = value;
+    }
+
+    void SetInt64(int64_t value)
+    {
+        Reset();
+        mType = UT_JSON_TYPE_INT;
+        mData.mInt = value;
+    }
+
+    void SetUint64(uint64_t value)
+    {
+        Reset();
+        mType = UT_JSON_TYPE_UINT;
+        mData.mUint = value;
+    }
+
+    void SetDouble(double value)
+    {
+        Reset();
+        mType = UT_JSON_TYPE_DOUBLE;
+        mData.mDouble = value;
+    }
+
+    void SetString(const char* s, size_t len, JsonArena& arena)
+    {
+        Reset();
+        mType = UT_JSON_TYPE_STRING;
+        mSize = (uint32_t)len;
+
+        char* p;
+        if (len < UT_JSON_INLINE_STRING_SIZE)
+        {
+            mInline = true;
+            p = mData.mInlineString;
+        }
+        else
+        {
+            p = (char*)arena.Allocate(len + 1);
+            mData.mString = p;
+        }
+
+        memcpy(p, s, len);
+        p[len] = 0;
+    }
+
+    void SetString(const std::string& s, JsonArena& arena)
+    {
+        SetString(s.data(), s.size(), arena);
+    }
+
+    /*
+     * Empty array with room for capacity items.
+     */
+    void SetArray(JsonArena& arena, size_t capacity = 0)
+    {
+        Reset();
+        mType = UT_JSON_TYPE_ARRAY;
+        Reserve(sizeof(JsonValue), capacity, arena);
+    }
+
+    inline void SetObject(JsonArena& arena, size_t capacity = 0);
+
+    JsonValue& PushBack(JsonValue&& value, JsonArena& arena)
+    {
+        CheckType(IsArray(), "array");
+
+        if (mSize == mData.mContainer.mCapacity)
+        {
+            Reserve(sizeof(JsonValue), mSize ? mSize * 2 : 4, arena);
+        }
+
+        JsonValue* item = new ((JsonValue*)mData.mContainer.mPtr + mSize) JsonValue(std::move(value));
+        mSize++;
+
+        return *item;
+    }
+
+    inline JsonValue& AddMember(const char* name, size_t len, JsonValue&& value, JsonArena& arena);
+
+    JsonValue& AddMember(const std::string& name, JsonValue&& value, JsonArena& arena)
+    {
+        return AddMember(name.data(), name.size(), std::move(value), arena);
+    }
+
+    static const JsonValue& Null()
+    {
+        static const JsonValue null;
+        return null;
+    }
+
+private:
+    friend class JsonParser;
+
+    void Reset()
+    {
+        mData.mUint = 0;
+        mSize = 0;
+        mType = UT_JSON_TYPE_NULL;
+        mInline = false;
+    }
+
+    void CheckType(bool valid, const char* expected) const
+    {
+        if (!valid)
+        {
+            UT_THROW(JsonException, std::string("json value is not ") + expected);
+        }
+    }
+
+    /*
+     * Grow array or object storage. Old storage stays in the arena.
+     */
+    void Reserve(size_t itemSize, size_t capacity, JsonArena& arena)
+    {
+        if (capacity <= mData.mContainer.mCapacity && mData.mContainer.mPtr != NULL)
+        {
+            return;
+        }
+
+        void* ptr = capacity ? arena.Allocate(itemSize * capacity) : NULL;
+        if (mSize > 0)
+        {
+            memcpy(ptr, mData.mContainer.mPtr, itemSize * mSize);
+        }
+
+        mData.mContainer.mPtr = ptr;
+        mData.mContainer.mCapacity = (uint32_t)capacity;
+    }
+
+    /*
+     * Take ownership of count items already placed in arena.
+     */
+    void Attach(uint8_t type, void* ptr, size_t count)
+    {
+        Reset();
+        mType = type;
+        mSize = (uint32_t)count;
+        mData.mContainer.mPtr = ptr;
+        mData.mContainer.mCapacity = (uint32_t)count;
+    }
+
+private:
+    union Data
+    {
+        bool mBool;
+        int64_t mInt;
+        uint64_t mUint;
+        double mDouble;
+        const char* mString;
+        char mInlineString[UT_JSON_INLINE_STRING_SIZE];
+        struct
+        {
+            void* mPtr;
+            uint32_t mCapacity;
+        } mContainer;
+    } mData;
+
+    uint32_t mSize;
+    uint8_t mType;
+    bool mInline;
+};
+
+/*
+ * @brief
+ * @class: JsonMember
+ */
+class JsonMember
+{
+public:
+    JsonMember()
+    {}
+
+    JsonMember(JsonValue&& name, JsonValue&& value) :
+        mName(std::move(name)), mValue(std::move(value))
+    {}
+
+public:
+    JsonValue mName;
+    JsonValue mValue;
+};
+
+const JsonMember* JsonValue::MemberBegin() const
+{
+    return IsObject() ? (const JsonMember*)mData.mContainer.mPtr : NULL;
+}
+
+const JsonMember* JsonValue::MemberEnd() const
+{
+    return IsObject() ? (const JsonMember*)mData.mContainer.mPtr + mSize : NULL;
+}
+
+const JsonValue* JsonValue::Find(const char* name, size_t len) const
+{
+    if (!IsObject())
+    {
+        return NULL;
+    }
+
+    for (const JsonMember* member = MemberBegin(); member != MemberEnd(); member++)
+    {
+        if (member->mName.mSize == len && memcmp(member->mName.GetString(), name, len) == 0)
+        {
+            return &member->mValue;
+        }
+    }
+
+    return NULL;
+}
+
+void JsonValue::SetObject(JsonArena& arena, size_t capacity)
+{
+    Reset();
+    mType = UT_JSON_TYPE_OBJECT;
+    Reserve(sizeof(JsonMember), capacity, arena);
+}
+
+JsonValue& JsonValue::AddMember(const char* name, size_t len, JsonValue&& value, JsonArena& arena)
+{
+    CheckType(IsObject(), "object");
+
+    if (mSize == mData.mContainer.mCapacity)
+    {
+        Reserve(sizeof(JsonMember), mSize ? mSize * 2 : 4, arena);
+    }
+
+    JsonMember* member = new ((JsonMember*)mData.mContainer.mPtr + mSize) JsonMember();
+    member->mName.SetString(name, len, arena);
+    member->mValue = std::move(value);
+    mSize++;
+
+    return member->mValue;
+}
+
+/*
+ * Parse 4 hex digits of a unicode escape.
+ */
+inline bool ReadJsonHex4(const char*& ptr, const char* end, uint32_t& code)
+{
+    if (end - ptr < 4)
+    {
+        return false;
+    }
+
+    code = 0;
+    for (int32_t i=0; i<4; i++)
+    {
+        char c = *ptr++;
+        code <<= 4;
+
+        if (c >= '0' && c <= '9')
+        {
+            code |= c - '0';
+        }
+        else if (c >= 'a' && c <= 'f')
+        {
+            code |= c - 'a' + 10;
+        }
+        else if (c >= 'A' && c <= 'F')
+        {
+            code |= c - 'A' + 10;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Decode a unicode escape after "\\u" and append it as utf-8.
+ */
+inline bool ReadJsonUnicode(const char*& ptr, const char* end, std::string& out)
+{
+    uint32_t code = 0;
+    if (!ReadJsonHex4(ptr, end, code))
+    {
+        return false;
+    }
+
+    if (code >= 0xD800 && code <= 0xDBFF)
+    {
+        uint32_t low = 0;
+        if (end - ptr < 2 || ptr[0] != '\\' || ptr[1] != 'u')
+        {
+            return false;
+        }
+
+        ptr += 2;
+        if (!ReadJsonHex4(ptr, end, low) || low < 0xDC00 || low > 0xDFFF)
+        {
+            return false;
+        }
+
+        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+    }
+
+    if (code < 0x80)
+    {
+        out.push_back((char)code);
+    }
+    else if (code < 0x800)
+    {
+        out.push_back((char)(0xC0 | (code >> 6)));
+        out.push_back((char)(0x80 | (code & 0x3F)));
+    }
+    else if (code < 0x10000)
+    {
+        out.push_back((char)(0xE0 | (code >> 12)));
+        out.push_back((char)(0x80 | ((code >> 6) & 0x3F)));
+        out.push_back((char)(0x80 | (code & 0x3F)));
+    }
+    else
+    {
+        out.push_back((char)(0xF0 | (code >> 18)));
+        out.push_back((char)(0x80 | ((code >> 12) & 0x3F)));
+        out.push_back((char)(0x80 | ((code >> 6) & 0x3F)));
+        out.push_back((char)(0x80 | (code & 0x3F)));
+    }
+
+    return true;
+}
+
+/*
+ * Read string body from after the opening quote to past the closing quote.
+ * A string without escapes is returned as data/len pointing into input and
+ * out is untouched; otherwise it is decoded into out and data/len point to
+ * out. Returns NULL, or error description.
+ */
+inline const char* ReadJsonString(const char*& ptr, const char* end, std::string& out, const char*& data, size_t& len)
+{
+    const char* begin = ptr;
+
+    while (ptr < end && *ptr != '"' && *ptr != '\\')
+    {
+        ptr++;
+    }
+
+    if (ptr >= end)
+    {
+        return "unterminated string";
+    }
+
+    if (*ptr == '"')
+    {
+        data = begin;
+        len = ptr - begin;
+        ptr++;
+        return NULL;
+    }
+
+    out.assign(begin, ptr - begin);
+
+    while (ptr < end && *ptr != '"')
+    {
+        char c = *ptr++;
+        if (c != '\\')
+        {
+            out.push_back(c);
+            continue;
+        }
+
+        if (ptr >= end)
+        {
+            break;
+        }
+
+        c = *ptr++;
+        switch (c)
+        {
+        case '"':
+        case '\\':
+        case '/':
+            out.push_back(c);
+            break;
+        case 'b':
+            out.push_back('\b');
+            break;
+        case 'f':
+            out.push_back('\f');
+            break;
+        case 'n':
+            out.push_back('\n');
+            break;
+        case 'r':
+            out.push_back('\r');
+            break;
+        case 't':
+            out.push_back('\t');
+            break;
+        case 'u':
+            if (!ReadJsonUnicode(ptr, end, out))
+            {
+                return "invalid unicode escape";
+            }
+            break;
+        default:
+            return "invalid escape";
+        }
+    }
+
+    if (ptr >= end)
+    {
+        return "unterminated string";
+    }
+
+    ptr++;
+    data = out.data();
+    len = out.size();
+
+    return NULL;
+}
+
+/*
+ * Read a number. Integers that fit become int64 / uint64, others double.
+ * Returns NULL, or error description.
+ */
+inline const char* ReadJsonNumber(const char*& ptr, const char* end, JsonValue& value)
+{
+    const char* begin = ptr;
+
+    bool negative = false;
+    if (*ptr == '-')
+    {
+        negative = true;
+        ptr++;
+    }
+
+    if (ptr >= end || *ptr < '0' || *ptr > '9')
+    {
+        return "invalid value";
+    }
+
+    if (*ptr == '0' && ptr + 1 < end && ptr[1] >= '0' && ptr[1] <= '9')
+    {
+        return "leading zero";
+    }
+
+    uint64_t integer = 0;
+    int32_t digits = 0;
+    bool overflow = false;
+
+    while (ptr < end && *ptr >= '0' && *ptr <= '9')
+    {
+        uint32_t digit = *ptr++ - '0';
+        if (integer > (UINT64_MAX - digit) / 10)
+        {
+            overflow = true;
+        }
+
+        integer = integer * 10 + digit;
+        digits += (integer > 0);
+    }
+
+    bool real = overflow;
+    int32_t exponent = 0;
+
+    if (ptr < end && *ptr == '.')
+    {
+        real = true;
+        ptr++;
+        while (ptr < end && *ptr >= '0' && *ptr <= '9')
+        {
+            if (digits < 19)
+            {
+                integer = integer * 10 + (*ptr - '0');
+                digits += (integer > 0);
+                exponent--;
+            }
+            else
+            {
+                overflow = true;
+            }
+
+            ptr++;
+        }
+    }
+
+    if (ptr < end && (*ptr == 'e' || *ptr == 'E'))
+    {
+        real = true;
+        ptr++;
+
+        bool negativeExponent = false;
+        if (ptr < end && (*ptr == '+' || *ptr == '-'))
+        {
+            negativeExponent = (*ptr++ == '-');
+        }
+
+        int32_t e = 0;
+        while (ptr < end && *ptr >= '0' && *ptr <= '9')
+        {
+            e = std::min(e * 10 + (*ptr++ - '0'), 100000);
+        }
+
+        exponent += negativeExponent ? -e : e;
+    }
+
+    /*
+     * exact fast path: mantissa fits a double and 10^|exponent| is exact.
+     */
+    if (real && !overflow && integer <= ((uint64_t)1 << 53) && exponent >= -22 && exponent <= 22)
+    {
+        double d = (double)integer;
+        d = exponent < 0 ? d / JsonPow10(-exponent) : d * JsonPow10(exponent);
+        value.SetDouble(negative ? -d : d);
+        return NULL;
+    }
+
+    if (!real)
+    {
+        if (!negative)
+        {
+            if (integer <= (uint64_t)INT64_MAX)
+            {
+                value.SetInt64((int64_t)integer);
+            }
+            else
+            {
+                value.SetUint64(integer);
+            }
+
+            return NULL;
+        }
+
+        if (integer <= (uint64_t)INT64_MAX + 1)
+        {
+            value.SetInt64((int64_t)(0 - integer));
+            return NULL;
+        }
+    }
+
+    /*
+     * input is not null terminated, strtod works on a copy
+     */
+    char buf[64];
+    size_t len = ptr - begin;
+    std::string longNumber;
+    const char* number = buf;
+
+    if (len < sizeof(buf))
+    {
+        memcpy(buf, begin, len);
+        buf[len] = 0;
+    }
+    else
+    {
+        longNumber.assign(begin, len);
+        number = longNumber.c_str();
+    }
+
+    char* tail = NULL;
+    double d = strtod(number, &tail);
+
+    if (tail != number + len)
+    {
+        return "invalid number";
+    }
+
+    value.SetDouble(d);
+
+    return NULL;
+}
+
+/*
+ * @brief
+ * @class: JsonParser
+ *
+ * Recursive descent parser writing into an arena. Items of the array or
+ * object being parsed are collected on stacks shared by all nesting levels
+ * and moved into an exactly sized arena block when it closes, so a parse
+ * allocates nothing per node once the stacks have grown.
+ */
+class JsonParser
+{
+public:
+    explicit JsonParser(JsonArena& arena) :
+        mArena(arena), mBegin(NULL), mPtr(NULL), mEnd(NULL)
+    {}
+
+    bool Parse(const char* s, size_t len, JsonValue& root)
+    {
+        mBegin = mPtr = s;
+        mEnd = s + len;
+        mError.clear();
+
+        SkipSpace();
+        if (!ParseValue(root, 0))
+        {
+            return false;
+        }
+
+        SkipSpace();
+        if (mPtr != mEnd)
+        {
+            return Error("unexpected trailing characters");
+        }
+
+        return true;
+    }
+
+    const std::string& GetError() const
+    {
+        return mError;
+    }
+
+private:
+    bool Error(const char* desc)
+    {
+        mError = std::string(desc) + " at offset " + std::to_string(mPtr - mBegin);
+        return false;
+    }
+
+    void SkipSpace()
+    {
+        while (mPtr < mEnd && (*mPtr == ' ' || *mPtr == '\t' || *mPtr == '\n' || *mPtr == '\r'))
+        {
+            mPtr++;
+        }
+    }
+
+    bool Consume(const char* literal, size_t len)
+    {
+        if ((size_t)(mEnd - mPtr) < len || memcmp(mPtr, literal, len) != 0)
+        {
+            return Error("invalid literal");
+        }
+
+        mPtr += len;
+        return true;
+    }
+
+    bool ParseValue(JsonValue& value, int32_t depth)
+    {
+        if (mPtr >= mEnd)
+        {
+            return Error("unexpected end of input");
+        }
+
+        switch (*mPtr)
+        {
+        case '{':
+            return ParseObject(value, depth + 1);
+        case '[':
+            return ParseArray(value, depth + 1);
+        case '"':
+            return ParseString(value);
+        case 't':
+            value.SetBool(true);
+            return Consume("true", 4);
+        case 'f':
+            value.SetBool(false);
+            return Consume("false", 5);
+        case 'n':
+            value.SetNull();
+            return Consume("null", 4);
+        default:
+            return ParseNumber(value);
+        }
+    }
+
+    bool ParseObject(JsonValue& value, int32_t depth)
+    {
+        if (depth > UT_JSON_MAX_DEPTH)
+        {
+            return Error("nesting too deep");
+        }
+
+        mPtr++;
+        SkipSpace();
+
+        size_t base = mMemberStack.size();
+
+        if (mPtr < mEnd && *mPtr == '}')
+        {
+            mPtr++;
+        }
+        else
+        {
+            while (true)
+            {
+                JsonValue name, item;
+
+                if (mPtr >= mEnd || *mPtr != '"')
+                {
+                    return Unwind(base, "expect member name");
+                }
+
+                if (!ParseString(name))
+                {
+                    return Unwind(base, NULL);
+                }
+
+                SkipSpace();
+                if (mPtr >= mEnd || *mPtr != ':')
+                {
+                    return Unwind(base, "expect ':'");
+                }
+
+                mPtr++;
+                SkipSpace();
+
+                if (!ParseValue(item, depth))
+                {
+                    return Unwind(base, NULL);
+                }
+
+                mMemberStack.emplace_back(std::move(name), std::move(item));
+
+                SkipSpace();
+                if (mPtr < mEnd && *mPtr == ',')
+                {
+                    mPtr++;
+                    SkipSpace();
+                    continue;
+                }
+
+                if (mPtr < mEnd && *mPtr == '}')
+                {
+                    mPtr++;
+                    break;
+                }
+
+                return Unwind(base, "expect ',' or '}'");
+            }
+        }
+
+        size_t count = mMemberStack.size() - base;
+        JsonMember* members = count ? (JsonMember*)mArena.Allocate(sizeof(JsonMember) * count) : NULL;
+
+        for (size_t i=0; i<count; i++)
+        {
+            new (members + i) JsonMember(std::move(mMemberStack[base + i].mName), std::move(mMemberStack[base + i].mValue));
+        }
+
+        mMemberStack.resize(base);
+        value.Attach(UT_JSON_TYPE_OBJECT, members, count);
+
+        return true;
+    }
+
+    bool ParseArray(JsonValue& value, int32_t depth)
+    {
+        if (depth > UT_JSON_MAX_DEPTH)
+        {
+            return Error("nesting too deep");
+        }
+
+        mPtr++;
+        SkipSpace();
+
+        size_t base = mValueStack.size();
+
+        if (mPtr < mEnd && *mPtr == ']')
+        {
+            mPtr++;
+        }
+        else
+        {
+            while (true)
+            {
+                JsonValue item;
+
+                if (!ParseValue(item, depth))
+                {
+                    mValueStack.resize(base);
+                    return false;
+                }
+
+                mValueStack.push_back(std::move(item));
+
+                SkipSpace();
+                if (mPtr < mEnd && *mPtr == ',')
+                {
+                    mPtr++;
+                    SkipSpace();
+                    continue;
+                }
+
+                if (mPtr < mEnd && *mPtr == ']')
+                {
+                    mPtr++;
+                    break;
+                }
+
+                mValueStack.resize(base);
+                return Error("expect ',' or ']'");
+            }
+        }
+
+        size_t count = mValueStack.size() - base;
+        JsonValue* items = count ? (JsonValue*)mArena.Allocate(sizeof(JsonValue) * count) : NULL;
+
+        for (size_t i=0; i<count; i++)
+        {
+            new (items + i) JsonValue(std::move(mValueStack[base + i]));
+        }
+
+        mValueStack.resize(base);
+        value.Attach(UT_JSON_TYPE_ARRAY, items, count);
+
+        return true;
+    }
+
+    bool Unwind(size_t base, const char* desc)
+    {
+        mMemberStack.resize(base);
+        return desc ? Error(desc) : false;
+    }
+
+    bool ParseString(JsonValue& value)
+    {
+        const char* data;
+        size_t len;
+
+        mPtr++;
+        const char* desc = ReadJsonString(mPtr, mEnd, mScratch, data, len);
+        if (desc != NULL)
+        {
+            return Error(desc);
+        }
+
+        value.SetString(data, len, mArena);
+
+        return true;
+    }
+
+    bool ParseNumber(JsonValue& value)
+    {
+        const char* desc = ReadJsonNumber(mPtr, mEnd, value);
+        return desc == NULL || Error(desc);
+    }
+
+private:
+    JsonArena& mArena;
+
+    const char* mBegin;
+    const char* mPtr;
+    const char* mEnd;
+
+    std::string mScratch;
+    std::string mError;
+
+    std::vector<JsonValue> mValueStack;
+    std::vector<JsonMember> mMemberStack;
+};
+
+/*
+ * Append digits / 10^k.
+ */
+inline void WriteJsonDecimal(uint64_t digits, int32_t k, bool negative, std::string& s)
+{
+    char buf[32];
+    char* end = buf + sizeof(buf);
+    char* p = end;
+
+    for (int32_t i=0; i<k; i++)
+    {
+        *--p = (char)('0' + digits % 10);
+        digits /= 10;
+    }
+
+    *--p = '.';
+
+    if (k == 0)
+    {
+        p = end;
+        *--p = '0';
+        *--p = '.';
+    }
+
+    do
+    {
+        *--p = (char)('0' + digits % 10);
+        digits /= 10;
+    }
+    while (digits > 0);
+
+    if (negative)
+    {
+        *--p = '-';
+    }
+
+    s.append(p, end - p);
+}
+
+/*
+ * Write value as the shortest decimal m / 10^k, k <= maxK, that reads back
+ * to the same value: JsonParser computes m / 10^k with one correctly rounded
+ * division and rounds it to T. Returns false if no such decimal exists.
+ */
+template<typename T>
+inline bool WriteJsonShortest(T value, int32_t maxK, std::string& s)
+{
+    double a = std::fabs((double)value);
+
+    for (int32_t k=0; k<=maxK; k++)
+    {
+        double m = std::nearbyint(a * JsonPow10(k));
+        if (m >= 9007199254740992.0)
+        {
+            break;
+        }
+
+        if ((T)(m / JsonPow10(k)) == (T)a)
+        {
+            WriteJsonDecimal((uint64_t)m, k, std::signbit(value), s);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+inline void WriteJsonFallback(const char* format, double d, std::string& s)
+{
+    char buf[32];
+    int len = snprintf(buf, sizeof(buf), format, d);
+    s.append(buf, len);
+
+    /*
+     * keep the value a double when read back
+     */
+    if (strpbrk(buf, ".eE") == NULL)
+    {
+        s.append(".0");
+    }
+}
+
+/*
+ * Write double with shortest round trip. nan and inf are written as null.
+ */
+inline void WriteJsonDouble(double d, std::string& s)
+{
+    if (!std::isfinite(d))
+    {
+        s.append("null");
+    }
+    else if (!WriteJsonShortest<double>(d, 17, s))
+    {
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%.15g", d);
+        WriteJsonFallback(strtod(buf, NULL) == d ? "%.15g" : "%.17g", d, s);
+    }
+}
+
+/*
+ * Write float with shortest round trip through float.
+ */
+inline void WriteJsonFloat(float f, std::string& s)
+{
+    if (!std::isfinite(f))
+    {
+        s.append("null");
+    }
+    else if (!WriteJsonShortest<float>(f, 12, s))
+    {
+        static const char* format[] = { "%.6g", "%.7g", "%.8g" };
+
+        char buf[32];
+        for (const char* fmt : format)
+        {
+            snprintf(buf, sizeof(buf), fmt, f);
+            if ((float)strtod(buf, NULL) == f)
+            {
+                WriteJsonFallback(fmt, f, s);
+                return;
+            }
+        }
+
+        WriteJsonFallback("%.9g", f, s);
+    }
+}
+
+/*
+ * Write quoted and escaped string.
+ */
+inline void WriteJsonString(const char* p, size_t len, std::string& s)
+{
+    const char* end = p + len;
+
+    s.push_back('"');
+    for (; p < end; p++)
+    {
+        unsigned char c = (unsigned char)*p;
+        switch (c)
+        {
+        case '"':
+            s.append("\\\"");
+            break;
+        case '\\':
+            s.append("\\\\");
+            break;
+        case '\n':
+            s.append("\\n");
+            break;
+        case '\r':
+            s.append("\\r");
+            break;
+        case '\t':
+            s.append("\\t");
+            break;
+        case '\b':
+            s.append("\\b");
+            break;
+        case '\f':
+            s.append("\\f");
+            break;
+        default:
+            if (c < 0x20)
+            {
+                char buf[8];
+                s.append(buf, snprintf(buf, sizeof(buf), "\\u%04x", c));
+            }
+            else
+            {
+                s.push_back((char)c);
+            }
+        }
+    }
+    s.push_back('"');
+}
+
+/*
+ * Serialize value.
+ */
+inline void WriteJson(const JsonValue& value, std::string& s, bool pretty = false, int32_t indent = 0)
+{
+    char buf[32];
+
+    switch (value.GetType())
+    {
+    case UT_JSON_TYPE_NULL:
+        s.append("null");
+        break;
+    case UT_JSON_TYPE_BOOL:
+        s.append(value.GetBool() ? "true" : "false");
+        break;
+    case UT_JSON_TYPE_INT:
+        s.append(buf, snprintf(buf, sizeof(buf), "%" PRId64, value.GetInt64()));
+        break;
+    case UT_JSON_TYPE_UINT:
+        s.append(buf, snprintf(buf, sizeof(buf), "%" PRIu64, value.GetUint64()));
+        break;
+    case UT_JSON_TYPE_DOUBLE:
+        WriteJsonDouble(value.GetDouble(), s);
+        break;
+    case UT_JSON_TYPE_STRING:
+        WriteJsonString(value.GetString(), value.GetStringLength(), s);
+        break;
+    case UT_JSON_TYPE_ARRAY:
+    {
+        s.push_back('[');
+        for (const JsonValue* item = value.Begin(); item != value.End(); item++)
+        {
+            if (item != value.Begin())
+            {
+                s.push_back(',');
+            }
+
+            if (pretty)
+            {
+                s.push_back('\n');
+                s.append((indent + 1) * 4, ' ');
+            }
+
+            WriteJson(*item, s, pretty, indent + 1);
+        }
+
+        if (pretty && value.Size() > 0)
+        {
+            s.push_back('\n');
+            s.append(indent * 4, ' ');
+        }
+        s.push_back(']');
+        break;
+    }
+    case UT_JSON_TYPE_OBJECT:
+    {
+        s.push_back('{');
+        for (const JsonMember* member = value.MemberBegin(); member != value.MemberEnd(); member++)
+        {
+            if (member != value.MemberBegin())
+            {
+                s.push_back(',');
+            }
+
+            if (pretty)
+            {
+                s.push_back('\n');
+                s.append((indent + 1) * 4, ' ');
+            }
+
+            WriteJson(member->mName, s);
+            s.append(pretty ? ": " : ":");
+            WriteJson(member->mValue, s, pretty, indent + 1);
+        }
+
+        if (pretty && value.Size() > 0)
+        {
+            s.push_back('\n');
+            s.append(indent * 4, ' ');
+        }
+        s.push_back('}');
+        break;
+    }
+    }
+}
+
+/*
+ * Convert to Any tree used by Jsonize, JsonConfig and ChannelFactory::Init.
+ * Integers become int32_t when they fit, otherwise int64_t / uint64_t.
+ */
+inline void JsonValueToAny(const JsonValue& value, Any& a)
+{
+    switch (value.GetType())
+    {
+    case UT_JSON_TYPE_NULL:
+        a = Any();
+        break;
+    case UT_JSON_TYPE_BOOL:
+        a = value.GetBool();
+        break;
+    case UT_JSON_TYPE_INT:
+    {
+        int64_t i = value.GetInt64();
+        if (i >= INT32_MIN && i <= INT32_MAX)
+        {
+            a = (int32_t)i;
+        }
+        else
+        {
+            a = i;
+        }
+        break;
+    }
+    case UT_JSON_TYPE_UINT:
+        a = value.GetUint64();
+        break;
+    case UT_JSON_TYPE_DOUBLE:
+        a = value.GetDouble();
+        break;
+    case UT_JSON_TYPE_STRING:
+        a = value.GetStdString();
+        break;
+    case UT_JSON_TYPE_ARRAY:
+    {
+        a = JsonArray(value.Size());
+        JsonArray& array = const_cast<JsonArray&>(AnyCast<JsonArray>(a));
+
+        size_t i = 0;
+        for (const JsonValue* item = value.Begin(); item != value.End(); item++)
+        {
+            JsonValueToAny(*item, array[i++]);
+        }
+        break;
+    }
+    case UT_JSON_TYPE_OBJECT:
+    {
+        a = JsonMap();
+        JsonMap& map = const_cast<JsonMap&>(AnyCast<JsonMap>(a));
+
+        for (const JsonMember* member = value.MemberBegin(); member != value.MemberEnd(); member++)
+        {
+            JsonValueToAny(member->mValue, map[member->mName.GetStdString()]);
+        }
+        break;
+    }
+    }
+}
+
+/*
+ * Convert Any tree into value. Throws JsonException for non json types.
+ */
+inline void AnyToJsonValue(const Any& a, JsonValue& value, JsonArena& arena)
+{
+    if (a.Empty())
+    {
+        value.SetNull();
+    }
+    else if (IsBool(a))
+    {
+        value.SetBool(AnyCast<bool>(a));
+    }
+    else if (IsUint64(a))
+    {
+        value.SetUint64(AnyCast<uint64_t>(a));
+    }
+    else if (IsInteger(a))
+    {
+        value.SetInt64(AnyNumberCast<int64_t>(a));
+    }
+    else if (IsNumber(a))
+    {
+        value.SetDouble(AnyNumberCast<double>(a));
+    }
+    else if (IsString(a))
+    {
+        value.SetString(AnyCast<std::string>(a), arena);
+    }
+    else if (IsJsonArray(a))
+    {
+        const JsonArray& array = AnyCast<JsonArray>(a);
+        value.SetArray(arena, array.size());
+
+        for (const Any& item : array)
+        {
+            AnyToJsonValue(item, value.PushBack(JsonValue(), arena), arena);
+        }
+    }
+    else if (IsJsonMap(a))
+    {
+        const JsonMap& map = AnyCast<JsonMap>(a);
+        value.SetObject(arena, map.size());
+
+        for (const auto& item : map)
+        {
+            AnyToJsonValue(item.second, value.AddMember(item.first, JsonValue(), arena), arena);
+        }
+    }
+    else
+    {
+        UT_THROW(JsonException, std::string("type is not json type: ") + a.GetTypeInfo().name());
+    }
+}
+
+/*
+ * @brief
+ * @class: JsonDocument
+ *
+ * Root value and the arena holding all of its nodes. Move-only: moving a
+ * document moves the arena, no node is copied.
+ *
+ *   JsonDocument doc;
+ *   if (!doc.Parse(s)) { ... doc.GetError() ... }
+ *   double kp = doc.GetRoot()["kp"].GetDouble();
+ */
+class JsonDocument
+{
+public:
+    explicit JsonDocument(size_t chunkSize = UT_JSON_ARENA_CHUNK_SIZE) :
+        mArena(chunkSize)
+    {}
+
+    JsonDocument(JsonDocument&&) = default;
+    JsonDocument& operator=(JsonDocument&&) = default;
+
+    JsonDocument(const JsonDocument&) = delete;
+    JsonDocument& operator=(const JsonDocument&) = delete;
+
+    bool Parse(const char* s, size_t len)
+    {
+        mRoot.SetNull();
+        mArena.Reset();
+
+        JsonParser parser(mArena);
+        if (!parser.Parse(s, len, mRoot))
+        {
+            mError = parser.GetError();
+            Clear();
+            return false;
+        }
+
+        mError.clear();
+        return true;
+    }
+
+    bool Parse(const std::string& s)
+    {
+        return Parse(s.data(), s.size());
+    }
+
+    const std::string& GetError() const
+    {
+        return mError;
+    }
+
+    JsonValue& GetRoot()
+    {
+        return mRoot;
+    }
+
+    const JsonValue& GetRoot() const
+    {
+        return mRoot;
+    }
+
+    JsonArena& GetArena()
+    {
+        return mArena;
+    }
+
+    std::string ToString(bool pretty = false) const
+    {
+        std::string s;
+        WriteJson(mRoot, s, pretty);
+        return s;
+    }
+
+    void ToAny(Any& a) const
+    {
+        JsonValueToAny(mRoot, a);
+    }
+
+    void FromAny(const Any& a)
+    {
+        Clear();
+        AnyToJsonValue(a, mRoot, mArena);
+    }
+
+    void Clear()
+    {
+        mRoot.SetNull();
+        mArena.Clear();
+    }
+
+private:
+    JsonArena mArena;
+    JsonValue mRoot;
+    std::string mError;
+};
+
+/*
+ * Parse with JsonDocument and bridge to Jsonize types. Throws JsonException
+ * on parse error, like FromJsonString.
+ */
+template<typename T>
+void FromJsonDocument(const std::string& s, T& t)
+{
+    JsonDocument doc;
+    if (!doc.Parse(s))
+    {
+        UT_THROW(JsonException, doc.GetError());
+    }
+
+    Any a;
+    doc.ToAny(a);
+    FromJson<T>(a, t);
+}
+
+}
+}
+
+#endif//__UT_JSON_VALUE_HPP__
@@ -0,0 +1,204 @@
+#ifndef __UT_LATEST_VALUE_HPP__
+#define __UT_LATEST_VALUE_HPP__
+
+#include <unitree/common/decl.hpp>
+#include <type_traits>
+
+/*
+ * slots a reader may fall behind before it retries
+ */
+#define UT_LATEST_VALUE_SLOT_NUMBER     4
+
+namespace unitree
+{
+namespace common
+{
+/*
+ * @brief
+ * @class: LatestSnapshot
+ *
+ * Copy of a LatestValue taken by GetData. Reads like the shared_ptr the
+ * example DataBuffer returned: test it, then use -> or *.
+ */
+template<typename T>
+class LatestSnapshot
+{
+public:
+    LatestSnapshot() :
+        mVersion(0), mValid(false), mValue()
+    {}
+
+    explicit operator bool() const
+    {
+        return mValid;
+    }
+
+    const T* operator->() const
+    {
+        return &mValue;
+    }
+
+    const T& operator*() const
+    {
+        return mValue;
+    }
+
+    /*
+     * number of the Set that produced the value, 0 if empty
+     */
+    uint64_t GetVersion() const
+    {
+        return mVersion;
+    }
+
+private:
+    template<typename U, uint32_t N>
+    friend class LatestValue;
+
+    uint64_t mVersion;
+    bool mValid;
+    T mValue;
+};
+
+/*
+ * @brief
+ * @class: LatestValue
+ *
+ * Latest value cell for one writer and any number of readers, with all
+ * storage preallocated. Set copies into the slot after the published one
+ * and then publishes it, never waiting; Get copies the published slot and
+ * retries only if the writer got all the way round the ring meanwhile
+ * (a seqlock per slot), so neither side allocates or locks.
+ *
+ * Every Set gets the next version, starting from 1. A reader keeps the
+ * version of what it last used and compares it with GetVersion to tell a
+ * fresh value from a stale one.
+ *
+ * T must be trivially copyable: readers may copy a slot while it is being
+ * overwritten and discard the copy afterwards.
+ */
+template<typename T, uint32_t N = UT_LATEST_VALUE_SLOT_NUMBER>
+class LatestValue
+{
+    static_assert(std::is_trivially_copyable<T>::value, "LatestValue requires a trivially copyable type");
+    static_assert(N >= 2, "LatestValue requires at least 2 slots");
+
+public:
+    LatestValue() :
+        mLatest(0)
+    {
+        for (uint32_t i=0; i<N; i++)
+        {
+            mSlots[i].mVersion.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    LatestValue(const LatestValue&) = delete;
+    LatestValue& operator=(const LatestValue&) = delete;
+
+    /*
+     * single writer
+     */
+    void Set(const T& value)
+    {
+        uint64_t version = (mLatest.load(std::memory_order_relaxed) >> 1) + 1;
+        Slot& slot = mSlots[version % N];
+
+        slot.mVersion.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        memcpy((void*)&slot.mValue, (const void*)&value, sizeof(T));
+
+        slot.mVersion.store(version, std::memory_order_release);
+        mLatest.store((version << 1) | 1, std::memory_order_release);
+    }
+
+    /*
+     * drop the value; versions keep counting. single writer
+     */
+    void Clear()
+    {
+        uint64_t version = (mLatest.load(std::memory_order_relaxed) >> 1) + 1;
+        mLatest.store(version << 1, std::memory_order_release);
+    }
+
+    /*
+     * false if nothing was set since construction or Clear
+     */
+    bool Get(T& value) const
+    {
+        uint64_t version = 0;
+        return Get(value, version);
+    }
+
+    bool Get(T& value, uint64_t& version) const
+    {
+        while (true)
+        {
+            uint64_t latest = mLatest.load(std::memory_order_acquire);
+            version = latest >> 1;
+
+            if ((latest & 1) == 0)
+            {
+                return false;
+            }
+
+            const Slot& slot = mSlots[version % N];
+            if (slot.mVersion.load(std::memory_order_acquire) != version)
+            {
+                continue;
+            }
+
+            memcpy((void*)&value, (const void*)&slot.mValue, sizeof(T));
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (slot.mVersion.load(std::memory_order_relaxed) == version)
+            {
+                return true;
+            }
+        }
+    }
+
+    /*
+     * version of the latest Set or Clear, 0 before the first
+     */
+    uint64_t GetVersion() const
+    {
+        return mLatest.load(std::memory_order_acquire) >> 1;
+    }
+
+    bool HasValue() const
+    {
+        return (mLatest.load(std::memory_order_acquire) & 1) != 0;
+    }
+
+    /*
+     * DataBuffer compatible interface
+     */
+    void SetData(const T& value)
+    {
+        Set(value);
+    }
+
+    LatestSnapshot<T> GetData() const
+    {
+        LatestSnapshot<T> snapshot;
+        snapshot.mValid = Get(snapshot.mValue, snapshot.mVersion);
+        return snapshot;
+    }
+
+private:
+    struct alignas(64) Slot
+    {
+        std::atomic<uint64_t> mVersion;
+        T mValue;
+    };
+
+    alignas(64) std::atomic<uint64_t> mLatest;
+    Slot mSlots[N];
+};
+
+}
+}
+
+#endif//__UT_LATEST_VALUE_HPP__
@@ -0,0 +1,573 @@
+#ifndef __UT_RT_LOCK_HPP__
+#define __UT_RT_LOCK_HPP__
+
+#include <unitree/common/exception.hpp>
+#include <unitree/common/lock/lock.hpp>
+#include <unitree/common/time/latency_histogram.hpp>
+#include <linux/futex.h>
+#include <vector>
+
+/*
+ * AdaptiveMutex spin bound and the longest backoff between two tries
+ */
+#define UT_LOCK_SPIN_MAX_NUMBER         100
+#define UT_LOCK_BACKOFF_MAX_NUMBER      64
+
+namespace unitree
+{
+namespace common
+{
+static inline void CpuRelax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield" ::: "memory");
+#else
+    __asm__ __volatile__("" ::: "memory");
+#endif
+}
+
+/*
+ * @brief
+ * @class: PiMutex
+ *
+ * Mutex with PTHREAD_PRIO_INHERIT: a low priority owner is boosted to the
+ * priority of the highest waiter, so a SCHED_FIFO thread blocked on it
+ * waits for the critical section only, not for whatever preempts the
+ * owner. Same interface as Mutex (LockGuard), plus lock/unlock/try_lock
+ * for std::lock_guard and std::unique_lock.
+ */
+class PiMutex
+{
+public:
+    explicit PiMutex()
+    {
+        pthread_mutexattr_t attr;
+        pthread_mutexattr_init(&attr);
+        pthread_mutexattr_setprotocol(&attr, PTHREAD_PRIO_INHERIT);
+
+        int32_t ret = pthread_mutex_init(&mNative, &attr);
+        pthread_mutexattr_destroy(&attr);
+
+        UT_THROW_IF(ret != 0, LockException, "pi mutex init failed");
+    }
+
+    ~PiMutex()
+    {
+        pthread_mutex_destroy(&mNative);
+    }
+
+    PiMutex(const PiMutex&) = delete;
+    PiMutex& operator=(const PiMutex&) = delete;
+
+    void Lock()
+    {
+        int32_t ret = pthread_mutex_lock(&mNative);
+        UT_THROW_IF(ret != 0, LockException, "pi mutex lock failed");
+    }
+
+    void Unlock()
+    {
+        pthread_mutex_unlock(&mNative);
+    }
+
+    bool Trylock()
+    {
+        return pthread_mutex_trylock(&mNative) == 0;
+    }
+
+    pthread_mutex_t & GetNative()
+    {
+        return mNative;
+    }
+
+    void lock()
+    {
+        Lock();
+    }
+
+    void unlock()
+    {
+        Unlock();
+    }
+
+    bool try_lock()
+    {
+        return Trylock();
+    }
+
+private:
+    pthread_mutex_t mNative;
+};
+
+/*
+ * @brief
+ * @class: PiCond
+ *
+ * Condition for PiMutex, timed waits on CLOCK_MONOTONIC.
+ */
+class PiCond
+{
+public:
+    explicit PiCond()
+    {
+        pthread_condattr_t attr;
+        pthread_condattr_init(&attr);
+        pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+
+        int32_t ret = pthread_cond_init(&mNative, &attr);
+        pthread_condattr_destroy(&attr);
+
+        UT_THROW_IF(ret != 0, LockException, "pi cond init failed");
+    }
+
+    ~PiCond()
+    {
+        pthread_cond_destroy(&mNative);
+    }
+
+    PiCond(const PiCond&) = delete;
+    PiCond& operator=(const PiCond&) = delete;
+
+    void Wait(PiMutex& mutex)
+    {
+        pthread_cond_wait(&mNative, &mutex.GetNative());
+    }
+
+    /*
+     * false on timeout
+     */
+    bool Wait(PiMutex& mutex, uint64_t microsec)
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+
+        uint64_t nsec = (uint64_t)ts.tv_nsec + (microsec % 1000000) * 1000;
+        ts.tv_sec += microsec / 1000000 + nsec / 1000000000;
+        ts.tv_nsec = nsec % 1000000000;
+
+        return pthread_cond_timedwait(&mNative, &mutex.GetNative(), &ts) != UT_LOCK_ENO_TIMEDOUT;
+    }
+
+    void Notify()
+    {
+        pthread_cond_signal(&mNative);
+    }
+
+    void NotifyAll()
+    {
+        pthread_cond_broadcast(&mNative);
+    }
+
+private:
+    pthread_cond_t mNative;
+};
+
+/*
+ * @brief
+ * @class: PiMutexCond
+ *
+ * MutexCond on a PiMutex.
+ */
+class PiMutexCond
+{
+public:
+    explicit PiMutexCond()
+    {}
+
+    void Lock()
+    {
+        mMutex.Lock();
+    }
+
+    void Unlock()
+    {
+        mMutex.Unlock();
+    }
+
+    /*
+     * microsec 0 waits without limit; false on timeout
+     */
+    bool Wait(int64_t microsec = 0)
+    {
+        if (microsec <= 0)
+        {
+            mCond.Wait(mMutex);
+            return true;
+        }
+
+        return mCond.Wait(mMutex, (uint64_t)microsec);
+    }
+
+    void Notify()
+    {
+        mCond.Notify();
+    }
+
+    void NotifyAll()
+    {
+        mCond.NotifyAll();
+    }
+
+private:
+    PiMutex mMutex;
+    PiCond mCond;
+};
+
+/*
+ * @brief
+ * @class: AdaptiveMutex
+ *
+ * Futex mutex for short critical sections. The lock word holds the owner
+ * tid, so an uncontended Lock/Unlock is one CAS each. A contended Lock
+ * spins a bounded number of tries with exponential backoff, the bound
+ * adapting to how long past acquisitions took, then sleeps in
+ * FUTEX_LOCK_PI: the kernel boosts the owner like PiMutex does.
+ */
+class AdaptiveMutex
+{
+public:
+    explicit AdaptiveMutex() :
+        mWord(0), mSpin(0)
+    {}
+
+    AdaptiveMutex(const AdaptiveMutex&) = delete;
+    AdaptiveMutex& operator=(const AdaptiveMutex&) = delete;
+
+    void Lock()
+    {
+        uint32_t tid = GetTid();
+        uint32_t expected = 0;
+
+        if (mWord.compare_exchange_strong(expected, tid, std::memory_order_acquire))
+        {
+            return;
+        }
+
+        int32_t spin = mSpin.load(std::memory_order_relaxed);
+        int32_t maxSpin = std::min(UT_LOCK_SPIN_MAX_NUMBER, spin * 2 + 10);
+        int32_t backoff = 1;
+
+        for (int32_t i=0; i<maxSpin; i++)
+        {
+            for (int32_t j=0; j<backoff; j++)
+            {
+                CpuRelax();
+            }
+            backoff = std::min(backoff * 2, UT_LOCK_BACKOFF_MAX_NUMBER);
+
+            expected = 0;
+            if (mWord.load(std::memory_order_relaxed) == 0 &&
+                mWord.compare_exchange_weak(expected, tid, std::memory_order_acquire))
+            {
+                mSpin.store(spin + (i - spin) / 8, std::memory_order_relaxed);
+                return;
+            }
+        }
+
+        mSpin.store(spin + (maxSpin - spin) / 8, std::memory_order_relaxed);
+
+        while (syscall(SYS_futex, (uint32_t*)&mWord, FUTEX_LOCK_PI_PRIVATE, 0, NULL, NULL, 0) != 0)
+        {
+            UT_THROW_IF(errno != EINTR && errno != EAGAIN, LockException, "adaptive mutex futex lock failed");
+        }
+    }
+
+    void Unlock()
+    {
+        uint32_t expected = GetTid();
+
+        /*
+         * waiters in the kernel set FUTEX_WAITERS, the kernel hands over
+         */
+        if (!mWord.compare_exchange_strong(expected, 0, std::memory_order_release))
+        {
+            syscall(SYS_futex, (uint32_t*)&mWord, FUTEX_UNLOCK_PI_PRIVATE, 0, NULL, NULL, 0);
+        }
+    }
+
+    bool Trylock()
+    {
+        uint32_t expected = 0;
+        return mWord.compare_exchange_strong(expected, GetTid(), std::memory_order_acquire);
+    }
+
+    void lock()
+    {
+        Lock();
+    }
+
+    void unlock()
+    {
+        Unlock();
+    }
+
+    bool try_lock()
+    {
+        return Trylock();
+    }
+
+private:
+    static uint32_t GetTid()
+    {
+        static thread_local uint32_t tid = (uint32_t)syscall(SYS_gettid);
+        return tid;
+    }
+
+private:
+    std::atomic<uint32_t> mWord;
+    std::atomic<int32_t> mSpin;
+};
+
+/*
+ * @brief
+ * @class: LockStatistics
+ */
+class LockStatistics
+{
+public:
+    std::string mName;
+    uint64_t mLockCount;
+    uint64_t mContendedCount;
+
+    /*
+     * nanosecond
+     */
+    uint64_t mWaitMean;
+    uint64_t mWaitP99;
+    uint64_t mWaitMax;
+    uint64_t mHoldMean;
+    uint64_t mHoldP99;
+    uint64_t mHoldMax;
+
+    std::string ToString() const
+    {
+        char buf[256];
+        snprintf(buf, sizeof(buf), "%s lock:%lu contended:%lu wait(us) mean:%.1f p99:%.1f max:%.1f "
+            "hold(us) mean:%.1f p99:%.1f max:%.1f", mName.c_str(), (unsigned long)mLockCount,
+            (unsigned long)mContendedCount, mWaitMean / 1e3, mWaitP99 / 1e3, mWaitMax / 1e3,
+            mHoldMean / 1e3, mHoldP99 / 1e3, mHoldMax / 1e3);
+        return buf;
+    }
+};
+
+/*
+ * @brief
+ * @class: LockInstrument
+ *
+ * Wait and hold time of one named lock; registered in LockRegistry for
+ * as long as it lives.
+ */
+class LockInstrument
+{
+public:
+    explicit LockInstrument(const std::string& name);
+    ~LockInstrument();
+
+    LockInstrument(const LockInstrument&) = delete;
+    LockInstrument& operator=(const LockInstrument&) = delete;
+
+    LockStatistics GetStatistics() const
+    {
+        LockStatistics statistics;
+        statistics.mName = mName;
+        statistics.mLockCount = mHoldTime.GetCount();
+        statistics.mContendedCount = mContendedCount.load(std::memory_order_relaxed);
+        statistics.mWaitMean = mWaitTime.GetMean();
+        statistics.mWaitP99 = mWaitTime.GetPercentile(0.99);
+        statistics.mWaitMax = mWaitTime.GetMax();
+        statistics.mHoldMean = mHoldTime.GetMean();
+        statistics.mHoldP99 = mHoldTime.GetPercentile(0.99);
+        statistics.mHoldMax = mHoldTime.GetMax();
+        return statistics;
+    }
+
+    void ResetStatistics()
+    {
+        mWaitTime.Reset();
+        mHoldTime.Reset();
+        mContendedCount.store(0, std::memory_order_relaxed);
+    }
+
+    static int64_t Now()
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+    }
+
+public:
+    std::string mName;
+    LatencyHistogram mWaitTime;
+    LatencyHistogram mHoldTime;
+    std::atomic<uint64_t> mContendedCount;
+};
+
+/*
+ * @brief
+ * @class: LockRegistry
+ *
+ * All live LockInstruments, for reporting. Only construction and
+ * destruction of an instrumented lock take the registry lock.
+ */
+class LockRegistry
+{
+public:
+    static LockRegistry* Instance()
+    {
+        static LockRegistry inst;
+        return &inst;
+    }
+
+    void Register(LockInstrument* instrument)
+    {
+        LockGuard<Mutex> guard(mLock);
+        mInstruments.push_back(instrument);
+    }
+
+    void Unregister(LockInstrument* instrument)
+    {
+        LockGuard<Mutex> guard(mLock);
+        mInstruments.erase(std::remove(mInstruments.begin(), mInstruments.end(), instrument), mInstruments.end());
+    }
+
+    std::vector<LockStatistics> GetStatistics()
+    {
+        std::vector<LockStatistics> statistics;
+
+        LockGuard<Mutex> guard(mLock);
+        for (LockInstrument* instrument : mInstruments)
+        {
+            statistics.push_back(instrument->GetStatistics());
+        }
+
+        return statistics;
+    }
+
+    void ResetStatistics()
+    {
+        LockGuard<Mutex> guard(mLock);
+        for (LockInstrument* instrument : mInstruments)
+        {
+            instrument->ResetStatistics();
+        }
+    }
+
+private:
+    LockRegistry()
+    {}
+
+private:
+    Mutex mLock;
+    std::vector<LockInstrument*> mInstruments;
+};
+
+inline LockInstrument::LockInstrument(const std::string& name) :
+    mName(name), mContendedCount(0)
+{
+    LockRegistry::Instance()->Register(this);
+}
+
+inline LockInstrument::~LockInstrument()
+{
+    LockRegistry::Instance()->Unregister(this);
+}
+
+/*
+ * @brief
+ * @class: InstrumentedLock
+ *
+ * Wraps any lock with Lock/Unlock/Trylock (Mutex, PiMutex, AdaptiveMutex,
+ * Spinlock ...) and records how long Lock waited and how long the lock
+ * was held, under a name reported by LockRegistry. Costs two clock reads
+ * per Lock/Unlock pair plus one on contention.
+ *
+ *   InstrumentedLock<PiMutex> mLock("state_buffer");
+ *   LockGuard<InstrumentedLock<PiMutex>> guard(mLock);
+ */
+template<typename LOCK_TYPE>
+class InstrumentedLock
+{
+public:
+    explicit InstrumentedLock(const std::string& name) :
+        mInstrument(name), mLockTime(0)
+    {}
+
+    void Lock()
+    {
+        if (!mLock.Trylock())
+        {
+            int64_t begin = LockInstrument::Now();
+            mLock.Lock();
+            mLockTime = LockInstrument::Now();
+
+            mInstrument.mWaitTime.Add(mLockTime - begin);
+            mInstrument.mContendedCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            mLockTime = LockInstrument::Now();
+            mInstrument.mWaitTime.Add(0);
+        }
+    }
+
+    void Unlock()
+    {
+        int64_t hold = LockInstrument::Now() - mLockTime;
+        mLock.Unlock();
+
+        mInstrument.mHoldTime.Add(hold);
+    }
+
+    bool Trylock()
+    {
+        if (!mLock.Trylock())
+        {
+            return false;
+        }
+
+        mLockTime = LockInstrument::Now();
+        mInstrument.mWaitTime.Add(0);
+        return true;
+    }
+
+    void lock()
+    {
+        Lock();
+    }
+
+    void unlock()
+    {
+        Unlock();
+    }
+
+    bool try_lock()
+    {
+        return Trylock();
+    }
+
+    LOCK_TYPE& GetLock()
+    {
+        return mLock;
+    }
+
+    LockStatistics GetStatistics() const
+    {
+        return mInstrument.GetStatistics();
+    }
+
+private:
+    LOCK_TYPE mLock;
+    LockInstrument mInstrument;
+
+    /*
+     * written by the owner only
+     */
+    int64_t mLockTime;
+};
+
+}
+}
+
+#endif//__UT_RT_LOCK_HPP__
@@ -0,0 +1,660 @@
+#ifndef __UT_LOG_BLOCK_STORE_HPP__
+#define __UT_LOG_BLOCK_STORE_HPP__
+
+#include <unitree/common/log/log_store.hpp>
+#include <unitree/common/filesystem/directory.hpp>
+#include <unitree/common/time/time_tool.hpp>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <algorithm>
+#include <deque>
+
+/*
+ * log store type of LogBlockFileStore
+ */
+#define UT_LOG_STORE_FILE_BLOCK         4
+#define UT_LOG_STORE_DESC_FILE_BLOCK    "BLOCKFILE"
+
+/*
+ * log block size and number
+ */
+#define UT_LOG_BLOCK_SIZE               1048576         //1M
+#define UT_LOG_MIN_BLOCK_SIZE           65536           //64K
+#define UT_LOG_BLOCK_NUMBER             8
+#define UT_LOG_MIN_BLOCK_NUMBER         2
+
+/*
+ * total size of the log files of one store
+ */
+#define UT_LOG_DISK_BUDGET              1073741824      //1G
+
+#define UT_LOG_BLOCK_ALIGN              4096
+#define UT_LOG_COMPRESS_EXT             ".gz"
+
+/*
+ * length of the YYYYMMDD-HHMMSS-uuuuuu stamp in rotated file names
+ */
+#define UT_LOG_ROTATE_STAMP_LEN         22
+
+namespace unitree
+{
+namespace common
+{
+/*
+ * @brief
+ * @class: LogBlockStorePolicy
+ *
+ * LogStorePolicy of LogBlockFileStore. mFileSize is the rotation size,
+ * mFileNumber the number of rotated files kept, mFileWriteInter the
+ * longest time a partly filled block waits before it is written.
+ */
+class LogBlockStorePolicy : public LogStorePolicy
+{
+public:
+    explicit LogBlockStorePolicy(const std::string& name, const std::string& fileName, const std::string& directory,
+        int32_t fileNumber = UT_LOG_MAX_FILE_NUMBER, int64_t fileSize = UT_LOG_FILE_SIZE,
+        int64_t fileWriteInter = UT_LOG_WRITE_INTER, int32_t cpuId = UT_CPU_ID_NONE) :
+        LogStorePolicy(name, UT_LOG_STORE_FILE_BLOCK, fileNumber, fileSize, fileWriteInter, cpuId, fileName, directory),
+        mBlockSize(UT_LOG_BLOCK_SIZE), mBlockNumber(UT_LOG_BLOCK_NUMBER), mDiskBudget(UT_LOG_DISK_BUDGET),
+        mCompress(true), mCompressCommand("gzip")
+    {}
+
+public:
+    /*
+     * write unit; Append drops lines once all blocks wait for the disk
+     */
+    int64_t mBlockSize;
+    int32_t mBlockNumber;
+
+    /*
+     * oldest rotated files are removed while the files of the store
+     * take more than this
+     */
+    int64_t mDiskBudget;
+
+    /*
+     * compress rotated files with mCompressCommand (gzip compatible)
+     */
+    bool mCompress;
+    std::string mCompressCommand;
+};
+
+typedef std::shared_ptr<LogBlockStorePolicy> LogBlockStorePolicyPtr;
+
+/*
+ * @brief
+ * @class: LogBlockStoreStatistics
+ */
+class LogBlockStoreStatistics
+{
+public:
+    LogBlockStoreStatistics() :
+        mWriteBytes(0), mWriteCount(0), mDropCount(0), mRotateCount(0), mCompressCount(0), mRemoveCount(0)
+    {}
+
+public:
+    uint64_t mWriteBytes;
+    uint64_t mWriteCount;
+    uint64_t mDropCount;
+    uint64_t mRotateCount;
+    uint64_t mCompressCount;
+    uint64_t mRemoveCount;
+};
+
+/*
+ * @brief
+ * @class: LogBlockFileStore
+ *
+ * Append copies lines into the current block under a short lock. Full
+ * blocks, and a partly filled one after mFileWriteInter, are written by an
+ * I/O thread, so callers never wait on the file. Each write starts
+ * writeback of its range at once, which keeps the page cache from
+ * building up large dirty bursts. Rotated files are compressed and the
+ * disk budget enforced by a second thread running at idle cpu and io
+ * priority.
+ *
+ *   LogBlockStorePolicyPtr policyPtr(new LogBlockStorePolicy("block", "robot", "/var/log/robot"));
+ *   LoggerPtr loggerPtr(new Logger(UT_LOG_INFO, LogStorePtr(new LogBlockFileStore(policyPtr))));
+ */
+class LogBlockFileStore : public LogStore
+{
+public:
+    explicit LogBlockFileStore(LogBlockStorePolicyPtr policyPtr) :
+        mPolicyPtr(policyPtr), mQuit(false), mFd(UT_FD_INVALID), mFileSize(0), mCurrent(-1), mCurrentLen(0),
+        mFlushTime(0), mCompressQuit(false)
+    {
+        mBlockSize = std::max<int64_t>(mPolicyPtr->mBlockSize, UT_LOG_MIN_BLOCK_SIZE);
+        mBlockSize = (mBlockSize + UT_LOG_BLOCK_ALIGN - 1) / UT_LOG_BLOCK_ALIGN * UT_LOG_BLOCK_ALIGN;
+
+        int32_t blockNumber = std::max<int32_t>(mPolicyPtr->mBlockNumber, UT_LOG_MIN_BLOCK_NUMBER);
+        for (int32_t i=0; i<blockNumber; i++)
+        {
+            void* block = NULL;
+            if (posix_memalign(&block, UT_LOG_BLOCK_ALIGN, mBlockSize) != 0)
+            {
+                UT_THROW(CommonException, "alloc log block failed");
+            }
+
+            memset(block, 0, mBlockSize);
+            mBlocks.push_back((char*)block);
+            mFreeList.push_back(i);
+        }
+
+        mCurrent = mFreeList.front();
+        mFreeList.pop_front();
+
+        mDirectory = mPolicyPtr->mDirectory.empty() ? std::string(".") : mPolicyPtr->mDirectory;
+        mFileName = mDirectory + UT_PATH_DELIM_STR + mPolicyPtr->mFileName + UT_LOG_FILE_EXT;
+
+        CreateDirectory(mDirectory);
+        OpenFile();
+
+        /*
+         * rotated files a previous run left uncompressed
+         */
+        if (mPolicyPtr->mCompress)
+        {
+            for (const std::string& name : ListRotated())
+            {
+                if (!IsCompressed(name))
+                {
+                    mCompressList.push_back(name);
+                }
+            }
+        }
+
+        mThreadPtr = CreateThreadEx("log_block_io", mPolicyPtr->mCpuId, &LogBlockFileStore::IoThreadFunc, this);
+        mCompressThreadPtr = CreateThreadEx("log_compress", UT_CPU_ID_NONE, &LogBlockFileStore::CompressThreadFunc, this);
+    }
+
+    ~LogBlockFileStore()
+    {
+        mLock.Lock();
+        mQuit = true;
+        mLock.Notify();
+        mLock.Unlock();
+        mThreadPtr->Wait();
+
+        mCompressLock.Lock();
+        mCompressQuit = true;
+        mCompressLock.Notify();
+        mCompressLock.Unlock();
+        mCompressThreadPtr->Wait();
+
+        CloseFile();
+
+        for (char* block : mBlocks)
+        {
+            free(block);
+        }
+    }
+
+    void Append(const std::string& s)
+    {
+        const char* p = s.data();
+        size_t len = s.size();
+        bool notify = false;
+
+        mLock.Lock();
+
+        /*
+         * keep lines whole: drop the line unless the current block and the
+         * free blocks can take all of it
+         */
+        int64_t space = (int64_t)mFreeList.size() * mBlockSize + (mCurrent < 0 ? 0 : mBlockSize - mCurrentLen);
+        if ((int64_t)len > space)
+        {
+            mStatistics.mDropCount++;
+            mLock.Unlock();
+            return;
+        }
+
+        while (len > 0)
+        {
+            if (mCurrent < 0)
+            {
+                mCurrent = mFreeList.front();
+                mFreeList.pop_front();
+                mCurrentLen = 0;
+            }
+
+            size_t n = std::min(len, (size_t)(mBlockSize - mCurrentLen));
+            memcpy(mBlocks[mCurrent] + mCurrentLen, p, n);
+            mCurrentLen += n;
+            p += n;
+            len -= n;
+
+            if (mCurrentLen == mBlockSize)
+            {
+                mFullList.push_back(Block { mCurrent, mCurrentLen });
+                mCurrent = -1;
+                mCurrentLen = 0;
+                notify = true;
+            }
+        }
+
+        if (notify)
+        {
+            mLock.Notify();
+        }
+
+        mLock.Unlock();
+    }
+
+    LogBlockStoreStatistics GetStatistics()
+    {
+        mLock.Lock();
+        LogBlockStoreStatistics statistics = mStatistics;
+        mLock.Unlock();
+
+        mCompressLock.Lock();
+        statistics.mCompressCount = mCompressCount;
+        statistics.mRemoveCount = mRemoveCount;
+        mCompressLock.Unlock();
+
+        return statistics;
+    }
+
+private:
+    struct Block
+    {
+        int32_t mIndex;
+        int64_t mLen;
+    };
+
+    int32_t IoThreadFunc()
+    {
+        std::vector<Block> blocks;
+        int64_t inter = std::max<int64_t>(mPolicyPtr->mFileWriteInter, UT_LOG_MIN_WRITE_INTER);
+        bool quit = false;
+
+        while (!quit)
+        {
+            mLock.Lock();
+
+            if (mFullList.empty() && !mQuit)
+            {
+                mLock.Wait(inter);
+            }
+
+            quit = mQuit;
+
+            /*
+             * partly filled block waited long enough
+             */
+            int64_t now = (int64_t)GetCurrentMonotonicTimeMicrosecond();
+            if (mCurrent >= 0 && mCurrentLen > 0 && (quit || now - mFlushTime >= inter))
+            {
+                mFullList.push_back(Block { mCurrent, mCurrentLen });
+                mCurrent = -1;
+                mCurrentLen = 0;
+            }
+
+            blocks.assign(mFullList.begin(), mFullList.end());
+            mFullList.clear();
+
+            mLock.Unlock();
+
+            int64_t bytes = 0;
+            for (const Block& block : blocks)
+            {
+                WriteBlock(mBlocks[block.mIndex], block.mLen);
+                bytes += block.mLen;
+            }
+
+            if (!blocks.empty())
+            {
+                mFlushTime = now;
+            }
+
+            mLock.Lock();
+            for (const Block& block : blocks)
+            {
+                mFreeList.push_back(block.mIndex);
+            }
+            mStatistics.mWriteBytes += bytes;
+            mStatistics.mWriteCount += blocks.size();
+            mLock.Unlock();
+
+            blocks.clear();
+        }
+
+        return 0;
+    }
+
+    void WriteBlock(const char* p, int64_t len)
+    {
+        if (mFd == UT_FD_INVALID)
+        {
+            OpenFile();
+            if (mFd == UT_FD_INVALID)
+            {
+                return;
+            }
+        }
+
+        int64_t offset = mFileSize;
+        int64_t left = len;
+
+        while (left > 0)
+        {
+            ssize_t n = write(mFd, p, left);
+            if (n < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                break;
+            }
+
+            p += n;
+            left -= n;
+        }
+
+        mFileSize += len - left;
+
+        /*
+         * start writeback now instead of letting dirty pages pile up
+         */
+        sync_file_range(mFd, offset, len - left, SYNC_FILE_RANGE_WRITE);
+
+        if (mFileSize >= mPolicyPtr->mFileSize)
+        {
+            Rotate();
+        }
+    }
+
+    void OpenFile()
+    {
+        mFd = open(mFileName.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, UT_OPEN_MODE_RW);
+        if (mFd == UT_FD_INVALID)
+        {
+            return;
+        }
+
+        struct stat statbuf;
+        mFileSize = (fstat(mFd, &statbuf) == 0) ? statbuf.st_size : 0;
+    }
+
+    void CloseFile()
+    {
+        if (mFd != UT_FD_INVALID)
+        {
+            fdatasync(mFd);
+            posix_fadvise(mFd, 0, 0, POSIX_FADV_DONTNEED);
+            close(mFd);
+            mFd = UT_FD_INVALID;
+        }
+    }
+
+    void Rotate()
+    {
+        CloseFile();
+
+        /*
+         * name.YYYYMMDD-HHMMSS-uuuuuu.LOG sorts by rotation time
+         */
+        uint64_t now = GetCurrentTimeMicrosecond();
+        time_t sec = (time_t)(now / UT_NUMER_MICRO);
+        struct tm tmbuf;
+        localtime_r(&sec, &tmbuf);
+
+        char buf[64];
+        snprintf(buf, sizeof(buf), ".%04d%02d%02d-%02d%02d%02d-%06d", tmbuf.tm_year + 1900, tmbuf.tm_mon + 1,
+            tmbuf.tm_mday, tmbuf.tm_hour, tmbuf.tm_min, tmbuf.tm_sec, (int32_t)(now % UT_NUMER_MICRO));
+
+        std::string rotated = mDirectory + UT_PATH_DELIM_STR + mPolicyPtr->mFileName + buf + UT_LOG_FILE_EXT;
+        if (rename(mFileName.c_str(), rotated.c_str()) != 0)
+        {
+            rotated.clear();
+        }
+
+        OpenFile();
+
+        mLock.Lock();
+        mStatistics.mRotateCount++;
+        mLock.Unlock();
+
+        mCompressLock.Lock();
+        if (!rotated.empty() && mPolicyPtr->mCompress)
+        {
+            mCompressList.push_back(rotated);
+        }
+        mCompressPending = true;
+        mCompressLock.Notify();
+        mCompressLock.Unlock();
+    }
+
+    int32_t CompressThreadFunc()
+    {
+        /*
+         * idle cpu priority and idle io class (3 << 13) for this thread and
+         * the compressor processes it starts
+         */
+        pid_t tid = (pid_t)syscall(SYS_gettid);
+        setpriority(PRIO_PROCESS, tid, 19);
+        syscall(SYS_ioprio_set, 1, tid, 3 << 13);
+
+        mCompressPending = true;
+
+        while (true)
+        {
+            std::string name;
+
+            mCompressLock.Lock();
+            while (!mCompressQuit && mCompressList.empty() && !mCompressPending)
+            {
+                mCompressLock.Wait();
+            }
+
+            if (mCompressQuit)
+            {
+                mCompressLock.Unlock();
+                break;
+            }
+
+            bool pending = mCompressPending;
+            mCompressPending = false;
+
+            if (!mCompressList.empty())
+            {
+                name = mCompressList.front();
+                mCompressList.pop_front();
+            }
+
+            mCompressLock.Unlock();
+
+            if (!name.empty() && Compress(name))
+            {
+                mCompressLock.Lock();
+                mCompressCount++;
+                mCompressLock.Unlock();
+            }
+
+            if (pending || !name.empty())
+            {
+                EnforceBudget();
+            }
+        }
+
+        return 0;
+    }
+
+    bool Compress(const std::string& name)
+    {
+        const char* argv[] = { mPolicyPtr->mCompressCommand.c_str(), "-f", "-q", name.c_str(), NULL };
+
+        pid_t pid;
+        if (posix_spawnp(&pid, argv[0], NULL, NULL, (char* const*)argv, environ) != 0)
+        {
+            return false;
+        }
+
+        int status = 0;
+        while (waitpid(pid, &status, 0) < 0 && errno == EINTR)
+        {}
+
+        return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+
+    /*
+     * Remove the oldest rotated files while there are more than
+     * mFileNumber of them or all files take more than mDiskBudget.
+     */
+    void EnforceBudget()
+    {
+        std::vector<std::string> names = ListRotated();
+        std::vector<int64_t> sizes;
+        int64_t total = 0;
+
+        struct stat statbuf;
+        if (stat(mFileName.c_str(), &statbuf) == 0)
+        {
+            total += statbuf.st_size;
+        }
+
+        for (const std::string& name : names)
+        {
+            int64_t size = (stat(name.c_str(), &statbuf) == 0) ? statbuf.st_size : 0;
+            sizes.push_back(size);
+            total += size;
+        }
+
+        size_t count = names.size();
+        for (size_t i=0; i<names.size(); i++)
+        {
+            if (count <= (size_t)std::max<int32_t>(mPolicyPtr->mFileNumber, 0) && total <= mPolicyPtr->mDiskBudget)
+            {
+                break;
+            }
+
+            if (unlink(names[i].c_str()) == 0)
+            {
+                total -= sizes[i];
+                count--;
+
+                mCompressLock.Lock();
+                mRemoveCount++;
+                mCompressList.erase(std::remove(mCompressList.begin(), mCompressList.end(), names[i]), mCompressList.end());
+                mCompressLock.Unlock();
+            }
+        }
+    }
+
+    /*
+     * rotated files of this store, oldest first. Only names Rotate makes,
+     * <name>.YYYYMMDD-HHMMSS-uuuuuu.LOG[.gz], match, so the files of a
+     * store named <name>.<sub> in the same directory are left alone.
+     */
+    std::vector<std::string> ListRotated()
+    {
+        std::vector<std::string> files, names;
+        std::string prefix = mPolicyPtr->mFileName + ".";
+        std::string ext = UT_LOG_FILE_EXT;
+
+        try
+        {
+            ListDirectory(mDirectory, files, false, false);
+        }
+        catch (const std::exception&)
+        {
+            return names;
+        }
+
+        for (const std::string& file : files)
+        {
+            if (file.compare(0, prefix.size(), prefix) != 0)
+            {
+                continue;
+            }
+
+            std::string rest = file.substr(prefix.size());
+            if (!IsRotateStamp(rest))
+            {
+                continue;
+            }
+
+            rest = rest.substr(UT_LOG_ROTATE_STAMP_LEN);
+            if (rest == ext || rest == ext + UT_LOG_COMPRESS_EXT)
+            {
+                names.push_back(mDirectory + UT_PATH_DELIM_STR + file);
+            }
+        }
+
+        std::sort(names.begin(), names.end());
+
+        return names;
+    }
+
+    /*
+     * s starts with the YYYYMMDD-HHMMSS-uuuuuu stamp of Rotate
+     */
+    static bool IsRotateStamp(const std::string& s)
+    {
+        if (s.size() < UT_LOG_ROTATE_STAMP_LEN)
+        {
+            return false;
+        }
+
+        for (size_t i=0; i<UT_LOG_ROTATE_STAMP_LEN; i++)
+        {
+            bool dash = (i == 8 || i == 15);
+            if (dash ? s[i] != '-' : !isdigit((unsigned char)s[i]))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    static bool IsSuffix(const std::string& s, const std::string& suffix)
+    {
+        return s.size() > suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+    static bool IsCompressed(const std::string& name)
+    {
+        return IsSuffix(name, UT_LOG_COMPRESS_EXT);
+    }
+
+private:
+    LogBlockStorePolicyPtr mPolicyPtr;
+    std::string mDirectory;
+    std::string mFileName;
+
+    MutexCond mLock;
+    volatile bool mQuit;
+    int64_t mBlockSize;
+    std::vector<char*> mBlocks;
+    std::deque<int32_t> mFreeList;
+    std::deque<Block> mFullList;
+
+    /*
+     * owned by the io thread
+     */
+    int32_t mFd;
+    int64_t mFileSize;
+
+    int32_t mCurrent;
+    int64_t mCurrentLen;
+    int64_t mFlushTime;
+    LogBlockStoreStatistics mStatistics;
+    ThreadPtr mThreadPtr;
+
+    MutexCond mCompressLock;
+    volatile bool mCompressQuit;
+    bool mCompressPending = false;
+    std::deque<std::string> mCompressList;
+    uint64_t mCompressCount = 0;
+    uint64_t mRemoveCount = 0;
+    ThreadPtr mCompressThreadPtr;
+};
+
+typedef std::shared_ptr<LogBlockFileStore> LogBlockFileStorePtr;
+
+}
+}
+
+#endif//__UT_LOG_BLOCK_STORE_HPP__
@@ -0,0 +1,784 @@
+#ifndef __UT_LOG_DEFERRED_HPP__
+#define __UT_LOG_DEFERRED_HPP__
+
+#include <unitree/common/log/log_logger.hpp>
+#include <unitree/common/time/fast_clock.hpp>
+#include <algorithm>
+#include <type_traits>
+
+/*
+ * deferred log ring size of one thread
+ */
+#define UT_LOG_DEFERRED_RING_SIZE       65536           //64K
+#define UT_LOG_DEFERRED_MIN_RING_SIZE   4096            //4K
+
+/*
+ * string arguments longer than this are truncated
+ */
+#define UT_LOG_DEFERRED_MAX_STRING      512
+
+/*
+ * formatter thread interval(micro second)
+ */
+#define UT_LOG_DEFERRED_INTER           2000            //2ms
+
+namespace unitree
+{
+namespace common
+{
+/*
+ * Decoder of the arguments of one call signature. Its address is the
+ * format id stored with each record.
+ */
+using LogDecodeFunc = const char* (*)(const char* p, std::ostream& os);
+
+/*
+ * @brief
+ * @class: LogRecordHeader
+ * Record in a deferred log ring, followed by the encoded arguments.
+ * mLevel < 0 marks padding up to the ring end.
+ */
+class LogRecordHeader
+{
+public:
+    uint32_t mSize;
+    int32_t mLevel;
+    int32_t mTid;
+    uint32_t mReserve;
+    uint64_t mTime;
+    LogDecodeFunc mDecoder;
+    LogStore* mStore;
+};
+
+/*
+ * Argument encoding: arithmetic and enum values are copied raw, strings
+ * (std::string and pointers to char, signed char or unsigned char) as
+ * uint32 length plus bytes. Other object pointers are copied as addresses
+ * and printed as such, never dereferenced. Other types are not deferrable
+ * and are logged synchronously.
+ */
+template<typename T>
+struct LogArg
+{
+    using Type = typename std::decay<T>::type;
+    using Pointee = typename std::remove_cv<typename std::remove_pointer<Type>::type>::type;
+
+    static constexpr bool IS_POINTER = std::is_pointer<Type>::value;
+
+    static constexpr bool IS_STRING = std::is_same<Type,std::string>::value ||
+        (IS_POINTER && (std::is_same<Pointee,char>::value || std::is_same<Pointee,signed char>::value ||
+        std::is_same<Pointee,unsigned char>::value));
+
+    static constexpr bool IS_RAW = std::is_arithmetic<Type>::value || std::is_enum<Type>::value ||
+        (IS_POINTER && !IS_STRING && !std::is_function<Pointee>::value);
+
+    static constexpr bool DEFERRABLE = IS_STRING || IS_RAW;
+
+    static size_t GetLength(const T& value)
+    {
+        if constexpr (std::is_same<Type,std::string>::value)
+        {
+            return std::min(value.size(), (size_t)UT_LOG_DEFERRED_MAX_STRING);
+        }
+        else
+        {
+            const char* p = (const char*)value;
+            return p == NULL ? 0 : strnlen(p, UT_LOG_DEFERRED_MAX_STRING);
+        }
+    }
+
+    static const char* GetData(const T& value)
+    {
+        if constexpr (std::is_same<Type,std::string>::value)
+        {
+            return value.data();
+        }
+        else
+        {
+            return (const char*)value;
+        }
+    }
+
+    static size_t GetSize(const T& value)
+    {
+        if constexpr (IS_STRING)
+        {
+            return sizeof(uint32_t) + GetLength(value);
+        }
+        else
+        {
+            return sizeof(Type);
+        }
+    }
+
+    static char* Encode(char* p, const T& value)
+    {
+        if constexpr (IS_STRING)
+        {
+            uint32_t len = (uint32_t)GetLength(value);
+            memcpy(p, &len, sizeof(len));
+            memcpy(p + sizeof(len), GetData(value), len);
+            return p + sizeof(len) + len;
+        }
+        else
+        {
+            Type v = value;
+            memcpy(p, &v, sizeof(v));
+            return p + sizeof(v);
+        }
+    }
+
+    static const char* Decode(const char* p, std::ostream& os)
+    {
+        if constexpr (IS_STRING)
+        {
+            uint32_t len;
+            memcpy(&len, p, sizeof(len));
+            os.write(p + sizeof(len), len);
+            return p + sizeof(len) + len;
+        }
+        else
+        {
+            Type v;
+            memcpy(&v, p, sizeof(v));
+            if constexpr (std::is_enum<Type>::value)
+            {
+                os << (typename std::underlying_type<Type>::type)v;
+            }
+            else if constexpr (IS_POINTER)
+            {
+                os << (const void*)v;
+            }
+            else
+            {
+                os << v;
+            }
+            return p + sizeof(v);
+        }
+    }
+};
+
+template<typename ...Args>
+struct LogArgs
+{
+    static constexpr bool DEFERRABLE = (LogArg<Args>::DEFERRABLE && ...);
+
+    static size_t GetSize(const Args&... args)
+    {
+        return (size_t(0) + ... + LogArg<Args>::GetSize(args));
+    }
+
+    static void Encode(char* p, const Args&... args)
+    {
+        ((p = LogArg<Args>::Encode(p, args)), ...);
+    }
+
+    static const char* Decode(const char* p, std::ostream& os)
+    {
+        ((p = LogArg<Args>::Decode(p, os)), ...);
+        return p;
+    }
+};
+
+/*
+ * @brief
+ * @class: LogRing
+ *
+ * Single producer single consumer byte ring of one thread. Records are
+ * contiguous; a record that does not fit before the ring end is preceded
+ * by a padding record.
+ */
+class LogRing
+{
+public:
+    explicit LogRing(size_t size) :
+        mSize(size), mMask(size - 1), mHead(0), mTail(0), mDropCount(0), mClosed(false), mWriting(false)
+    {
+        /*
+         * touch every page now, not on the first records
+         */
+        mBuffer = (char*)aligned_alloc(8, size);
+        memset(mBuffer, 0, size);
+        mTid = (int32_t)syscall(SYS_gettid);
+    }
+
+    ~LogRing()
+    {
+        free(mBuffer);
+    }
+
+    /*
+     * Producer side. Returns record space of size bytes (multiple of 8),
+     * or NULL if the ring is full.
+     */
+    char* Reserve(size_t size)
+    {
+        uint64_t head = mHead.load(std::memory_order_relaxed);
+        uint64_t tail = mTail.load(std::memory_order_acquire);
+        size_t offset = head & mMask;
+        size_t pad = (offset + size > mSize) ? mSize - offset : 0;
+
+        if (size > mSize || head + pad + size - tail > mSize)
+        {
+            mDropCount.store(mDropCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return NULL;
+        }
+
+        if (pad > 0)
+        {
+            LogRecordHeader* padding = (LogRecordHeader*)(mBuffer + offset);
+            padding->mSize = (uint32_t)pad;
+            padding->mLevel = -1;
+            head += pad;
+            mHead.store(head, std::memory_order_release);
+        }
+
+        return mBuffer + (head & mMask);
+    }
+
+    void Commit(size_t size)
+    {
+        mHead.store(mHead.load(std::memory_order_relaxed) + size, std::memory_order_release);
+    }
+
+    /*
+     * Consumer side. Calls func(header) for each committed record.
+     */
+    template<typename Func>
+    size_t Drain(Func&& func)
+    {
+        uint64_t tail = mTail.load(std::memory_order_relaxed);
+        uint64_t head = mHead.load(std::memory_order_acquire);
+        size_t count = 0;
+
+        while (tail < head)
+        {
+            const LogRecordHeader* header = (const LogRecordHeader*)(mBuffer + (tail & mMask));
+            if (header->mLevel >= 0)
+            {
+                func(*header);
+                count++;
+            }
+
+            tail += header->mSize;
+        }
+
+        mTail.store(tail, std::memory_order_release);
+
+        return count;
+    }
+
+    int32_t GetTid() const
+    {
+        return mTid;
+    }
+
+    uint64_t GetDropCount() const
+    {
+        return mDropCount.load(std::memory_order_relaxed);
+    }
+
+    void Close()
+    {
+        mClosed.store(true, std::memory_order_release);
+    }
+
+    bool IsClosed() const
+    {
+        return mClosed.load(std::memory_order_acquire);
+    }
+
+    /*
+     * Producer side, around one push. Sequentially consistent with the
+     * enabled flag of LogDeferred, so Final either sees the push in
+     * progress or the push sees the backend stopped.
+     */
+    void BeginWrite()
+    {
+        mWriting.store(true);
+    }
+
+    void EndWrite()
+    {
+        mWriting.store(false, std::memory_order_release);
+    }
+
+    bool IsWriting() const
+    {
+        return mWriting.load();
+    }
+
+private:
+    size_t mSize;
+    size_t mMask;
+    char* mBuffer;
+    int32_t mTid;
+
+    alignas(64) std::atomic<uint64_t> mHead;
+    alignas(64) std::atomic<uint64_t> mTail;
+    std::atomic<uint64_t> mDropCount;
+    std::atomic<bool> mClosed;
+    std::atomic<bool> mWriting;
+};
+
+/*
+ * @brief
+ * @class: LogDeferredStatistics
+ */
+class LogDeferredStatistics
+{
+public:
+    LogDeferredStatistics() :
+        mRecordCount(0), mDropCount(0), mThreadCount(0)
+    {}
+
+public:
+    uint64_t mRecordCount;
+    uint64_t mDropCount;
+    uint64_t mThreadCount;
+};
+
+/*
+ * @brief
+ * @class: LogDeferred
+ *
+ * Deferred log backend. Once started, the LOG_DEFERRED_* macros copy the
+ * arguments of each call into a ring owned by the calling thread, with no lock and no
+ * formatting; a formatter thread turns the records into the usual log
+ * lines and appends them to the logger's LogStore. When a ring is full the
+ * record is dropped and counted.
+ *
+ * The first log call of a thread allocates its ring, and the first record
+ * of a thread for a store registers the store; both take a short lock that
+ * is never held across store I/O. Real-time threads should call
+ * PrepareThread(logger) at startup for each logger they use.
+ */
+class LogDeferred
+{
+public:
+    static LogDeferred* Instance()
+    {
+        static LogDeferred inst;
+        return &inst;
+    }
+
+    ~LogDeferred()
+    {
+        Final();
+    }
+
+    void Init(size_t ringSize = UT_LOG_DEFERRED_RING_SIZE, int32_t cpuId = UT_CPU_ID_NONE)
+    {
+        LockGuard<Mutex> lock(mMutex);
+
+        if (mThreadPtr != NULL)
+        {
+            return;
+        }
+
+        size_t size = UT_LOG_DEFERRED_MIN_RING_SIZE;
+        while (size < ringSize)
+        {
+            size <<= 1;
+        }
+
+        mRingSize = size;
+        mQuit = false;
+        mThreadPtr = CreateThreadEx("log_deferred", cpuId, &LogDeferred::ThreadFunc, this);
+        mEnabled.store(true);
+    }
+
+    /*
+     * Stop accepting records, wait for pushes in progress, then format
+     * everything still queued. Later LOG_DEFERRED_* calls log synchronously.
+     */
+    void Final()
+    {
+        ThreadPtr threadPtr;
+        {
+            LockGuard<Mutex> lock(mMutex);
+            mEnabled.store(false);
+            mQuit = true;
+            threadPtr = mThreadPtr;
+            mThreadPtr.reset();
+        }
+
+        if (threadPtr != NULL)
+        {
+            threadPtr->Wait();
+        }
+
+        WaitWriters();
+
+        while (Flush() > 0)
+        {}
+    }
+
+    bool IsEnabled() const
+    {
+        return mEnabled.load(std::memory_order_relaxed);
+    }
+
+    /*
+     * Allocate the ring of the calling thread and register the store of
+     * logger, so later deferred log calls of this thread take no lock.
+     */
+    void PrepareThread(Logger* logger = NULL)
+    {
+        GetRing();
+
+        if (logger != NULL && logger->GetStore() != NULL)
+        {
+            CheckStore(logger->GetStore());
+        }
+    }
+
+    /*
+     * Queue one record. Returns false if the backend is stopped and the
+     * caller should log synchronously; a record dropped because the ring
+     * is full counts as queued.
+     */
+    template<typename ...Args>
+    bool Push(const LogStorePtr& storePtr, int32_t level, const Args&... args)
+    {
+        LogRing* ring = GetRing();
+
+        ring->BeginWrite();
+
+        if (!mEnabled.load())
+        {
+            ring->EndWrite();
+            return false;
+        }
+
+        CheckStore(storePtr);
+
+        size_t size = (sizeof(LogRecordHeader) + LogArgs<Args...>::GetSize(args...) + 7) & ~(size_t)7;
+
+        char* p = ring->Reserve(size);
+        if (p == NULL)
+        {
+            ring->EndWrite();
+            return true;
+        }
+
+        struct timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+
+        LogRecordHeader* header = (LogRecordHeader*)p;
+        header->mSize = (uint32_t)size;
+        header->mLevel = level;
+        header->mTid = ring->GetTid();
+        header->mReserve = 0;
+        header->mTime = (uint64_t)ts.tv_sec * UT_NUMER_NANO + ts.tv_nsec;
+        header->mDecoder = &LogArgs<Args...>::Decode;
+        header->mStore = storePtr.get();
+
+        LogArgs<Args...>::Encode(p + sizeof(LogRecordHeader), args...);
+
+        ring->Commit(size);
+        ring->EndWrite();
+
+        return true;
+    }
+
+    /*
+     * Format and append all queued records, return the record count.
+     * The ring list is only locked to copy it; draining and store I/O run
+     * under the flush lock, which log calls never take.
+     */
+    size_t Flush()
+    {
+        LockGuard<Mutex> flushLock(mFlushMutex);
+
+        {
+            LockGuard<Mutex> lock(mMutex);
+            mFlushRings.assign(mRings.begin(), mRings.end());
+        }
+
+        size_t count = 0;
+        mClosedRings.clear();
+
+        for (LogRing* ring : mFlushRings)
+        {
+            /*
+             * a ring is closed after the last record of its thread, so read
+             * the flag before draining.
+             */
+            bool closed = ring->IsClosed();
+
+            count += ring->Drain([this](const LogRecordHeader& header) {
+                Format(header);
+            });
+
+            if (closed)
+            {
+                mClosedRings.push_back(ring);
+            }
+        }
+
+        mRecordCount.fetch_add(count, std::memory_order_relaxed);
+
+        if (!mClosedRings.empty())
+        {
+            {
+                LockGuard<Mutex> lock(mMutex);
+                for (LogRing* ring : mClosedRings)
+                {
+                    mClosedDropCount += ring->GetDropCount();
+                    mRings.erase(std::find(mRings.begin(), mRings.end(), ring));
+                }
+            }
+
+            for (LogRing* ring : mClosedRings)
+            {
+                delete ring;
+            }
+        }
+
+        return count;
+    }
+
+    LogDeferredStatistics GetStatistics()
+    {
+        LockGuard<Mutex> lock(mMutex);
+
+        LogDeferredStatistics statistics;
+        statistics.mRecordCount = mRecordCount.load(std::memory_order_relaxed);
+        statistics.mDropCount = mClosedDropCount;
+        statistics.mThreadCount = mRings.size();
+
+        for (LogRing* ring : mRings)
+        {
+            statistics.mDropCount += ring->GetDropCount();
+        }
+
+        return statistics;
+    }
+
+private:
+    LogDeferred() :
+        mEnabled(false), mRingSize(UT_LOG_DEFERRED_RING_SIZE), mQuit(false), mClosedDropCount(0), mRecordCount(0),
+        mPid(getpid())
+    {}
+
+    /*
+     * Closes the ring when its thread exits.
+     */
+    struct RingHolder
+    {
+        LogRing* mRing = NULL;
+        LogStore* mStores[8] = {};
+
+        ~RingHolder()
+        {
+            if (mRing != NULL)
+            {
+                mRing->Close();
+            }
+        }
+    };
+
+    static RingHolder& GetHolder()
+    {
+        static thread_local RingHolder holder;
+        return holder;
+    }
+
+    LogRing* GetRing()
+    {
+        RingHolder& holder = GetHolder();
+        if (holder.mRing == NULL)
+        {
+            LogRing* ring = new LogRing(mRingSize);
+
+            LockGuard<Mutex> lock(mMutex);
+            mRings.push_back(ring);
+            holder.mRing = ring;
+        }
+
+        return holder.mRing;
+    }
+
+    /*
+     * Keep every store a record refers to alive until the backend ends.
+     * Each thread remembers the last few stores it registered.
+     */
+    void CheckStore(const LogStorePtr& storePtr)
+    {
+        RingHolder& holder = GetHolder();
+        LogStore* store = storePtr.get();
+
+        for (LogStore* s : holder.mStores)
+        {
+            if (s == store)
+            {
+                return;
+            }
+        }
+
+        {
+            LockGuard<Mutex> lock(mMutex);
+            if (std::find(mStores.begin(), mStores.end(), storePtr) == mStores.end())
+            {
+                mStores.push_back(storePtr);
+            }
+        }
+
+        memmove(holder.mStores + 1, holder.mStores, sizeof(holder.mStores) - sizeof(LogStore*));
+        holder.mStores[0] = store;
+    }
+
+    /*
+     * Wait for pushes that passed the enabled check before Final cleared it.
+     */
+    void WaitWriters()
+    {
+        while (true)
+        {
+            bool writing = false;
+            {
+                LockGuard<Mutex> lock(mMutex);
+                for (LogRing* ring : mRings)
+                {
+                    writing = writing || ring->IsWriting();
+                }
+            }
+
+            if (!writing)
+            {
+                return;
+            }
+
+            sched_yield();
+        }
+    }
+
+    void Format(const LogRecordHeader& header)
+    {
+        mOs.str(std::string());
+        mOs.clear();
+
+        mOs << "[" << mTimestampCache.GetMillisecondString(header.mTime) << "] ";
+        mOs << "[" << GetLogLevelDesc(header.mLevel) << "] ";
+        mOs << "[" << mPid << "] ";
+        mOs << "[" << header.mTid << "]";
+        mOs << std::setprecision(6) << std::fixed;
+        mOs << " ";
+        header.mDecoder((const char*)&header + sizeof(LogRecordHeader), mOs);
+        mOs << std::endl;
+
+        header.mStore->Append(mOs.str());
+    }
+
+    int32_t ThreadFunc()
+    {
+        while (!mQuit)
+        {
+            Flush();
+            usleep(UT_LOG_DEFERRED_INTER);
+        }
+
+        return 0;
+    }
+
+private:
+    std::atomic<bool> mEnabled;
+    size_t mRingSize;
+    volatile bool mQuit;
+    ThreadPtr mThreadPtr;
+
+    /*
+     * ring and store lists; held briefly by log calls, never across I/O
+     */
+    Mutex mMutex;
+    std::vector<LogRing*> mRings;
+    std::vector<LogStorePtr> mStores;
+    uint64_t mClosedDropCount;
+
+    /*
+     * formatter side: one Flush at a time
+     */
+    Mutex mFlushMutex;
+    std::vector<LogRing*> mFlushRings;
+    std::vector<LogRing*> mClosedRings;
+    std::atomic<uint64_t> mRecordCount;
+
+    uint32_t mPid;
+    std::ostringstream mOs;
+    TimestampCache mTimestampCache;
+};
+
+/*
+ * Start / stop deferred logging of the LOG_DEFERRED_* macros.
+ */
+inline void LogDeferredInit(size_t ringSize = UT_LOG_DEFERRED_RING_SIZE, int32_t cpuId = UT_CPU_ID_NONE)
+{
+    LogDeferred::Instance()->Init(ringSize, cpuId);
+}
+
+inline void LogDeferredFinal()
+{
+    LogDeferred::Instance()->Final();
+}
+
+/*
+ * Log through the deferred backend when it is started and the argument
+ * types have a raw encoding, synchronously through logger otherwise.
+ * Logger::Log itself is never deferred: it is also instantiated in the
+ * prebuilt library, and changing its inline body would leave call sites
+ * disagreeing on which copy the linker keeps.
+ */
+template<typename ...Args>
+inline void LogDeferredWrite(Logger* logger, int32_t level, Args&&... args)
+{
+    if (level > logger->GetLevel() || logger->GetStore() == NULL)
+    {
+        return;
+    }
+
+    if constexpr (LogArgs<Args...>::DEFERRABLE)
+    {
+        LogDeferred* deferred = LogDeferred::Instance();
+        if (deferred->IsEnabled() && deferred->Push(logger->GetStore(), level, args...))
+        {
+            return;
+        }
+    }
+
+    logger->Log(level, std::forward<Args>(args)...);
+}
+
+}
+}
+
+//deferred write log macro wrapper
+#define __UT_LOG_DEFERRED(logger, level, ...)  \
+    do {                            \
+        if (logger != NULL)         \
+        {                           \
+            unitree::common::LogDeferredWrite(logger, level, __VA_ARGS__);  \
+        }                           \
+    } while (0)
+
+//deferred debug
+#define LOG_DEFERRED_DEBUG(logger, ...)     \
+    __UT_LOG_DEFERRED(logger, UT_LOG_DEBUG, __VA_ARGS__)
+
+//deferred info
+#define LOG_DEFERRED_INFO(logger, ...)      \
+    __UT_LOG_DEFERRED(logger, UT_LOG_INFO, __VA_ARGS__)
+
+//deferred warning
+#define LOG_DEFERRED_WARNING(logger, ...)   \
+    __UT_LOG_DEFERRED(logger, UT_LOG_WARNING, __VA_ARGS__)
+
+//deferred error
+#define LOG_DEFERRED_ERROR(logger, ...)     \
+    __UT_LOG_DEFERRED(logger, UT_LOG_ERROR, __VA_ARGS__)
+
+//deferred fatal
+#define LOG_DEFERRED_FATAL(logger, ...)     \
+    __UT_LOG_DEFERRED(logger, UT_LOG_FATAL, __VA_ARGS__)
+
+#endif//__UT_LOG_DEFERRED_HPP__
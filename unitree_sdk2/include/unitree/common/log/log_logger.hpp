@@ -46,6 +46,16 @@ public:
         mStorePtr->Append(os.str());
     }
 
+    int32_t GetLevel() const
+    {
+        return mLevel;
+    }
+
+    const LogStorePtr& GetStore() const
+    {
+        return mStorePtr;
+    }
+
     void LogFormat(int32_t level, LogBuilder& builder)
     {
         if (level > mLevel || mStorePtr == NULL)
@@ -0,0 +1,304 @@
+#ifndef __UT_MPMC_QUEUE_HPP__
+#define __UT_MPMC_QUEUE_HPP__
+
+#include <unitree/common/exception.hpp>
+#include <linux/futex.h>
+
+/*
+ * default capacity; rings are preallocated, unlike BlockQueue
+ */
+#define UT_MPMC_QUEUE_SIZE      1024
+
+/*
+ * Get spin rounds before sleeping on the futex
+ */
+#define UT_MPMC_SPIN_NUMBER     128
+
+namespace unitree
+{
+namespace common
+{
+/*
+ * @brief
+ * @class: MpmcRing
+ *
+ * Bounded multi producer multi consumer ring (D. Vyukov). Each cell
+ * carries a sequence number telling producers and consumers whose turn it
+ * is, so a Push or Pop is one CAS on the shared position plus one store on
+ * the cell, and never blocks. Elements are moved in and out.
+ */
+template<typename T>
+class MpmcRing
+{
+public:
+    explicit MpmcRing(uint64_t capacity) :
+        mCapacity(capacity == 0 ? 1 : capacity), mCells(new Cell[mCapacity]), mEnqueuePos(0), mDequeuePos(0)
+    {
+        for (uint64_t i=0; i<mCapacity; i++)
+        {
+            mCells[i].mSeq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~MpmcRing()
+    {
+        T t;
+        while (Pop(t))
+        {}
+
+        delete[] mCells;
+    }
+
+    MpmcRing(const MpmcRing&) = delete;
+    MpmcRing& operator=(const MpmcRing&) = delete;
+
+    template<typename U>
+    bool Push(U&& u)
+    {
+        uint64_t pos = mEnqueuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+
+        while (true)
+        {
+            cell = &mCells[pos % mCapacity];
+            uint64_t seq = cell->mSeq.load(std::memory_order_acquire);
+            int64_t diff = (int64_t)seq - (int64_t)pos;
+
+            if (diff == 0)
+            {
+                if (mEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                /*
+                 * full
+                 */
+                return false;
+            }
+            else
+            {
+                pos = mEnqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        new (cell->mData) T(std::forward<U>(u));
+        cell->mSeq.store(pos + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    bool Pop(T& t)
+    {
+        uint64_t pos = mDequeuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+
+        while (true)
+        {
+            cell = &mCells[pos % mCapacity];
+            uint64_t seq = cell->mSeq.load(std::memory_order_acquire);
+            int64_t diff = (int64_t)seq - (int64_t)(pos + 1);
+
+            if (diff == 0)
+            {
+                if (mDequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                /*
+                 * empty
+                 */
+                return false;
+            }
+            else
+            {
+                pos = mDequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        T* data = (T*)cell->mData;
+        t = std::move(*data);
+        data->~T();
+        cell->mSeq.store(pos + mCapacity, std::memory_order_release);
+
+        return true;
+    }
+
+    uint64_t Size() const
+    {
+        uint64_t dequeuePos = mDequeuePos.load(std::memory_order_relaxed);
+        uint64_t enqueuePos = mEnqueuePos.load(std::memory_order_relaxed);
+        return enqueuePos > dequeuePos ? enqueuePos - dequeuePos : 0;
+    }
+
+    uint64_t GetCapacity() const
+    {
+        return mCapacity;
+    }
+
+private:
+    struct alignas(64) Cell
+    {
+        std::atomic<uint64_t> mSeq;
+        alignas(T) char mData[sizeof(T)];
+    };
+
+    uint64_t mCapacity;
+    Cell* mCells;
+
+    alignas(64) std::atomic<uint64_t> mEnqueuePos;
+    alignas(64) std::atomic<uint64_t> mDequeuePos;
+};
+
+/*
+ * @brief
+ * @class: MpmcQueue
+ *
+ * Bounded lock-free alternative to BlockQueue with the same Put/Get
+ * semantics. Put never blocks; Get spins briefly and then sleeps on a
+ * futex, and producers only make the wake syscall when a consumer sleeps.
+ *
+ * putfront elements go to a second ring that Get drains first, so they
+ * overtake the normal ones but keep their own FIFO order. Both rings hold
+ * maxSize elements.
+ */
+template<typename T>
+class MpmcQueue
+{
+public:
+    explicit MpmcQueue(uint64_t maxSize = UT_MPMC_QUEUE_SIZE) :
+        mQueue(maxSize), mFrontQueue(maxSize), mSignal(0), mWaiters(0)
+    {}
+
+    bool Put(const T& t, bool replace = false, bool putfront = false)
+    {
+        return PutInner(t, replace, putfront);
+    }
+
+    bool Put(T&& t, bool replace = false, bool putfront = false)
+    {
+        return PutInner(std::move(t), replace, putfront);
+    }
+
+    /*
+     * microsec 0 waits without limit. Returns false on timeout or
+     * Interrupt, as BlockQueue does.
+     */
+    bool Get(T& t, uint64_t microsec = 0)
+    {
+        for (int32_t i=0; i<UT_MPMC_SPIN_NUMBER; i++)
+        {
+            if (TryGet(t))
+            {
+                return true;
+            }
+        }
+
+        uint32_t signal = mSignal.load(std::memory_order_acquire);
+        mWaiters.fetch_add(1, std::memory_order_seq_cst);
+
+        if (TryGet(t))
+        {
+            mWaiters.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        struct timespec ts;
+        struct timespec* timeout = NULL;
+        if (microsec > 0)
+        {
+            ts.tv_sec = microsec / 1000000;
+            ts.tv_nsec = (microsec % 1000000) * 1000;
+            timeout = &ts;
+        }
+
+        syscall(SYS_futex, (uint32_t*)&mSignal, FUTEX_WAIT_PRIVATE, signal, timeout, NULL, 0);
+        mWaiters.fetch_sub(1, std::memory_order_relaxed);
+
+        return TryGet(t);
+    }
+
+    T Get(uint64_t microsec = 0)
+    {
+        T t;
+        if (Get(t, microsec))
+        {
+            return t;
+        }
+
+        UT_THROW(TimeoutException, "mpmc queue get timeout or interrupted");
+    }
+
+    bool TryGet(T& t)
+    {
+        return mFrontQueue.Pop(t) || mQueue.Pop(t);
+    }
+
+    bool Empty() const
+    {
+        return Size() == 0;
+    }
+
+    uint64_t Size() const
+    {
+        return mQueue.Size() + mFrontQueue.Size();
+    }
+
+    void Interrupt(bool all = false)
+    {
+        mSignal.fetch_add(1, std::memory_order_release);
+        syscall(SYS_futex, (uint32_t*)&mSignal, FUTEX_WAKE_PRIVATE, all ? INT_MAX : 1, NULL, NULL, 0);
+    }
+
+private:
+    template<typename U>
+    bool PutInner(U&& u, bool replace, bool putfront)
+    {
+        MpmcRing<T>& ring = putfront ? mFrontQueue : mQueue;
+        bool noneReplaced = true;
+
+        while (!ring.Push(std::forward<U>(u)))
+        {
+            if (!replace)
+            {
+                return false;
+            }
+
+            /*
+             * drop the oldest element of the same ring
+             */
+            T evicted;
+            ring.Pop(evicted);
+            noneReplaced = false;
+        }
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (mWaiters.load(std::memory_order_relaxed) > 0)
+        {
+            mSignal.fetch_add(1, std::memory_order_release);
+            syscall(SYS_futex, (uint32_t*)&mSignal, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+        }
+
+        return noneReplaced;
+    }
+
+private:
+    MpmcRing<T> mQueue;
+    MpmcRing<T> mFrontQueue;
+
+    alignas(64) std::atomic<uint32_t> mSignal;
+    alignas(64) std::atomic<int32_t> mWaiters;
+};
+
+template <typename T>
+using MpmcQueuePtr = std::shared_ptr<MpmcQueue<T>>;
+
+}
+}
+
+#endif//__UT_MPMC_QUEUE_HPP__
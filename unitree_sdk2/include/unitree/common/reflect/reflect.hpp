@@ -0,0 +1,244 @@
+#ifndef __UT_REFLECT_HPP__
+#define __UT_REFLECT_HPP__
+
+#include <unitree/common/decl.hpp>
+#include <array>
+#include <vector>
+#include <type_traits>
+
+namespace unitree
+{
+namespace common
+{
+/*
+ * field element type
+ */
+enum
+{
+    UT_FIELD_TYPE_NONE      = 0,
+    UT_FIELD_TYPE_BOOL      = 1,
+    UT_FIELD_TYPE_INT8      = 2,
+    UT_FIELD_TYPE_UINT8     = 3,
+    UT_FIELD_TYPE_INT16     = 4,
+    UT_FIELD_TYPE_UINT16    = 5,
+    UT_FIELD_TYPE_INT32     = 6,
+    UT_FIELD_TYPE_UINT32    = 7,
+    UT_FIELD_TYPE_INT64     = 8,
+    UT_FIELD_TYPE_UINT64    = 9,
+    UT_FIELD_TYPE_FLOAT     = 10,
+    UT_FIELD_TYPE_DOUBLE    = 11,
+    UT_FIELD_TYPE_STRING    = 12,
+    UT_FIELD_TYPE_STRUCT    = 13
+};
+
+/*
+ * field shape
+ */
+enum
+{
+    UT_FIELD_KIND_SCALAR    = 0,
+    UT_FIELD_KIND_ARRAY     = 1,
+    UT_FIELD_KIND_SEQUENCE  = 2
+};
+
+class TypeDescriptor;
+
+/*
+ * @brief
+ * @class: FieldDescriptor
+ *
+ * One member of a reflected type. mExtent is 1 for scalars, N for
+ * std::array<E,N> and 0 for sequences (std::vector<E>), whose element
+ * data and count are reached through the mSequence* functions.
+ */
+class FieldDescriptor
+{
+public:
+    const char* mName;
+    size_t mOffset;
+    uint8_t mType;
+    uint8_t mKind;
+    uint32_t mExtent;
+    size_t mElementSize;
+    const TypeDescriptor* mStruct;
+    const void* (*mSequenceData)(const void* field);
+    size_t (*mSequenceSize)(const void* field);
+    void* (*mSequenceResize)(void* field, size_t size);
+};
+
+/*
+ * @brief
+ * @class: TypeDescriptor
+ */
+class TypeDescriptor
+{
+public:
+    const char* mName;
+    size_t mSize;
+    const FieldDescriptor* mFields;
+    size_t mFieldCount;
+
+    constexpr const FieldDescriptor* Begin() const
+    {
+        return mFields;
+    }
+
+    constexpr const FieldDescriptor* End() const
+    {
+        return mFields + mFieldCount;
+    }
+};
+
+/*
+ * Reflection table of T. Specializations define TYPE, a constexpr
+ * TypeDescriptor; see include/unitree/idl/reflect for the generated ones.
+ */
+template<typename T>
+struct TypeReflection
+{
+    static constexpr bool VALID = false;
+};
+
+template<typename T, typename = void>
+struct IsReflected : std::false_type
+{};
+
+template<typename T>
+struct IsReflected<T, typename std::enable_if<TypeReflection<T>::VALID>::type> : std::true_type
+{};
+
+template<typename T>
+constexpr const TypeDescriptor& GetTypeDescriptor()
+{
+    return TypeReflection<T>::TYPE;
+}
+
+template<typename T>
+struct FieldTypeOf
+{
+    static constexpr uint8_t VALUE = IsReflected<T>::value ? UT_FIELD_TYPE_STRUCT : UT_FIELD_TYPE_NONE;
+};
+
+#define UT_DECL_FIELD_TYPE(T, type)             \
+    template<>                                  \
+    struct FieldTypeOf<T>                       \
+    {                                           \
+        static constexpr uint8_t VALUE = type;  \
+    };
+
+UT_DECL_FIELD_TYPE(bool, UT_FIELD_TYPE_BOOL)
+UT_DECL_FIELD_TYPE(int8_t, UT_FIELD_TYPE_INT8)
+UT_DECL_FIELD_TYPE(uint8_t, UT_FIELD_TYPE_UINT8)
+UT_DECL_FIELD_TYPE(int16_t, UT_FIELD_TYPE_INT16)
+UT_DECL_FIELD_TYPE(uint16_t, UT_FIELD_TYPE_UINT16)
+UT_DECL_FIELD_TYPE(int32_t, UT_FIELD_TYPE_INT32)
+UT_DECL_FIELD_TYPE(uint32_t, UT_FIELD_TYPE_UINT32)
+UT_DECL_FIELD_TYPE(int64_t, UT_FIELD_TYPE_INT64)
+UT_DECL_FIELD_TYPE(uint64_t, UT_FIELD_TYPE_UINT64)
+UT_DECL_FIELD_TYPE(float, UT_FIELD_TYPE_FLOAT)
+UT_DECL_FIELD_TYPE(double, UT_FIELD_TYPE_DOUBLE)
+UT_DECL_FIELD_TYPE(std::string, UT_FIELD_TYPE_STRING)
+
+#undef UT_DECL_FIELD_TYPE
+
+template<typename E>
+constexpr const TypeDescriptor* GetStructDescriptor()
+{
+    if constexpr (IsReflected<E>::value)
+    {
+        return &TypeReflection<E>::TYPE;
+    }
+    else
+    {
+        return NULL;
+    }
+}
+
+template<typename E>
+const void* GetSequenceData(const void* field)
+{
+    return static_cast<const std::vector<E>*>(field)->data();
+}
+
+template<typename E>
+size_t GetSequenceSize(const void* field)
+{
+    return static_cast<const std::vector<E>*>(field)->size();
+}
+
+template<typename E>
+void* ResizeSequence(void* field, size_t size)
+{
+    std::vector<E>* v = static_cast<std::vector<E>*>(field);
+    v->resize(size);
+    return v->data();
+}
+
+/*
+ * Descriptor of a field of type F at offset.
+ */
+template<typename F>
+struct FieldMaker
+{
+    static_assert(FieldTypeOf<F>::VALUE != UT_FIELD_TYPE_NONE, "field type is not reflected");
+
+    static constexpr FieldDescriptor Make(const char* name, size_t offset)
+    {
+        return FieldDescriptor { name, offset, FieldTypeOf<F>::VALUE, UT_FIELD_KIND_SCALAR, 1, sizeof(F),
+            GetStructDescriptor<F>(), NULL, NULL, NULL };
+    }
+};
+
+template<typename E, size_t N>
+struct FieldMaker<std::array<E,N>>
+{
+    static_assert(FieldTypeOf<E>::VALUE != UT_FIELD_TYPE_NONE, "field element type is not reflected");
+
+    static constexpr FieldDescriptor Make(const char* name, size_t offset)
+    {
+        return FieldDescriptor { name, offset, FieldTypeOf<E>::VALUE, UT_FIELD_KIND_ARRAY, (uint32_t)N, sizeof(E),
+            GetStructDescriptor<E>(), NULL, NULL, NULL };
+    }
+};
+
+template<typename E>
+struct FieldMaker<std::vector<E>>
+{
+    static_assert(FieldTypeOf<E>::VALUE != UT_FIELD_TYPE_NONE, "field element type is not reflected");
+
+    static constexpr FieldDescriptor Make(const char* name, size_t offset)
+    {
+        return FieldDescriptor { name, offset, FieldTypeOf<E>::VALUE, UT_FIELD_KIND_SEQUENCE, 0, sizeof(E),
+            GetStructDescriptor<E>(), &GetSequenceData<E>, &GetSequenceSize<E>, &ResizeSequence<E> };
+    }
+};
+
+/*
+ * true if field lies at offset in the object at base. F must be the field
+ * type of the table, so an accessor returning another type does not compile.
+ */
+template<typename F>
+inline bool CheckFieldOffset(const F* field, const void* base, size_t offset)
+{
+    return (size_t)((const char*)field - (const char*)base) == offset;
+}
+
+}
+}
+
+/*
+ * Field entry of a reflection table. Layout is a struct with the same
+ * members in the same order as the reflected type, so that offsetof gives
+ * constant offsets of its private members.
+ */
+#define UT_REFLECT_FIELD(Layout, member, name) \
+    unitree::common::FieldMaker<decltype(Layout::member)>::Make(name, offsetof(Layout, member))
+
+/*
+ * Layout mirrors the private members by hand, so sizeof alone misses two
+ * swapped members of one type. Compare the offset with the accessor of obj.
+ */
+#define UT_REFLECT_CHECK_FIELD(Layout, obj, member, accessor) \
+    unitree::common::CheckFieldOffset<decltype(Layout::member)>(&(obj).accessor(), &(obj), offsetof(Layout, member))
+
+#endif//__UT_REFLECT_HPP__
@@ -0,0 +1,584 @@
+#ifndef __UT_REFLECT_VISITOR_HPP__
+#define __UT_REFLECT_VISITOR_HPP__
+
+#include <unitree/common/reflect/reflect.hpp>
+#include <unitree/common/json/json_value.hpp>
+
+namespace unitree
+{
+namespace common
+{
+template<typename R>
+inline R ReadFieldValue(const char* p, uint8_t type)
+{
+    switch (type)
+    {
+    case UT_FIELD_TYPE_BOOL:
+        return (R)*(const bool*)p;
+    case UT_FIELD_TYPE_INT8:
+        return (R)*(const int8_t*)p;
+    case UT_FIELD_TYPE_UINT8:
+        return (R)*(const uint8_t*)p;
+    case UT_FIELD_TYPE_INT16:
+        return (R)*(const int16_t*)p;
+    case UT_FIELD_TYPE_UINT16:
+        return (R)*(const uint16_t*)p;
+    case UT_FIELD_TYPE_INT32:
+        return (R)*(const int32_t*)p;
+    case UT_FIELD_TYPE_UINT32:
+        return (R)*(const uint32_t*)p;
+    case UT_FIELD_TYPE_INT64:
+        return (R)*(const int64_t*)p;
+    case UT_FIELD_TYPE_UINT64:
+        return (R)*(const uint64_t*)p;
+    case UT_FIELD_TYPE_FLOAT:
+        return (R)*(const float*)p;
+    case UT_FIELD_TYPE_DOUBLE:
+        return (R)*(const double*)p;
+    default:
+        return (R)0;
+    }
+}
+
+inline size_t GetFieldTypeSize(uint8_t type)
+{
+    static const size_t sizes[] = { 0, sizeof(bool), 1, 1, 2, 2, 4, 4, 8, 8, sizeof(float), sizeof(double) };
+    return type < sizeof(sizes) / sizeof(sizes[0]) ? sizes[type] : 0;
+}
+
+/*
+ * @brief
+ * @class: FieldColumn
+ * One numeric leaf of a flattened type, e.g. "motor_state[3].q".
+ */
+class FieldColumn
+{
+public:
+    std::string mName;
+    size_t mOffset;
+    uint8_t mType;
+};
+
+/*
+ * @brief
+ * @class: FieldColumnTable
+ *
+ * Numeric leaves of a reflected type in field order, built once from the
+ * descriptors. Strings and sequences have no fixed column and are left out.
+ * Flatten walks runs of same typed leaves with a fixed stride, so the type
+ * switch is taken once per run rather than once per value.
+ */
+class FieldColumnTable
+{
+public:
+    explicit FieldColumnTable(const TypeDescriptor& type)
+    {
+        Build(type, 0, std::string());
+    }
+
+    size_t GetCount() const
+    {
+        return mColumns.size();
+    }
+
+    const std::vector<FieldColumn>& GetColumns() const
+    {
+        return mColumns;
+    }
+
+    std::vector<std::string> GetNames() const
+    {
+        std::vector<std::string> names;
+        names.reserve(mColumns.size());
+
+        for (const FieldColumn& column : mColumns)
+        {
+            names.push_back(column.mName);
+        }
+
+        return names;
+    }
+
+    /*
+     * Write GetCount() values to out.
+     */
+    template<typename R>
+    void Flatten(const void* obj, R* out) const
+    {
+        const char* base = (const char*)obj;
+
+        for (const Run& run : mRuns)
+        {
+            const char* p = base + run.mOffset;
+            R* o = out + run.mIndex;
+
+            if (run.mType == UT_FIELD_TYPE_FLOAT)
+            {
+                for (size_t i=0; i<run.mCount; i++)
+                {
+                    o[i] = (R)*(const float*)(p + i * run.mStride);
+                }
+            }
+            else
+            {
+                for (size_t i=0; i<run.mCount; i++)
+                {
+                    o[i] = ReadFieldValue<R>(p + i * run.mStride, run.mType);
+                }
+            }
+        }
+    }
+
+private:
+    struct Run
+    {
+        size_t mIndex;
+        size_t mOffset;
+        size_t mStride;
+        size_t mCount;
+        uint8_t mType;
+    };
+
+    void Build(const TypeDescriptor& type, size_t offset, const std::string& prefix)
+    {
+        for (const FieldDescriptor* field = type.Begin(); field != type.End(); ++field)
+        {
+            if (field->mKind == UT_FIELD_KIND_SEQUENCE || field->mType == UT_FIELD_TYPE_STRING)
+            {
+                continue;
+            }
+
+            std::string name = prefix + field->mName;
+            size_t base = offset + field->mOffset;
+
+            for (uint32_t i=0; i<field->mExtent; i++)
+            {
+                std::string elementName = field->mKind == UT_FIELD_KIND_ARRAY ? name + "[" + std::to_string(i) + "]" : name;
+                size_t elementOffset = base + i * field->mElementSize;
+
+                if (field->mType == UT_FIELD_TYPE_STRUCT)
+                {
+                    Build(*field->mStruct, elementOffset, elementName + ".");
+                }
+                else
+                {
+                    Add(elementName, elementOffset, field->mType);
+                }
+            }
+        }
+    }
+
+    void Add(const std::string& name, size_t offset, uint8_t type)
+    {
+        if (!mRuns.empty())
+        {
+            Run& run = mRuns.back();
+            size_t last = run.mOffset + (run.mCount - 1) * run.mStride;
+
+            if (run.mType == type && offset > last && (run.mCount == 1 || offset - last == run.mStride))
+            {
+                run.mStride = offset - last;
+                run.mCount++;
+                mColumns.push_back(FieldColumn { name, offset, type });
+                return;
+            }
+        }
+
+        mRuns.push_back(Run { mColumns.size(), offset, GetFieldTypeSize(type), 1, type });
+        mColumns.push_back(FieldColumn { name, offset, type });
+    }
+
+private:
+    std::vector<FieldColumn> mColumns;
+    std::vector<Run> mRuns;
+};
+
+template<typename T>
+const FieldColumnTable& GetFieldColumns()
+{
+    static const FieldColumnTable table(GetTypeDescriptor<T>());
+    return table;
+}
+
+/*
+ * Numeric leaves of t in field order, as float or double columns.
+ */
+template<typename T, typename R>
+void FlattenFields(const T& t, R* out)
+{
+    GetFieldColumns<T>().Flatten(&t, out);
+}
+
+template<typename T, typename R>
+void FlattenFields(const T& t, std::vector<R>& out)
+{
+    const FieldColumnTable& table = GetFieldColumns<T>();
+    out.resize(table.GetCount());
+    table.Flatten(&t, out.data());
+}
+
+/*
+ * Append a scalar field element as json text.
+ */
+inline void WriteFieldJson(const char* p, uint8_t type, std::string& s)
+{
+    char buf[32];
+
+    switch (type)
+    {
+    case UT_FIELD_TYPE_BOOL:
+        s.append(*(const bool*)p ? "true" : "false");
+        break;
+    case UT_FIELD_TYPE_INT64:
+        s.append(buf, snprintf(buf, sizeof(buf), "%" PRId64, *(const int64_t*)p));
+        break;
+    case UT_FIELD_TYPE_UINT64:
+        s.append(buf, snprintf(buf, sizeof(buf), "%" PRIu64, *(const uint64_t*)p));
+        break;
+    case UT_FIELD_TYPE_FLOAT:
+        WriteJsonFloat(*(const float*)p, s);
+        break;
+    case UT_FIELD_TYPE_DOUBLE:
+        WriteJsonDouble(*(const double*)p, s);
+        break;
+    case UT_FIELD_TYPE_STRING:
+    {
+        const std::string& str = *(const std::string*)p;
+        WriteJsonString(str.data(), str.size(), s);
+        break;
+    }
+    default:
+        s.append(buf, snprintf(buf, sizeof(buf), "%" PRId64, ReadFieldValue<int64_t>(p, type)));
+    }
+}
+
+inline void WriteStructJson(const char* base, const TypeDescriptor& type, std::string& s)
+{
+    s.push_back('{');
+
+    for (const FieldDescriptor* field = type.Begin(); field != type.End(); ++field)
+    {
+        if (field != type.Begin())
+        {
+            s.push_back(',');
+        }
+
+        WriteJsonString(field->mName, strlen(field->mName), s);
+        s.push_back(':');
+
+        const char* p = base + field->mOffset;
+        size_t count = field->mExtent;
+
+        if (field->mKind == UT_FIELD_KIND_SEQUENCE)
+        {
+            count = field->mSequenceSize(p);
+            p = (const char*)field->mSequenceData(p);
+        }
+
+        if (field->mKind != UT_FIELD_KIND_SCALAR)
+        {
+            s.push_back('[');
+        }
+
+        for (size_t i=0; i<count; i++)
+        {
+            if (i > 0)
+            {
+                s.push_back(',');
+            }
+
+            const char* element = p + i * field->mElementSize;
+            if (field->mType == UT_FIELD_TYPE_STRUCT)
+            {
+                WriteStructJson(element, *field->mStruct, s);
+            }
+            else
+            {
+                WriteFieldJson(element, field->mType, s);
+            }
+        }
+
+        if (field->mKind != UT_FIELD_KIND_SCALAR)
+        {
+            s.push_back(']');
+        }
+    }
+
+    s.push_back('}');
+}
+
+/*
+ * Append t as a json object, members named after the idl fields.
+ */
+template<typename T>
+void WriteFieldsJson(const T& t, std::string& s)
+{
+    WriteStructJson((const char*)&t, GetTypeDescriptor<T>(), s);
+}
+
+template<typename T>
+std::string ToFieldsJsonString(const T& t)
+{
+    std::string s;
+    WriteFieldsJson(t, s);
+    return s;
+}
+
+/*
+ * Binary dump: fields in order, scalars in host byte order without
+ * padding, strings and sequences prefixed with a uint32 count.
+ */
+inline void WriteStructBinary(const char* base, const TypeDescriptor& type, std::string& s)
+{
+    for (const FieldDescriptor* field = type.Begin(); field != type.End(); ++field)
+    {
+        const char* p = base + field->mOffset;
+        size_t count = field->mExtent;
+
+        if (field->mKind == UT_FIELD_KIND_SEQUENCE)
+        {
+            count = field->mSequenceSize(p);
+            p = (const char*)field->mSequenceData(p);
+
+            uint32_t n = (uint32_t)count;
+            s.append((const char*)&n, sizeof(n));
+        }
+
+        if (field->mType == UT_FIELD_TYPE_STRUCT)
+        {
+            for (size_t i=0; i<count; i++)
+            {
+                WriteStructBinary(p + i * field->mElementSize, *field->mStruct, s);
+            }
+        }
+        else if (field->mType == UT_FIELD_TYPE_STRING)
+        {
+            for (size_t i=0; i<count; i++)
+            {
+                const std::string& str = *(const std::string*)(p + i * field->mElementSize);
+                uint32_t n = (uint32_t)str.size();
+                s.append((const char*)&n, sizeof(n));
+                s.append(str);
+            }
+        }
+        else
+        {
+            /*
+             * scalar elements of arrays and sequences are contiguous
+             */
+            s.append(p, count * field->mElementSize);
+        }
+    }
+}
+
+inline bool ReadStructBinary(const char*& ptr, const char* end, char* base, const TypeDescriptor& type)
+{
+    for (const FieldDescriptor* field = type.Begin(); field != type.End(); ++field)
+    {
+        char* p = base + field->mOffset;
+        size_t count = field->mExtent;
+
+        if (field->mKind == UT_FIELD_KIND_SEQUENCE)
+        {
+            uint32_t n;
+            if ((size_t)(end - ptr) < sizeof(n))
+            {
+                return false;
+            }
+
+            memcpy(&n, ptr, sizeof(n));
+            ptr += sizeof(n);
+
+            /*
+             * every element takes at least one byte, reject counts the
+             * input cannot hold before resizing
+             */
+            if (n > (size_t)(end - ptr))
+            {
+                return false;
+            }
+
+            count = n;
+            p = (char*)field->mSequenceResize(p, count);
+        }
+
+        if (field->mType == UT_FIELD_TYPE_STRUCT)
+        {
+            for (size_t i=0; i<count; i++)
+            {
+                if (!ReadStructBinary(ptr, end, p + i * field->mElementSize, *field->mStruct))
+                {
+                    return false;
+                }
+            }
+        }
+        else if (field->mType == UT_FIELD_TYPE_STRING)
+        {
+            for (size_t i=0; i<count; i++)
+            {
+                uint32_t n;
+                if ((size_t)(end - ptr) < sizeof(n))
+                {
+                    return false;
+                }
+
+                memcpy(&n, ptr, sizeof(n));
+                ptr += sizeof(n);
+
+                if (n > (size_t)(end - ptr))
+                {
+                    return false;
+                }
+
+                ((std::string*)(p + i * field->mElementSize))->assign(ptr, n);
+                ptr += n;
+            }
+        }
+        else
+        {
+            size_t len = count * field->mElementSize;
+            if (len > (size_t)(end - ptr))
+            {
+                return false;
+            }
+
+            memcpy(p, ptr, len);
+            ptr += len;
+        }
+    }
+
+    return true;
+}
+
+template<typename T>
+void WriteFieldsBinary(const T& t, std::string& s)
+{
+    WriteStructBinary((const char*)&t, GetTypeDescriptor<T>(), s);
+}
+
+/*
+ * Read a WriteFieldsBinary dump of T. Returns false on short input.
+ */
+template<typename T>
+bool ReadFieldsBinary(const char* data, size_t len, T& t)
+{
+    const char* ptr = data;
+    return ReadStructBinary(ptr, data + len, (char*)&t, GetTypeDescriptor<T>()) && ptr == data + len;
+}
+
+/*
+ * @brief
+ * @class: FieldDiff
+ * One leaf that differs; a sequence of different length is reported once
+ * with its sizes as values.
+ */
+class FieldDiff
+{
+public:
+    std::string mPath;
+    std::string mA;
+    std::string mB;
+};
+
+inline bool IsFieldEqual(const char* a, const char* b, uint8_t type, double tolerance)
+{
+    if (type == UT_FIELD_TYPE_STRING)
+    {
+        return *(const std::string*)a == *(const std::string*)b;
+    }
+
+    if (type == UT_FIELD_TYPE_FLOAT || type == UT_FIELD_TYPE_DOUBLE)
+    {
+        double x = ReadFieldValue<double>(a, type);
+        double y = ReadFieldValue<double>(b, type);
+        return x == y || std::fabs(x - y) <= tolerance || (std::isnan(x) && std::isnan(y));
+    }
+
+    return memcmp(a, b, GetFieldTypeSize(type)) == 0;
+}
+
+inline void DiffStruct(const char* a, const char* b, const TypeDescriptor& type, double tolerance, std::string& path,
+    std::vector<FieldDiff>& diffs)
+{
+    for (const FieldDescriptor* field = type.Begin(); field != type.End(); ++field)
+    {
+        size_t pathLen = path.size();
+        if (pathLen > 0)
+        {
+            path.push_back('.');
+        }
+        path.append(field->mName);
+
+        const char* pa = a + field->mOffset;
+        const char* pb = b + field->mOffset;
+        size_t count = field->mExtent;
+
+        if (field->mKind == UT_FIELD_KIND_SEQUENCE)
+        {
+            size_t na = field->mSequenceSize(pa);
+            size_t nb = field->mSequenceSize(pb);
+
+            if (na != nb)
+            {
+                diffs.push_back(FieldDiff { path, std::to_string(na), std::to_string(nb) });
+                path.resize(pathLen);
+                continue;
+            }
+
+            count = na;
+            pa = (const char*)field->mSequenceData(pa);
+            pb = (const char*)field->mSequenceData(pb);
+        }
+
+        size_t nameLen = path.size();
+
+        for (size_t i=0; i<count; i++)
+        {
+            if (field->mKind != UT_FIELD_KIND_SCALAR)
+            {
+                path.resize(nameLen);
+                path.push_back('[');
+                path.append(std::to_string(i));
+                path.push_back(']');
+            }
+
+            const char* ea = pa + i * field->mElementSize;
+            const char* eb = pb + i * field->mElementSize;
+
+            if (field->mType == UT_FIELD_TYPE_STRUCT)
+            {
+                DiffStruct(ea, eb, *field->mStruct, tolerance, path, diffs);
+            }
+            else if (!IsFieldEqual(ea, eb, field->mType, tolerance))
+            {
+                FieldDiff diff;
+                diff.mPath = path;
+                WriteFieldJson(ea, field->mType, diff.mA);
+                WriteFieldJson(eb, field->mType, diff.mB);
+                diffs.push_back(std::move(diff));
+            }
+        }
+
+        path.resize(pathLen);
+    }
+}
+
+/*
+ * Append the leaves where a and b differ to diffs, floating point fields
+ * compared within tolerance. Returns the number appended.
+ */
+template<typename T>
+size_t DiffFields(const T& a, const T& b, std::vector<FieldDiff>& diffs, double tolerance = 0.0)
+{
+    size_t count = diffs.size();
+    std::string path;
+
+    DiffStruct((const char*)&a, (const char*)&b, GetTypeDescriptor<T>(), tolerance, path, diffs);
+
+    return diffs.size() - count;
+}
+
+}
+}
+
+#endif//__UT_REFLECT_VISITOR_HPP__
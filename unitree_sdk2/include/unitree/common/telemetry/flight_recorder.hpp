@@ -0,0 +1,613 @@
+#ifndef __UT_FLIGHT_RECORDER_HPP__
+#define __UT_FLIGHT_RECORDER_HPP__
+
+#include <unitree/common/telemetry/telemetry_recorder.hpp>
+#include <unitree/common/reflect/reflect_visitor.hpp>
+#include <unitree/common/filesystem/directory.hpp>
+#include <unitree/common/log/log.hpp>
+
+/*
+ * dump thread poll interval(micro second)
+ */
+#define UT_FLIGHT_POLL_INTER            10000           //10ms
+
+/*
+ * time kept recording after a trigger(micro second)
+ */
+#define UT_FLIGHT_POST_TIME             500000          //500ms
+
+/*
+ * triggers within this time after a dump are ignored(micro second)
+ */
+#define UT_FLIGHT_HOLD_TIME             10000000        //10s
+
+#define UT_FLIGHT_DUMP_PREFIX           "flight"
+#define UT_FLIGHT_DUMP_EXT              ".bin"
+#define UT_FLIGHT_META_FILE             "meta.json"
+#define UT_FLIGHT_MAX_REASON            64
+
+namespace unitree
+{
+namespace common
+{
+/*
+ * @brief
+ * @class: FlightChannel
+ *
+ * Ring of the latest records of one stream, written by a single thread.
+ * The dump thread freezes the ring while it reads it; records arriving
+ * in that time are skipped and counted instead of waiting, and the count
+ * is written into the dump.
+ */
+class FlightChannel
+{
+public:
+    explicit FlightChannel(const std::string& name, size_t capacity) :
+        mName(name), mCapacity(capacity), mTimes(capacity, 0), mHead(0), mBusy(false), mFrozen(false),
+        mSkipCount(0)
+    {
+        UT_THROW_IF(capacity == 0, CommonException, "flight channel capacity is zero: " + name);
+    }
+
+    virtual ~FlightChannel()
+    {}
+
+    const std::string& GetName() const
+    {
+        return mName;
+    }
+
+    uint64_t GetSkipCount() const
+    {
+        return mSkipCount.load(std::memory_order_relaxed);
+    }
+
+    /*
+     * Append records oldest first as [uint64 time ns][uint32 len][data]
+     * and describe the channel in meta: "skip" counts the records skipped
+     * while this dump read the ring, "skip_total" all skipped so far.
+     */
+    void Dump(std::string& data, std::string& meta)
+    {
+        uint64_t skipCount = GetSkipCount();
+
+        Freeze();
+
+        uint64_t head = mHead.load(std::memory_order_acquire);
+        uint64_t begin = head > mCapacity ? head - mCapacity : 0;
+
+        try
+        {
+            for (uint64_t i=begin; i<head; i++)
+            {
+                size_t index = i % mCapacity;
+                data.append((const char*)&mTimes[index], sizeof(uint64_t));
+
+                size_t pos = data.size();
+                uint32_t len = 0;
+                data.append((const char*)&len, sizeof(len));
+
+                Encode(index, data);
+
+                len = (uint32_t)(data.size() - pos - sizeof(len));
+                memcpy(&data[pos], &len, sizeof(len));
+            }
+        }
+        catch (...)
+        {
+            Unfreeze();
+            throw;
+        }
+
+        Unfreeze();
+
+        uint64_t skipTotal = GetSkipCount();
+
+        std::ostringstream os;
+        os << "{\"name\":\"" << mName << "\",\"file\":\"" << mName << UT_FLIGHT_DUMP_EXT << "\",\"records\":"
+           << head - begin << ",\"skip\":" << skipTotal - skipCount << ",\"skip_total\":" << skipTotal << ",";
+        Describe(os);
+        os << "}";
+
+        meta.append(os.str());
+    }
+
+protected:
+    bool BeginRecord()
+    {
+        mBusy.store(true, std::memory_order_seq_cst);
+        if (mFrozen.load(std::memory_order_seq_cst))
+        {
+            /*
+             * counted before clearing busy, so Unfreeze sees it
+             */
+            mSkipCount.fetch_add(1, std::memory_order_relaxed);
+            mBusy.store(false, std::memory_order_release);
+            return false;
+        }
+
+        return true;
+    }
+
+    void EndRecord(uint64_t head)
+    {
+        mHead.store(head + 1, std::memory_order_release);
+        mBusy.store(false, std::memory_order_release);
+    }
+
+    virtual void Encode(size_t index, std::string& data) = 0;
+    virtual void Describe(std::ostringstream& os) = 0;
+
+private:
+    void Freeze()
+    {
+        mFrozen.store(true, std::memory_order_seq_cst);
+        while (mBusy.load(std::memory_order_seq_cst))
+        {
+            sched_yield();
+        }
+    }
+
+    /*
+     * wait for a record that saw the ring frozen to count its skip
+     */
+    void Unfreeze()
+    {
+        mFrozen.store(false, std::memory_order_seq_cst);
+        while (mBusy.load(std::memory_order_seq_cst))
+        {
+            sched_yield();
+        }
+    }
+
+protected:
+    std::string mName;
+    size_t mCapacity;
+    std::vector<uint64_t> mTimes;
+    std::atomic<uint64_t> mHead;
+
+private:
+    std::atomic<bool> mBusy;
+    std::atomic<bool> mFrozen;
+    std::atomic<uint64_t> mSkipCount;
+};
+
+typedef std::shared_ptr<FlightChannel> FlightChannelPtr;
+
+/*
+ * layout of a reflected type for offline decoding of its binary dump
+ */
+inline void WriteTypeSchemaJson(const TypeDescriptor& type, std::ostringstream& os)
+{
+    os << "[";
+    for (const FieldDescriptor* field = type.Begin(); field != type.End(); ++field)
+    {
+        os << (field == type.Begin() ? "" : ",") << "{\"name\":\"" << field->mName << "\",\"type\":"
+           << (uint32_t)field->mType << ",\"kind\":" << (uint32_t)field->mKind << ",\"extent\":" << field->mExtent;
+
+        if (field->mType == UT_FIELD_TYPE_STRUCT)
+        {
+            os << ",\"fields\":";
+            WriteTypeSchemaJson(*field->mStruct, os);
+        }
+
+        os << "}";
+    }
+    os << "]";
+}
+
+/*
+ * @brief
+ * @class: FlightChannelT
+ *
+ * Slots are constructed up front and Record copy-assigns into them, so
+ * types without sequence or string members never allocate on the
+ * recording thread. Reflected types are dumped with WriteFieldsBinary,
+ * others must be trivially copyable and are dumped as raw bytes,
+ * optionally described by a TelemetrySchema.
+ */
+template<typename T>
+class FlightChannelT : public FlightChannel
+{
+    static_assert(IsReflected<T>::value || std::is_trivially_copyable<T>::value,
+        "flight channel type must be reflected or trivially copyable");
+
+public:
+    explicit FlightChannelT(const std::string& name, size_t capacity, const TelemetrySchema* schema = NULL) :
+        FlightChannel(name, capacity), mSlots(capacity)
+    {
+        if (schema != NULL)
+        {
+            mSchema = *schema;
+        }
+    }
+
+    void Record(const T& t)
+    {
+        if (!BeginRecord())
+        {
+            return;
+        }
+
+        uint64_t head = mHead.load(std::memory_order_relaxed);
+        size_t index = head % mCapacity;
+
+        mTimes[index] = GetFastMonotonicTimeNanosecond();
+        mSlots[index] = t;
+
+        EndRecord(head);
+    }
+
+protected:
+    void Encode(size_t index, std::string& data)
+    {
+        if constexpr (IsReflected<T>::value)
+        {
+            WriteFieldsBinary(mSlots[index], data);
+        }
+        else
+        {
+            data.append((const char*)&mSlots[index], sizeof(T));
+        }
+    }
+
+    void Describe(std::ostringstream& os)
+    {
+        if constexpr (IsReflected<T>::value)
+        {
+            os << "\"encoding\":\"reflect\",\"type\":\"" << GetTypeDescriptor<T>().mName << "\",\"fields\":";
+            WriteTypeSchemaJson(GetTypeDescriptor<T>(), os);
+        }
+        else
+        {
+            os << "\"encoding\":\"raw\",\"size\":" << sizeof(T) << ",\"columns\":[";
+
+            const std::vector<TelemetryColumn>& columns = mSchema.GetColumns();
+            for (size_t i=0; i<columns.size(); i++)
+            {
+                const TelemetryColumn& column = columns[i];
+                os << (i ? "," : "") << "{\"name\":\"" << column.mName << "\",\"dtype\":\"" << column.mDescr
+                   << "\",\"count\":" << column.mCount << ",\"offset\":" << column.mOffset << "}";
+            }
+
+            os << "]";
+        }
+    }
+
+private:
+    std::vector<T> mSlots;
+    TelemetrySchema mSchema;
+};
+
+template<typename T>
+using FlightChannelTPtr = std::shared_ptr<FlightChannelT<T>>;
+
+/*
+ * @brief
+ * @class: FlightRecorder
+ *
+ * Black box keeping the last records of each channel in memory. Trigger
+ * is lock-free and async-signal-safe; the dump thread notices it, keeps
+ * recording for the post time, then writes every channel into
+ * <directory>/flight-<time>-<reason>/ through a temporary directory that
+ * is renamed when complete, so a dump is either whole or absent.
+ *
+ *   FlightRecorder recorder("/var/log/flight");
+ *   auto stateChannel = recorder.AddChannel<LowState_>("lowstate", 1000);
+ *   recorder.Start();
+ *   stateChannel->Record(lowstate);        // control thread
+ *   recorder.Trigger("bad_orientation");   // termination
+ */
+class FlightRecorder
+{
+public:
+    explicit FlightRecorder(const std::string& directory, int64_t postTime = UT_FLIGHT_POST_TIME,
+        int64_t holdTime = UT_FLIGHT_HOLD_TIME) :
+        mDirectory(directory), mPostTime(postTime), mHoldTime(holdTime), mQuit(false), mTriggered(false),
+        mLastDumpTime(0), mDumpCount(0), mFailCount(0)
+    {
+        mLogger = GetLogger("/unitree/telemetry/flight_recorder");
+        memset(mReason, 0, sizeof(mReason));
+        CreateDirectory(mDirectory);
+    }
+
+    ~FlightRecorder()
+    {
+        if (GetSignalRecorder() == this)
+        {
+            GetSignalRecorder() = NULL;
+        }
+
+        if (mThreadPtr)
+        {
+            mLock.Lock();
+            mQuit = true;
+            mLock.Notify();
+            mLock.Unlock();
+            mThreadPtr->Wait();
+        }
+    }
+
+    /*
+     * add channels before Start
+     */
+    template<typename T>
+    FlightChannelTPtr<T> AddChannel(const std::string& name, size_t capacity, const TelemetrySchema* schema = NULL)
+    {
+        UT_THROW_IF(mThreadPtr != NULL, CommonException, "flight recorder already started");
+
+        FlightChannelTPtr<T> channelPtr(new FlightChannelT<T>(name, capacity, schema));
+        mChannels.push_back(channelPtr);
+
+        return channelPtr;
+    }
+
+    void Start(int32_t cpuId = UT_CPU_ID_NONE)
+    {
+        mThreadPtr = CreateThreadEx("flight_dump", cpuId, &FlightRecorder::DumpThreadFunc, this);
+    }
+
+    /*
+     * Request a dump. The first reason since the last dump is kept.
+     */
+    void Trigger(const char* reason)
+    {
+        bool expected = false;
+        if (mTriggering.compare_exchange_strong(expected, true, std::memory_order_acquire))
+        {
+            if (!mTriggered.load(std::memory_order_relaxed))
+            {
+                size_t i = 0;
+                for (; reason != NULL && reason[i] != 0 && i < UT_FLIGHT_MAX_REASON - 1; i++)
+                {
+                    mReason[i] = IsNameChar(reason[i]) ? reason[i] : '_';
+                }
+                mReason[i] = 0;
+
+                mTriggered.store(true, std::memory_order_release);
+            }
+
+            mTriggering.store(false, std::memory_order_release);
+        }
+    }
+
+    /*
+     * Trigger a dump on signal sig. One recorder serves signals per process.
+     */
+    void InstallSignalTrigger(int32_t sig)
+    {
+        GetSignalRecorder() = this;
+
+        struct sigaction action;
+        memset(&action, 0, sizeof(action));
+        action.sa_handler = &FlightRecorder::SignalHandler;
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = SA_RESTART;
+
+        UT_THROW_IF(sigaction(sig, &action, NULL) != 0, SystemException, "install flight recorder signal failed");
+    }
+
+    /*
+     * Dump now on the calling thread, regardless of the hold time.
+     * Returns the dump directory. On failure the temporary directory is
+     * removed and the exception rethrown.
+     */
+    std::string Dump(const std::string& reason)
+    {
+        LockGuard<Mutex> guard(mDumpMutex);
+
+        std::string safeReason = reason.substr(0, UT_FLIGHT_MAX_REASON - 1);
+        for (char& c : safeReason)
+        {
+            c = IsNameChar(c) ? c : '_';
+        }
+
+        char name[64 + UT_FLIGHT_MAX_REASON];
+        time_t sec = (time_t)(GetCurrentTimeMicrosecond() / UT_NUMER_MICRO);
+        struct tm tmbuf;
+        localtime_r(&sec, &tmbuf);
+        snprintf(name, sizeof(name), "%s-%04d%02d%02d-%02d%02d%02d-%lu-%s", UT_FLIGHT_DUMP_PREFIX,
+            tmbuf.tm_year + 1900, tmbuf.tm_mon + 1, tmbuf.tm_mday, tmbuf.tm_hour, tmbuf.tm_min, tmbuf.tm_sec,
+            (unsigned long)mDumpCount.load(), safeReason.c_str());
+
+        std::string dirName = mDirectory + UT_PATH_DELIM_STR + name;
+        std::string tempName = mDirectory + UT_PATH_DELIM_STR + "." + name + ".tmp";
+
+        UT_THROW_IF(mkdir(tempName.c_str(), 0755) != 0, FileException, "create flight dump failed: " + tempName);
+
+        try
+        {
+            WriteDump(tempName, safeReason);
+
+            UT_THROW_IF(rename(tempName.c_str(), dirName.c_str()) != 0, FileException,
+                "rename flight dump failed: " + dirName);
+        }
+        catch (...)
+        {
+            RemoveDump(tempName);
+            throw;
+        }
+
+        mDumpCount++;
+
+        return dirName;
+    }
+
+    uint64_t GetDumpCount() const
+    {
+        return mDumpCount;
+    }
+
+    /*
+     * dumps of the dump thread that failed
+     */
+    uint64_t GetFailCount() const
+    {
+        return mFailCount;
+    }
+
+private:
+    void WriteDump(const std::string& tempName, const std::string& safeReason)
+    {
+        std::string meta = "{\"reason\":\"" + safeReason + "\",\"clock\":\"monotonic_ns\",\"time\":"
+            + std::to_string(GetCurrentMonotonicTimeNanosecond()) + ",\"channels\":[";
+        std::string data;
+
+        for (size_t i=0; i<mChannels.size(); i++)
+        {
+            data.clear();
+            meta.append(i ? "," : "");
+            mChannels[i]->Dump(data, meta);
+
+            WriteDumpFile(tempName + UT_PATH_DELIM_STR + mChannels[i]->GetName() + UT_FLIGHT_DUMP_EXT, data);
+        }
+
+        meta.append("]}\n");
+        WriteDumpFile(tempName + UT_PATH_DELIM_STR + UT_FLIGHT_META_FILE, meta);
+    }
+
+    void RemoveDump(const std::string& tempName)
+    {
+        try
+        {
+            RemoveDirectory(tempName, true);
+        }
+        catch (const std::exception& e)
+        {
+            LOG_ERROR(mLogger, "remove partial flight dump failed. dir:", tempName, ", error:", e.what());
+        }
+    }
+
+    int32_t DumpThreadFunc()
+    {
+        while (true)
+        {
+            mLock.Lock();
+            if (!mQuit)
+            {
+                mLock.Wait(UT_FLIGHT_POLL_INTER);
+            }
+            bool quit = mQuit;
+            mLock.Unlock();
+
+            if (quit)
+            {
+                break;
+            }
+
+            if (!mTriggered.load(std::memory_order_acquire))
+            {
+                continue;
+            }
+
+            int64_t now = (int64_t)GetCurrentMonotonicTimeMicrosecond();
+            if (mDumpCount > 0 && now - mLastDumpTime < mHoldTime)
+            {
+                mTriggered.store(false, std::memory_order_release);
+                continue;
+            }
+
+            /*
+             * record what follows the trigger too
+             */
+            mLock.Lock();
+            if (!mQuit && mPostTime > 0)
+            {
+                mLock.Wait(mPostTime);
+            }
+            mLock.Unlock();
+
+            try
+            {
+                Dump(mReason);
+            }
+            catch (const std::exception& e)
+            {
+                mFailCount++;
+                LOG_ERROR(mLogger, "flight dump failed. reason:", mReason, ", error:", e.what());
+            }
+
+            mLastDumpTime = (int64_t)GetCurrentMonotonicTimeMicrosecond();
+            mTriggered.store(false, std::memory_order_release);
+        }
+
+        return 0;
+    }
+
+    static void WriteDumpFile(const std::string& fileName, const std::string& data)
+    {
+        int32_t fd = open(fileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, UT_OPEN_MODE_RW);
+        UT_THROW_IF(fd == UT_FD_INVALID, FileException, "open flight dump file failed: " + fileName);
+
+        const char* p = data.data();
+        size_t left = data.size();
+
+        while (left > 0)
+        {
+            ssize_t n = write(fd, p, left);
+            if (n < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (n <= 0)
+            {
+                close(fd);
+                UT_THROW(FileException, "write flight dump file failed: " + fileName);
+            }
+
+            p += n;
+            left -= n;
+        }
+
+        fsync(fd);
+        close(fd);
+    }
+
+    static bool IsNameChar(char c)
+    {
+        return isalnum((unsigned char)c) || c == '_' || c == '-';
+    }
+
+    static FlightRecorder*& GetSignalRecorder()
+    {
+        static FlightRecorder* recorder = NULL;
+        return recorder;
+    }
+
+    static void SignalHandler(int)
+    {
+        FlightRecorder* recorder = GetSignalRecorder();
+        if (recorder != NULL)
+        {
+            recorder->Trigger("signal");
+        }
+    }
+
+private:
+    std::string mDirectory;
+    int64_t mPostTime;
+    int64_t mHoldTime;
+    std::vector<FlightChannelPtr> mChannels;
+
+    MutexCond mLock;
+    volatile bool mQuit;
+    ThreadPtr mThreadPtr;
+
+    std::atomic<bool> mTriggering { false };
+    std::atomic<bool> mTriggered;
+    char mReason[UT_FLIGHT_MAX_REASON];
+
+    Mutex mDumpMutex;
+    int64_t mLastDumpTime;
+    std::atomic<uint64_t> mDumpCount;
+    std::atomic<uint64_t> mFailCount;
+
+    Logger* mLogger;
+};
+
+typedef std::shared_ptr<FlightRecorder> FlightRecorderPtr;
+
+}
+}
+
+#endif//__UT_FLIGHT_RECORDER_HPP__
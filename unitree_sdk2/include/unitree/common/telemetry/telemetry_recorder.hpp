@@ -0,0 +1,533 @@
+#ifndef __UT_TELEMETRY_RECORDER_HPP__
+#define __UT_TELEMETRY_RECORDER_HPP__
+
+#include <unitree/common/reflect/reflect.hpp>
+#include <unitree/common/lock/lock.hpp>
+#include <unitree/common/thread/thread.hpp>
+#include <unitree/common/time/fast_clock.hpp>
+#include <unitree/common/filesystem/filesystem.hpp>
+#include <unitree/common/exception.hpp>
+#include <unitree/common/log/log.hpp>
+
+/*
+ * record number of the ring between control thread and writer thread
+ */
+#define UT_TELEMETRY_RING_SIZE          4096
+#define UT_TELEMETRY_MIN_RING_SIZE      64
+
+/*
+ * writer thread poll interval(micro second)
+ */
+#define UT_TELEMETRY_WRITE_INTER        20000           //20ms
+
+/*
+ * rows a column file grows by
+ */
+#define UT_TELEMETRY_GROW_ROWS          65536
+
+/*
+ * fixed .npy header length, so the shape can be rewritten in place
+ */
+#define UT_TELEMETRY_NPY_HEADER_SIZE    128
+
+#define UT_TELEMETRY_NPY_EXT            ".npy"
+#define UT_TELEMETRY_SCHEMA_FILE        "schema.json"
+#define UT_TELEMETRY_TIMESTAMP          "timestamp"
+
+namespace unitree
+{
+namespace common
+{
+/*
+ * numpy dtype of a reflected field type
+ */
+inline const char* GetNpyDescr(uint8_t type)
+{
+    switch (type)
+    {
+    case UT_FIELD_TYPE_BOOL:
+        return "|b1";
+    case UT_FIELD_TYPE_INT8:
+        return "|i1";
+    case UT_FIELD_TYPE_UINT8:
+        return "|u1";
+    case UT_FIELD_TYPE_INT16:
+        return "<i2";
+    case UT_FIELD_TYPE_UINT16:
+        return "<u2";
+    case UT_FIELD_TYPE_INT32:
+        return "<i4";
+    case UT_FIELD_TYPE_UINT32:
+        return "<u4";
+    case UT_FIELD_TYPE_INT64:
+        return "<i8";
+    case UT_FIELD_TYPE_UINT64:
+        return "<u8";
+    case UT_FIELD_TYPE_FLOAT:
+        return "<f4";
+    case UT_FIELD_TYPE_DOUBLE:
+        return "<f8";
+    default:
+        return NULL;
+    }
+}
+
+template<typename F>
+struct TelemetryFieldTraits
+{
+    typedef F ELEMENT;
+    static constexpr size_t COUNT = 1;
+};
+
+template<typename E, size_t N>
+struct TelemetryFieldTraits<std::array<E,N>>
+{
+    typedef E ELEMENT;
+    static constexpr size_t COUNT = N;
+};
+
+template<typename E, size_t N>
+struct TelemetryFieldTraits<E[N]>
+{
+    typedef E ELEMENT;
+    static constexpr size_t COUNT = N;
+};
+
+/*
+ * @brief
+ * @class: TelemetryColumn
+ */
+class TelemetryColumn
+{
+public:
+    std::string mName;
+    const char* mDescr;
+    size_t mOffset;
+    size_t mElementSize;
+    size_t mCount;
+};
+
+/*
+ * @brief
+ * @class: TelemetrySchema
+ *
+ * Columns of a fixed record type, one numeric scalar or fixed array
+ * member each. Filled with UT_TELEMETRY_COLUMN.
+ */
+class TelemetrySchema
+{
+public:
+    template<typename F>
+    void Add(const std::string& name, size_t offset)
+    {
+        typedef typename TelemetryFieldTraits<F>::ELEMENT E;
+
+        const char* descr = GetNpyDescr(FieldTypeOf<E>::VALUE);
+        UT_THROW_IF(descr == NULL, CommonException, "telemetry column is not numeric: " + name);
+
+        mColumns.push_back(TelemetryColumn { name, descr, offset, sizeof(E), TelemetryFieldTraits<F>::COUNT });
+    }
+
+    const std::vector<TelemetryColumn>& GetColumns() const
+    {
+        return mColumns;
+    }
+
+private:
+    std::vector<TelemetryColumn> mColumns;
+};
+
+/*
+ * @brief
+ * @class: NpyColumnFile
+ *
+ * One column stored as a memory mapped .npy file of shape (rows, count).
+ * The header is rewritten with the current row number on every Sync, so
+ * the file can be loaded while recording goes on.
+ */
+class NpyColumnFile
+{
+public:
+    explicit NpyColumnFile(const std::string& fileName, const char* descr, size_t elementSize, size_t count) :
+        mFileName(fileName), mDescr(descr), mCount(count), mRowSize(elementSize * count),
+        mFd(UT_FD_INVALID), mData(NULL), mRows(0), mCapacity(0)
+    {
+        mFd = open(mFileName.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, UT_OPEN_MODE_RW);
+        UT_THROW_IF(mFd == UT_FD_INVALID, FileException, "open telemetry file failed: " + mFileName);
+
+        try
+        {
+            Grow();
+        }
+        catch (...)
+        {
+            close(mFd);
+            throw;
+        }
+
+        Sync();
+    }
+
+    ~NpyColumnFile()
+    {
+        Sync();
+        munmap(mData, UT_TELEMETRY_NPY_HEADER_SIZE + mCapacity * mRowSize);
+
+        /*
+         * drop the unused tail
+         */
+        if (ftruncate(mFd, UT_TELEMETRY_NPY_HEADER_SIZE + mRows * mRowSize) != 0)
+        {}
+
+        close(mFd);
+    }
+
+    void Append(const void* row)
+    {
+        if (mRows == mCapacity)
+        {
+            Grow();
+        }
+
+        memcpy(mData + UT_TELEMETRY_NPY_HEADER_SIZE + mRows * mRowSize, row, mRowSize);
+        mRows++;
+    }
+
+    void Sync()
+    {
+        char dict[UT_TELEMETRY_NPY_HEADER_SIZE];
+        int32_t len;
+
+        if (mCount == 1)
+        {
+            len = snprintf(dict, sizeof(dict), "{'descr': '%s', 'fortran_order': False, 'shape': (%lu,), }",
+                mDescr, (unsigned long)mRows);
+        }
+        else
+        {
+            len = snprintf(dict, sizeof(dict), "{'descr': '%s', 'fortran_order': False, 'shape': (%lu, %lu), }",
+                mDescr, (unsigned long)mRows, (unsigned long)mCount);
+        }
+
+        /*
+         * magic, version 1.0, little endian header length, then the dict
+         * padded with spaces and ended by '\n'
+         */
+        char* p = mData;
+        memcpy(p, "\x93NUMPY\x01\x00", 8);
+        p[8] = (char)((UT_TELEMETRY_NPY_HEADER_SIZE - 10) & 0xff);
+        p[9] = (char)((UT_TELEMETRY_NPY_HEADER_SIZE - 10) >> 8);
+        memset(p + 10, ' ', UT_TELEMETRY_NPY_HEADER_SIZE - 10);
+        memcpy(p + 10, dict, len);
+        p[UT_TELEMETRY_NPY_HEADER_SIZE - 1] = '\n';
+    }
+
+    size_t GetRows() const
+    {
+        return mRows;
+    }
+
+private:
+    /*
+     * the old mapping stays valid until the new one is in place, so a
+     * failed Grow leaves the file usable up to its current capacity
+     */
+    void Grow()
+    {
+        size_t capacity = mCapacity + UT_TELEMETRY_GROW_ROWS;
+        size_t size = UT_TELEMETRY_NPY_HEADER_SIZE + capacity * mRowSize;
+
+        UT_THROW_IF(ftruncate(mFd, size) != 0, FileException, "resize telemetry file failed: " + mFileName);
+
+        void* data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, mFd, 0);
+        UT_THROW_IF(data == MAP_FAILED, FileException, "map telemetry file failed: " + mFileName);
+
+        if (mData != NULL)
+        {
+            munmap(mData, UT_TELEMETRY_NPY_HEADER_SIZE + mCapacity * mRowSize);
+        }
+
+        mData = (char*)data;
+        mCapacity = capacity;
+    }
+
+private:
+    std::string mFileName;
+    const char* mDescr;
+    size_t mCount;
+    size_t mRowSize;
+    int32_t mFd;
+    char* mData;
+    size_t mRows;
+    size_t mCapacity;
+};
+
+typedef std::shared_ptr<NpyColumnFile> NpyColumnFilePtr;
+
+/*
+ * @brief
+ * @class: TelemetryRecorder
+ *
+ * Push copies a record by value into a single producer single consumer
+ * ring and never blocks, allocates or calls into the kernel; when the
+ * ring is full the record is dropped and counted. A writer thread moves
+ * records out of the ring into one <column>.npy file per column under
+ * directory, plus timestamp.npy (monotonic nanoseconds taken at Push) and
+ * schema.json describing the columns.
+ *
+ * writeInter <= 0 selects UT_TELEMETRY_WRITE_INTER. If writing fails the
+ * writer logs the error once, drops records from then on, and notes the
+ * error in schema.json.
+ *
+ *   np.load("jpos.npy")  # (rows, 12) float32
+ */
+template<typename Record>
+class TelemetryRecorder
+{
+    static_assert(std::is_trivially_copyable<Record>::value, "telemetry record must be trivially copyable");
+
+public:
+    explicit TelemetryRecorder(const std::string& directory, const TelemetrySchema& schema,
+        size_t ringSize = UT_TELEMETRY_RING_SIZE, int64_t writeInter = UT_TELEMETRY_WRITE_INTER,
+        int32_t cpuId = UT_CPU_ID_NONE) :
+        mDirectory(directory), mSchema(schema), mWriteInter(writeInter > 0 ? writeInter : UT_TELEMETRY_WRITE_INTER),
+        mQuit(false), mFailed(false), mHead(0), mTail(0), mDropCount(0)
+    {
+        mLogger = GetLogger("/unitree/telemetry/telemetry_recorder");
+
+        size_t size = UT_TELEMETRY_MIN_RING_SIZE;
+        while (size < ringSize)
+        {
+            size <<= 1;
+        }
+
+        mMask = size - 1;
+        mSlots.resize(size);
+
+        mTimestampFile = NpyColumnFilePtr(new NpyColumnFile(GetColumnFileName(UT_TELEMETRY_TIMESTAMP),
+            GetNpyDescr(UT_FIELD_TYPE_UINT64), sizeof(uint64_t), 1));
+
+        for (const TelemetryColumn& column : mSchema.GetColumns())
+        {
+            mColumnFiles.push_back(NpyColumnFilePtr(new NpyColumnFile(GetColumnFileName(column.mName),
+                column.mDescr, column.mElementSize, column.mCount)));
+        }
+
+        UT_THROW_IF(!WriteSchema(), FileException, "write telemetry schema failed: " + mDirectory);
+
+        mThreadPtr = CreateThreadEx("telemetry", cpuId, &TelemetryRecorder::WriterThreadFunc, this);
+    }
+
+    ~TelemetryRecorder()
+    {
+        mLock.Lock();
+        mQuit = true;
+        mLock.Notify();
+        mLock.Unlock();
+
+        mThreadPtr->Wait();
+
+        if (!WriteSchema())
+        {
+            LOG_ERROR(mLogger, "write telemetry schema failed. directory:", mDirectory);
+        }
+    }
+
+    /*
+     * control thread side, single producer
+     */
+    bool Push(const Record& record)
+    {
+        uint64_t head = mHead.load(std::memory_order_relaxed);
+        if (head - mTail.load(std::memory_order_acquire) > mMask)
+        {
+            mDropCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        Slot& slot = mSlots[head & mMask];
+        slot.mTime = GetFastMonotonicTimeNanosecond();
+        slot.mRecord = record;
+
+        mHead.store(head + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    uint64_t GetDropCount() const
+    {
+        return mDropCount.load(std::memory_order_relaxed);
+    }
+
+    /*
+     * writing failed; records are dropped since
+     */
+    bool IsFailed() const
+    {
+        return mFailed.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Slot
+    {
+        uint64_t mTime;
+        Record mRecord;
+    };
+
+    int32_t WriterThreadFunc()
+    {
+        bool quit = false;
+
+        while (!quit)
+        {
+            mLock.Lock();
+            if (!mQuit)
+            {
+                mLock.Wait(mWriteInter);
+            }
+            quit = mQuit;
+            mLock.Unlock();
+
+            try
+            {
+                Drain();
+            }
+            catch (const std::exception& e)
+            {
+                mError = e.what();
+                mFailed.store(true, std::memory_order_relaxed);
+                LOG_ERROR(mLogger, "telemetry write failed, dropping records. directory:", mDirectory, ", error:", mError);
+            }
+        }
+
+        return 0;
+    }
+
+    void Drain()
+    {
+        uint64_t tail = mTail.load(std::memory_order_relaxed);
+        uint64_t head = mHead.load(std::memory_order_acquire);
+
+        if (tail == head)
+        {
+            return;
+        }
+
+        if (mFailed.load(std::memory_order_relaxed))
+        {
+            mDropCount.fetch_add(head - tail, std::memory_order_relaxed);
+            mTail.store(head, std::memory_order_release);
+            return;
+        }
+
+        const std::vector<TelemetryColumn>& columns = mSchema.GetColumns();
+
+        for (; tail != head; tail++)
+        {
+            const Slot& slot = mSlots[tail & mMask];
+            const char* p = (const char*)&slot.mRecord;
+
+            mTimestampFile->Append(&slot.mTime);
+            for (size_t i=0; i<columns.size(); i++)
+            {
+                mColumnFiles[i]->Append(p + columns[i].mOffset);
+            }
+
+            mTail.store(tail + 1, std::memory_order_release);
+        }
+
+        mTimestampFile->Sync();
+        for (const NpyColumnFilePtr& filePtr : mColumnFiles)
+        {
+            filePtr->Sync();
+        }
+    }
+
+    /*
+     * false if schema.json could not be written; never throws, it also
+     * runs in the destructor
+     */
+    bool WriteSchema()
+    {
+        std::ostringstream os;
+        os << "{\"clock\":\"monotonic_ns\",\"timestamp\":\"" << UT_TELEMETRY_TIMESTAMP << UT_TELEMETRY_NPY_EXT << "\""
+           << ",\"rows\":" << mTimestampFile->GetRows() << ",\"drop\":" << GetDropCount();
+
+        if (mFailed.load(std::memory_order_relaxed))
+        {
+            os << ",\"error\":\"" << mError << "\"";
+        }
+
+        os << ",\"columns\":[";
+
+        const std::vector<TelemetryColumn>& columns = mSchema.GetColumns();
+        for (size_t i=0; i<columns.size(); i++)
+        {
+            const TelemetryColumn& column = columns[i];
+            os << (i ? "," : "") << "{\"name\":\"" << column.mName << "\",\"dtype\":\"" << column.mDescr
+               << "\",\"count\":" << column.mCount << ",\"file\":\"" << column.mName << UT_TELEMETRY_NPY_EXT << "\"}";
+        }
+        os << "]}\n";
+
+        std::string s = os.str();
+        std::string fileName = mDirectory + UT_PATH_DELIM_STR + UT_TELEMETRY_SCHEMA_FILE;
+
+        int32_t fd = open(fileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, UT_OPEN_MODE_RW);
+        if (fd == UT_FD_INVALID)
+        {
+            return false;
+        }
+
+        bool ok = write(fd, s.data(), s.size()) == (ssize_t)s.size();
+        close(fd);
+
+        return ok;
+    }
+
+    std::string GetColumnFileName(const std::string& name) const
+    {
+        return mDirectory + UT_PATH_DELIM_STR + name + UT_TELEMETRY_NPY_EXT;
+    }
+
+private:
+    std::string mDirectory;
+    TelemetrySchema mSchema;
+    int64_t mWriteInter;
+
+    MutexCond mLock;
+    volatile bool mQuit;
+
+    /*
+     * mError is written by the writer thread before mFailed is set, and
+     * read after it has been joined
+     */
+    std::atomic<bool> mFailed;
+    std::string mError;
+    Logger* mLogger;
+
+    std::vector<Slot> mSlots;
+    uint64_t mMask;
+
+    alignas(64) std::atomic<uint64_t> mHead;
+    alignas(64) std::atomic<uint64_t> mTail;
+    alignas(64) std::atomic<uint64_t> mDropCount;
+
+    NpyColumnFilePtr mTimestampFile;
+    std::vector<NpyColumnFilePtr> mColumnFiles;
+    ThreadPtr mThreadPtr;
+};
+
+template<typename Record>
+using TelemetryRecorderPtr = std::shared_ptr<TelemetryRecorder<Record>>;
+
+}
+}
+
+/*
+ * Column named after a member of Record, which must be a numeric scalar,
+ * std::array or C array.
+ */
+#define UT_TELEMETRY_COLUMN(schema, Record, member) \
+    (schema).Add<decltype(Record::member)>(#member, offsetof(Record, member))
+
+#endif//__UT_TELEMETRY_RECORDER_HPP__
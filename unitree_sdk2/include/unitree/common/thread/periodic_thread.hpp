@@ -0,0 +1,345 @@
+#ifndef __UT_PERIODIC_THREAD_HPP__
+#define __UT_PERIODIC_THREAD_HPP__
+
+#include <unitree/common/thread/thread.hpp>
+#include <unitree/common/time/latency_histogram.hpp>
+#include <alloca.h>
+
+/*
+ * stack touched before the first period, so the loop takes no page faults
+ */
+#define UT_THREAD_PREFAULT_STACK_SIZE   262144          //256K
+
+#ifndef SCHED_DEADLINE
+#define SCHED_DEADLINE                  6
+#endif
+
+namespace unitree
+{
+namespace common
+{
+/*
+ * @brief
+ * @class: PeriodicThreadAttr
+ *
+ * mSchedPolicy is SCHED_OTHER, SCHED_FIFO, SCHED_RR or SCHED_DEADLINE.
+ * mPriority applies to SCHED_FIFO/SCHED_RR, mRuntimeMicrosec is the
+ * SCHED_DEADLINE budget per period (deadline = period).
+ */
+class PeriodicThreadAttr
+{
+public:
+    PeriodicThreadAttr() :
+        mSchedPolicy(SCHED_OTHER), mPriority(0), mRuntimeMicrosec(0), mLockMemory(false),
+        mPrefaultStackSize(UT_THREAD_PREFAULT_STACK_SIZE)
+    {}
+
+    static PeriodicThreadAttr Fifo(int32_t priority, bool lockMemory = true)
+    {
+        PeriodicThreadAttr attr;
+        attr.mSchedPolicy = SCHED_FIFO;
+        attr.mPriority = priority;
+        attr.mLockMemory = lockMemory;
+        return attr;
+    }
+
+    static PeriodicThreadAttr Deadline(uint64_t runtimeMicrosec, bool lockMemory = true)
+    {
+        PeriodicThreadAttr attr;
+        attr.mSchedPolicy = SCHED_DEADLINE;
+        attr.mRuntimeMicrosec = runtimeMicrosec;
+        attr.mLockMemory = lockMemory;
+        return attr;
+    }
+
+public:
+    int32_t mSchedPolicy;
+    int32_t mPriority;
+    uint64_t mRuntimeMicrosec;
+    bool mLockMemory;
+    size_t mPrefaultStackSize;
+};
+
+/*
+ * @brief
+ * @class: PeriodicThreadStatistics
+ */
+class PeriodicThreadStatistics
+{
+public:
+    uint64_t mCycleCount;
+    uint64_t mOverrunCount;
+    uint64_t mMissedPeriodCount;
+
+    /*
+     * nanosecond
+     */
+    uint64_t mWakeLatencyMean;
+    uint64_t mWakeLatencyP99;
+    uint64_t mWakeLatencyMax;
+    uint64_t mExecTimeMean;
+    uint64_t mExecTimeP99;
+    uint64_t mExecTimeMax;
+
+    /*
+     * scheduling setup result, 0 or errno
+     */
+    int32_t mSchedError;
+
+    std::string ToString() const
+    {
+        char buf[256];
+        snprintf(buf, sizeof(buf), "cycle:%lu overrun:%lu missed:%lu wake(us) mean:%.1f p99:%.1f max:%.1f "
+            "exec(us) mean:%.1f p99:%.1f max:%.1f sched:%d", (unsigned long)mCycleCount,
+            (unsigned long)mOverrunCount, (unsigned long)mMissedPeriodCount, mWakeLatencyMean / 1e3,
+            mWakeLatencyP99 / 1e3, mWakeLatencyMax / 1e3, mExecTimeMean / 1e3, mExecTimeP99 / 1e3,
+            mExecTimeMax / 1e3, mSchedError);
+        return buf;
+    }
+};
+
+/*
+ * Applies memory locking, stack prefault and the scheduling policy of attr
+ * to the calling thread. Returns 0 or the errno of the last failing step.
+ */
+static inline int32_t SetupThreadSched(const PeriodicThreadAttr& attr, uint64_t intervalMicrosec)
+{
+    int32_t error = 0;
+
+    if (attr.mLockMemory && mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+    {
+        error = errno;
+    }
+
+    if (attr.mPrefaultStackSize > 0)
+    {
+        volatile char* stack = (volatile char*)alloca(attr.mPrefaultStackSize);
+        for (size_t i=0; i<attr.mPrefaultStackSize; i+=4096)
+        {
+            stack[i] = 0;
+        }
+    }
+
+    if (attr.mSchedPolicy == SCHED_FIFO || attr.mSchedPolicy == SCHED_RR)
+    {
+        struct sched_param param;
+        param.sched_priority = attr.mPriority;
+
+        int32_t ret = pthread_setschedparam(pthread_self(), attr.mSchedPolicy, &param);
+        if (ret != 0)
+        {
+            error = ret;
+        }
+    }
+    else if (attr.mSchedPolicy == SCHED_DEADLINE)
+    {
+        /*
+         * struct sched_attr of sched_setattr(2), not in glibc headers
+         */
+        struct
+        {
+            uint32_t size;
+            uint32_t sched_policy;
+            uint64_t sched_flags;
+            int32_t sched_nice;
+            uint32_t sched_priority;
+            uint64_t sched_runtime;
+            uint64_t sched_deadline;
+            uint64_t sched_period;
+        } schedAttr;
+
+        memset(&schedAttr, 0, sizeof(schedAttr));
+        schedAttr.size = sizeof(schedAttr);
+        schedAttr.sched_policy = SCHED_DEADLINE;
+        schedAttr.sched_runtime = attr.mRuntimeMicrosec * 1000;
+        schedAttr.sched_deadline = intervalMicrosec * 1000;
+        schedAttr.sched_period = intervalMicrosec * 1000;
+
+        if (syscall(SYS_sched_setattr, 0, &schedAttr, 0) != 0)
+        {
+            error = errno;
+        }
+    }
+
+    return error;
+}
+
+/*
+ * @brief
+ * @class: PeriodicThread
+ *
+ * Like RecurrentThread but sleeps to absolute deadlines with
+ * clock_nanosleep(TIMER_ABSTIME), so the period does not drift with the
+ * run time of the function. A period that ends after the next deadline
+ * is an overrun; deadlines already passed are skipped, keeping the phase.
+ *
+ * Scheduling policy, memory locking and stack prefault are applied by the
+ * thread itself before the first period. A failure (usually EPERM without
+ * CAP_SYS_NICE) leaves the thread at normal priority and is reported by
+ * GetSchedError rather than thrown.
+ */
+class PeriodicThread : public Thread
+{
+public:
+    __UT_THREAD_DECL_TMPL_FUNC_ARG__
+    explicit PeriodicThread(const std::string& name, int32_t cpuId, uint64_t intervalMicrosec,
+        const PeriodicThreadAttr& attr, __UT_THREAD_TMPL_FUNC_ARG__)
+        : Thread(name, cpuId), mQuit(false), mIntervalMicrosec(intervalMicrosec), mAttr(attr),
+          mReady(false), mSchedError(0), mCycleCount(0), mOverrunCount(0), mMissedPeriodCount(0)
+    {
+        UT_THROW_IF(mIntervalMicrosec == 0, CommonException, "periodic thread interval is zero");
+
+        mFunc = std::bind(__UT_THREAD_BIND_FUNC_ARG__);
+
+        Run(&PeriodicThread::ThreadFunc, this);
+
+        /*
+         * return once the scheduling result is known
+         */
+        mReadyLock.Lock();
+        while (!mReady)
+        {
+            mReadyLock.Wait();
+        }
+        mReadyLock.Unlock();
+    }
+
+    virtual ~PeriodicThread()
+    {
+        mQuit = true;
+        Wait();
+    }
+
+    void Quit()
+    {
+        mQuit = true;
+    }
+
+    int32_t GetSchedError() const
+    {
+        return mSchedError;
+    }
+
+    const LatencyHistogram& GetWakeLatency() const
+    {
+        return mWakeLatency;
+    }
+
+    const LatencyHistogram& GetExecTime() const
+    {
+        return mExecTime;
+    }
+
+    PeriodicThreadStatistics GetStatistics() const
+    {
+        PeriodicThreadStatistics statistics;
+        statistics.mCycleCount = mCycleCount.load(std::memory_order_relaxed);
+        statistics.mOverrunCount = mOverrunCount.load(std::memory_order_relaxed);
+        statistics.mMissedPeriodCount = mMissedPeriodCount.load(std::memory_order_relaxed);
+        statistics.mWakeLatencyMean = mWakeLatency.GetMean();
+        statistics.mWakeLatencyP99 = mWakeLatency.GetPercentile(0.99);
+        statistics.mWakeLatencyMax = mWakeLatency.GetMax();
+        statistics.mExecTimeMean = mExecTime.GetMean();
+        statistics.mExecTimeP99 = mExecTime.GetPercentile(0.99);
+        statistics.mExecTimeMax = mExecTime.GetMax();
+        statistics.mSchedError = mSchedError;
+        return statistics;
+    }
+
+    void ResetStatistics()
+    {
+        mWakeLatency.Reset();
+        mExecTime.Reset();
+        mOverrunCount.store(0, std::memory_order_relaxed);
+        mMissedPeriodCount.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    int32_t ThreadFunc()
+    {
+        mSchedError = SetupThreadSched(mAttr, mIntervalMicrosec);
+
+        mReadyLock.Lock();
+        mReady = true;
+        mReadyLock.Notify();
+        mReadyLock.Unlock();
+
+        const int64_t period = (int64_t)mIntervalMicrosec * 1000;
+
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        int64_t next = GetNanosec(ts) + period;
+
+        while (!mQuit)
+        {
+            ts.tv_sec = next / 1000000000;
+            ts.tv_nsec = next % 1000000000;
+            while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+            {}
+
+            if (mQuit)
+            {
+                break;
+            }
+
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+            int64_t wake = GetNanosec(ts);
+            mWakeLatency.Add(wake > next ? wake - next : 0);
+
+            mFunc();
+
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+            int64_t end = GetNanosec(ts);
+            mExecTime.Add(end - wake);
+            mCycleCount.fetch_add(1, std::memory_order_relaxed);
+
+            next += period;
+            if (end > next)
+            {
+                int64_t missed = (end - next) / period + 1;
+                next += missed * period;
+
+                mOverrunCount.fetch_add(1, std::memory_order_relaxed);
+                mMissedPeriodCount.fetch_add(missed, std::memory_order_relaxed);
+            }
+        }
+
+        return 0;
+    }
+
+    static int64_t GetNanosec(const struct timespec& ts)
+    {
+        return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+    }
+
+private:
+    volatile bool mQuit;
+    uint64_t mIntervalMicrosec;
+    PeriodicThreadAttr mAttr;
+    std::function<void()> mFunc;
+
+    MutexCond mReadyLock;
+    bool mReady;
+    volatile int32_t mSchedError;
+
+    std::atomic<uint64_t> mCycleCount;
+    std::atomic<uint64_t> mOverrunCount;
+    std::atomic<uint64_t> mMissedPeriodCount;
+    LatencyHistogram mWakeLatency;
+    LatencyHistogram mExecTime;
+};
+
+typedef std::shared_ptr<PeriodicThread> PeriodicThreadPtr;
+
+__UT_THREAD_DECL_TMPL_FUNC_ARG__
+PeriodicThreadPtr CreatePeriodicThreadEx(const std::string& name, int32_t cpuId, uint64_t intervalMicrosec,
+    const PeriodicThreadAttr& attr, __UT_THREAD_TMPL_FUNC_ARG__)
+{
+    return PeriodicThreadPtr(new PeriodicThread(name, cpuId, intervalMicrosec, attr,
+        __UT_THREAD_BIND_FUNC_ARG__));
+}
+
+}
+}
+
+#endif//__UT_PERIODIC_THREAD_HPP__
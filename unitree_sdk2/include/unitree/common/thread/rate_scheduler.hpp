@@ -0,0 +1,407 @@
+#ifndef __UT_RATE_SCHEDULER_HPP__
+#define __UT_RATE_SCHEDULER_HPP__
+
+#include <unitree/common/thread/periodic_thread.hpp>
+#include <linux/futex.h>
+#include <algorithm>
+
+/*
+ * trigger 0 is the scheduler tick, 1..31 are fired with Trigger()
+ */
+#define UT_RATE_TRIGGER_TICK            0
+#define UT_RATE_TRIGGER_MAX_NUMBER      32
+
+namespace unitree
+{
+namespace common
+{
+/*
+ * @brief
+ * @class: RateTaskStatistics
+ */
+class RateTaskStatistics
+{
+public:
+    std::string mName;
+    uint32_t mTrigger;
+    uint32_t mDivider;
+    int32_t mPhase;
+    uint64_t mBudgetMicrosec;
+
+    uint64_t mRunCount;
+    uint64_t mOverBudgetCount;
+    uint64_t mErrorCount;
+
+    /*
+     * nanosecond. latency is from the trigger (or tick deadline) to the
+     * start of the task, i.e. the age of the data it works on.
+     */
+    uint64_t mExecTimeMean;
+    uint64_t mExecTimeP99;
+    uint64_t mExecTimeMax;
+    uint64_t mLatencyMean;
+    uint64_t mLatencyP99;
+    uint64_t mLatencyMax;
+
+    std::string ToString() const
+    {
+        char buf[320];
+        snprintf(buf, sizeof(buf), "%s trigger:%u/%u phase:%d run:%lu over:%lu(budget %luus) error:%lu "
+            "exec(us) mean:%.1f p99:%.1f max:%.1f latency(us) mean:%.1f p99:%.1f max:%.1f",
+            mName.c_str(), mTrigger, mDivider, mPhase, (unsigned long)mRunCount, (unsigned long)mOverBudgetCount,
+            (unsigned long)mBudgetMicrosec, (unsigned long)mErrorCount, mExecTimeMean / 1e3, mExecTimeP99 / 1e3,
+            mExecTimeMax / 1e3, mLatencyMean / 1e3, mLatencyP99 / 1e3, mLatencyMax / 1e3);
+        return buf;
+    }
+};
+
+/*
+ * @brief
+ * @class: RateScheduler
+ *
+ * Runs several tasks of different rates in one thread instead of one
+ * RecurrentThread each, so they keep a fixed phase relative to each
+ * other and to the data they consume.
+ *
+ * A task runs on every divider-th occurrence of its trigger: the tick
+ * (UT_RATE_TRIGGER_TICK, every tickMicrosec to absolute deadlines) or a
+ * trigger fired from another thread with Trigger(), typically a channel
+ * subscriber handler on each new sample. The thread wakes as soon as a
+ * trigger fires; all tasks due in that wake run in ascending phase, then
+ * insertion order. A trigger fired again before the thread consumed it
+ * is coalesced and counted by GetCoalescedCount.
+ *
+ * tickMicrosec 0 makes the scheduler purely trigger driven. Tasks are
+ * added before Start. Scheduling attributes are those of PeriodicThread.
+ */
+class RateScheduler
+{
+public:
+    explicit RateScheduler(const std::string& name, int32_t cpuId, uint64_t tickMicrosec,
+        const PeriodicThreadAttr& attr = PeriodicThreadAttr()) :
+        mName(name), mCpuId(cpuId), mTickMicrosec(tickMicrosec), mAttr(attr), mQuit(false),
+        mReady(false), mSchedError(0), mPending(0), mSignal(0), mTickCount(0), mMissedTickCount(0)
+    {
+        for (int32_t i=0; i<UT_RATE_TRIGGER_MAX_NUMBER; i++)
+        {
+            mTriggerTime[i].store(0, std::memory_order_relaxed);
+            mCoalescedCount[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    ~RateScheduler()
+    {
+        Quit();
+    }
+
+    RateScheduler(const RateScheduler&) = delete;
+    RateScheduler& operator=(const RateScheduler&) = delete;
+
+    /*
+     * budgetMicrosec 0 means no budget. An exception from a task is
+     * counted and does not stop the scheduler.
+     */
+    __UT_THREAD_DECL_TMPL_FUNC_ARG__
+    void AddTask(const std::string& name, uint32_t trigger, uint32_t divider, int32_t phase,
+        uint64_t budgetMicrosec, __UT_THREAD_TMPL_FUNC_ARG__)
+    {
+        UT_THROW_IF(mThreadPtr != NULL, CommonException, "rate scheduler task added after start");
+        UT_THROW_IF(trigger >= UT_RATE_TRIGGER_MAX_NUMBER, CommonException, "rate scheduler trigger out of range");
+        UT_THROW_IF(trigger == UT_RATE_TRIGGER_TICK && mTickMicrosec == 0, CommonException,
+            "rate scheduler has no tick");
+
+        TaskPtr taskPtr(new Task());
+        taskPtr->mName = name;
+        taskPtr->mTrigger = trigger;
+        taskPtr->mDivider = divider == 0 ? 1 : divider;
+        taskPtr->mPhase = phase;
+        taskPtr->mBudget = budgetMicrosec * 1000;
+        taskPtr->mFunc = std::bind(__UT_THREAD_BIND_FUNC_ARG__);
+        taskPtr->mRunCount.store(0, std::memory_order_relaxed);
+        taskPtr->mOverBudgetCount.store(0, std::memory_order_relaxed);
+        taskPtr->mErrorCount.store(0, std::memory_order_relaxed);
+
+        mTasks.push_back(taskPtr);
+    }
+
+    /*
+     * returns once the scheduling result is known
+     */
+    void Start()
+    {
+        UT_THROW_IF(mThreadPtr != NULL, CommonException, "rate scheduler already started");
+
+        std::stable_sort(mTasks.begin(), mTasks.end(), [](const TaskPtr& a, const TaskPtr& b)
+        {
+            return a->mPhase < b->mPhase;
+        });
+
+        mThreadPtr = CreateThreadEx(mName, mCpuId, &RateScheduler::ThreadFunc, this);
+
+        mReadyLock.Lock();
+        while (!mReady)
+        {
+            mReadyLock.Wait();
+        }
+        mReadyLock.Unlock();
+    }
+
+    void Quit()
+    {
+        if (mThreadPtr == NULL)
+        {
+            return;
+        }
+
+        mQuit = true;
+        Wake();
+
+        mThreadPtr->Wait();
+        mThreadPtr.reset();
+    }
+
+    /*
+     * Lock free, may be called from any thread.
+     */
+    void Trigger(uint32_t trigger)
+    {
+        uint32_t bit = 1U << (trigger % UT_RATE_TRIGGER_MAX_NUMBER);
+
+        mTriggerTime[trigger % UT_RATE_TRIGGER_MAX_NUMBER].store(GetNanosec(), std::memory_order_relaxed);
+        if (mPending.fetch_or(bit, std::memory_order_release) & bit)
+        {
+            mCoalescedCount[trigger % UT_RATE_TRIGGER_MAX_NUMBER].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        Wake();
+    }
+
+    int32_t GetSchedError() const
+    {
+        return mSchedError;
+    }
+
+    uint64_t GetTickCount() const
+    {
+        return mTickCount.load(std::memory_order_relaxed);
+    }
+
+    uint64_t GetMissedTickCount() const
+    {
+        return mMissedTickCount.load(std::memory_order_relaxed);
+    }
+
+    uint64_t GetCoalescedCount(uint32_t trigger) const
+    {
+        return mCoalescedCount[trigger % UT_RATE_TRIGGER_MAX_NUMBER].load(std::memory_order_relaxed);
+    }
+
+    std::vector<RateTaskStatistics> GetStatistics() const
+    {
+        std::vector<RateTaskStatistics> statistics;
+
+        for (const TaskPtr& taskPtr : mTasks)
+        {
+            RateTaskStatistics s;
+            s.mName = taskPtr->mName;
+            s.mTrigger = taskPtr->mTrigger;
+            s.mDivider = taskPtr->mDivider;
+            s.mPhase = taskPtr->mPhase;
+            s.mBudgetMicrosec = taskPtr->mBudget / 1000;
+            s.mRunCount = taskPtr->mRunCount.load(std::memory_order_relaxed);
+            s.mOverBudgetCount = taskPtr->mOverBudgetCount.load(std::memory_order_relaxed);
+            s.mErrorCount = taskPtr->mErrorCount.load(std::memory_order_relaxed);
+            s.mExecTimeMean = taskPtr->mExecTime.GetMean();
+            s.mExecTimeP99 = taskPtr->mExecTime.GetPercentile(0.99);
+            s.mExecTimeMax = taskPtr->mExecTime.GetMax();
+            s.mLatencyMean = taskPtr->mLatency.GetMean();
+            s.mLatencyP99 = taskPtr->mLatency.GetPercentile(0.99);
+            s.mLatencyMax = taskPtr->mLatency.GetMax();
+            statistics.push_back(s);
+        }
+
+        return statistics;
+    }
+
+    void ResetStatistics()
+    {
+        for (const TaskPtr& taskPtr : mTasks)
+        {
+            taskPtr->mOverBudgetCount.store(0, std::memory_order_relaxed);
+            taskPtr->mErrorCount.store(0, std::memory_order_relaxed);
+            taskPtr->mExecTime.Reset();
+            taskPtr->mLatency.Reset();
+        }
+    }
+
+private:
+    struct Task
+    {
+        std::string mName;
+        uint32_t mTrigger;
+        uint32_t mDivider;
+        int32_t mPhase;
+        int64_t mBudget;
+        std::function<void()> mFunc;
+
+        std::atomic<uint64_t> mRunCount;
+        std::atomic<uint64_t> mOverBudgetCount;
+        std::atomic<uint64_t> mErrorCount;
+        LatencyHistogram mExecTime;
+        LatencyHistogram mLatency;
+    };
+
+    typedef std::shared_ptr<Task> TaskPtr;
+
+    int32_t ThreadFunc()
+    {
+        mSchedError = SetupThreadSched(mAttr, mTickMicrosec);
+
+        mReadyLock.Lock();
+        mReady = true;
+        mReadyLock.Notify();
+        mReadyLock.Unlock();
+
+        const int64_t period = (int64_t)mTickMicrosec * 1000;
+        int64_t next = GetNanosec() + period;
+
+        /*
+         * occurrences of each trigger seen by this thread
+         */
+        uint64_t occurrence[UT_RATE_TRIGGER_MAX_NUMBER] = { 0 };
+        int64_t triggerTime[UT_RATE_TRIGGER_MAX_NUMBER] = { 0 };
+
+        while (!mQuit)
+        {
+            uint32_t signal = mSignal.load(std::memory_order_acquire);
+            uint32_t fired = mPending.exchange(0, std::memory_order_acquire);
+
+            int64_t now = GetNanosec();
+            if (period > 0 && now >= next)
+            {
+                fired |= 1U << UT_RATE_TRIGGER_TICK;
+                mTriggerTime[UT_RATE_TRIGGER_TICK].store(next, std::memory_order_relaxed);
+                mTickCount.fetch_add(1, std::memory_order_relaxed);
+
+                next += period;
+                if (now >= next)
+                {
+                    int64_t missed = (now - next) / period + 1;
+                    next += missed * period;
+                    mMissedTickCount.fetch_add(missed, std::memory_order_relaxed);
+                }
+            }
+
+            if (fired == 0)
+            {
+                WaitSignal(signal, period > 0 ? &next : NULL);
+                continue;
+            }
+
+            for (int32_t i=0; i<UT_RATE_TRIGGER_MAX_NUMBER; i++)
+            {
+                if (fired & (1U << i))
+                {
+                    occurrence[i]++;
+                    triggerTime[i] = mTriggerTime[i].load(std::memory_order_relaxed);
+                }
+            }
+
+            for (const TaskPtr& taskPtr : mTasks)
+            {
+                uint32_t trigger = taskPtr->mTrigger;
+                if ((fired & (1U << trigger)) && (occurrence[trigger] - 1) % taskPtr->mDivider == 0)
+                {
+                    RunTask(*taskPtr, triggerTime[trigger]);
+                }
+            }
+        }
+
+        return 0;
+    }
+
+    void RunTask(Task& task, int64_t triggerTime)
+    {
+        int64_t begin = GetNanosec();
+        task.mLatency.Add(begin > triggerTime ? begin - triggerTime : 0);
+
+        try
+        {
+            task.mFunc();
+        }
+        catch (...)
+        {
+            task.mErrorCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        int64_t exec = GetNanosec() - begin;
+        task.mExecTime.Add(exec);
+        task.mRunCount.fetch_add(1, std::memory_order_relaxed);
+
+        if (task.mBudget > 0 && exec > task.mBudget)
+        {
+            task.mOverBudgetCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /*
+     * sleep until the signal changes or the absolute monotonic deadline
+     */
+    void WaitSignal(uint32_t signal, const int64_t* deadline)
+    {
+        struct timespec ts;
+        struct timespec* timeout = NULL;
+
+        if (deadline != NULL)
+        {
+            ts.tv_sec = *deadline / 1000000000;
+            ts.tv_nsec = *deadline % 1000000000;
+            timeout = &ts;
+        }
+
+        syscall(SYS_futex, (uint32_t*)&mSignal, FUTEX_WAIT_BITSET_PRIVATE, signal, timeout, NULL,
+            FUTEX_BITSET_MATCH_ANY);
+    }
+
+    void Wake()
+    {
+        mSignal.fetch_add(1, std::memory_order_release);
+        syscall(SYS_futex, (uint32_t*)&mSignal, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+    }
+
+    static int64_t GetNanosec()
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+    }
+
+private:
+    std::string mName;
+    int32_t mCpuId;
+    uint64_t mTickMicrosec;
+    PeriodicThreadAttr mAttr;
+
+    std::vector<TaskPtr> mTasks;
+    ThreadPtr mThreadPtr;
+
+    volatile bool mQuit;
+    MutexCond mReadyLock;
+    bool mReady;
+    volatile int32_t mSchedError;
+
+    std::atomic<uint32_t> mPending;
+    std::atomic<uint32_t> mSignal;
+    std::atomic<int64_t> mTriggerTime[UT_RATE_TRIGGER_MAX_NUMBER];
+    std::atomic<uint64_t> mCoalescedCount[UT_RATE_TRIGGER_MAX_NUMBER];
+
+    std::atomic<uint64_t> mTickCount;
+    std::atomic<uint64_t> mMissedTickCount;
+};
+
+typedef std::shared_ptr<RateScheduler> RateSchedulerPtr;
+
+}
+}
+
+#endif//__UT_RATE_SCHEDULER_HPP__
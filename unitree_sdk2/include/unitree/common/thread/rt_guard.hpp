@@ -0,0 +1,417 @@
+#ifndef __UT_RT_GUARD_HPP__
+#define __UT_RT_GUARD_HPP__
+
+#include <unitree/common/thread/recurrent_thread.hpp>
+#include <execinfo.h>
+#include <malloc.h>
+
+/*
+ * violations reported with a backtrace per thread; later ones are only
+ * counted
+ */
+#define UT_RT_GUARD_REPORT_MAX_NUMBER   16
+#define UT_RT_GUARD_BACKTRACE_DEPTH     32
+
+namespace unitree
+{
+namespace common
+{
+enum
+{
+    UT_RT_VIOLATION_MALLOC      = 0,
+    UT_RT_VIOLATION_FREE        = 1,
+    UT_RT_VIOLATION_PAGE_FAULT  = 2,
+    UT_RT_VIOLATION_NUMBER      = 3
+};
+
+enum
+{
+    UT_RT_GUARD_MODE_REPORT     = 0,
+    UT_RT_GUARD_MODE_TRAP       = 1
+};
+
+/*
+ * @brief
+ * @class: RtGuard
+ *
+ * Detects heap use and page faults in code that must not take them,
+ * typically the body of a control loop. Code runs guarded inside an
+ * RtGuardScope; allocation calls there are violations:
+ *
+ *   - malloc/calloc/realloc/posix_memalign/aligned_alloc/memalign/valloc/
+ *     pvalloc and free, which also covers new/delete, make_shared, vector growth and string
+ *     streams. The hooks are defined once per executable with
+ *     UT_RT_GUARD_INSTALL_HOOKS() at file scope; without them only page
+ *     faults are checked.
+ *   - minor and major page faults taken by the thread during the scope,
+ *     from getrusage(RUSAGE_THREAD) at scope entry and exit.
+ *
+ * A violation is counted, and the first UT_RT_GUARD_REPORT_MAX_NUMBER of
+ * each thread are written to stderr with a backtrace, without allocating.
+ * In UT_RT_GUARD_MODE_TRAP (the default unless NDEBUG) an allocation
+ * also raises SIGTRAP to stop in the debugger.
+ *
+ * Together with PrepareProcess (mlockall, no heap trimming, prefaulted
+ * heap) a run without violations shows the guarded path is allocation
+ * and page fault free.
+ */
+class RtGuard
+{
+public:
+    /*
+     * Lock current and future pages, keep freed heap memory mapped and
+     * prefault heapBytes of it. Returns 0 or the errno of mlockall.
+     */
+    static int32_t PrepareProcess(size_t heapBytes)
+    {
+        int32_t error = 0;
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+        {
+            error = errno;
+        }
+
+        mallopt(M_TRIM_THRESHOLD, -1);
+        mallopt(M_MMAP_MAX, 0);
+
+        if (heapBytes > 0)
+        {
+            volatile char* heap = (volatile char*)malloc(heapBytes);
+            if (heap != NULL)
+            {
+                for (size_t i=0; i<heapBytes; i+=4096)
+                {
+                    heap[i] = 0;
+                }
+                free((void*)heap);
+            }
+        }
+
+        PrepareThread();
+
+        return error;
+    }
+
+    /*
+     * load what backtrace needs, so the first report does not allocate
+     */
+    static void PrepareThread()
+    {
+        void* frames[2];
+        backtrace(frames, 2);
+    }
+
+    static void SetMode(int32_t mode)
+    {
+        GetGlobal().mMode.store(mode, std::memory_order_relaxed);
+    }
+
+    static int32_t GetMode()
+    {
+        return GetGlobal().mMode.load(std::memory_order_relaxed);
+    }
+
+    static bool IsHooked()
+    {
+        return GetGlobal().mHooked.load(std::memory_order_relaxed);
+    }
+
+    /*
+     * process wide, since start
+     */
+    static uint64_t GetViolationCount(int32_t kind)
+    {
+        return GetGlobal().mCount[kind].load(std::memory_order_relaxed);
+    }
+
+    static bool IsGuarded()
+    {
+        ThreadState& state = GetThreadState();
+        return state.mDepth > 0 && state.mAllowDepth == 0 && !state.mReporting;
+    }
+
+    /*
+     * called by the allocation hooks
+     */
+    static void CheckAlloc(int32_t kind, size_t size)
+    {
+        if (IsGuarded())
+        {
+            Violation(kind, size);
+        }
+    }
+
+    static void SetHooked()
+    {
+        GetGlobal().mHooked.store(true, std::memory_order_relaxed);
+    }
+
+private:
+    friend class RtGuardScope;
+    friend class RtGuardAllowScope;
+
+    struct Global
+    {
+#ifdef NDEBUG
+        std::atomic<int32_t> mMode { UT_RT_GUARD_MODE_REPORT };
+#else
+        std::atomic<int32_t> mMode { UT_RT_GUARD_MODE_TRAP };
+#endif
+        std::atomic<bool> mHooked { false };
+        std::atomic<uint64_t> mCount[UT_RT_VIOLATION_NUMBER] = {};
+    };
+
+    struct ThreadState
+    {
+        int32_t mDepth;
+        int32_t mAllowDepth;
+        bool mReporting;
+        uint32_t mReportCount;
+        const char* mName;
+        long mMinorFault;
+        long mMajorFault;
+    };
+
+    static Global& GetGlobal()
+    {
+        static Global global;
+        return global;
+    }
+
+    static ThreadState& GetThreadState()
+    {
+        static thread_local ThreadState state = { 0, 0, false, 0, "", 0, 0 };
+        return state;
+    }
+
+    static void Violation(int32_t kind, size_t size)
+    {
+        static const char* const kindName[UT_RT_VIOLATION_NUMBER] = { "malloc", "free", "page fault" };
+
+        GetGlobal().mCount[kind].fetch_add(1, std::memory_order_relaxed);
+
+        ThreadState& state = GetThreadState();
+        if (state.mReportCount < UT_RT_GUARD_REPORT_MAX_NUMBER)
+        {
+            state.mReportCount++;
+            state.mReporting = true;
+
+            char buf[192];
+            int32_t len = snprintf(buf, sizeof(buf), "[rt_guard] %s: %s %lu in guarded scope\n",
+                state.mName, kindName[kind], (unsigned long)size);
+            WriteStderr(buf, len);
+
+            if (kind != UT_RT_VIOLATION_PAGE_FAULT)
+            {
+                void* frames[UT_RT_GUARD_BACKTRACE_DEPTH];
+                int32_t depth = backtrace(frames, UT_RT_GUARD_BACKTRACE_DEPTH);
+                backtrace_symbols_fd(frames, depth, STDERR_FILENO);
+            }
+
+            state.mReporting = false;
+        }
+
+        if (kind != UT_RT_VIOLATION_PAGE_FAULT && GetMode() == UT_RT_GUARD_MODE_TRAP)
+        {
+            raise(SIGTRAP);
+        }
+    }
+
+    static void WriteStderr(const char* buf, int32_t len)
+    {
+        if (len <= 0)
+        {
+            return;
+        }
+
+        len = std::min<int32_t>(len, 191);
+        while (len > 0)
+        {
+            ssize_t n = write(STDERR_FILENO, buf, len);
+            if (n <= 0)
+            {
+                break;
+            }
+            buf += n;
+            len -= n;
+        }
+    }
+
+    static void GetFaults(long& minor, long& major)
+    {
+        struct rusage usage;
+        getrusage(RUSAGE_THREAD, &usage);
+        minor = usage.ru_minflt;
+        major = usage.ru_majflt;
+    }
+};
+
+/*
+ * @brief
+ * @class: RtGuardScope
+ *
+ * Guards the calling thread until the end of the scope. Scopes nest; the
+ * outermost one names the violations and checks page faults.
+ */
+class RtGuardScope
+{
+public:
+    explicit RtGuardScope(const char* name)
+    {
+        RtGuard::ThreadState& state = RtGuard::GetThreadState();
+        if (state.mDepth++ == 0)
+        {
+            state.mName = name;
+            RtGuard::GetFaults(state.mMinorFault, state.mMajorFault);
+        }
+    }
+
+    ~RtGuardScope()
+    {
+        RtGuard::ThreadState& state = RtGuard::GetThreadState();
+        if (state.mDepth == 1)
+        {
+            long minor, major;
+            RtGuard::GetFaults(minor, major);
+
+            long faults = (minor - state.mMinorFault) + (major - state.mMajorFault);
+            if (faults > 0 && state.mAllowDepth == 0)
+            {
+                RtGuard::Violation(UT_RT_VIOLATION_PAGE_FAULT, (size_t)faults);
+            }
+        }
+        state.mDepth--;
+    }
+
+    RtGuardScope(const RtGuardScope&) = delete;
+    RtGuardScope& operator=(const RtGuardScope&) = delete;
+};
+
+/*
+ * @brief
+ * @class: RtGuardAllowScope
+ *
+ * Lifts the guard for a known, accepted allocation inside a guarded scope.
+ */
+class RtGuardAllowScope
+{
+public:
+    RtGuardAllowScope()
+    {
+        RtGuard::GetThreadState().mAllowDepth++;
+    }
+
+    ~RtGuardAllowScope()
+    {
+        RtGuard::GetThreadState().mAllowDepth--;
+    }
+
+    RtGuardAllowScope(const RtGuardAllowScope&) = delete;
+    RtGuardAllowScope& operator=(const RtGuardAllowScope&) = delete;
+};
+
+/*
+ * Callable running func(args...) in an RtGuardScope named name, for
+ * RecurrentThread, PeriodicThread or RateScheduler tasks.
+ */
+__UT_THREAD_DECL_TMPL_FUNC_ARG__
+std::function<void()> RtGuardWrap(const std::string& name, __UT_THREAD_TMPL_FUNC_ARG__)
+{
+    std::function<void()> wrapped = std::bind(__UT_THREAD_BIND_FUNC_ARG__);
+    std::shared_ptr<std::string> namePtr(new std::string(name));
+
+    return [wrapped, namePtr]()
+    {
+        RtGuardScope guard(namePtr->c_str());
+        wrapped();
+    };
+}
+
+__UT_THREAD_DECL_TMPL_FUNC_ARG__
+ThreadPtr CreateRtGuardedRecurrentThreadEx(const std::string& name, int32_t cpuId, uint64_t intervalMicrosec,
+    __UT_THREAD_TMPL_FUNC_ARG__)
+{
+    RtGuard::PrepareThread();
+    return CreateRecurrentThreadEx(name, cpuId, intervalMicrosec, RtGuardWrap(name, __UT_THREAD_BIND_FUNC_ARG__));
+}
+
+}
+}
+
+/*
+ * Interpose the allocator of the executable; use once, at file scope of
+ * one translation unit. Forwards to the glibc implementation.
+ */
+#define UT_RT_GUARD_INSTALL_HOOKS()                                                 \
+extern "C" void* __libc_malloc(size_t);                                             \
+extern "C" void* __libc_calloc(size_t, size_t);                                     \
+extern "C" void* __libc_realloc(void*, size_t);                                     \
+extern "C" void* __libc_memalign(size_t, size_t);                                   \
+extern "C" void* __libc_valloc(size_t);                                             \
+extern "C" void* __libc_pvalloc(size_t);                                            \
+extern "C" void __libc_free(void*);                                                 \
+extern "C" void* malloc(size_t size)                                                \
+{                                                                                   \
+    unitree::common::RtGuard::CheckAlloc(unitree::common::UT_RT_VIOLATION_MALLOC, size); \
+    return __libc_malloc(size);                                                     \
+}                                                                                   \
+extern "C" void* calloc(size_t n, size_t size)                                      \
+{                                                                                   \
+    unitree::common::RtGuard::CheckAlloc(unitree::common::UT_RT_VIOLATION_MALLOC, n * size); \
+    return __libc_calloc(n, size);                                                  \
+}                                                                                   \
+extern "C" void* realloc(void* ptr, size_t size)                                    \
+{                                                                                   \
+    unitree::common::RtGuard::CheckAlloc(unitree::common::UT_RT_VIOLATION_MALLOC, size); \
+    return __libc_realloc(ptr, size);                                               \
+}                                                                                   \
+extern "C" int posix_memalign(void** ptr, size_t align, size_t size)               \
+{                                                                                   \
+    if (align % sizeof(void*) != 0 || (align & (align - 1)) != 0)                   \
+    {                                                                               \
+        return EINVAL;                                                              \
+    }                                                                               \
+    unitree::common::RtGuard::CheckAlloc(unitree::common::UT_RT_VIOLATION_MALLOC, size); \
+    void* p = __libc_memalign(align, size);                                         \
+    if (p == NULL)                                                                  \
+    {                                                                               \
+        return ENOMEM;                                                              \
+    }                                                                               \
+    *ptr = p;                                                                       \
+    return 0;                                                                       \
+}                                                                                   \
+extern "C" void* aligned_alloc(size_t align, size_t size)                           \
+{                                                                                   \
+    if (align == 0 || (align & (align - 1)) != 0)                                   \
+    {                                                                               \
+        errno = EINVAL;                                                             \
+        return NULL;                                                                \
+    }                                                                               \
+    unitree::common::RtGuard::CheckAlloc(unitree::common::UT_RT_VIOLATION_MALLOC, size); \
+    return __libc_memalign(align, size);                                            \
+}                                                                                   \
+extern "C" void* memalign(size_t align, size_t size)                                \
+{                                                                                   \
+    unitree::common::RtGuard::CheckAlloc(unitree::common::UT_RT_VIOLATION_MALLOC, size); \
+    return __libc_memalign(align, size);                                            \
+}                                                                                   \
+extern "C" void* valloc(size_t size)                                                \
+{                                                                                   \
+    unitree::common::RtGuard::CheckAlloc(unitree::common::UT_RT_VIOLATION_MALLOC, size); \
+    return __libc_valloc(size);                                                     \
+}                                                                                   \
+extern "C" void* pvalloc(size_t size)                                               \
+{                                                                                   \
+    unitree::common::RtGuard::CheckAlloc(unitree::common::UT_RT_VIOLATION_MALLOC, size); \
+    return __libc_pvalloc(size);                                                    \
+}                                                                                   \
+extern "C" void free(void* ptr)                                                     \
+{                                                                                   \
+    if (ptr != NULL)                                                                \
+    {                                                                               \
+        unitree::common::RtGuard::CheckAlloc(unitree::common::UT_RT_VIOLATION_FREE, 0); \
+    }                                                                               \
+    __libc_free(ptr);                                                               \
+}                                                                                   \
+static int __ut_rt_guard_hooked __attribute__((unused)) = (unitree::common::RtGuard::SetHooked(), 0);
+
+#endif//__UT_RT_GUARD_HPP__
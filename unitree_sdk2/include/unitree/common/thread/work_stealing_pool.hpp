@@ -0,0 +1,870 @@
+#ifndef __UT_WORK_STEALING_POOL_HPP__
+#define __UT_WORK_STEALING_POOL_HPP__
+
+#include <unitree/common/thread/thread.hpp>
+#include <unitree/common/thread/thread_task.hpp>
+#include <unitree/common/block_queue.hpp>
+#include <cstddef>
+#include <exception>
+#include <thread>
+
+/*
+ * callables up to this size are stored in the task itself
+ */
+#define UT_INLINE_TASK_BUFFER_SIZE      48
+
+/*
+ * task number of a worker deque; tasks pushed beyond go to the shared queue
+ */
+#define UT_WORK_DEQUE_SIZE              4096
+
+/*
+ * task nodes kept per worker thread, and per pool for other threads, for reuse
+ */
+#define UT_TASK_NODE_CACHE_SIZE         256
+
+/*
+ * idle worker spin rounds before sleeping, and the longest sleep
+ */
+#define UT_WORK_SPIN_NUMBER             64
+#define UT_WORK_IDLE_WAIT_MICROSEC      10000
+
+namespace unitree
+{
+namespace common
+{
+/*
+ * @brief
+ * @class: InlineTask
+ *
+ * Type erased void() callable stored in a fixed buffer when it fits,
+ * typically lambdas capturing a few pointers or a shared_ptr, and on the
+ * heap otherwise.
+ */
+class InlineTask
+{
+public:
+    InlineTask() : mOps(NULL)
+    {}
+
+    ~InlineTask()
+    {
+        Reset();
+    }
+
+    InlineTask(const InlineTask&) = delete;
+    InlineTask& operator=(const InlineTask&) = delete;
+
+    template<typename F>
+    void Set(F&& f)
+    {
+        typedef typename std::decay<F>::type T;
+
+        Reset();
+
+        if constexpr (sizeof(T) <= UT_INLINE_TASK_BUFFER_SIZE && alignof(T) <= alignof(std::max_align_t))
+        {
+            new (mBuffer) T(std::forward<F>(f));
+            mOps = &InlineOps<T>::OPS;
+        }
+        else
+        {
+            *(T**)mBuffer = new T(std::forward<F>(f));
+            mOps = &HeapOps<T>::OPS;
+        }
+    }
+
+    void Run()
+    {
+        mOps->mRun(mBuffer);
+    }
+
+    void Reset()
+    {
+        if (mOps != NULL)
+        {
+            mOps->mDestroy(mBuffer);
+            mOps = NULL;
+        }
+    }
+
+    bool IsInline() const
+    {
+        return mOps != NULL && mOps->mInline;
+    }
+
+private:
+    struct Ops
+    {
+        void (*mRun)(void*);
+        void (*mDestroy)(void*);
+        bool mInline;
+    };
+
+    template<typename T>
+    struct InlineOps
+    {
+        static void Run(void* p)
+        {
+            (*(T*)p)();
+        }
+
+        static void Destroy(void* p)
+        {
+            ((T*)p)->~T();
+        }
+
+        static constexpr Ops OPS = { &Run, &Destroy, true };
+    };
+
+    template<typename T>
+    struct HeapOps
+    {
+        static void Run(void* p)
+        {
+            (**(T**)p)();
+        }
+
+        static void Destroy(void* p)
+        {
+            delete *(T**)p;
+        }
+
+        static constexpr Ops OPS = { &Run, &Destroy, false };
+    };
+
+private:
+    alignas(std::max_align_t) char mBuffer[UT_INLINE_TASK_BUFFER_SIZE];
+    const Ops* mOps;
+};
+
+/*
+ * @brief
+ * @class: TaskNode
+ *
+ * Per thread node cache. The pool uses it on its workers and keeps a
+ * shared free list for other threads, see WorkStealingThreadPool.
+ */
+class TaskNode
+{
+public:
+    TaskNode() : mNext(NULL)
+    {}
+
+    /*
+     * cached node of the calling thread, NULL if none
+     */
+    static TaskNode* TakeCached()
+    {
+        std::vector<TaskNode*>& cache = GetCache().mNodes;
+        if (cache.empty())
+        {
+            return NULL;
+        }
+
+        TaskNode* node = cache.back();
+        cache.pop_back();
+        return node;
+    }
+
+    /*
+     * keep a reset node in the calling thread's cache, false if it is full
+     */
+    static bool PutCached(TaskNode* node)
+    {
+        std::vector<TaskNode*>& cache = GetCache().mNodes;
+        if (cache.size() >= UT_TASK_NODE_CACHE_SIZE)
+        {
+            return false;
+        }
+
+        cache.push_back(node);
+        return true;
+    }
+
+public:
+    InlineTask mTask;
+    TaskNode* mNext;
+
+private:
+    struct Cache
+    {
+        Cache()
+        {
+            mNodes.reserve(UT_TASK_NODE_CACHE_SIZE);
+        }
+
+        ~Cache()
+        {
+            for (TaskNode* node : mNodes)
+            {
+                delete node;
+            }
+        }
+
+        std::vector<TaskNode*> mNodes;
+    };
+
+    static Cache& GetCache()
+    {
+        static thread_local Cache cache;
+        return cache;
+    }
+};
+
+/*
+ * @brief
+ * @class: WorkDeque
+ *
+ * Chase-Lev deque of fixed size (Le et al., "Correct and Efficient
+ * Work-Stealing for Weak Memory Models"). Push and Pop by the owner at
+ * the bottom, Steal by any thread at the top.
+ */
+class WorkDeque
+{
+public:
+    WorkDeque() : mTop(0), mBottom(0)
+    {
+        for (int64_t i=0; i<UT_WORK_DEQUE_SIZE; i++)
+        {
+            mBuffer[i].store(NULL, std::memory_order_relaxed);
+        }
+    }
+
+    bool Push(TaskNode* node)
+    {
+        int64_t b = mBottom.load(std::memory_order_relaxed);
+        int64_t t = mTop.load(std::memory_order_acquire);
+        if (b - t >= UT_WORK_DEQUE_SIZE)
+        {
+            return false;
+        }
+
+        mBuffer[b & (UT_WORK_DEQUE_SIZE - 1)].store(node, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        mBottom.store(b + 1, std::memory_order_relaxed);
+
+        return true;
+    }
+
+    TaskNode* Pop()
+    {
+        int64_t b = mBottom.load(std::memory_order_relaxed) - 1;
+        mBottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = mTop.load(std::memory_order_relaxed);
+
+        if (t > b)
+        {
+            mBottom.store(b + 1, std::memory_order_relaxed);
+            return NULL;
+        }
+
+        TaskNode* node = mBuffer[b & (UT_WORK_DEQUE_SIZE - 1)].load(std::memory_order_relaxed);
+        if (t == b)
+        {
+            /*
+             * last task, race the thieves for it
+             */
+            if (!mTop.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                node = NULL;
+            }
+            mBottom.store(b + 1, std::memory_order_relaxed);
+        }
+
+        return node;
+    }
+
+    TaskNode* Steal()
+    {
+        int64_t t = mTop.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = mBottom.load(std::memory_order_acquire);
+
+        if (t >= b)
+        {
+            return NULL;
+        }
+
+        TaskNode* node = mBuffer[t & (UT_WORK_DEQUE_SIZE - 1)].load(std::memory_order_relaxed);
+        if (!mTop.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            return NULL;
+        }
+
+        return node;
+    }
+
+private:
+    alignas(64) std::atomic<int64_t> mTop;
+    alignas(64) std::atomic<int64_t> mBottom;
+    alignas(64) std::atomic<TaskNode*> mBuffer[UT_WORK_DEQUE_SIZE];
+};
+
+/*
+ * @brief
+ * @class: WorkStealingThreadPool
+ *
+ * Tasks added from outside the pool go to a shared queue; tasks added by a
+ * worker, including ParallelFor chunks, go to its own deque and idle
+ * workers steal from the others. AddTask and AddTaskFuture keep the
+ * ThreadPool signatures; tasks are not dropped for queue time.
+ *
+ * Task nodes are recycled: workers keep a thread local cache and spill to
+ * a free list of the pool, which other threads allocate from under the
+ * shared queue lock. Once the caches are warm, submission does not touch
+ * the allocator.
+ */
+class WorkStealingThreadPool
+{
+public:
+    enum
+    {
+        MIN_THREAD_NUMBER = 1,
+        MAX_THREAD_NUMBER = 1000
+    };
+
+    explicit WorkStealingThreadPool(uint32_t threadNumber = 0, uint32_t queueMaxSize = UT_QUEUE_MAX_LEN,
+        const std::string& name = "ws_pool") :
+        mQuit(false), mQueueMaxSize(queueMaxSize), mPending(0), mSleeping(0), mHead(NULL), mTail(NULL),
+        mFreeHead(NULL), mFreeSize(0), mErrorCount(0)
+    {
+        if (threadNumber == 0)
+        {
+            threadNumber = std::max<uint32_t>(std::thread::hardware_concurrency(), MIN_THREAD_NUMBER);
+        }
+
+        mThreadNumber = std::min<uint32_t>(std::max<uint32_t>(threadNumber, MIN_THREAD_NUMBER), MAX_THREAD_NUMBER);
+
+        for (uint32_t i=0; i<mThreadNumber; i++)
+        {
+            mDeques.push_back(std::unique_ptr<WorkDeque>(new WorkDeque()));
+        }
+
+        for (uint32_t i=0; i<mThreadNumber; i++)
+        {
+            mThreadList.push_back(CreateThreadEx(name, UT_CPU_ID_NONE, &WorkStealingThreadPool::WorkerFunc, this, i));
+        }
+    }
+
+    ~WorkStealingThreadPool()
+    {
+        Quit();
+
+        while (mFreeHead != NULL)
+        {
+            TaskNode* node = mFreeHead;
+            mFreeHead = node->mNext;
+            delete node;
+        }
+    }
+
+    __UT_THREAD_DECL_TMPL_FUNC_ARG__
+    bool AddTask(__UT_THREAD_TMPL_FUNC_ARG__)
+    {
+        TaskNode* node = AllocNode();
+        if constexpr (sizeof...(Args) == 0)
+        {
+            node->mTask.Set(std::forward<Func>(func));
+        }
+        else
+        {
+            node->mTask.Set(std::bind(__UT_THREAD_BIND_FUNC_ARG__));
+        }
+
+        return Submit(node);
+    }
+
+    __UT_THREAD_DECL_TMPL_FUNC_ARG__
+    FuturePtr AddTaskFuture(__UT_THREAD_TMPL_FUNC_ARG__)
+    {
+        ThreadTaskFuturePtr taskPtr = ThreadTaskFuturePtr(new ThreadTaskFuture(__UT_THREAD_BIND_FUNC_ARG__));
+
+        if (AddTask([taskPtr]() { taskPtr->Execute(); }))
+        {
+            return taskPtr->GetFuture();
+        }
+
+        return FuturePtr();
+    }
+
+    /*
+     * Run func(i) for i in [begin, end) in chunks of grain, on the workers
+     * and the calling thread; returns when all are done. The first
+     * exception thrown by func is rethrown here.
+     */
+    template<typename Func>
+    void ParallelFor(int64_t begin, int64_t end, int64_t grain, Func&& func)
+    {
+        ParallelForRange(begin, end, grain, [&func](int64_t b, int64_t e)
+        {
+            for (int64_t i=b; i<e; i++)
+            {
+                func(i);
+            }
+        });
+    }
+
+    /*
+     * Run func(b, e) on subranges of [begin, end) no longer than grain.
+     */
+    template<typename Func>
+    void ParallelForRange(int64_t begin, int64_t end, int64_t grain, Func&& func)
+    {
+        if (begin >= end)
+        {
+            return;
+        }
+
+        grain = std::max<int64_t>(grain, 1);
+        int64_t chunks = (end - begin + grain - 1) / grain;
+
+        ParallelState state(chunks);
+
+        auto body = [&state, &func, begin, end, grain]()
+        {
+            int64_t chunk;
+            while ((chunk = state.mNext.fetch_add(1, std::memory_order_relaxed)) < state.mChunks)
+            {
+                int64_t b = begin + chunk * grain;
+                try
+                {
+                    func(b, std::min(b + grain, end));
+                }
+                catch (...)
+                {
+                    state.SetError(std::current_exception());
+                }
+            }
+        };
+
+        RunParallel(state, body);
+    }
+
+    /*
+     * Reduce [begin, end): map(b, e) gives the value of a subrange and
+     * combine folds them, in range order, starting from identity.
+     */
+    template<typename T, typename Map, typename Combine>
+    T ParallelReduce(int64_t begin, int64_t end, int64_t grain, T identity, Map&& map, Combine&& combine)
+    {
+        if (begin >= end)
+        {
+            return identity;
+        }
+
+        grain = std::max<int64_t>(grain, 1);
+        int64_t chunks = (end - begin + grain - 1) / grain;
+
+        /*
+         * one cache line per chunk: chunks written by different threads
+         * share neither a line nor, for bool, a std::vector<bool> word
+         */
+        struct alignas(64) Partial
+        {
+            T mValue;
+        };
+
+        std::vector<Partial> partial(chunks, Partial { identity });
+
+        ParallelForRange(0, chunks, 1, [&](int64_t b, int64_t e)
+        {
+            for (int64_t chunk=b; chunk<e; chunk++)
+            {
+                int64_t first = begin + chunk * grain;
+                partial[chunk].mValue = map(first, std::min(first + grain, end));
+            }
+        });
+
+        T result = identity;
+        for (const Partial& value : partial)
+        {
+            result = combine(result, value.mValue);
+        }
+
+        return result;
+    }
+
+    uint64_t GetTaskSize() const
+    {
+        return mPending.load(std::memory_order_relaxed);
+    }
+
+    uint32_t GetThreadNumber() const
+    {
+        return mThreadNumber;
+    }
+
+    /*
+     * tasks that ended with an exception
+     */
+    uint64_t GetErrorCount() const
+    {
+        return mErrorCount.load(std::memory_order_relaxed);
+    }
+
+    bool IsQuit() const
+    {
+        return mQuit;
+    }
+
+    /*
+     * stop the workers; tasks not started yet are discarded. A ParallelFor
+     * in progress runs its remaining chunks on the calling thread.
+     */
+    void Quit()
+    {
+        if (mQuit)
+        {
+            return;
+        }
+
+        mLock.Lock();
+        mQuit = true;
+        mLock.NotifyAll();
+        mLock.Unlock();
+
+        for (ThreadPtr& threadPtr : mThreadList)
+        {
+            threadPtr->Wait();
+        }
+        mThreadList.clear();
+
+        TaskNode* node;
+        while ((node = TakeTask(-1)) != NULL)
+        {
+            FreeNode(node);
+        }
+    }
+
+private:
+    struct ParallelState
+    {
+        explicit ParallelState(int64_t chunks) :
+            mChunks(chunks), mNext(0), mRunning(0)
+        {}
+
+        void SetError(std::exception_ptr error)
+        {
+            LockGuard<Mutex> guard(mErrorMutex);
+            if (!mError)
+            {
+                mError = error;
+            }
+        }
+
+        int64_t mChunks;
+        std::atomic<int64_t> mNext;
+        std::atomic<int32_t> mRunning;
+        Mutex mErrorMutex;
+        std::exception_ptr mError;
+    };
+
+    /*
+     * Held by a helper task; releases the caller when the task is destroyed,
+     * whether it ran or was discarded by Quit or a failed Submit.
+     */
+    struct ParallelHelper
+    {
+        explicit ParallelHelper(ParallelState* state) :
+            mState(state)
+        {}
+
+        ParallelHelper(ParallelHelper&& other) :
+            mState(other.mState)
+        {
+            other.mState = NULL;
+        }
+
+        ~ParallelHelper()
+        {
+            if (mState != NULL)
+            {
+                mState->mRunning.fetch_sub(1, std::memory_order_release);
+            }
+        }
+
+        ParallelState* mState;
+    };
+
+    template<typename Body>
+    void RunParallel(ParallelState& state, Body& body)
+    {
+        /*
+         * helpers take chunks from a shared counter, so a slow chunk does
+         * not hold back the rest; the caller works as one of them
+         */
+        int64_t helpers = std::min<int64_t>(state.mChunks - 1, mThreadNumber);
+        for (int64_t i=0; i<helpers; i++)
+        {
+            state.mRunning.fetch_add(1, std::memory_order_relaxed);
+
+            TaskNode* node = AllocNode();
+            node->mTask.Set([&body, helper = ParallelHelper(&state)]()
+            {
+                body();
+            });
+
+            if (!Submit(node))
+            {
+                break;
+            }
+        }
+
+        body();
+
+        /*
+         * helpers still queued or running refer to state; run other tasks
+         * meanwhile so nested parallel calls on workers cannot deadlock
+         */
+        int32_t spin = 0;
+        while (state.mRunning.load(std::memory_order_acquire) > 0)
+        {
+            if (RunOne(GetWorkerIndex()))
+            {
+                spin = 0;
+            }
+            else if (++spin > UT_WORK_SPIN_NUMBER)
+            {
+                sched_yield();
+            }
+        }
+
+        if (state.mError)
+        {
+            std::rethrow_exception(state.mError);
+        }
+    }
+
+    bool Submit(TaskNode* node)
+    {
+        if (mQuit || mPending.load(std::memory_order_relaxed) >= mQueueMaxSize)
+        {
+            FreeNode(node);
+            return false;
+        }
+
+        mPending.fetch_add(1, std::memory_order_seq_cst);
+
+        int32_t index = GetWorkerIndex();
+        if (index < 0 || !mDeques[index]->Push(node))
+        {
+            LockGuard<Mutex> guard(mQueueMutex);
+            if (mTail == NULL)
+            {
+                mHead = mTail = node;
+            }
+            else
+            {
+                mTail->mNext = node;
+                mTail = node;
+            }
+        }
+
+        /*
+         * pairs with the sleeper count taken before the idle check
+         */
+        if (mSleeping.load(std::memory_order_seq_cst) > 0)
+        {
+            mLock.Lock();
+            mLock.Notify();
+            mLock.Unlock();
+        }
+
+        return true;
+    }
+
+    TaskNode* TakeTask(int32_t index)
+    {
+        TaskNode* node = NULL;
+
+        if (index >= 0)
+        {
+            node = mDeques[index]->Pop();
+        }
+
+        if (node == NULL)
+        {
+            LockGuard<Mutex> guard(mQueueMutex);
+            node = mHead;
+            if (node != NULL)
+            {
+                mHead = node->mNext;
+                if (mHead == NULL)
+                {
+                    mTail = NULL;
+                }
+            }
+        }
+
+        for (uint32_t i=1; node == NULL && i<=mThreadNumber; i++)
+        {
+            int32_t victim = (int32_t)((index + i) % mThreadNumber);
+            if (victim != index)
+            {
+                node = mDeques[victim]->Steal();
+            }
+        }
+
+        if (node != NULL)
+        {
+            mPending.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        return node;
+    }
+
+    bool RunOne(int32_t index)
+    {
+        TaskNode* node = TakeTask(index);
+        if (node == NULL)
+        {
+            return false;
+        }
+
+        try
+        {
+            node->mTask.Run();
+        }
+        catch (...)
+        {
+            mErrorCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        FreeNode(node);
+
+        return true;
+    }
+
+    TaskNode* AllocNode()
+    {
+        TaskNode* node = NULL;
+
+        if (GetWorkerIndex() >= 0)
+        {
+            node = TaskNode::TakeCached();
+        }
+
+        if (node == NULL)
+        {
+            LockGuard<Mutex> guard(mQueueMutex);
+            node = mFreeHead;
+            if (node != NULL)
+            {
+                mFreeHead = node->mNext;
+                node->mNext = NULL;
+                mFreeSize--;
+            }
+        }
+
+        return node != NULL ? node : new TaskNode();
+    }
+
+    void FreeNode(TaskNode* node)
+    {
+        node->mTask.Reset();
+        node->mNext = NULL;
+
+        if (GetWorkerIndex() >= 0 && TaskNode::PutCached(node))
+        {
+            return;
+        }
+
+        {
+            LockGuard<Mutex> guard(mQueueMutex);
+            if (mFreeSize < UT_TASK_NODE_CACHE_SIZE)
+            {
+                node->mNext = mFreeHead;
+                mFreeHead = node;
+                mFreeSize++;
+                return;
+            }
+        }
+
+        delete node;
+    }
+
+    int32_t WorkerFunc(uint32_t index)
+    {
+        GetWorker() = WorkerId { this, (int32_t)index };
+
+        int32_t spin = 0;
+        while (!mQuit)
+        {
+            if (RunOne(index))
+            {
+                spin = 0;
+                continue;
+            }
+
+            if (++spin < UT_WORK_SPIN_NUMBER)
+            {
+                sched_yield();
+                continue;
+            }
+
+            spin = 0;
+
+            mLock.Lock();
+            mSleeping.fetch_add(1, std::memory_order_seq_cst);
+            if (!mQuit && mPending.load(std::memory_order_seq_cst) == 0)
+            {
+                mLock.Wait(UT_WORK_IDLE_WAIT_MICROSEC);
+            }
+            mSleeping.fetch_sub(1, std::memory_order_relaxed);
+            mLock.Unlock();
+        }
+
+        GetWorker() = WorkerId { NULL, -1 };
+
+        return 0;
+    }
+
+    struct WorkerId
+    {
+        WorkStealingThreadPool* mPool;
+        int32_t mIndex;
+    };
+
+    static WorkerId& GetWorker()
+    {
+        static thread_local WorkerId worker = { NULL, -1 };
+        return worker;
+    }
+
+    /*
+     * deque index of the calling thread, -1 if it is not a worker of this pool
+     */
+    int32_t GetWorkerIndex()
+    {
+        const WorkerId& worker = GetWorker();
+        return worker.mPool == this ? worker.mIndex : -1;
+    }
+
+private:
+    volatile bool mQuit;
+    uint32_t mThreadNumber;
+    uint64_t mQueueMaxSize;
+
+    std::atomic<uint64_t> mPending;
+    std::atomic<int32_t> mSleeping;
+    MutexCond mLock;
+
+    Mutex mQueueMutex;
+    TaskNode* mHead;
+    TaskNode* mTail;
+    TaskNode* mFreeHead;
+    uint32_t mFreeSize;
+
+    std::vector<std::unique_ptr<WorkDeque>> mDeques;
+    std::vector<ThreadPtr> mThreadList;
+    std::atomic<uint64_t> mErrorCount;
+};
+
+typedef std::shared_ptr<WorkStealingThreadPool> WorkStealingThreadPoolPtr;
+
+}
+}
+
+#endif//__UT_WORK_STEALING_POOL_HPP__
@@ -0,0 +1,353 @@
+#ifndef __UT_FAST_CLOCK_HPP__
+#define __UT_FAST_CLOCK_HPP__
+
+#include <unitree/common/time/time_tool.hpp>
+#include <unitree/common/lock/lock.hpp>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+
+/*
+ * tsc calibration window(micro second)
+ */
+#define UT_TSC_CALIBRATE_MICROSEC       20000
+#define UT_TSC_CALIBRATE_ROUND          16
+
+/*
+ * "YEAR-MON-DAY HOUR:MIN:SEC.MILLI" plus terminator
+ */
+#define UT_TIMESTAMP_BUFFER_SIZE        32
+
+namespace unitree
+{
+namespace common
+{
+/*
+ * header inline clock reads. clock_gettime is served by the vdso on
+ * linux, these only save the call into the sdk library.
+ */
+inline uint64_t GetFastMonotonicTimeNanosecond()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * UT_NUMER_NANO + ts.tv_nsec;
+}
+
+inline uint64_t GetFastMonotonicTimeMicrosecond()
+{
+    return GetFastMonotonicTimeNanosecond() / UT_NUMER_MILLI;
+}
+
+inline uint64_t GetFastTimeNanosecond()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (uint64_t)ts.tv_sec * UT_NUMER_NANO + ts.tv_nsec;
+}
+
+inline uint64_t GetFastTimeMicrosecond()
+{
+    return GetFastTimeNanosecond() / UT_NUMER_MILLI;
+}
+
+/*
+ * @brief
+ * @class: TscClock
+ *
+ * CLOCK_MONOTONIC nanoseconds computed from the cpu cycle counter (rdtsc
+ * on x86, cntvct_el0 on aarch64) without entering the vdso. Usable only
+ * when the counter runs at a constant rate and is synchronized across
+ * cores (invariant tsc); until Calibrate succeeds GetNanosecond falls
+ * back to clock_gettime.
+ *
+ * Calibrate may run while other threads read the clock: the conversion
+ * parameters are published under a sequence lock, so a reader either sees
+ * a whole calibration or retries. The counter is not corrected for ntp
+ * slew, so over hours it drifts from CLOCK_MONOTONIC by the crystal error;
+ * calibrate again when that matters.
+ */
+class TscClock
+{
+public:
+    static TscClock* Instance()
+    {
+        static TscClock inst;
+        return &inst;
+    }
+
+    static uint64_t ReadCounter()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#elif defined(__aarch64__)
+        uint64_t counter;
+        __asm__ __volatile__("isb; mrs %0, cntvct_el0" : "=r"(counter) :: "memory");
+        return counter;
+#else
+        return 0;
+#endif
+    }
+
+    /*
+     * constant rate and core synchronized counter
+     */
+    static bool HasInvariantCounter()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        uint32_t eax = 0, ebx = 0, ecx = 0, edx = 0;
+        if (!__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) || eax < 0x80000007)
+        {
+            return false;
+        }
+
+        __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+        return (edx & (1 << 8)) != 0;
+#elif defined(__aarch64__)
+        //the generic timer is architecturally constant rate
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /*
+     * measure the counter against CLOCK_MONOTONIC over microsec and enable
+     * the counter path. returns false, leaving the fallback in place, when
+     * the counter is not invariant or the measured rate is implausible.
+     */
+    bool Calibrate(uint64_t microsec = UT_TSC_CALIBRATE_MICROSEC)
+    {
+        LockGuard<Mutex> lock(mMutex);
+
+        Publish(0, 0, 0, 0);
+
+        if (!HasInvariantCounter())
+        {
+            return false;
+        }
+
+        uint64_t counter0 = 0, nanosec0 = 0;
+        uint64_t counter1 = 0, nanosec1 = 0;
+
+        Sample(counter0, nanosec0);
+        usleep(microsec);
+        Sample(counter1, nanosec1);
+
+        if (counter1 <= counter0 || nanosec1 <= nanosec0)
+        {
+            return false;
+        }
+
+        uint64_t counterDelta = counter1 - counter0;
+        uint64_t nanosecDelta = nanosec1 - nanosec0;
+
+        //below 1MHz the clock would be coarser than the vdso one
+        uint64_t frequency = (uint64_t)((unsigned __int128)counterDelta * UT_NUMER_NANO / nanosecDelta);
+        if (frequency < UT_NUMER_MICRO)
+        {
+            return false;
+        }
+
+        uint64_t mult = (uint64_t)(((unsigned __int128)nanosecDelta << 32) / counterDelta);
+        Publish(mult, counter1, nanosec1, frequency);
+
+        return true;
+    }
+
+    bool IsEnabled() const
+    {
+        return mMult.load(std::memory_order_relaxed) != 0;
+    }
+
+    /*
+     * counter ticks per second, 0 if not calibrated
+     */
+    uint64_t GetFrequency() const
+    {
+        return mFrequency.load(std::memory_order_relaxed);
+    }
+
+    uint64_t GetNanosecond() const
+    {
+        uint32_t sequence;
+        uint64_t mult, baseCounter, baseNanosecond;
+
+        do
+        {
+            sequence = mSequence.load(std::memory_order_acquire);
+            mult = mMult.load(std::memory_order_relaxed);
+            baseCounter = mBaseCounter.load(std::memory_order_relaxed);
+            baseNanosecond = mBaseNanosecond.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        while (UT_UNLIKELY((sequence & 1) != 0 || mSequence.load(std::memory_order_relaxed) != sequence));
+
+        if (UT_UNLIKELY(mult == 0))
+        {
+            return GetFastMonotonicTimeNanosecond();
+        }
+
+        //another core may read a counter a few ticks behind the base
+        int64_t delta = (int64_t)(ReadCounter() - baseCounter);
+        if (UT_UNLIKELY(delta < 0))
+        {
+            return baseNanosecond - (uint64_t)(((unsigned __int128)(-delta) * mult) >> 32);
+        }
+
+        return baseNanosecond + (uint64_t)(((unsigned __int128)delta * mult) >> 32);
+    }
+
+    uint64_t GetMicrosecond() const
+    {
+        return GetNanosecond() / UT_NUMER_MILLI;
+    }
+
+private:
+    TscClock() :
+        mSequence(0), mMult(0), mBaseCounter(0), mBaseNanosecond(0), mFrequency(0)
+    {}
+
+    /*
+     * sequence lock writer, under mMutex. mult 0 disables the counter path.
+     */
+    void Publish(uint64_t mult, uint64_t baseCounter, uint64_t baseNanosecond, uint64_t frequency)
+    {
+        uint32_t sequence = mSequence.load(std::memory_order_relaxed);
+        mSequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        mMult.store(mult, std::memory_order_relaxed);
+        mBaseCounter.store(baseCounter, std::memory_order_relaxed);
+        mBaseNanosecond.store(baseNanosecond, std::memory_order_relaxed);
+        mFrequency.store(frequency, std::memory_order_relaxed);
+
+        mSequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    /*
+     * CLOCK_MONOTONIC paired with the counter read in the middle of the
+     * narrowest of a few windows, to keep preemption out of the sample
+     */
+    static void Sample(uint64_t& counter, uint64_t& nanosec)
+    {
+        uint64_t window = UINT64_MAX;
+
+        for (int32_t i=0; i<UT_TSC_CALIBRATE_ROUND; i++)
+        {
+            uint64_t before = ReadCounter();
+            uint64_t now = GetFastMonotonicTimeNanosecond();
+            uint64_t after = ReadCounter();
+
+            if (after - before < window)
+            {
+                window = after - before;
+                counter = before + window / 2;
+                nanosec = now;
+            }
+        }
+    }
+
+private:
+    Mutex mMutex;
+    std::atomic<uint32_t> mSequence;
+    std::atomic<uint64_t> mMult;
+    std::atomic<uint64_t> mBaseCounter;
+    std::atomic<uint64_t> mBaseNanosecond;
+    std::atomic<uint64_t> mFrequency;
+};
+
+inline uint64_t GetTscMonotonicTimeNanosecond()
+{
+    return TscClock::Instance()->GetNanosecond();
+}
+
+inline uint64_t GetTscMonotonicTimeMicrosecond()
+{
+    return TscClock::Instance()->GetMicrosecond();
+}
+
+/*
+ * @brief
+ * @class: TimestampCache
+ *
+ * Local time formatted as UT_TIME_MILLISEC_FORMAT_STR. The date and time
+ * of day are formatted with localtime_r once per second, the milliseconds
+ * patched in once per millisecond; any other call is one clock read.
+ * Times passed in should be close to increasing, as from one log stream.
+ * Not thread safe, use GetCachedTimeMillisecondString for a per-thread
+ * instance.
+ */
+class TimestampCache
+{
+public:
+    TimestampCache() :
+        mSecond(-1), mMillisecond(UINT64_MAX), mLength(0)
+    {
+        mBuffer[0] = 0;
+    }
+
+    const char* GetMillisecondString()
+    {
+        return GetMillisecondString(GetFastTimeNanosecond());
+    }
+
+    /*
+     * nanosec: CLOCK_REALTIME nanoseconds
+     */
+    const char* GetMillisecondString(uint64_t nanosec)
+    {
+        uint64_t millisec = nanosec / UT_NUMER_MICRO;
+        if (UT_LIKELY(millisec == mMillisecond))
+        {
+            return mBuffer;
+        }
+
+        time_t sec = (time_t)(nanosec / UT_NUMER_NANO);
+        if (sec != mSecond)
+        {
+            struct tm tmv;
+            localtime_r(&sec, &tmv);
+
+            int32_t len = snprintf(mBuffer, UT_TIMESTAMP_BUFFER_SIZE, UT_TIME_FORMAT_STR,
+                tmv.tm_year + 1900, tmv.tm_mon + 1, tmv.tm_mday, tmv.tm_hour, tmv.tm_min, tmv.tm_sec);
+
+            //".mmm" and the terminator must fit behind the seconds
+            mLength = (len > 0 && len < UT_TIMESTAMP_BUFFER_SIZE - 4) ? len : 0;
+            mSecond = sec;
+        }
+
+        int32_t milli = (int32_t)(millisec % UT_NUMER_MILLI);
+        mBuffer[mLength] = '.';
+        mBuffer[mLength + 1] = (char)('0' + milli / 100);
+        mBuffer[mLength + 2] = (char)('0' + milli / 10 % 10);
+        mBuffer[mLength + 3] = (char)('0' + milli % 10);
+        mBuffer[mLength + 4] = 0;
+
+        mMillisecond = millisec;
+
+        return mBuffer;
+    }
+
+private:
+    time_t mSecond;
+    uint64_t mMillisecond;
+    int32_t mLength;
+    char mBuffer[UT_TIMESTAMP_BUFFER_SIZE];
+};
+
+/*
+ * same text as GetTimeMillisecondString, valid until the calling thread
+ * asks again
+ */
+inline const char* GetCachedTimeMillisecondString()
+{
+    static thread_local TimestampCache cache;
+    return cache.GetMillisecondString();
+}
+
+}
+}
+
+#endif//__UT_FAST_CLOCK_HPP__
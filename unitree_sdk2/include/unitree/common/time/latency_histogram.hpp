@@ -0,0 +1,172 @@
+#ifndef __UT_LATENCY_HISTOGRAM_HPP__
+#define __UT_LATENCY_HISTOGRAM_HPP__
+
+#include <unitree/common/decl.hpp>
+#include <algorithm>
+#include <vector>
+
+/*
+ * latency histogram: 8 sub buckets per power of two nanoseconds,
+ * about 12% resolution up to 2^40ns
+ */
+#define UT_LATENCY_SUB_BUCKET_BITS      3
+#define UT_LATENCY_SUB_BUCKET_NUMBER    (1 << UT_LATENCY_SUB_BUCKET_BITS)
+#define UT_LATENCY_MAX_BITS             40
+#define UT_LATENCY_BUCKET_NUMBER        ((UT_LATENCY_MAX_BITS + 1) * UT_LATENCY_SUB_BUCKET_NUMBER)
+
+namespace unitree
+{
+namespace common
+{
+/*
+ * @brief
+ * @class: LatencyHistogram
+ *
+ * Updated with relaxed atomics from any number of threads and read at any
+ * time; a concurrent snapshot may be off by the samples in flight.
+ */
+class LatencyHistogram
+{
+public:
+    LatencyHistogram()
+    {
+        Reset();
+    }
+
+    void Add(uint64_t nanosec)
+    {
+        mBuckets[GetBucket(nanosec)].fetch_add(1, std::memory_order_relaxed);
+        mCount.fetch_add(1, std::memory_order_relaxed);
+        mSum.fetch_add(nanosec, std::memory_order_relaxed);
+
+        uint64_t min = mMin.load(std::memory_order_relaxed);
+        while (nanosec < min && !mMin.compare_exchange_weak(min, nanosec, std::memory_order_relaxed))
+        {}
+
+        uint64_t max = mMax.load(std::memory_order_relaxed);
+        while (nanosec > max && !mMax.compare_exchange_weak(max, nanosec, std::memory_order_relaxed))
+        {}
+    }
+
+    void Reset()
+    {
+        for (int32_t i=0; i<UT_LATENCY_BUCKET_NUMBER; i++)
+        {
+            mBuckets[i].store(0, std::memory_order_relaxed);
+        }
+
+        mCount.store(0, std::memory_order_relaxed);
+        mSum.store(0, std::memory_order_relaxed);
+        mMin.store(UINT64_MAX, std::memory_order_relaxed);
+        mMax.store(0, std::memory_order_relaxed);
+    }
+
+    uint64_t GetCount() const
+    {
+        return mCount.load(std::memory_order_relaxed);
+    }
+
+    uint64_t GetMin() const
+    {
+        return GetCount() ? mMin.load(std::memory_order_relaxed) : 0;
+    }
+
+    uint64_t GetMax() const
+    {
+        return mMax.load(std::memory_order_relaxed);
+    }
+
+    uint64_t GetMean() const
+    {
+        uint64_t count = GetCount();
+        return count ? mSum.load(std::memory_order_relaxed) / count : 0;
+    }
+
+    /*
+     * upper bound of the bucket holding the given fraction (0.99 = p99)
+     */
+    uint64_t GetPercentile(double fraction) const
+    {
+        uint64_t count = GetCount();
+        if (count == 0)
+        {
+            return 0;
+        }
+
+        uint64_t rank = (uint64_t)(fraction * count);
+        uint64_t seen = 0;
+
+        for (int32_t i=0; i<UT_LATENCY_BUCKET_NUMBER; i++)
+        {
+            seen += mBuckets[i].load(std::memory_order_relaxed);
+            if (seen > rank)
+            {
+                return std::min(GetBucketLimit(i), GetMax());
+            }
+        }
+
+        return GetMax();
+    }
+
+    /*
+     * non empty buckets as (upper bound ns, count)
+     */
+    std::vector<std::pair<uint64_t,uint64_t>> GetBuckets() const
+    {
+        std::vector<std::pair<uint64_t,uint64_t>> buckets;
+        for (int32_t i=0; i<UT_LATENCY_BUCKET_NUMBER; i++)
+        {
+            uint64_t n = mBuckets[i].load(std::memory_order_relaxed);
+            if (n > 0)
+            {
+                buckets.push_back(std::make_pair(GetBucketLimit(i), n));
+            }
+        }
+
+        return buckets;
+    }
+
+private:
+    static int32_t GetBucket(uint64_t v)
+    {
+        if (v < UT_LATENCY_SUB_BUCKET_NUMBER)
+        {
+            return (int32_t)v;
+        }
+
+        int32_t msb = 63 - __builtin_clzll(v);
+        if (msb > UT_LATENCY_MAX_BITS)
+        {
+            return UT_LATENCY_BUCKET_NUMBER - 1;
+        }
+
+        int32_t sub = (int32_t)((v >> (msb - UT_LATENCY_SUB_BUCKET_BITS)) & (UT_LATENCY_SUB_BUCKET_NUMBER - 1));
+        return (msb - UT_LATENCY_SUB_BUCKET_BITS + 1) * UT_LATENCY_SUB_BUCKET_NUMBER + sub;
+    }
+
+    static uint64_t GetBucketLimit(int32_t bucket)
+    {
+        if (bucket < UT_LATENCY_SUB_BUCKET_NUMBER)
+        {
+            return (uint64_t)bucket;
+        }
+
+        int32_t msb = bucket / UT_LATENCY_SUB_BUCKET_NUMBER + UT_LATENCY_SUB_BUCKET_BITS - 1;
+        uint64_t sub = bucket % UT_LATENCY_SUB_BUCKET_NUMBER;
+        uint64_t step = 1ULL << (msb - UT_LATENCY_SUB_BUCKET_BITS);
+
+        return (1ULL << msb) + (sub + 1) * step - 1;
+    }
+
+private:
+    std::atomic<uint64_t> mBuckets[UT_LATENCY_BUCKET_NUMBER];
+    std::atomic<uint64_t> mCount;
+    std::atomic<uint64_t> mSum;
+    std::atomic<uint64_t> mMin;
+    std::atomic<uint64_t> mMax;
+};
+
+}
+}
+
+#endif//__UT_LATENCY_HISTOGRAM_HPP__
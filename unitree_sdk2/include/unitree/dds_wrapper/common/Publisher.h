@@ -4,6 +4,7 @@
 #pragma once
 
 #include <unitree/robot/channel/channel_publisher.hpp>
+#include <unitree/common/lock/rt_lock.hpp>
 #include <atomic>
 #include <thread>
 #include <memory>
@@ -165,7 +166,7 @@ private:
   std::atomic_bool is_running_;
   std::atomic_bool keep_running_;
 
-  std::mutex mutex_;
+  unitree::common::PiMutex mutex_;
 
   std::thread thread_;
 
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <unitree/robot/channel/channel_subscriber.hpp>
+#include <unitree/common/lock/rt_lock.hpp>
 #include <mutex>
 #include <thread>
 #include <spdlog/spdlog.h>
@@ -25,6 +26,9 @@ class SubscriptionBase
 public:
   using MsgType = MessageType;
   using SharedPtr = std::shared_ptr<SubscriptionBase<MsgType>>;
+  // priority inheritance: the dds thread holding it is boosted while a
+  // realtime control thread waits to read msg_
+  using MutexType = unitree::common::PiMutex;
 
   SubscriptionBase(const std::string& topic, const std::function<void(const void*)>& handler = nullptr)
   {
@@ -35,7 +39,7 @@ public:
     } else {
       sub_->InitChannel([this](const void *msg){
         last_update_time_ = std::chrono::steady_clock::now();
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<MutexType> lock(mutex_);
         pre_communication();
         msg_ = *(const MessageType*)msg;
         post_communication();
@@ -68,7 +72,7 @@ public:
   }
 
   MessageType msg_;
-  std::mutex mutex_;
+  MutexType mutex_;
 
 protected:
   virtual void pre_communication() {}  // something before receiving message
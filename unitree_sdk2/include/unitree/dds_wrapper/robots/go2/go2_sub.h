@@ -42,7 +42,7 @@ public:
 
   void update()
   {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<MutexType> lock(mutex_);
     // ********** Joystick ********** //
     // Check if all joystick values are zero to determine if the joystick is inactive
     if(std::all_of(msg_.wireless_remote().begin(), msg_.wireless_remote().end(), [](uint8_t i){return i == 0;}))
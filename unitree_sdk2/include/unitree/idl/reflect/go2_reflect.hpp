@@ -0,0 +1,1483 @@
+/*
+ * Generated by tools/idl_reflect.py from include/unitree/idl/go2. Do not edit.
+ */
+#ifndef __UT_IDL_REFLECT_GO2_HPP__
+#define __UT_IDL_REFLECT_GO2_HPP__
+
+#include <unitree/common/reflect/reflect.hpp>
+#include <unitree/idl/go2/AudioData_.hpp>
+#include <unitree/idl/go2/BmsCmd_.hpp>
+#include <unitree/idl/go2/BmsState_.hpp>
+#include <unitree/idl/go2/ConfigChangeStatus_.hpp>
+#include <unitree/idl/go2/Error_.hpp>
+#include <unitree/idl/go2/Go2FrontVideoData_.hpp>
+#include <unitree/idl/go2/HeightMap_.hpp>
+#include <unitree/idl/go2/IMUState_.hpp>
+#include <unitree/idl/go2/InterfaceConfig_.hpp>
+#include <unitree/idl/go2/LidarState_.hpp>
+#include <unitree/idl/go2/LowCmd_.hpp>
+#include <unitree/idl/go2/LowState_.hpp>
+#include <unitree/idl/go2/MotorCmd_.hpp>
+#include <unitree/idl/go2/MotorCmds_.hpp>
+#include <unitree/idl/go2/MotorState_.hpp>
+#include <unitree/idl/go2/MotorStates_.hpp>
+#include <unitree/idl/go2/PathPoint_.hpp>
+#include <unitree/idl/go2/Req_.hpp>
+#include <unitree/idl/go2/Res_.hpp>
+#include <unitree/idl/go2/SportModeCmd_.hpp>
+#include <unitree/idl/go2/SportModeState_.hpp>
+#include <unitree/idl/go2/TimeSpec_.hpp>
+#include <unitree/idl/go2/UwbState_.hpp>
+#include <unitree/idl/go2/UwbSwitch_.hpp>
+#include <unitree/idl/go2/VoxelMapCompressed_.hpp>
+#include <unitree/idl/go2/WirelessController_.hpp>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winvalid-offsetof"
+
+namespace unitree
+{
+namespace common
+{
+template<>
+struct TypeReflection<::unitree_go::msg::dds_::AudioData_>
+{
+    struct Layout
+    {
+        uint64_t time_frame_;
+        std::vector<uint8_t> data_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, time_frame_, "time_frame"),
+        UT_REFLECT_FIELD(Layout, data_, "data"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_go::msg::dds_::AudioData_", sizeof(::unitree_go::msg::dds_::AudioData_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_go::msg::dds_::AudioData_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, time_frame_, time_frame) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, data_, data);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_go::msg::dds_::AudioData_>::Layout) == sizeof(::unitree_go::msg::dds_::AudioData_),
+    "layout of unitree_go::msg::dds_::AudioData_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_go::msg::dds_::BmsCmd_>
+{
+    struct Layout
+    {
+        uint8_t off_;
+        std::array<uint8_t, 3> reserve_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, off_, "off"),
+        UT_REFLECT_FIELD(Layout, reserve_, "reserve"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_go::msg::dds_::BmsCmd_", sizeof(::unitree_go::msg::dds_::BmsCmd_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_go::msg::dds_::BmsCmd_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, off_, off) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, reserve_, reserve);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_go::msg::dds_::BmsCmd_>::Layout) == sizeof(::unitree_go::msg::dds_::BmsCmd_),
+    "layout of unitree_go::msg::dds_::BmsCmd_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_go::msg::dds_::BmsState_>
+{
+    struct Layout
+    {
+        uint8_t version_high_;
+        uint8_t version_low_;
+        uint8_t status_;
+        uint8_t soc_;
+        int32_t current_;
+        uint16_t cycle_;
+        std::array<uint8_t, 2> bq_ntc_;
+        std::array<uint8_t, 2> mcu_ntc_;
+        std::array<uint16_t, 15> cell_vol_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, version_high_, "version_high"),
+        UT_REFLECT_FIELD(Layout, version_low_, "version_low"),
+        UT_REFLECT_FIELD(Layout, status_, "status"),
+        UT_REFLECT_FIELD(Layout, soc_, "soc"),
+        UT_REFLECT_FIELD(Layout, current_, "current"),
+        UT_REFLECT_FIELD(Layout, cycle_, "cycle"),
+        UT_REFLECT_FIELD(Layout, bq_ntc_, "bq_ntc"),
+        UT_REFLECT_FIELD(Layout, mcu_ntc_, "mcu_ntc"),
+        UT_REFLECT_FIELD(Layout, cell_vol_, "cell_vol"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_go::msg::dds_::BmsState_", sizeof(::unitree_go::msg::dds_::BmsState_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_go::msg::dds_::BmsState_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, version_high_, version_high) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, version_low_, version_low) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, status_, status) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, soc_, soc) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, current_, current) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, cycle_, cycle) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, bq_ntc_, bq_ntc) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, mcu_ntc_, mcu_ntc) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, cell_vol_, cell_vol);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_go::msg::dds_::BmsState_>::Layout) == sizeof(::unitree_go::msg::dds_::BmsState_),
+    "layout of unitree_go::msg::dds_::BmsState_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_go::msg::dds_::ConfigChangeStatus_>
+{
+    struct Layout
+    {
+        std::string name_;
+        std::string content_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, name_, "name"),
+        UT_REFLECT_FIELD(Layout, content_, "content"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_go::msg::dds_::ConfigChangeStatus_", sizeof(::unitree_go::msg::dds_::ConfigChangeStatus_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_go::msg::dds_::ConfigChangeStatus_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, name_, name) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, content_, content);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_go::msg::dds_::ConfigChangeStatus_>::Layout) == sizeof(::unitree_go::msg::dds_::ConfigChangeStatus_),
+    "layout of unitree_go::msg::dds_::ConfigChangeStatus_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_go::msg::dds_::Error_>
+{
+    struct Layout
+    {
+        uint32_t source_;
+        uint32_t state_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, source_, "source"),
+        UT_REFLECT_FIELD(Layout, state_, "state"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_go::msg::dds_::Error_", sizeof(::unitree_go::msg::dds_::Error_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_go::msg::dds_::Error_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, source_, source) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, state_, state);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_go::msg::dds_::Error_>::Layout) == sizeof(::unitree_go::msg::dds_::Error_),
+    "layout of unitree_go::msg::dds_::Error_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_go::msg::dds_::Go2FrontVideoData_>
+{
+    struct Layout
+    {
+        uint64_t time_frame_;
+        std::vector<uint8_t> video720p_;
+        std::vector<uint8_t> video360p_;
+        std::vector<uint8_t> video180p_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, time_frame_, "time_frame"),
+        UT_REFLECT_FIELD(Layout, video720p_, "video720p"),
+        UT_REFLECT_FIELD(Layout, video360p_, "video360p"),
+        UT_REFLECT_FIELD(Layout, video180p_, "video180p"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_go::msg::dds_::Go2FrontVideoData_", sizeof(::unitree_go::msg::dds_::Go2FrontVideoData_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_go::msg::dds_::Go2FrontVideoData_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, time_frame_, time_frame) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, video720p_, video720p) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, video360p_, video360p) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, video180p_, video180p);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_go::msg::dds_::Go2FrontVideoData_>::Layout) == sizeof(::unitree_go::msg::dds_::Go2FrontVideoData_),
+    "layout of unitree_go::msg::dds_::Go2FrontVideoData_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_go::msg::dds_::HeightMap_>
+{
+    struct Layout
+    {
+        double stamp_;
+        std::string frame_id_;
+        float resolution_;
+        uint32_t width_;
+        uint32_t height_;
+        std::array<float, 2> origin_;
+        std::vector<float> data_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, stamp_, "stamp"),
+        UT_REFLECT_FIELD(Layout, frame_id_, "frame_id"),
+        UT_REFLECT_FIELD(Layout, resolution_, "resolution"),
+        UT_REFLECT_FIELD(Layout, width_, "width"),
+        UT_REFLECT_FIELD(Layout, height_, "height"),
+        UT_REFLECT_FIELD(Layout, origin_, "origin"),
+        UT_REFLECT_FIELD(Layout, data_, "data"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_go::msg::dds_::HeightMap_", sizeof(::unitree_go::msg::dds_::HeightMap_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_go::msg::dds_::HeightMap_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, stamp_, stamp) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, frame_id_, frame_id) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, resolution_, resolution) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, width_, width) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, height_, height) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, origin_, origin) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, data_, data);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_go::msg::dds_::HeightMap_>::Layout) == sizeof(::unitree_go::msg::dds_::HeightMap_),
+    "layout of unitree_go::msg::dds_::HeightMap_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_go::msg::dds_::IMUState_>
+{
+    struct Layout
+    {
+        std::array<float, 4> quaternion_;
+        std::array<float, 3> gyroscope_;
+        std::array<float, 3> accelerometer_;
+        std::array<float, 3> rpy_;
+        uint8_t temperature_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, quaternion_, "quaternion"),
+        UT_REFLECT_FIELD(Layout, gyroscope_, "gyroscope"),
+        UT_REFLECT_FIELD(Layout, accelerometer_, "accelerometer"),
+        UT_REFLECT_FIELD(Layout, rpy_, "rpy"),
+        UT_REFLECT_FIELD(Layout, temperature_, "temperature"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_go::msg::dds_::IMUState_", sizeof(::unitree_go::msg::dds_::IMUState_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_go::msg::dds_::IMUState_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, quaternion_, quaternion) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, gyroscope_, gyroscope) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, accelerometer_, accelerometer) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, rpy_, rpy) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, temperature_, temperature);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_go::msg::dds_::IMUState_>::Layout) == sizeof(::unitree_go::msg::dds_::IMUState_),
+    "layout of unitree_go::msg::dds_::IMUState_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_go::msg::dds_::InterfaceConfig_>
+{
+    struct Layout
+    {
+        uint8_t mode_;
+        uint8_t value_;
+        std::array<uint8_t, 2> reserve_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, mode_, "mode"),
+        UT_REFLECT_FIELD(Layout, value_, "value"),
+        UT_REFLECT_FIELD(Layout, reserve_, "reserve"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_go::msg::dds_::InterfaceConfig_", sizeof(::unitree_go::msg::dds_::InterfaceConfig_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_go::msg::dds_::InterfaceConfig_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, mode_, mode) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, value_, value) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, reserve_, reserve);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_go::msg::dds_::InterfaceConfig_>::Layout) == sizeof(::unitree_go::msg::dds_::InterfaceConfig_),
+    "layout of unitree_go::msg::dds_::InterfaceConfig_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_go::msg::dds_::LidarState_>
+{
+    struct Layout
+    {
+        double stamp_;
+        std::string firmware_version_;
+        std::string software_version_;
+        std::string sdk_version_;
+        float sys_rotation_speed_;
+        float com_rotation_speed_;
+        uint8_t error_state_;
+        uint8_t dirty_percentage_;
+        float cloud_frequency_;
+        float cloud_packet_loss_rate_;
+        uint32_t cloud_size_;
+        uint32_t cloud_scan_num_;
+        float imu_frequency_;
+        float imu_packet_loss_rate_;
+        std::array<float, 3> imu_rpy_;
+        double serial_recv_stamp_;
+        uint32_t serial_buffer_size_;
+        uint32_t serial_buffer_read_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, stamp_, "stamp"),
+        UT_REFLECT_FIELD(Layout, firmware_version_, "firmware_version"),
+        UT_REFLECT_FIELD(Layout, software_version_, "software_version"),
+        UT_REFLECT_FIELD(Layout, sdk_version_, "sdk_version"),
+        UT_REFLECT_FIELD(Layout, sys_rotation_speed_, "sys_rotation_speed"),
+        UT_REFLECT_FIELD(Layout, com_rotation_speed_, "com_rotation_speed"),
+        UT_REFLECT_FIELD(Layout, error_state_, "error_state"),
+        UT_REFLECT_FIELD(Layout, dirty_percentage_, "dirty_percentage"),
+        UT_REFLECT_FIELD(Layout, cloud_frequency_, "cloud_frequency"),
+        UT_REFLECT_FIELD(Layout, cloud_packet_loss_rate_, "cloud_packet_loss_rate"),
+        UT_REFLECT_FIELD(Layout, cloud_size_, "cloud_size"),
+        UT_REFLECT_FIELD(Layout, cloud_scan_num_, "cloud_scan_num"),
+        UT_REFLECT_FIELD(Layout, imu_frequency_, "imu_frequency"),
+        UT_REFLECT_FIELD(Layout, imu_packet_loss_rate_, "imu_packet_loss_rate"),
+        UT_REFLECT_FIELD(Layout, imu_rpy_, "imu_rpy"),
+        UT_REFLECT_FIELD(Layout, serial_recv_stamp_, "serial_recv_stamp"),
+        UT_REFLECT_FIELD(Layout, serial_buffer_size_, "serial_buffer_size"),
+        UT_REFLECT_FIELD(Layout, serial_buffer_read_, "serial_buffer_read"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_go::msg::dds_::LidarState_", sizeof(::unitree_go::msg::dds_::LidarState_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_go::msg::dds_::LidarState_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, stamp_, stamp) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, firmware_version_, firmware_version) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, software_version_, software_version) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, sdk_version_, sdk_version) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, sys_rotation_speed_, sys_rotation_speed) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, com_rotation_speed_, com_rotation_speed) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, error_state_, error_state) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, dirty_percentage_, dirty_percentage) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, cloud_frequency_, cloud_frequency) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, cloud_packet_loss_rate_, cloud_packet_loss_rate) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, cloud_size_, cloud_size) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, cloud_scan_num_, cloud_scan_num) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, imu_frequency_, imu_frequency) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, imu_packet_loss_rate_, imu_packet_loss_rate) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, imu_rpy_, imu_rpy) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, serial_recv_stamp_, serial_recv_stamp) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, serial_buffer_size_, serial_buffer_size) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, serial_buffer_read_, serial_buffer_read);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_go::msg::dds_::LidarState_>::Layout) == sizeof(::unitree_go::msg::dds_::LidarState_),
+    "layout of unitree_go::msg::dds_::LidarState_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_go::msg::dds_::MotorCmd_>
+{
+    struct Layout
+    {
+        uint8_t mode_;
+        float q_;
+        float dq_;
+        float tau_;
+        float kp_;
+        float kd_;
+        std::array<uint32_t, 3> reserve_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, mode_, "mode"),
+        UT_REFLECT_FIELD(Layout, q_, "q"),
+        UT_REFLECT_FIELD(Layout, dq_, "dq"),
+        UT_REFLECT_FIELD(Layout, tau_, "tau"),
+        UT_REFLECT_FIELD(Layout, kp_, "kp"),
+        UT_REFLECT_FIELD(Layout, kd_, "kd"),
+        UT_REFLECT_FIELD(Layout, reserve_, "reserve"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_go::msg::dds_::MotorCmd_", sizeof(::unitree_go::msg::dds_::MotorCmd_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_go::msg::dds_::MotorCmd_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, mode_, mode) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, q_, q) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, dq_, dq) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, tau_, tau) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, kp_, kp) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, kd_, kd) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, reserve_, reserve);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_go::msg::dds_::MotorCmd_>::Layout) == sizeof(::unitree_go::msg::dds_::MotorCmd_),
+    "layout of unitree_go::msg::dds_::MotorCmd_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_go::msg::dds_::LowCmd_>
+{
+    struct Layout
+    {
+        std::array<uint8_t, 2> head_;
+        uint8_t level_flag_;
+        uint8_t frame_reserve_;
+        std::array<uint32_t, 2> sn_;
+        std::array<uint32_t, 2> version_;
+        uint16_t bandwidth_;
+        std::array<::unitree_go::msg::dds_::MotorCmd_, 20> motor_cmd_;
+        ::unitree_go::msg::dds_::BmsCmd_ bms_cmd_;
+        std::array<uint8_t, 40> wireless_remote_;
+        std::array<uint8_t, 12> led_;
+        std::array<uint8_t, 2> fan_;
+        uint8_t gpio_;
+        uint32_t reserve_;
+        uint32_t crc_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, head_, "head"),
+        UT_REFLECT_FIELD(Layout, level_flag_, "level_flag"),
+        UT_REFLECT_FIELD(Layout, frame_reserve_, "frame_reserve"),
+        UT_REFLECT_FIELD(Layout, sn_, "sn"),
+        UT_REFLECT_FIELD(Layout, version_, "version"),
+        UT_REFLECT_FIELD(Layout, bandwidth_, "bandwidth"),
+        UT_REFLECT_FIELD(Layout, motor_cmd_, "motor_cmd"),
+        UT_REFLECT_FIELD(Layout, bms_cmd_, "bms_cmd"),
+        UT_REFLECT_FIELD(Layout, wireless_remote_, "wireless_remote"),
+        UT_REFLECT_FIELD(Layout, led_, "led"),
+        UT_REFLECT_FIELD(Layout, fan_, "fan"),
+        UT_REFLECT_FIELD(Layout, gpio_, "gpio"),
+        UT_REFLECT_FIELD(Layout, reserve_, "reserve"),
+        UT_REFLECT_FIELD(Layout, crc_, "crc"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_go::msg::dds_::LowCmd_", sizeof(::unitree_go::msg::dds_::LowCmd_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_go::msg::dds_::LowCmd_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, head_, head) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, level_flag_, level_flag) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, frame_reserve_, frame_reserve) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, sn_, sn) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, version_, version) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, bandwidth_, bandwidth) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, motor_cmd_, motor_cmd) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, bms_cmd_, bms_cmd) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, wireless_remote_, wireless_remote) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, led_, led) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, fan_, fan) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, gpio_, gpio) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, reserve_, reserve) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, crc_, crc);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_go::msg::dds_::LowCmd_>::Layout) == sizeof(::unitree_go::msg::dds_::LowCmd_),
+    "layout of unitree_go::msg::dds_::LowCmd_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_go::msg::dds_::MotorState_>
+{
+    struct Layout
+    {
+        uint8_t mode_;
+        float q_;
+        float dq_;
+        float ddq_;
+        float tau_est_;
+        float q_raw_;
+        float dq_raw_;
+        float ddq_raw_;
+        uint8_t temperature_;
+        uint32_t lost_;
+        std::array<uint32_t, 2> reserve_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, mode_, "mode"),
+        UT_REFLECT_FIELD(Layout, q_, "q"),
+        UT_REFLECT_FIELD(Layout, dq_, "dq"),
+        UT_REFLECT_FIELD(Layout, ddq_, "ddq"),
+        UT_REFLECT_FIELD(Layout, tau_est_, "tau_est"),
+        UT_REFLECT_FIELD(Layout, q_raw_, "q_raw"),
+        UT_REFLECT_FIELD(Layout, dq_raw_, "dq_raw"),
+        UT_REFLECT_FIELD(Layout, ddq_raw_, "ddq_raw"),
+        UT_REFLECT_FIELD(Layout, temperature_, "temperature"),
+        UT_REFLECT_FIELD(Layout, lost_, "lost"),
+        UT_REFLECT_FIELD(Layout, reserve_, "reserve"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_go::msg::dds_::MotorState_", sizeof(::unitree_go::msg::dds_::MotorState_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_go::msg::dds_::MotorState_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, mode_, mode) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, q_, q) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, dq_, dq) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, ddq_, ddq) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, tau_est_, tau_est) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, q_raw_, q_raw) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, dq_raw_, dq_raw) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, ddq_raw_, ddq_raw) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, temperature_, temperature) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, lost_, lost) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, reserve_, reserve);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_go::msg::dds_::MotorState_>::Layout) == sizeof(::unitree_go::msg::dds_::MotorState_),
+    "layout of unitree_go::msg::dds_::MotorState_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_go::msg::dds_::LowState_>
+{
+    struct Layout
+    {
+        std::array<uint8_t, 2> head_;
+        uint8_t level_flag_;
+        uint8_t frame_reserve_;
+        std::array<uint32_t, 2> sn_;
+        std::array<uint32_t, 2> version_;
+        uint16_t bandwidth_;
+        ::unitree_go::msg::dds_::IMUState_ imu_state_;
+        std::array<::unitree_go::msg::dds_::MotorState_, 20> motor_state_;
+        ::unitree_go::msg::dds_::BmsState_ bms_state_;
+        std::array<int16_t, 4> foot_force_;
+        std::array<int16_t, 4> foot_force_est_;
+        uint32_t tick_;
+        std::array<uint8_t, 40> wireless_remote_;
+        uint8_t bit_flag_;
+        float adc_reel_;
+        uint8_t temperature_ntc1_;
+        uint8_t temperature_ntc2_;
+        float power_v_;
+        float power_a_;
+        std::array<uint16_t, 4> fan_frequency_;
+        uint32_t reserve_;
+        uint32_t crc_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, head_, "head"),
+        UT_REFLECT_FIELD(Layout, level_flag_, "level_flag"),
+        UT_REFLECT_FIELD(Layout, frame_reserve_, "frame_reserve"),
+        UT_REFLECT_FIELD(Layout, sn_, "sn"),
+        UT_REFLECT_FIELD(Layout, version_, "version"),
+        UT_REFLECT_FIELD(Layout, bandwidth_, "bandwidth"),
+        UT_REFLECT_FIELD(Layout, imu_state_, "imu_state"),
+        UT_REFLECT_FIELD(Layout, motor_state_, "motor_state"),
+        UT_REFLECT_FIELD(Layout, bms_state_, "bms_state"),
+        UT_REFLECT_FIELD(Layout, foot_force_, "foot_force"),
+        UT_REFLECT_FIELD(Layout, foot_force_est_, "foot_force_est"),
+        UT_REFLECT_FIELD(Layout, tick_, "tick"),
+        UT_REFLECT_FIELD(Layout, wireless_remote_, "wireless_remote"),
+        UT_REFLECT_FIELD(Layout, bit_flag_, "bit_flag"),
+        UT_REFLECT_FIELD(Layout, adc_reel_, "adc_reel"),
+        UT_REFLECT_FIELD(Layout, temperature_ntc1_, "temperature_ntc1"),
+        UT_REFLECT_FIELD(Layout, temperature_ntc2_, "temperature_ntc2"),
+        UT_REFLECT_FIELD(Layout, power_v_, "power_v"),
+        UT_REFLECT_FIELD(Layout, power_a_, "power_a"),
+        UT_REFLECT_FIELD(Layout, fan_frequency_, "fan_frequency"),
+        UT_REFLECT_FIELD(Layout, reserve_, "reserve"),
+        UT_REFLECT_FIELD(Layout, crc_, "crc"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_go::msg::dds_::LowState_", sizeof(::unitree_go::msg::dds_::LowState_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_go::msg::dds_::LowState_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, head_, head) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, level_flag_, level_flag) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, frame_reserve_, frame_reserve) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, sn_, sn) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, version_, version) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, bandwidth_, bandwidth) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, imu_state_, imu_state) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, motor_state_, motor_state) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, bms_state_, bms_state) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, foot_force_, foot_force) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, foot_force_est_, foot_force_est) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, tick_, tick) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, wireless_remote_, wireless_remote) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, bit_flag_, bit_flag) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, adc_reel_, adc_reel) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, temperature_ntc1_, temperature_ntc1) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, temperature_ntc2_, temperature_ntc2) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, power_v_, power_v) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, power_a_, power_a) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, fan_frequency_, fan_frequency) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, reserve_, reserve) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, crc_, crc);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_go::msg::dds_::LowState_>::Layout) == sizeof(::unitree_go::msg::dds_::LowState_),
+    "layout of unitree_go::msg::dds_::LowState_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_go::msg::dds_::MotorCmds_>
+{
+    struct Layout
+    {
+        std::vector<::unitree_go::msg::dds_::MotorCmd_> cmds_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, cmds_, "cmds"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_go::msg::dds_::MotorCmds_", sizeof(::unitree_go::msg::dds_::MotorCmds_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_go::msg::dds_::MotorCmds_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, cmds_, cmds);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_go::msg::dds_::MotorCmds_>::Layout) == sizeof(::unitree_go::msg::dds_::MotorCmds_),
+    "layout of unitree_go::msg::dds_::MotorCmds_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_go::msg::dds_::MotorStates_>
+{
+    struct Layout
+    {
+        std::vector<::unitree_go::msg::dds_::MotorState_> states_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, states_, "states"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_go::msg::dds_::MotorStates_", sizeof(::unitree_go::msg::dds_::MotorStates_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_go::msg::dds_::MotorStates_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, states_, states);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_go::msg::dds_::MotorStates_>::Layout) == sizeof(::unitree_go::msg::dds_::MotorStates_),
+    "layout of unitree_go::msg::dds_::MotorStates_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_go::msg::dds_::PathPoint_>
+{
+    struct Layout
+    {
+        float t_from_start_;
+        float x_;
+        float y_;
+        float yaw_;
+        float vx_;
+        float vy_;
+        float vyaw_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, t_from_start_, "t_from_start"),
+        UT_REFLECT_FIELD(Layout, x_, "x"),
+        UT_REFLECT_FIELD(Layout, y_, "y"),
+        UT_REFLECT_FIELD(Layout, yaw_, "yaw"),
+        UT_REFLECT_FIELD(Layout, vx_, "vx"),
+        UT_REFLECT_FIELD(Layout, vy_, "vy"),
+        UT_REFLECT_FIELD(Layout, vyaw_, "vyaw"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_go::msg::dds_::PathPoint_", sizeof(::unitree_go::msg::dds_::PathPoint_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_go::msg::dds_::PathPoint_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, t_from_start_, t_from_start) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, x_, x) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, y_, y) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, yaw_, yaw) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, vx_, vx) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, vy_, vy) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, vyaw_, vyaw);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_go::msg::dds_::PathPoint_>::Layout) == sizeof(::unitree_go::msg::dds_::PathPoint_),
+    "layout of unitree_go::msg::dds_::PathPoint_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_go::msg::dds_::Req_>
+{
+    struct Layout
+    {
+        std::string uuid_;
+        std::string body_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, uuid_, "uuid"),
+        UT_REFLECT_FIELD(Layout, body_, "body"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_go::msg::dds_::Req_", sizeof(::unitree_go::msg::dds_::Req_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_go::msg::dds_::Req_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, uuid_, uuid) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, body_, body);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_go::msg::dds_::Req_>::Layout) == sizeof(::unitree_go::msg::dds_::Req_),
+    "layout of unitree_go::msg::dds_::Req_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_go::msg::dds_::Res_>
+{
+    struct Layout
+    {
+        std::string uuid_;
+        std::vector<uint8_t> data_;
+        std::string body_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, uuid_, "uuid"),
+        UT_REFLECT_FIELD(Layout, data_, "data"),
+        UT_REFLECT_FIELD(Layout, body_, "body"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_go::msg::dds_::Res_", sizeof(::unitree_go::msg::dds_::Res_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_go::msg::dds_::Res_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, uuid_, uuid) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, data_, data) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, body_, body);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_go::msg::dds_::Res_>::Layout) == sizeof(::unitree_go::msg::dds_::Res_),
+    "layout of unitree_go::msg::dds_::Res_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_go::msg::dds_::SportModeCmd_>
+{
+    struct Layout
+    {
+        uint8_t mode_;
+        uint8_t gait_type_;
+        uint8_t speed_level_;
+        float foot_raise_height_;
+        float body_height_;
+        std::array<float, 2> position_;
+        std::array<float, 3> euler_;
+        std::array<float, 2> velocity_;
+        float yaw_speed_;
+        ::unitree_go::msg::dds_::BmsCmd_ bms_cmd_;
+        std::array<::unitree_go::msg::dds_::PathPoint_, 30> path_point_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, mode_, "mode"),
+        UT_REFLECT_FIELD(Layout, gait_type_, "gait_type"),
+        UT_REFLECT_FIELD(Layout, speed_level_, "speed_level"),
+        UT_REFLECT_FIELD(Layout, foot_raise_height_, "foot_raise_height"),
+        UT_REFLECT_FIELD(Layout, body_height_, "body_height"),
+        UT_REFLECT_FIELD(Layout, position_, "position"),
+        UT_REFLECT_FIELD(Layout, euler_, "euler"),
+        UT_REFLECT_FIELD(Layout, velocity_, "velocity"),
+        UT_REFLECT_FIELD(Layout, yaw_speed_, "yaw_speed"),
+        UT_REFLECT_FIELD(Layout, bms_cmd_, "bms_cmd"),
+        UT_REFLECT_FIELD(Layout, path_point_, "path_point"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_go::msg::dds_::SportModeCmd_", sizeof(::unitree_go::msg::dds_::SportModeCmd_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_go::msg::dds_::SportModeCmd_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, mode_, mode) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, gait_type_, gait_type) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, speed_level_, speed_level) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, foot_raise_height_, foot_raise_height) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, body_height_, body_height) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, position_, position) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, euler_, euler) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, velocity_, velocity) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, yaw_speed_, yaw_speed) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, bms_cmd_, bms_cmd) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, path_point_, path_point);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_go::msg::dds_::SportModeCmd_>::Layout) == sizeof(::unitree_go::msg::dds_::SportModeCmd_),
+    "layout of unitree_go::msg::dds_::SportModeCmd_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_go::msg::dds_::TimeSpec_>
+{
+    struct Layout
+    {
+        int32_t sec_;
+        uint32_t nanosec_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, sec_, "sec"),
+        UT_REFLECT_FIELD(Layout, nanosec_, "nanosec"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_go::msg::dds_::TimeSpec_", sizeof(::unitree_go::msg::dds_::TimeSpec_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_go::msg::dds_::TimeSpec_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, sec_, sec) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, nanosec_, nanosec);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_go::msg::dds_::TimeSpec_>::Layout) == sizeof(::unitree_go::msg::dds_::TimeSpec_),
+    "layout of unitree_go::msg::dds_::TimeSpec_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_go::msg::dds_::SportModeState_>
+{
+    struct Layout
+    {
+        ::unitree_go::msg::dds_::TimeSpec_ stamp_;
+        uint32_t error_code_;
+        ::unitree_go::msg::dds_::IMUState_ imu_state_;
+        uint8_t mode_;
+        float progress_;
+        uint8_t gait_type_;
+        float foot_raise_height_;
+        std::array<float, 3> position_;
+        float body_height_;
+        std::array<float, 3> velocity_;
+        float yaw_speed_;
+        std::array<float, 4> range_obstacle_;
+        std::array<int16_t, 4> foot_force_;
+        std::array<float, 12> foot_position_body_;
+        std::array<float, 12> foot_speed_body_;
+        std::array<::unitree_go::msg::dds_::PathPoint_, 10> path_point_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, stamp_, "stamp"),
+        UT_REFLECT_FIELD(Layout, error_code_, "error_code"),
+        UT_REFLECT_FIELD(Layout, imu_state_, "imu_state"),
+        UT_REFLECT_FIELD(Layout, mode_, "mode"),
+        UT_REFLECT_FIELD(Layout, progress_, "progress"),
+        UT_REFLECT_FIELD(Layout, gait_type_, "gait_type"),
+        UT_REFLECT_FIELD(Layout, foot_raise_height_, "foot_raise_height"),
+        UT_REFLECT_FIELD(Layout, position_, "position"),
+        UT_REFLECT_FIELD(Layout, body_height_, "body_height"),
+        UT_REFLECT_FIELD(Layout, velocity_, "velocity"),
+        UT_REFLECT_FIELD(Layout, yaw_speed_, "yaw_speed"),
+        UT_REFLECT_FIELD(Layout, range_obstacle_, "range_obstacle"),
+        UT_REFLECT_FIELD(Layout, foot_force_, "foot_force"),
+        UT_REFLECT_FIELD(Layout, foot_position_body_, "foot_position_body"),
+        UT_REFLECT_FIELD(Layout, foot_speed_body_, "foot_speed_body"),
+        UT_REFLECT_FIELD(Layout, path_point_, "path_point"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_go::msg::dds_::SportModeState_", sizeof(::unitree_go::msg::dds_::SportModeState_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_go::msg::dds_::SportModeState_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, stamp_, stamp) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, error_code_, error_code) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, imu_state_, imu_state) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, mode_, mode) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, progress_, progress) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, gait_type_, gait_type) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, foot_raise_height_, foot_raise_height) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, position_, position) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, body_height_, body_height) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, velocity_, velocity) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, yaw_speed_, yaw_speed) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, range_obstacle_, range_obstacle) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, foot_force_, foot_force) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, foot_position_body_, foot_position_body) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, foot_speed_body_, foot_speed_body) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, path_point_, path_point);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_go::msg::dds_::SportModeState_>::Layout) == sizeof(::unitree_go::msg::dds_::SportModeState_),
+    "layout of unitree_go::msg::dds_::SportModeState_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_go::msg::dds_::UwbState_>
+{
+    struct Layout
+    {
+        std::array<uint8_t, 2> version_;
+        uint8_t channel_;
+        uint8_t joy_mode_;
+        float orientation_est_;
+        float pitch_est_;
+        float distance_est_;
+        float yaw_est_;
+        float tag_roll_;
+        float tag_pitch_;
+        float tag_yaw_;
+        float base_roll_;
+        float base_pitch_;
+        float base_yaw_;
+        std::array<float, 2> joystick_;
+        uint8_t error_state_;
+        uint8_t buttons_;
+        uint8_t enabled_from_app_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, version_, "version"),
+        UT_REFLECT_FIELD(Layout, channel_, "channel"),
+        UT_REFLECT_FIELD(Layout, joy_mode_, "joy_mode"),
+        UT_REFLECT_FIELD(Layout, orientation_est_, "orientation_est"),
+        UT_REFLECT_FIELD(Layout, pitch_est_, "pitch_est"),
+        UT_REFLECT_FIELD(Layout, distance_est_, "distance_est"),
+        UT_REFLECT_FIELD(Layout, yaw_est_, "yaw_est"),
+        UT_REFLECT_FIELD(Layout, tag_roll_, "tag_roll"),
+        UT_REFLECT_FIELD(Layout, tag_pitch_, "tag_pitch"),
+        UT_REFLECT_FIELD(Layout, tag_yaw_, "tag_yaw"),
+        UT_REFLECT_FIELD(Layout, base_roll_, "base_roll"),
+        UT_REFLECT_FIELD(Layout, base_pitch_, "base_pitch"),
+        UT_REFLECT_FIELD(Layout, base_yaw_, "base_yaw"),
+        UT_REFLECT_FIELD(Layout, joystick_, "joystick"),
+        UT_REFLECT_FIELD(Layout, error_state_, "error_state"),
+        UT_REFLECT_FIELD(Layout, buttons_, "buttons"),
+        UT_REFLECT_FIELD(Layout, enabled_from_app_, "enabled_from_app"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_go::msg::dds_::UwbState_", sizeof(::unitree_go::msg::dds_::UwbState_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_go::msg::dds_::UwbState_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, version_, version) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, channel_, channel) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, joy_mode_, joy_mode) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, orientation_est_, orientation_est) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, pitch_est_, pitch_est) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, distance_est_, distance_est) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, yaw_est_, yaw_est) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, tag_roll_, tag_roll) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, tag_pitch_, tag_pitch) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, tag_yaw_, tag_yaw) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, base_roll_, base_roll) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, base_pitch_, base_pitch) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, base_yaw_, base_yaw) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, joystick_, joystick) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, error_state_, error_state) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, buttons_, buttons) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, enabled_from_app_, enabled_from_app);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_go::msg::dds_::UwbState_>::Layout) == sizeof(::unitree_go::msg::dds_::UwbState_),
+    "layout of unitree_go::msg::dds_::UwbState_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_go::msg::dds_::UwbSwitch_>
+{
+    struct Layout
+    {
+        uint8_t enabled_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, enabled_, "enabled"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_go::msg::dds_::UwbSwitch_", sizeof(::unitree_go::msg::dds_::UwbSwitch_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_go::msg::dds_::UwbSwitch_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, enabled_, enabled);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_go::msg::dds_::UwbSwitch_>::Layout) == sizeof(::unitree_go::msg::dds_::UwbSwitch_),
+    "layout of unitree_go::msg::dds_::UwbSwitch_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_go::msg::dds_::VoxelMapCompressed_>
+{
+    struct Layout
+    {
+        double stamp_;
+        std::string frame_id_;
+        double resolution_;
+        std::array<double, 3> origin_;
+        std::array<uint16_t, 3> width_;
+        uint64_t src_size_;
+        std::vector<uint8_t> data_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, stamp_, "stamp"),
+        UT_REFLECT_FIELD(Layout, frame_id_, "frame_id"),
+        UT_REFLECT_FIELD(Layout, resolution_, "resolution"),
+        UT_REFLECT_FIELD(Layout, origin_, "origin"),
+        UT_REFLECT_FIELD(Layout, width_, "width"),
+        UT_REFLECT_FIELD(Layout, src_size_, "src_size"),
+        UT_REFLECT_FIELD(Layout, data_, "data"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_go::msg::dds_::VoxelMapCompressed_", sizeof(::unitree_go::msg::dds_::VoxelMapCompressed_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_go::msg::dds_::VoxelMapCompressed_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, stamp_, stamp) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, frame_id_, frame_id) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, resolution_, resolution) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, origin_, origin) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, width_, width) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, src_size_, src_size) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, data_, data);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_go::msg::dds_::VoxelMapCompressed_>::Layout) == sizeof(::unitree_go::msg::dds_::VoxelMapCompressed_),
+    "layout of unitree_go::msg::dds_::VoxelMapCompressed_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_go::msg::dds_::WirelessController_>
+{
+    struct Layout
+    {
+        float lx_;
+        float ly_;
+        float rx_;
+        float ry_;
+        uint16_t keys_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, lx_, "lx"),
+        UT_REFLECT_FIELD(Layout, ly_, "ly"),
+        UT_REFLECT_FIELD(Layout, rx_, "rx"),
+        UT_REFLECT_FIELD(Layout, ry_, "ry"),
+        UT_REFLECT_FIELD(Layout, keys_, "keys"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_go::msg::dds_::WirelessController_", sizeof(::unitree_go::msg::dds_::WirelessController_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_go::msg::dds_::WirelessController_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, lx_, lx) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, ly_, ly) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, rx_, rx) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, ry_, ry) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, keys_, keys);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_go::msg::dds_::WirelessController_>::Layout) == sizeof(::unitree_go::msg::dds_::WirelessController_),
+    "layout of unitree_go::msg::dds_::WirelessController_ changed, run tools/idl_reflect.py");
+
+/*
+ * Check field offsets of every table against the accessors of the real
+ * types. failed is set to the first type whose layout does not match.
+ */
+inline bool CheckGo2ReflectLayout(std::string& failed)
+{
+    if (!TypeReflection<::unitree_go::msg::dds_::AudioData_>::CheckLayout())
+    {
+        failed = "unitree_go::msg::dds_::AudioData_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_go::msg::dds_::BmsCmd_>::CheckLayout())
+    {
+        failed = "unitree_go::msg::dds_::BmsCmd_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_go::msg::dds_::BmsState_>::CheckLayout())
+    {
+        failed = "unitree_go::msg::dds_::BmsState_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_go::msg::dds_::ConfigChangeStatus_>::CheckLayout())
+    {
+        failed = "unitree_go::msg::dds_::ConfigChangeStatus_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_go::msg::dds_::Error_>::CheckLayout())
+    {
+        failed = "unitree_go::msg::dds_::Error_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_go::msg::dds_::Go2FrontVideoData_>::CheckLayout())
+    {
+        failed = "unitree_go::msg::dds_::Go2FrontVideoData_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_go::msg::dds_::HeightMap_>::CheckLayout())
+    {
+        failed = "unitree_go::msg::dds_::HeightMap_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_go::msg::dds_::IMUState_>::CheckLayout())
+    {
+        failed = "unitree_go::msg::dds_::IMUState_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_go::msg::dds_::InterfaceConfig_>::CheckLayout())
+    {
+        failed = "unitree_go::msg::dds_::InterfaceConfig_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_go::msg::dds_::LidarState_>::CheckLayout())
+    {
+        failed = "unitree_go::msg::dds_::LidarState_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_go::msg::dds_::MotorCmd_>::CheckLayout())
+    {
+        failed = "unitree_go::msg::dds_::MotorCmd_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_go::msg::dds_::LowCmd_>::CheckLayout())
+    {
+        failed = "unitree_go::msg::dds_::LowCmd_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_go::msg::dds_::MotorState_>::CheckLayout())
+    {
+        failed = "unitree_go::msg::dds_::MotorState_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_go::msg::dds_::LowState_>::CheckLayout())
+    {
+        failed = "unitree_go::msg::dds_::LowState_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_go::msg::dds_::MotorCmds_>::CheckLayout())
+    {
+        failed = "unitree_go::msg::dds_::MotorCmds_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_go::msg::dds_::MotorStates_>::CheckLayout())
+    {
+        failed = "unitree_go::msg::dds_::MotorStates_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_go::msg::dds_::PathPoint_>::CheckLayout())
+    {
+        failed = "unitree_go::msg::dds_::PathPoint_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_go::msg::dds_::Req_>::CheckLayout())
+    {
+        failed = "unitree_go::msg::dds_::Req_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_go::msg::dds_::Res_>::CheckLayout())
+    {
+        failed = "unitree_go::msg::dds_::Res_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_go::msg::dds_::SportModeCmd_>::CheckLayout())
+    {
+        failed = "unitree_go::msg::dds_::SportModeCmd_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_go::msg::dds_::TimeSpec_>::CheckLayout())
+    {
+        failed = "unitree_go::msg::dds_::TimeSpec_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_go::msg::dds_::SportModeState_>::CheckLayout())
+    {
+        failed = "unitree_go::msg::dds_::SportModeState_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_go::msg::dds_::UwbState_>::CheckLayout())
+    {
+        failed = "unitree_go::msg::dds_::UwbState_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_go::msg::dds_::UwbSwitch_>::CheckLayout())
+    {
+        failed = "unitree_go::msg::dds_::UwbSwitch_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_go::msg::dds_::VoxelMapCompressed_>::CheckLayout())
+    {
+        failed = "unitree_go::msg::dds_::VoxelMapCompressed_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_go::msg::dds_::WirelessController_>::CheckLayout())
+    {
+        failed = "unitree_go::msg::dds_::WirelessController_";
+        return false;
+    }
+
+    return true;
+}
+
+}
+}
+
+#pragma GCC diagnostic pop
+
+#endif//__UT_IDL_REFLECT_GO2_HPP__
@@ -0,0 +1,83 @@
+/*
+ * Generated by tools/idl_reflect.py from include/unitree/idl/hg_doubleimu. Do not edit.
+ */
+#ifndef __UT_IDL_REFLECT_HG_DOUBLEIMU_HPP__
+#define __UT_IDL_REFLECT_HG_DOUBLEIMU_HPP__
+
+#include <unitree/common/reflect/reflect.hpp>
+#include <unitree/idl/hg_doubleimu/doubleIMUState_.hpp>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winvalid-offsetof"
+
+namespace unitree
+{
+namespace common
+{
+template<>
+struct TypeReflection<::unitree_hg_doubleimu::msg::dds_::doubleIMUState_>
+{
+    struct Layout
+    {
+        std::array<float, 4> quaternion_;
+        std::array<float, 3> gyroscope_;
+        std::array<float, 3> accelerometer_;
+        std::array<float, 3> rpy_;
+        int16_t temperature_;
+        uint32_t tick_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, quaternion_, "quaternion"),
+        UT_REFLECT_FIELD(Layout, gyroscope_, "gyroscope"),
+        UT_REFLECT_FIELD(Layout, accelerometer_, "accelerometer"),
+        UT_REFLECT_FIELD(Layout, rpy_, "rpy"),
+        UT_REFLECT_FIELD(Layout, temperature_, "temperature"),
+        UT_REFLECT_FIELD(Layout, tick_, "tick"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_hg_doubleimu::msg::dds_::doubleIMUState_", sizeof(::unitree_hg_doubleimu::msg::dds_::doubleIMUState_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_hg_doubleimu::msg::dds_::doubleIMUState_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, quaternion_, quaternion) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, gyroscope_, gyroscope) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, accelerometer_, accelerometer) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, rpy_, rpy) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, temperature_, temperature) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, tick_, tick);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_hg_doubleimu::msg::dds_::doubleIMUState_>::Layout) == sizeof(::unitree_hg_doubleimu::msg::dds_::doubleIMUState_),
+    "layout of unitree_hg_doubleimu::msg::dds_::doubleIMUState_ changed, run tools/idl_reflect.py");
+
+/*
+ * Check field offsets of every table against the accessors of the real
+ * types. failed is set to the first type whose layout does not match.
+ */
+inline bool CheckHgDoubleimuReflectLayout(std::string& failed)
+{
+    if (!TypeReflection<::unitree_hg_doubleimu::msg::dds_::doubleIMUState_>::CheckLayout())
+    {
+        failed = "unitree_hg_doubleimu::msg::dds_::doubleIMUState_";
+        return false;
+    }
+
+    return true;
+}
+
+}
+}
+
+#pragma GCC diagnostic pop
+
+#endif//__UT_IDL_REFLECT_HG_DOUBLEIMU_HPP__
@@ -0,0 +1,728 @@
+/*
+ * Generated by tools/idl_reflect.py from include/unitree/idl/hg. Do not edit.
+ */
+#ifndef __UT_IDL_REFLECT_HG_HPP__
+#define __UT_IDL_REFLECT_HG_HPP__
+
+#include <unitree/common/reflect/reflect.hpp>
+#include <unitree/idl/hg/AgvBmsState_.hpp>
+#include <unitree/idl/hg/BmsCmd_.hpp>
+#include <unitree/idl/hg/BmsState_.hpp>
+#include <unitree/idl/hg/HandCmd_.hpp>
+#include <unitree/idl/hg/HandState_.hpp>
+#include <unitree/idl/hg/IMUState_.hpp>
+#include <unitree/idl/hg/LowCmd_.hpp>
+#include <unitree/idl/hg/LowState_.hpp>
+#include <unitree/idl/hg/MainBoardState_.hpp>
+#include <unitree/idl/hg/MotorCmd_.hpp>
+#include <unitree/idl/hg/MotorState_.hpp>
+#include <unitree/idl/hg/PressSensorState_.hpp>
+#include <unitree/idl/hg/SportModeState_.hpp>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winvalid-offsetof"
+
+namespace unitree
+{
+namespace common
+{
+template<>
+struct TypeReflection<::unitree_hg::msg::dds_::AgvBmsState_>
+{
+    struct Layout
+    {
+        std::string software_version_;
+        uint8_t battery_percentage_;
+        int32_t current_;
+        std::array<int16_t, 3> temperature_;
+        std::string docking_status_;
+        bool is_charging_;
+        bool is_dc_connected_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, software_version_, "software_version"),
+        UT_REFLECT_FIELD(Layout, battery_percentage_, "battery_percentage"),
+        UT_REFLECT_FIELD(Layout, current_, "current"),
+        UT_REFLECT_FIELD(Layout, temperature_, "temperature"),
+        UT_REFLECT_FIELD(Layout, docking_status_, "docking_status"),
+        UT_REFLECT_FIELD(Layout, is_charging_, "is_charging"),
+        UT_REFLECT_FIELD(Layout, is_dc_connected_, "is_dc_connected"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_hg::msg::dds_::AgvBmsState_", sizeof(::unitree_hg::msg::dds_::AgvBmsState_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_hg::msg::dds_::AgvBmsState_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, software_version_, software_version) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, battery_percentage_, battery_percentage) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, current_, current) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, temperature_, temperature) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, docking_status_, docking_status) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, is_charging_, is_charging) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, is_dc_connected_, is_dc_connected);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_hg::msg::dds_::AgvBmsState_>::Layout) == sizeof(::unitree_hg::msg::dds_::AgvBmsState_),
+    "layout of unitree_hg::msg::dds_::AgvBmsState_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_hg::msg::dds_::BmsCmd_>
+{
+    struct Layout
+    {
+        uint8_t cmd_;
+        std::array<uint8_t, 40> reserve_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, cmd_, "cmd"),
+        UT_REFLECT_FIELD(Layout, reserve_, "reserve"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_hg::msg::dds_::BmsCmd_", sizeof(::unitree_hg::msg::dds_::BmsCmd_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_hg::msg::dds_::BmsCmd_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, cmd_, cmd) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, reserve_, reserve);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_hg::msg::dds_::BmsCmd_>::Layout) == sizeof(::unitree_hg::msg::dds_::BmsCmd_),
+    "layout of unitree_hg::msg::dds_::BmsCmd_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_hg::msg::dds_::BmsState_>
+{
+    struct Layout
+    {
+        uint8_t version_high_;
+        uint8_t version_low_;
+        uint8_t fn_;
+        std::array<uint16_t, 40> cell_vol_;
+        std::array<uint32_t, 3> bmsvoltage_;
+        int32_t current_;
+        uint8_t soc_;
+        uint8_t soh_;
+        std::array<int16_t, 12> temperature_;
+        uint16_t cycle_;
+        uint16_t manufacturer_date_;
+        std::array<uint32_t, 5> bmsstate_;
+        std::array<uint32_t, 3> reserve_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, version_high_, "version_high"),
+        UT_REFLECT_FIELD(Layout, version_low_, "version_low"),
+        UT_REFLECT_FIELD(Layout, fn_, "fn"),
+        UT_REFLECT_FIELD(Layout, cell_vol_, "cell_vol"),
+        UT_REFLECT_FIELD(Layout, bmsvoltage_, "bmsvoltage"),
+        UT_REFLECT_FIELD(Layout, current_, "current"),
+        UT_REFLECT_FIELD(Layout, soc_, "soc"),
+        UT_REFLECT_FIELD(Layout, soh_, "soh"),
+        UT_REFLECT_FIELD(Layout, temperature_, "temperature"),
+        UT_REFLECT_FIELD(Layout, cycle_, "cycle"),
+        UT_REFLECT_FIELD(Layout, manufacturer_date_, "manufacturer_date"),
+        UT_REFLECT_FIELD(Layout, bmsstate_, "bmsstate"),
+        UT_REFLECT_FIELD(Layout, reserve_, "reserve"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_hg::msg::dds_::BmsState_", sizeof(::unitree_hg::msg::dds_::BmsState_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_hg::msg::dds_::BmsState_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, version_high_, version_high) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, version_low_, version_low) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, fn_, fn) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, cell_vol_, cell_vol) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, bmsvoltage_, bmsvoltage) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, current_, current) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, soc_, soc) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, soh_, soh) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, temperature_, temperature) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, cycle_, cycle) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, manufacturer_date_, manufacturer_date) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, bmsstate_, bmsstate) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, reserve_, reserve);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_hg::msg::dds_::BmsState_>::Layout) == sizeof(::unitree_hg::msg::dds_::BmsState_),
+    "layout of unitree_hg::msg::dds_::BmsState_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_hg::msg::dds_::MotorCmd_>
+{
+    struct Layout
+    {
+        uint8_t mode_;
+        float q_;
+        float dq_;
+        float tau_;
+        float kp_;
+        float kd_;
+        uint32_t reserve_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, mode_, "mode"),
+        UT_REFLECT_FIELD(Layout, q_, "q"),
+        UT_REFLECT_FIELD(Layout, dq_, "dq"),
+        UT_REFLECT_FIELD(Layout, tau_, "tau"),
+        UT_REFLECT_FIELD(Layout, kp_, "kp"),
+        UT_REFLECT_FIELD(Layout, kd_, "kd"),
+        UT_REFLECT_FIELD(Layout, reserve_, "reserve"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_hg::msg::dds_::MotorCmd_", sizeof(::unitree_hg::msg::dds_::MotorCmd_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_hg::msg::dds_::MotorCmd_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, mode_, mode) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, q_, q) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, dq_, dq) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, tau_, tau) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, kp_, kp) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, kd_, kd) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, reserve_, reserve);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_hg::msg::dds_::MotorCmd_>::Layout) == sizeof(::unitree_hg::msg::dds_::MotorCmd_),
+    "layout of unitree_hg::msg::dds_::MotorCmd_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_hg::msg::dds_::HandCmd_>
+{
+    struct Layout
+    {
+        std::vector<::unitree_hg::msg::dds_::MotorCmd_> motor_cmd_;
+        std::array<uint32_t, 4> reserve_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, motor_cmd_, "motor_cmd"),
+        UT_REFLECT_FIELD(Layout, reserve_, "reserve"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_hg::msg::dds_::HandCmd_", sizeof(::unitree_hg::msg::dds_::HandCmd_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_hg::msg::dds_::HandCmd_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, motor_cmd_, motor_cmd) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, reserve_, reserve);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_hg::msg::dds_::HandCmd_>::Layout) == sizeof(::unitree_hg::msg::dds_::HandCmd_),
+    "layout of unitree_hg::msg::dds_::HandCmd_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_hg::msg::dds_::MotorState_>
+{
+    struct Layout
+    {
+        uint8_t mode_;
+        float q_;
+        float dq_;
+        float ddq_;
+        float tau_est_;
+        std::array<int16_t, 2> temperature_;
+        float vol_;
+        std::array<uint32_t, 2> sensor_;
+        uint32_t motorstate_;
+        std::array<uint32_t, 4> reserve_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, mode_, "mode"),
+        UT_REFLECT_FIELD(Layout, q_, "q"),
+        UT_REFLECT_FIELD(Layout, dq_, "dq"),
+        UT_REFLECT_FIELD(Layout, ddq_, "ddq"),
+        UT_REFLECT_FIELD(Layout, tau_est_, "tau_est"),
+        UT_REFLECT_FIELD(Layout, temperature_, "temperature"),
+        UT_REFLECT_FIELD(Layout, vol_, "vol"),
+        UT_REFLECT_FIELD(Layout, sensor_, "sensor"),
+        UT_REFLECT_FIELD(Layout, motorstate_, "motorstate"),
+        UT_REFLECT_FIELD(Layout, reserve_, "reserve"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_hg::msg::dds_::MotorState_", sizeof(::unitree_hg::msg::dds_::MotorState_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_hg::msg::dds_::MotorState_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, mode_, mode) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, q_, q) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, dq_, dq) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, ddq_, ddq) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, tau_est_, tau_est) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, temperature_, temperature) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, vol_, vol) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, sensor_, sensor) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, motorstate_, motorstate) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, reserve_, reserve);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_hg::msg::dds_::MotorState_>::Layout) == sizeof(::unitree_hg::msg::dds_::MotorState_),
+    "layout of unitree_hg::msg::dds_::MotorState_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_hg::msg::dds_::PressSensorState_>
+{
+    struct Layout
+    {
+        std::array<float, 12> pressure_;
+        std::array<float, 12> temperature_;
+        uint32_t lost_;
+        uint32_t reserve_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, pressure_, "pressure"),
+        UT_REFLECT_FIELD(Layout, temperature_, "temperature"),
+        UT_REFLECT_FIELD(Layout, lost_, "lost"),
+        UT_REFLECT_FIELD(Layout, reserve_, "reserve"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_hg::msg::dds_::PressSensorState_", sizeof(::unitree_hg::msg::dds_::PressSensorState_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_hg::msg::dds_::PressSensorState_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, pressure_, pressure) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, temperature_, temperature) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, lost_, lost) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, reserve_, reserve);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_hg::msg::dds_::PressSensorState_>::Layout) == sizeof(::unitree_hg::msg::dds_::PressSensorState_),
+    "layout of unitree_hg::msg::dds_::PressSensorState_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_hg::msg::dds_::IMUState_>
+{
+    struct Layout
+    {
+        std::array<float, 4> quaternion_;
+        std::array<float, 3> gyroscope_;
+        std::array<float, 3> accelerometer_;
+        std::array<float, 3> rpy_;
+        int16_t temperature_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, quaternion_, "quaternion"),
+        UT_REFLECT_FIELD(Layout, gyroscope_, "gyroscope"),
+        UT_REFLECT_FIELD(Layout, accelerometer_, "accelerometer"),
+        UT_REFLECT_FIELD(Layout, rpy_, "rpy"),
+        UT_REFLECT_FIELD(Layout, temperature_, "temperature"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_hg::msg::dds_::IMUState_", sizeof(::unitree_hg::msg::dds_::IMUState_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_hg::msg::dds_::IMUState_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, quaternion_, quaternion) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, gyroscope_, gyroscope) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, accelerometer_, accelerometer) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, rpy_, rpy) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, temperature_, temperature);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_hg::msg::dds_::IMUState_>::Layout) == sizeof(::unitree_hg::msg::dds_::IMUState_),
+    "layout of unitree_hg::msg::dds_::IMUState_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_hg::msg::dds_::HandState_>
+{
+    struct Layout
+    {
+        std::vector<::unitree_hg::msg::dds_::MotorState_> motor_state_;
+        std::vector<::unitree_hg::msg::dds_::PressSensorState_> press_sensor_state_;
+        ::unitree_hg::msg::dds_::IMUState_ imu_state_;
+        float power_v_;
+        float power_a_;
+        float system_v_;
+        float device_v_;
+        std::array<uint32_t, 2> error_;
+        std::array<uint32_t, 2> reserve_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, motor_state_, "motor_state"),
+        UT_REFLECT_FIELD(Layout, press_sensor_state_, "press_sensor_state"),
+        UT_REFLECT_FIELD(Layout, imu_state_, "imu_state"),
+        UT_REFLECT_FIELD(Layout, power_v_, "power_v"),
+        UT_REFLECT_FIELD(Layout, power_a_, "power_a"),
+        UT_REFLECT_FIELD(Layout, system_v_, "system_v"),
+        UT_REFLECT_FIELD(Layout, device_v_, "device_v"),
+        UT_REFLECT_FIELD(Layout, error_, "error"),
+        UT_REFLECT_FIELD(Layout, reserve_, "reserve"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_hg::msg::dds_::HandState_", sizeof(::unitree_hg::msg::dds_::HandState_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_hg::msg::dds_::HandState_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, motor_state_, motor_state) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, press_sensor_state_, press_sensor_state) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, imu_state_, imu_state) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, power_v_, power_v) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, power_a_, power_a) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, system_v_, system_v) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, device_v_, device_v) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, error_, error) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, reserve_, reserve);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_hg::msg::dds_::HandState_>::Layout) == sizeof(::unitree_hg::msg::dds_::HandState_),
+    "layout of unitree_hg::msg::dds_::HandState_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_hg::msg::dds_::LowCmd_>
+{
+    struct Layout
+    {
+        uint8_t mode_pr_;
+        uint8_t mode_machine_;
+        std::array<::unitree_hg::msg::dds_::MotorCmd_, 35> motor_cmd_;
+        std::array<uint32_t, 4> reserve_;
+        uint32_t crc_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, mode_pr_, "mode_pr"),
+        UT_REFLECT_FIELD(Layout, mode_machine_, "mode_machine"),
+        UT_REFLECT_FIELD(Layout, motor_cmd_, "motor_cmd"),
+        UT_REFLECT_FIELD(Layout, reserve_, "reserve"),
+        UT_REFLECT_FIELD(Layout, crc_, "crc"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_hg::msg::dds_::LowCmd_", sizeof(::unitree_hg::msg::dds_::LowCmd_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_hg::msg::dds_::LowCmd_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, mode_pr_, mode_pr) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, mode_machine_, mode_machine) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, motor_cmd_, motor_cmd) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, reserve_, reserve) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, crc_, crc);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_hg::msg::dds_::LowCmd_>::Layout) == sizeof(::unitree_hg::msg::dds_::LowCmd_),
+    "layout of unitree_hg::msg::dds_::LowCmd_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_hg::msg::dds_::LowState_>
+{
+    struct Layout
+    {
+        std::array<uint32_t, 2> version_;
+        uint8_t mode_pr_;
+        uint8_t mode_machine_;
+        uint32_t tick_;
+        ::unitree_hg::msg::dds_::IMUState_ imu_state_;
+        std::array<::unitree_hg::msg::dds_::MotorState_, 35> motor_state_;
+        std::array<uint8_t, 40> wireless_remote_;
+        std::array<uint32_t, 4> reserve_;
+        uint32_t crc_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, version_, "version"),
+        UT_REFLECT_FIELD(Layout, mode_pr_, "mode_pr"),
+        UT_REFLECT_FIELD(Layout, mode_machine_, "mode_machine"),
+        UT_REFLECT_FIELD(Layout, tick_, "tick"),
+        UT_REFLECT_FIELD(Layout, imu_state_, "imu_state"),
+        UT_REFLECT_FIELD(Layout, motor_state_, "motor_state"),
+        UT_REFLECT_FIELD(Layout, wireless_remote_, "wireless_remote"),
+        UT_REFLECT_FIELD(Layout, reserve_, "reserve"),
+        UT_REFLECT_FIELD(Layout, crc_, "crc"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_hg::msg::dds_::LowState_", sizeof(::unitree_hg::msg::dds_::LowState_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_hg::msg::dds_::LowState_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, version_, version) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, mode_pr_, mode_pr) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, mode_machine_, mode_machine) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, tick_, tick) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, imu_state_, imu_state) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, motor_state_, motor_state) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, wireless_remote_, wireless_remote) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, reserve_, reserve) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, crc_, crc);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_hg::msg::dds_::LowState_>::Layout) == sizeof(::unitree_hg::msg::dds_::LowState_),
+    "layout of unitree_hg::msg::dds_::LowState_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_hg::msg::dds_::MainBoardState_>
+{
+    struct Layout
+    {
+        std::array<uint16_t, 6> fan_state_;
+        std::array<int16_t, 6> temperature_;
+        std::array<float, 6> value_;
+        std::array<uint32_t, 6> state_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, fan_state_, "fan_state"),
+        UT_REFLECT_FIELD(Layout, temperature_, "temperature"),
+        UT_REFLECT_FIELD(Layout, value_, "value"),
+        UT_REFLECT_FIELD(Layout, state_, "state"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_hg::msg::dds_::MainBoardState_", sizeof(::unitree_hg::msg::dds_::MainBoardState_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_hg::msg::dds_::MainBoardState_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, fan_state_, fan_state) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, temperature_, temperature) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, value_, value) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, state_, state);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_hg::msg::dds_::MainBoardState_>::Layout) == sizeof(::unitree_hg::msg::dds_::MainBoardState_),
+    "layout of unitree_hg::msg::dds_::MainBoardState_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::unitree_hg::msg::dds_::SportModeState_>
+{
+    struct Layout
+    {
+        uint32_t fsm_id_;
+        uint32_t fsm_mode_;
+        uint32_t task_id_;
+        float task_time_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, fsm_id_, "fsm_id"),
+        UT_REFLECT_FIELD(Layout, fsm_mode_, "fsm_mode"),
+        UT_REFLECT_FIELD(Layout, task_id_, "task_id"),
+        UT_REFLECT_FIELD(Layout, task_time_, "task_time"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "unitree_hg::msg::dds_::SportModeState_", sizeof(::unitree_hg::msg::dds_::SportModeState_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::unitree_hg::msg::dds_::SportModeState_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, fsm_id_, fsm_id) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, fsm_mode_, fsm_mode) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, task_id_, task_id) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, task_time_, task_time);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::unitree_hg::msg::dds_::SportModeState_>::Layout) == sizeof(::unitree_hg::msg::dds_::SportModeState_),
+    "layout of unitree_hg::msg::dds_::SportModeState_ changed, run tools/idl_reflect.py");
+
+/*
+ * Check field offsets of every table against the accessors of the real
+ * types. failed is set to the first type whose layout does not match.
+ */
+inline bool CheckHgReflectLayout(std::string& failed)
+{
+    if (!TypeReflection<::unitree_hg::msg::dds_::AgvBmsState_>::CheckLayout())
+    {
+        failed = "unitree_hg::msg::dds_::AgvBmsState_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_hg::msg::dds_::BmsCmd_>::CheckLayout())
+    {
+        failed = "unitree_hg::msg::dds_::BmsCmd_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_hg::msg::dds_::BmsState_>::CheckLayout())
+    {
+        failed = "unitree_hg::msg::dds_::BmsState_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_hg::msg::dds_::MotorCmd_>::CheckLayout())
+    {
+        failed = "unitree_hg::msg::dds_::MotorCmd_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_hg::msg::dds_::HandCmd_>::CheckLayout())
+    {
+        failed = "unitree_hg::msg::dds_::HandCmd_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_hg::msg::dds_::MotorState_>::CheckLayout())
+    {
+        failed = "unitree_hg::msg::dds_::MotorState_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_hg::msg::dds_::PressSensorState_>::CheckLayout())
+    {
+        failed = "unitree_hg::msg::dds_::PressSensorState_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_hg::msg::dds_::IMUState_>::CheckLayout())
+    {
+        failed = "unitree_hg::msg::dds_::IMUState_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_hg::msg::dds_::HandState_>::CheckLayout())
+    {
+        failed = "unitree_hg::msg::dds_::HandState_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_hg::msg::dds_::LowCmd_>::CheckLayout())
+    {
+        failed = "unitree_hg::msg::dds_::LowCmd_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_hg::msg::dds_::LowState_>::CheckLayout())
+    {
+        failed = "unitree_hg::msg::dds_::LowState_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_hg::msg::dds_::MainBoardState_>::CheckLayout())
+    {
+        failed = "unitree_hg::msg::dds_::MainBoardState_";
+        return false;
+    }
+
+    if (!TypeReflection<::unitree_hg::msg::dds_::SportModeState_>::CheckLayout())
+    {
+        failed = "unitree_hg::msg::dds_::SportModeState_";
+        return false;
+    }
+
+    return true;
+}
+
+}
+}
+
+#pragma GCC diagnostic pop
+
+#endif//__UT_IDL_REFLECT_HG_HPP__
@@ -0,0 +1,1089 @@
+/*
+ * Generated by tools/idl_reflect.py from include/unitree/idl/ros2. Do not edit.
+ */
+#ifndef __UT_IDL_REFLECT_ROS2_HPP__
+#define __UT_IDL_REFLECT_ROS2_HPP__
+
+#include <unitree/common/reflect/reflect.hpp>
+#include <unitree/idl/ros2/Header_.hpp>
+#include <unitree/idl/ros2/Imu_.hpp>
+#include <unitree/idl/ros2/MapMetaData_.hpp>
+#include <unitree/idl/ros2/OccupancyGrid_.hpp>
+#include <unitree/idl/ros2/Odometry_.hpp>
+#include <unitree/idl/ros2/Point32_.hpp>
+#include <unitree/idl/ros2/PointCloud2_.hpp>
+#include <unitree/idl/ros2/PointField_.hpp>
+#include <unitree/idl/ros2/PointStamped_.hpp>
+#include <unitree/idl/ros2/Point_.hpp>
+#include <unitree/idl/ros2/Pose2D_.hpp>
+#include <unitree/idl/ros2/PoseStamped_.hpp>
+#include <unitree/idl/ros2/PoseWithCovarianceStamped_.hpp>
+#include <unitree/idl/ros2/PoseWithCovariance_.hpp>
+#include <unitree/idl/ros2/Pose_.hpp>
+#include <unitree/idl/ros2/QuaternionStamped_.hpp>
+#include <unitree/idl/ros2/Quaternion_.hpp>
+#include <unitree/idl/ros2/String_.hpp>
+#include <unitree/idl/ros2/Time_.hpp>
+#include <unitree/idl/ros2/TwistStamped_.hpp>
+#include <unitree/idl/ros2/TwistWithCovarianceStamped_.hpp>
+#include <unitree/idl/ros2/TwistWithCovariance_.hpp>
+#include <unitree/idl/ros2/Twist_.hpp>
+#include <unitree/idl/ros2/Vector3_.hpp>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winvalid-offsetof"
+
+namespace unitree
+{
+namespace common
+{
+template<>
+struct TypeReflection<::builtin_interfaces::msg::dds_::Time_>
+{
+    struct Layout
+    {
+        int32_t sec_;
+        uint32_t nanosec_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, sec_, "sec"),
+        UT_REFLECT_FIELD(Layout, nanosec_, "nanosec"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "builtin_interfaces::msg::dds_::Time_", sizeof(::builtin_interfaces::msg::dds_::Time_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::builtin_interfaces::msg::dds_::Time_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, sec_, sec) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, nanosec_, nanosec);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::builtin_interfaces::msg::dds_::Time_>::Layout) == sizeof(::builtin_interfaces::msg::dds_::Time_),
+    "layout of builtin_interfaces::msg::dds_::Time_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::std_msgs::msg::dds_::Header_>
+{
+    struct Layout
+    {
+        ::builtin_interfaces::msg::dds_::Time_ stamp_;
+        std::string frame_id_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, stamp_, "stamp"),
+        UT_REFLECT_FIELD(Layout, frame_id_, "frame_id"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "std_msgs::msg::dds_::Header_", sizeof(::std_msgs::msg::dds_::Header_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::std_msgs::msg::dds_::Header_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, stamp_, stamp) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, frame_id_, frame_id);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::std_msgs::msg::dds_::Header_>::Layout) == sizeof(::std_msgs::msg::dds_::Header_),
+    "layout of std_msgs::msg::dds_::Header_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::geometry_msgs::msg::dds_::Quaternion_>
+{
+    struct Layout
+    {
+        double x_;
+        double y_;
+        double z_;
+        double w_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, x_, "x"),
+        UT_REFLECT_FIELD(Layout, y_, "y"),
+        UT_REFLECT_FIELD(Layout, z_, "z"),
+        UT_REFLECT_FIELD(Layout, w_, "w"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "geometry_msgs::msg::dds_::Quaternion_", sizeof(::geometry_msgs::msg::dds_::Quaternion_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::geometry_msgs::msg::dds_::Quaternion_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, x_, x) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, y_, y) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, z_, z) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, w_, w);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::geometry_msgs::msg::dds_::Quaternion_>::Layout) == sizeof(::geometry_msgs::msg::dds_::Quaternion_),
+    "layout of geometry_msgs::msg::dds_::Quaternion_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::geometry_msgs::msg::dds_::Vector3_>
+{
+    struct Layout
+    {
+        double x_;
+        double y_;
+        double z_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, x_, "x"),
+        UT_REFLECT_FIELD(Layout, y_, "y"),
+        UT_REFLECT_FIELD(Layout, z_, "z"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "geometry_msgs::msg::dds_::Vector3_", sizeof(::geometry_msgs::msg::dds_::Vector3_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::geometry_msgs::msg::dds_::Vector3_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, x_, x) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, y_, y) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, z_, z);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::geometry_msgs::msg::dds_::Vector3_>::Layout) == sizeof(::geometry_msgs::msg::dds_::Vector3_),
+    "layout of geometry_msgs::msg::dds_::Vector3_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::sensor_msgs::msg::dds_::Imu_>
+{
+    struct Layout
+    {
+        ::std_msgs::msg::dds_::Header_ header_;
+        ::geometry_msgs::msg::dds_::Quaternion_ orientation_;
+        std::array<double, 9> orientation_covariance_;
+        ::geometry_msgs::msg::dds_::Vector3_ angular_velocity_;
+        std::array<double, 9> angular_velocity_covariance_;
+        ::geometry_msgs::msg::dds_::Vector3_ linear_acceleration_;
+        std::array<double, 9> linear_acceleration_covariance_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, header_, "header"),
+        UT_REFLECT_FIELD(Layout, orientation_, "orientation"),
+        UT_REFLECT_FIELD(Layout, orientation_covariance_, "orientation_covariance"),
+        UT_REFLECT_FIELD(Layout, angular_velocity_, "angular_velocity"),
+        UT_REFLECT_FIELD(Layout, angular_velocity_covariance_, "angular_velocity_covariance"),
+        UT_REFLECT_FIELD(Layout, linear_acceleration_, "linear_acceleration"),
+        UT_REFLECT_FIELD(Layout, linear_acceleration_covariance_, "linear_acceleration_covariance"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "sensor_msgs::msg::dds_::Imu_", sizeof(::sensor_msgs::msg::dds_::Imu_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::sensor_msgs::msg::dds_::Imu_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, header_, header) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, orientation_, orientation) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, orientation_covariance_, orientation_covariance) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, angular_velocity_, angular_velocity) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, angular_velocity_covariance_, angular_velocity_covariance) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, linear_acceleration_, linear_acceleration) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, linear_acceleration_covariance_, linear_acceleration_covariance);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::sensor_msgs::msg::dds_::Imu_>::Layout) == sizeof(::sensor_msgs::msg::dds_::Imu_),
+    "layout of sensor_msgs::msg::dds_::Imu_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::geometry_msgs::msg::dds_::Point_>
+{
+    struct Layout
+    {
+        double x_;
+        double y_;
+        double z_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, x_, "x"),
+        UT_REFLECT_FIELD(Layout, y_, "y"),
+        UT_REFLECT_FIELD(Layout, z_, "z"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "geometry_msgs::msg::dds_::Point_", sizeof(::geometry_msgs::msg::dds_::Point_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::geometry_msgs::msg::dds_::Point_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, x_, x) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, y_, y) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, z_, z);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::geometry_msgs::msg::dds_::Point_>::Layout) == sizeof(::geometry_msgs::msg::dds_::Point_),
+    "layout of geometry_msgs::msg::dds_::Point_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::geometry_msgs::msg::dds_::Pose_>
+{
+    struct Layout
+    {
+        ::geometry_msgs::msg::dds_::Point_ position_;
+        ::geometry_msgs::msg::dds_::Quaternion_ orientation_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, position_, "position"),
+        UT_REFLECT_FIELD(Layout, orientation_, "orientation"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "geometry_msgs::msg::dds_::Pose_", sizeof(::geometry_msgs::msg::dds_::Pose_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::geometry_msgs::msg::dds_::Pose_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, position_, position) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, orientation_, orientation);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::geometry_msgs::msg::dds_::Pose_>::Layout) == sizeof(::geometry_msgs::msg::dds_::Pose_),
+    "layout of geometry_msgs::msg::dds_::Pose_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::nav_msgs::msg::dds_::MapMetaData_>
+{
+    struct Layout
+    {
+        ::builtin_interfaces::msg::dds_::Time_ map_load_time_;
+        float resolution_;
+        uint32_t width_;
+        uint32_t height_;
+        ::geometry_msgs::msg::dds_::Pose_ origin_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, map_load_time_, "map_load_time"),
+        UT_REFLECT_FIELD(Layout, resolution_, "resolution"),
+        UT_REFLECT_FIELD(Layout, width_, "width"),
+        UT_REFLECT_FIELD(Layout, height_, "height"),
+        UT_REFLECT_FIELD(Layout, origin_, "origin"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "nav_msgs::msg::dds_::MapMetaData_", sizeof(::nav_msgs::msg::dds_::MapMetaData_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::nav_msgs::msg::dds_::MapMetaData_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, map_load_time_, map_load_time) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, resolution_, resolution) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, width_, width) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, height_, height) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, origin_, origin);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::nav_msgs::msg::dds_::MapMetaData_>::Layout) == sizeof(::nav_msgs::msg::dds_::MapMetaData_),
+    "layout of nav_msgs::msg::dds_::MapMetaData_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::nav_msgs::msg::dds_::OccupancyGrid_>
+{
+    struct Layout
+    {
+        ::std_msgs::msg::dds_::Header_ header_;
+        ::nav_msgs::msg::dds_::MapMetaData_ info_;
+        std::vector<uint8_t> data_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, header_, "header"),
+        UT_REFLECT_FIELD(Layout, info_, "info"),
+        UT_REFLECT_FIELD(Layout, data_, "data"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "nav_msgs::msg::dds_::OccupancyGrid_", sizeof(::nav_msgs::msg::dds_::OccupancyGrid_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::nav_msgs::msg::dds_::OccupancyGrid_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, header_, header) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, info_, info) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, data_, data);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::nav_msgs::msg::dds_::OccupancyGrid_>::Layout) == sizeof(::nav_msgs::msg::dds_::OccupancyGrid_),
+    "layout of nav_msgs::msg::dds_::OccupancyGrid_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::geometry_msgs::msg::dds_::PoseWithCovariance_>
+{
+    struct Layout
+    {
+        ::geometry_msgs::msg::dds_::Pose_ pose_;
+        std::array<double, 36> covariance_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, pose_, "pose"),
+        UT_REFLECT_FIELD(Layout, covariance_, "covariance"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "geometry_msgs::msg::dds_::PoseWithCovariance_", sizeof(::geometry_msgs::msg::dds_::PoseWithCovariance_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::geometry_msgs::msg::dds_::PoseWithCovariance_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, pose_, pose) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, covariance_, covariance);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::geometry_msgs::msg::dds_::PoseWithCovariance_>::Layout) == sizeof(::geometry_msgs::msg::dds_::PoseWithCovariance_),
+    "layout of geometry_msgs::msg::dds_::PoseWithCovariance_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::geometry_msgs::msg::dds_::Twist_>
+{
+    struct Layout
+    {
+        ::geometry_msgs::msg::dds_::Vector3_ linear_;
+        ::geometry_msgs::msg::dds_::Vector3_ angular_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, linear_, "linear"),
+        UT_REFLECT_FIELD(Layout, angular_, "angular"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "geometry_msgs::msg::dds_::Twist_", sizeof(::geometry_msgs::msg::dds_::Twist_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::geometry_msgs::msg::dds_::Twist_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, linear_, linear) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, angular_, angular);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::geometry_msgs::msg::dds_::Twist_>::Layout) == sizeof(::geometry_msgs::msg::dds_::Twist_),
+    "layout of geometry_msgs::msg::dds_::Twist_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::geometry_msgs::msg::dds_::TwistWithCovariance_>
+{
+    struct Layout
+    {
+        ::geometry_msgs::msg::dds_::Twist_ twist_;
+        std::array<double, 36> covariance_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, twist_, "twist"),
+        UT_REFLECT_FIELD(Layout, covariance_, "covariance"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "geometry_msgs::msg::dds_::TwistWithCovariance_", sizeof(::geometry_msgs::msg::dds_::TwistWithCovariance_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::geometry_msgs::msg::dds_::TwistWithCovariance_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, twist_, twist) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, covariance_, covariance);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::geometry_msgs::msg::dds_::TwistWithCovariance_>::Layout) == sizeof(::geometry_msgs::msg::dds_::TwistWithCovariance_),
+    "layout of geometry_msgs::msg::dds_::TwistWithCovariance_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::nav_msgs::msg::dds_::Odometry_>
+{
+    struct Layout
+    {
+        ::std_msgs::msg::dds_::Header_ header_;
+        std::string child_frame_id_;
+        ::geometry_msgs::msg::dds_::PoseWithCovariance_ pose_;
+        ::geometry_msgs::msg::dds_::TwistWithCovariance_ twist_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, header_, "header"),
+        UT_REFLECT_FIELD(Layout, child_frame_id_, "child_frame_id"),
+        UT_REFLECT_FIELD(Layout, pose_, "pose"),
+        UT_REFLECT_FIELD(Layout, twist_, "twist"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "nav_msgs::msg::dds_::Odometry_", sizeof(::nav_msgs::msg::dds_::Odometry_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::nav_msgs::msg::dds_::Odometry_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, header_, header) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, child_frame_id_, child_frame_id) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, pose_, pose) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, twist_, twist);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::nav_msgs::msg::dds_::Odometry_>::Layout) == sizeof(::nav_msgs::msg::dds_::Odometry_),
+    "layout of nav_msgs::msg::dds_::Odometry_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::geometry_msgs::msg::dds_::Point32_>
+{
+    struct Layout
+    {
+        float x_;
+        float y_;
+        float z_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, x_, "x"),
+        UT_REFLECT_FIELD(Layout, y_, "y"),
+        UT_REFLECT_FIELD(Layout, z_, "z"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "geometry_msgs::msg::dds_::Point32_", sizeof(::geometry_msgs::msg::dds_::Point32_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::geometry_msgs::msg::dds_::Point32_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, x_, x) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, y_, y) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, z_, z);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::geometry_msgs::msg::dds_::Point32_>::Layout) == sizeof(::geometry_msgs::msg::dds_::Point32_),
+    "layout of geometry_msgs::msg::dds_::Point32_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::sensor_msgs::msg::dds_::PointField_>
+{
+    struct Layout
+    {
+        std::string name_;
+        uint32_t offset_;
+        uint8_t datatype_;
+        uint32_t count_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, name_, "name"),
+        UT_REFLECT_FIELD(Layout, offset_, "offset"),
+        UT_REFLECT_FIELD(Layout, datatype_, "datatype"),
+        UT_REFLECT_FIELD(Layout, count_, "count"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "sensor_msgs::msg::dds_::PointField_", sizeof(::sensor_msgs::msg::dds_::PointField_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::sensor_msgs::msg::dds_::PointField_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, name_, name) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, offset_, offset) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, datatype_, datatype) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, count_, count);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::sensor_msgs::msg::dds_::PointField_>::Layout) == sizeof(::sensor_msgs::msg::dds_::PointField_),
+    "layout of sensor_msgs::msg::dds_::PointField_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::sensor_msgs::msg::dds_::PointCloud2_>
+{
+    struct Layout
+    {
+        ::std_msgs::msg::dds_::Header_ header_;
+        uint32_t height_;
+        uint32_t width_;
+        std::vector<::sensor_msgs::msg::dds_::PointField_> fields_;
+        bool is_bigendian_;
+        uint32_t point_step_;
+        uint32_t row_step_;
+        std::vector<uint8_t> data_;
+        bool is_dense_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, header_, "header"),
+        UT_REFLECT_FIELD(Layout, height_, "height"),
+        UT_REFLECT_FIELD(Layout, width_, "width"),
+        UT_REFLECT_FIELD(Layout, fields_, "fields"),
+        UT_REFLECT_FIELD(Layout, is_bigendian_, "is_bigendian"),
+        UT_REFLECT_FIELD(Layout, point_step_, "point_step"),
+        UT_REFLECT_FIELD(Layout, row_step_, "row_step"),
+        UT_REFLECT_FIELD(Layout, data_, "data"),
+        UT_REFLECT_FIELD(Layout, is_dense_, "is_dense"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "sensor_msgs::msg::dds_::PointCloud2_", sizeof(::sensor_msgs::msg::dds_::PointCloud2_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::sensor_msgs::msg::dds_::PointCloud2_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, header_, header) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, height_, height) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, width_, width) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, fields_, fields) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, is_bigendian_, is_bigendian) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, point_step_, point_step) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, row_step_, row_step) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, data_, data) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, is_dense_, is_dense);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::sensor_msgs::msg::dds_::PointCloud2_>::Layout) == sizeof(::sensor_msgs::msg::dds_::PointCloud2_),
+    "layout of sensor_msgs::msg::dds_::PointCloud2_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::geometry_msgs::msg::dds_::PointStamped_>
+{
+    struct Layout
+    {
+        ::std_msgs::msg::dds_::Header_ header_;
+        ::geometry_msgs::msg::dds_::Point_ point_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, header_, "header"),
+        UT_REFLECT_FIELD(Layout, point_, "point"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "geometry_msgs::msg::dds_::PointStamped_", sizeof(::geometry_msgs::msg::dds_::PointStamped_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::geometry_msgs::msg::dds_::PointStamped_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, header_, header) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, point_, point);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::geometry_msgs::msg::dds_::PointStamped_>::Layout) == sizeof(::geometry_msgs::msg::dds_::PointStamped_),
+    "layout of geometry_msgs::msg::dds_::PointStamped_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::geometry_msgs::msg::dds_::Pose2D_>
+{
+    struct Layout
+    {
+        double x_;
+        double y_;
+        double theta_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, x_, "x"),
+        UT_REFLECT_FIELD(Layout, y_, "y"),
+        UT_REFLECT_FIELD(Layout, theta_, "theta"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "geometry_msgs::msg::dds_::Pose2D_", sizeof(::geometry_msgs::msg::dds_::Pose2D_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::geometry_msgs::msg::dds_::Pose2D_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, x_, x) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, y_, y) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, theta_, theta);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::geometry_msgs::msg::dds_::Pose2D_>::Layout) == sizeof(::geometry_msgs::msg::dds_::Pose2D_),
+    "layout of geometry_msgs::msg::dds_::Pose2D_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::geometry_msgs::msg::dds_::PoseStamped_>
+{
+    struct Layout
+    {
+        ::std_msgs::msg::dds_::Header_ header_;
+        ::geometry_msgs::msg::dds_::Pose_ pose_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, header_, "header"),
+        UT_REFLECT_FIELD(Layout, pose_, "pose"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "geometry_msgs::msg::dds_::PoseStamped_", sizeof(::geometry_msgs::msg::dds_::PoseStamped_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::geometry_msgs::msg::dds_::PoseStamped_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, header_, header) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, pose_, pose);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::geometry_msgs::msg::dds_::PoseStamped_>::Layout) == sizeof(::geometry_msgs::msg::dds_::PoseStamped_),
+    "layout of geometry_msgs::msg::dds_::PoseStamped_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::geometry_msgs::msg::dds_::PoseWithCovarianceStamped_>
+{
+    struct Layout
+    {
+        ::std_msgs::msg::dds_::Header_ header_;
+        ::geometry_msgs::msg::dds_::PoseWithCovariance_ pose_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, header_, "header"),
+        UT_REFLECT_FIELD(Layout, pose_, "pose"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "geometry_msgs::msg::dds_::PoseWithCovarianceStamped_", sizeof(::geometry_msgs::msg::dds_::PoseWithCovarianceStamped_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::geometry_msgs::msg::dds_::PoseWithCovarianceStamped_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, header_, header) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, pose_, pose);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::geometry_msgs::msg::dds_::PoseWithCovarianceStamped_>::Layout) == sizeof(::geometry_msgs::msg::dds_::PoseWithCovarianceStamped_),
+    "layout of geometry_msgs::msg::dds_::PoseWithCovarianceStamped_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::geometry_msgs::msg::dds_::QuaternionStamped_>
+{
+    struct Layout
+    {
+        ::std_msgs::msg::dds_::Header_ header_;
+        ::geometry_msgs::msg::dds_::Quaternion_ quaternion_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, header_, "header"),
+        UT_REFLECT_FIELD(Layout, quaternion_, "quaternion"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "geometry_msgs::msg::dds_::QuaternionStamped_", sizeof(::geometry_msgs::msg::dds_::QuaternionStamped_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::geometry_msgs::msg::dds_::QuaternionStamped_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, header_, header) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, quaternion_, quaternion);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::geometry_msgs::msg::dds_::QuaternionStamped_>::Layout) == sizeof(::geometry_msgs::msg::dds_::QuaternionStamped_),
+    "layout of geometry_msgs::msg::dds_::QuaternionStamped_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::std_msgs::msg::dds_::String_>
+{
+    struct Layout
+    {
+        std::string data_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, data_, "data"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "std_msgs::msg::dds_::String_", sizeof(::std_msgs::msg::dds_::String_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::std_msgs::msg::dds_::String_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, data_, data);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::std_msgs::msg::dds_::String_>::Layout) == sizeof(::std_msgs::msg::dds_::String_),
+    "layout of std_msgs::msg::dds_::String_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::geometry_msgs::msg::dds_::TwistStamped_>
+{
+    struct Layout
+    {
+        ::std_msgs::msg::dds_::Header_ header_;
+        ::geometry_msgs::msg::dds_::Twist_ twist_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, header_, "header"),
+        UT_REFLECT_FIELD(Layout, twist_, "twist"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "geometry_msgs::msg::dds_::TwistStamped_", sizeof(::geometry_msgs::msg::dds_::TwistStamped_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::geometry_msgs::msg::dds_::TwistStamped_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, header_, header) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, twist_, twist);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::geometry_msgs::msg::dds_::TwistStamped_>::Layout) == sizeof(::geometry_msgs::msg::dds_::TwistStamped_),
+    "layout of geometry_msgs::msg::dds_::TwistStamped_ changed, run tools/idl_reflect.py");
+
+template<>
+struct TypeReflection<::geometry_msgs::msg::dds_::TwistWithCovarianceStamped_>
+{
+    struct Layout
+    {
+        ::std_msgs::msg::dds_::Header_ header_;
+        ::geometry_msgs::msg::dds_::TwistWithCovariance_ twist_;
+    };
+
+    static constexpr bool VALID = true;
+
+    static constexpr FieldDescriptor FIELDS[] =
+    {
+        UT_REFLECT_FIELD(Layout, header_, "header"),
+        UT_REFLECT_FIELD(Layout, twist_, "twist"),
+    };
+
+    static constexpr TypeDescriptor TYPE =
+    {
+        "geometry_msgs::msg::dds_::TwistWithCovarianceStamped_", sizeof(::geometry_msgs::msg::dds_::TwistWithCovarianceStamped_), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])
+    };
+
+    static bool CheckLayout()
+    {
+        ::geometry_msgs::msg::dds_::TwistWithCovarianceStamped_ obj;
+        return
+            UT_REFLECT_CHECK_FIELD(Layout, obj, header_, header) &&
+            UT_REFLECT_CHECK_FIELD(Layout, obj, twist_, twist);
+    }
+};
+
+static_assert(sizeof(TypeReflection<::geometry_msgs::msg::dds_::TwistWithCovarianceStamped_>::Layout) == sizeof(::geometry_msgs::msg::dds_::TwistWithCovarianceStamped_),
+    "layout of geometry_msgs::msg::dds_::TwistWithCovarianceStamped_ changed, run tools/idl_reflect.py");
+
+/*
+ * Check field offsets of every table against the accessors of the real
+ * types. failed is set to the first type whose layout does not match.
+ */
+inline bool CheckRos2ReflectLayout(std::string& failed)
+{
+    if (!TypeReflection<::builtin_interfaces::msg::dds_::Time_>::CheckLayout())
+    {
+        failed = "builtin_interfaces::msg::dds_::Time_";
+        return false;
+    }
+
+    if (!TypeReflection<::std_msgs::msg::dds_::Header_>::CheckLayout())
+    {
+        failed = "std_msgs::msg::dds_::Header_";
+        return false;
+    }
+
+    if (!TypeReflection<::geometry_msgs::msg::dds_::Quaternion_>::CheckLayout())
+    {
+        failed = "geometry_msgs::msg::dds_::Quaternion_";
+        return false;
+    }
+
+    if (!TypeReflection<::geometry_msgs::msg::dds_::Vector3_>::CheckLayout())
+    {
+        failed = "geometry_msgs::msg::dds_::Vector3_";
+        return false;
+    }
+
+    if (!TypeReflection<::sensor_msgs::msg::dds_::Imu_>::CheckLayout())
+    {
+        failed = "sensor_msgs::msg::dds_::Imu_";
+        return false;
+    }
+
+    if (!TypeReflection<::geometry_msgs::msg::dds_::Point_>::CheckLayout())
+    {
+        failed = "geometry_msgs::msg::dds_::Point_";
+        return false;
+    }
+
+    if (!TypeReflection<::geometry_msgs::msg::dds_::Pose_>::CheckLayout())
+    {
+        failed = "geometry_msgs::msg::dds_::Pose_";
+        return false;
+    }
+
+    if (!TypeReflection<::nav_msgs::msg::dds_::MapMetaData_>::CheckLayout())
+    {
+        failed = "nav_msgs::msg::dds_::MapMetaData_";
+        return false;
+    }
+
+    if (!TypeReflection<::nav_msgs::msg::dds_::OccupancyGrid_>::CheckLayout())
+    {
+        failed = "nav_msgs::msg::dds_::OccupancyGrid_";
+        return false;
+    }
+
+    if (!TypeReflection<::geometry_msgs::msg::dds_::PoseWithCovariance_>::CheckLayout())
+    {
+        failed = "geometry_msgs::msg::dds_::PoseWithCovariance_";
+        return false;
+    }
+
+    if (!TypeReflection<::geometry_msgs::msg::dds_::Twist_>::CheckLayout())
+    {
+        failed = "geometry_msgs::msg::dds_::Twist_";
+        return false;
+    }
+
+    if (!TypeReflection<::geometry_msgs::msg::dds_::TwistWithCovariance_>::CheckLayout())
+    {
+        failed = "geometry_msgs::msg::dds_::TwistWithCovariance_";
+        return false;
+    }
+
+    if (!TypeReflection<::nav_msgs::msg::dds_::Odometry_>::CheckLayout())
+    {
+        failed = "nav_msgs::msg::dds_::Odometry_";
+        return false;
+    }
+
+    if (!TypeReflection<::geometry_msgs::msg::dds_::Point32_>::CheckLayout())
+    {
+        failed = "geometry_msgs::msg::dds_::Point32_";
+        return false;
+    }
+
+    if (!TypeReflection<::sensor_msgs::msg::dds_::PointField_>::CheckLayout())
+    {
+        failed = "sensor_msgs::msg::dds_::PointField_";
+        return false;
+    }
+
+    if (!TypeReflection<::sensor_msgs::msg::dds_::PointCloud2_>::CheckLayout())
+    {
+        failed = "sensor_msgs::msg::dds_::PointCloud2_";
+        return false;
+    }
+
+    if (!TypeReflection<::geometry_msgs::msg::dds_::PointStamped_>::CheckLayout())
+    {
+        failed = "geometry_msgs::msg::dds_::PointStamped_";
+        return false;
+    }
+
+    if (!TypeReflection<::geometry_msgs::msg::dds_::Pose2D_>::CheckLayout())
+    {
+        failed = "geometry_msgs::msg::dds_::Pose2D_";
+        return false;
+    }
+
+    if (!TypeReflection<::geometry_msgs::msg::dds_::PoseStamped_>::CheckLayout())
+    {
+        failed = "geometry_msgs::msg::dds_::PoseStamped_";
+        return false;
+    }
+
+    if (!TypeReflection<::geometry_msgs::msg::dds_::PoseWithCovarianceStamped_>::CheckLayout())
+    {
+        failed = "geometry_msgs::msg::dds_::PoseWithCovarianceStamped_";
+        return false;
+    }
+
+    if (!TypeReflection<::geometry_msgs::msg::dds_::QuaternionStamped_>::CheckLayout())
+    {
+        failed = "geometry_msgs::msg::dds_::QuaternionStamped_";
+        return false;
+    }
+
+    if (!TypeReflection<::std_msgs::msg::dds_::String_>::CheckLayout())
+    {
+        failed = "std_msgs::msg::dds_::String_";
+        return false;
+    }
+
+    if (!TypeReflection<::geometry_msgs::msg::dds_::TwistStamped_>::CheckLayout())
+    {
+        failed = "geometry_msgs::msg::dds_::TwistStamped_";
+        return false;
+    }
+
+    if (!TypeReflection<::geometry_msgs::msg::dds_::TwistWithCovarianceStamped_>::CheckLayout())
+    {
+        failed = "geometry_msgs::msg::dds_::TwistWithCovarianceStamped_";
+        return false;
+    }
+
+    return true;
+}
+
+}
+}
+
+#pragma GCC diagnostic pop
+
+#endif//__UT_IDL_REFLECT_ROS2_HPP__
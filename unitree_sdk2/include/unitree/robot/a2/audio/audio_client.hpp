@@ -2,7 +2,7 @@
 #define __UT_ROBOT_A2_AUDIO_CLIENT_HPP__
 
 #include <limits>
-#include <unitree/robot/client/client.hpp>
+#include <unitree/robot/client/routed_client.hpp>
 #include <unitree/robot/go2/public/jsonize_type.hpp>
 
 #include "audio_api.hpp"
@@ -10,9 +10,9 @@
 namespace unitree {
 namespace robot {
 namespace a2 {
-class AudioClient : public Client {
+class AudioClient : public RoutedClient {
  public:
-  AudioClient() : Client(AUDIO_SERVICE_NAME, false) {}
+  AudioClient() : RoutedClient(AUDIO_SERVICE_NAME, false) {}
   ~AudioClient() {}
 
   /*Init*/
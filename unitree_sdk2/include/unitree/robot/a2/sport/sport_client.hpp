@@ -2,7 +2,7 @@
 #define __UT_ROBOT_A2_SPORT_CLIENT_HPP__
 
 #include <limits>
-#include <unitree/robot/client/client.hpp>
+#include <unitree/robot/client/routed_client.hpp>
 #include <unitree/robot/go2/public/jsonize_type.hpp>
 #include "sport_api.hpp"
 
@@ -27,10 +27,10 @@ namespace unitree
       const int ID_RECOVERY = 12;
       const int ID_BASE_HEIGHT_CTRL = 13;
 
-      class SportClient : public Client
+      class SportClient : public RoutedClient
       {
       public:
-        SportClient() : Client(ROBOT_SPORT_SERVICE_NAME, false) {}
+        SportClient() : RoutedClient(ROBOT_SPORT_SERVICE_NAME, false) {}
         ~SportClient() {}
 
         /*Init*/
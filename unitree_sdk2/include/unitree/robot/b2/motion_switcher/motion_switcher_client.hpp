@@ -2,6 +2,10 @@
 #define __UT_ROBOT_B2_MOTION_SWITCHER_CLIENT_HPP__
 
 #include <unitree/robot/client/client.hpp>
+#include <unitree/robot/client/client_cache.hpp>
+#include <unitree/robot/b2/motion_switcher/motion_switcher_api.hpp>
+#include <unitree/common/time/sleep.hpp>
+#include <unitree/common/time/time_tool.hpp>
 
 namespace unitree
 {
@@ -9,6 +13,26 @@ namespace robot
 {
 namespace b2
 {
+/*
+ * @brief  first poll interval of WaitForMode. 10ms
+ */
+const int64_t MOTION_SWITCHER_WAIT_INTERVAL_MIN = 10000;
+
+/*
+ * @brief  max poll interval of WaitForMode. 200ms
+ */
+const int64_t MOTION_SWITCHER_WAIT_INTERVAL_MAX = 200000;
+
+/*
+ * @brief  time a released mode gets to stop before ReleaseMode is sent again. 2s
+ */
+const int64_t MOTION_SWITCHER_RELEASE_WAIT_TIME = 2000000;
+
+/*
+ * @brief: mode predicate of WaitForMode.
+ */
+using MotionModePredicate = std::function<bool(const std::string& form, const std::string& name)>;
+
 /*
  * @brief MotionSwitcherClient
  */
@@ -25,6 +49,181 @@ public:
     int32_t ReleaseMode();
     int32_t SetSilent(bool silent);
     int32_t GetSilent(bool& silent);
+
+    /*
+     * Wait until predicate holds for the current mode, or timeout (us).
+     * The switcher service has no transition topic, so CheckMode is polled
+     * from 10ms backing off to 200ms: a transition shortly after the call
+     * is seen within milliseconds, a long wait costs few requests.
+     * form and name receive the last checked mode.
+     */
+    int32_t WaitForMode(const MotionModePredicate& predicate, int64_t timeout, std::string* form = NULL, std::string* name = NULL)
+    {
+        int64_t deadline = (int64_t)common::GetCurrentMonotonicTimeMicrosecond() + timeout;
+        int64_t interval = MOTION_SWITCHER_WAIT_INTERVAL_MIN;
+
+        while (true)
+        {
+            std::string curForm, curName;
+            int32_t ret = MotionSwitcherClient::CheckMode(curForm, curName);
+
+            if (ret == 0)
+            {
+                if (form != NULL)
+                {
+                    *form = curForm;
+                }
+
+                if (name != NULL)
+                {
+                    *name = curName;
+                }
+
+                if (predicate(curForm, curName))
+                {
+                    return 0;
+                }
+            }
+
+            int64_t remain = deadline - (int64_t)common::GetCurrentMonotonicTimeMicrosecond();
+            if (remain <= 0)
+            {
+                return ret == 0 ? UT_ROBOT_ERR_CLIENT_API_TIMEOUT : ret;
+            }
+
+            common::MicroSleep(std::min(interval, remain));
+            interval = std::min(interval * 2, MOTION_SWITCHER_WAIT_INTERVAL_MAX);
+        }
+    }
+
+    /*
+     * Release modes until no motion service is active, or timeout (us).
+     * Returns as soon as CheckMode reports an empty mode name.
+     */
+    int32_t ReleaseModeAndWait(int64_t timeout)
+    {
+        int64_t deadline = (int64_t)common::GetCurrentMonotonicTimeMicrosecond() + timeout;
+
+        std::string form, name;
+        int32_t ret = MotionSwitcherClient::CheckMode(form, name);
+
+        while (ret != 0 || !name.empty())
+        {
+            int64_t remain = deadline - (int64_t)common::GetCurrentMonotonicTimeMicrosecond();
+            if (remain <= 0)
+            {
+                return ret == 0 ? UT_ROBOT_ERR_CLIENT_API_TIMEOUT : ret;
+            }
+
+            ret = MotionSwitcherClient::ReleaseMode();
+            if (ret != 0)
+            {
+                common::MicroSleep(std::min(MOTION_SWITCHER_WAIT_INTERVAL_MAX, remain));
+                ret = MotionSwitcherClient::CheckMode(form, name);
+                continue;
+            }
+
+            /*
+             * a released mode may fall back to another one; wait for the
+             * name to change, then release again if it is not empty.
+             */
+            const std::string released = name;
+            ret = WaitForMode([&released](const std::string&, const std::string& current) {
+                    return current != released;
+                }, std::min(MOTION_SWITCHER_RELEASE_WAIT_TIME, remain), &form, &name);
+
+            if (ret == UT_ROBOT_ERR_CLIENT_API_TIMEOUT)
+            {
+                ret = 0;
+            }
+        }
+
+        return 0;
+    }
+};
+
+/*
+ * @brief CachedMotionSwitcherClient
+ *
+ * MotionSwitcherClient serving CheckMode and GetSilent from a client side
+ * cache refreshed at most once per ttl. SelectMode, ReleaseMode and SetSilent
+ * through this client invalidate the cached state.
+ */
+class CachedMotionSwitcherClient : public MotionSwitcherClient
+{
+public:
+    explicit CachedMotionSwitcherClient(int64_t ttl = ROBOT_CLIENT_CACHE_TTL)
+    {
+        mCache.SetApiTtl(MOTION_SWITCHER_API_ID_CHECK_MODE, ttl);
+        mCache.SetApiTtl(MOTION_SWITCHER_API_ID_GET_SILENT, ttl);
+
+        mCache.SetApiInvalidation(MOTION_SWITCHER_API_ID_SELECT_MODE, MOTION_SWITCHER_API_ID_CHECK_MODE);
+        mCache.SetApiInvalidation(MOTION_SWITCHER_API_ID_RELEASE_MODE, MOTION_SWITCHER_API_ID_CHECK_MODE);
+        mCache.SetApiInvalidation(MOTION_SWITCHER_API_ID_SET_SILENT, MOTION_SWITCHER_API_ID_GET_SILENT);
+    }
+
+    ~CachedMotionSwitcherClient()
+    {}
+
+    int32_t CheckMode(std::string& form, std::string& name)
+    {
+        std::pair<std::string,std::string> mode;
+        int32_t ret = mCache.Get<std::pair<std::string,std::string>>(MOTION_SWITCHER_API_ID_CHECK_MODE, mode,
+            [this](std::pair<std::string,std::string>& value) {
+                return MotionSwitcherClient::CheckMode(value.first, value.second);
+            });
+
+        if (ret == 0)
+        {
+            form = mode.first;
+            name = mode.second;
+        }
+
+        return ret;
+    }
+
+    int32_t SelectMode(const std::string& nameOrAlias)
+    {
+        int32_t ret = MotionSwitcherClient::SelectMode(nameOrAlias);
+        mCache.Notify(MOTION_SWITCHER_API_ID_SELECT_MODE, ret);
+        return ret;
+    }
+
+    int32_t ReleaseMode()
+    {
+        int32_t ret = MotionSwitcherClient::ReleaseMode();
+        mCache.Notify(MOTION_SWITCHER_API_ID_RELEASE_MODE, ret);
+        return ret;
+    }
+
+    int32_t SetSilent(bool silent)
+    {
+        int32_t ret = MotionSwitcherClient::SetSilent(silent);
+        mCache.Notify(MOTION_SWITCHER_API_ID_SET_SILENT, ret);
+        return ret;
+    }
+
+    int32_t GetSilent(bool& silent)
+    {
+        return mCache.Get<bool>(MOTION_SWITCHER_API_ID_GET_SILENT, silent, [this](bool& value) {
+            return MotionSwitcherClient::GetSilent(value);
+        });
+    }
+
+    int32_t ReleaseModeAndWait(int64_t timeout)
+    {
+        int32_t ret = MotionSwitcherClient::ReleaseModeAndWait(timeout);
+        mCache.Notify(MOTION_SWITCHER_API_ID_RELEASE_MODE, 0);
+        return ret;
+    }
+
+    ClientCache& GetCache()
+    {
+        return mCache;
+    }
+
+private:
+    ClientCache mCache;
 };
 
 }
@@ -44,6 +44,14 @@ public:
         return channelPtr;
     }
 
+    template<typename MSG>
+    ChannelPtr<MSG> CreateRecvChannel(const std::string& name, const common::DdsReaderFilter<MSG>& filter, std::function<void(const void*)> callback, int32_t queuelen = 0)
+    {
+        ChannelPtr<MSG> channelPtr = mDdsFactoryPtr->CreateTopicChannel<MSG>(name);
+        mDdsFactoryPtr->SetReader(channelPtr, filter, callback, queuelen);
+        return channelPtr;
+    }
+
 public:
     ~ChannelFactory();
 
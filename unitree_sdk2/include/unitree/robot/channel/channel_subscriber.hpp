@@ -39,6 +39,26 @@ public:
         }
     }
 
+    /*
+     * Subscribe only to messages accepted by filter. The filter is evaluated
+     * in the dds receive path after deserialization, so rejected messages
+     * are never queued, copied or handled.
+     */
+    void InitChannel(const common::DdsReaderFilter<MSG>& filter, const std::function<void(const void*)>& handler, int64_t queuelen = 0)
+    {
+        mHandler = handler;
+        mQueueLen = queuelen;
+
+        if (mHandler)
+        {
+            mChannelPtr = ChannelFactory::Instance()->CreateRecvChannel<MSG>(mChannelName, filter, mHandler, mQueueLen);
+        }
+        else
+        {
+            UT_THROW(common::CommonException, "subscribe handler is invalid");
+        }
+    }
+
     void CloseChannel()
     {
         mChannelPtr.reset();
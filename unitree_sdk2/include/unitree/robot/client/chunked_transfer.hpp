@@ -0,0 +1,345 @@
+#ifndef __UT_ROBOT_SDK_CHUNKED_TRANSFER_HPP__
+#define __UT_ROBOT_SDK_CHUNKED_TRANSFER_HPP__
+
+#include <unitree/common/lock/lock.hpp>
+#include <unitree/common/thread/thread.hpp>
+#include <unitree/common/time/sleep.hpp>
+#include <unitree/common/time/time_tool.hpp>
+#include <unitree/robot/internal/internal.hpp>
+
+namespace unitree
+{
+namespace robot
+{
+/*
+ * @brief: send function of one chunk. return 0 when chunk is acknowledged.
+ */
+using ChunkSendFunc = std::function<int32_t(const ChunkView& chunk)>;
+
+/*
+ * @brief: wait time slice of chunk sender. 100ms
+ */
+const int64_t ROBOT_CHUNK_WAIT_TIME = 100000;
+
+/*
+ * @brief: interval between send attempts of a rejected chunk. 10ms
+ */
+const int64_t ROBOT_CHUNK_RETRY_INTERVAL = 10000;
+
+/*
+ * @brief
+ * @class: ChunkedTransferOption
+ */
+class ChunkedTransferOption
+{
+public:
+    explicit ChunkedTransferOption(size_t chunkSize = ROBOT_CHUNK_SIZE, int32_t window = ROBOT_CHUNK_WINDOW, int32_t retry = ROBOT_CHUNK_RETRY) :
+        mChunkSize(chunkSize), mWindow(window), mRetry(retry)
+    {}
+
+public:
+    /*
+     * max bytes of one chunk
+     */
+    size_t mChunkSize;
+
+    /*
+     * max chunks sent but not acknowledged. window 1 keeps chunks in order.
+     */
+    int32_t mWindow;
+
+    /*
+     * send attempts of one chunk
+     */
+    int32_t mRetry;
+};
+
+/*
+ * @brief
+ * @class: ChunkedTransfer
+ *
+ * Splits a buffer into fixed size chunks and sends them through send
+ * function with a sliding window: chunk n is sent only when all chunks
+ * before n - window are acknowledged. Chunks are views of the buffer, the
+ * send function copies each chunk once into its request.
+ * Sending runs on window sender threads; the object is the completion
+ * future of the transfer. Destroying it cancels an unfinished transfer.
+ */
+class ChunkedTransfer
+{
+public:
+    /*
+     * Send caller memory. data must stay valid until transfer is done.
+     */
+    explicit ChunkedTransfer(const uint8_t* data, size_t size, const ChunkSendFunc& sendFunc, const ChunkedTransferOption& option = ChunkedTransferOption()) :
+        mData(data), mSize(size), mSendFunc(sendFunc), mOption(option)
+    {
+        Prepare();
+    }
+
+    /*
+     * Send owned buffer.
+     */
+    explicit ChunkedTransfer(std::vector<uint8_t>&& data, const ChunkSendFunc& sendFunc, const ChunkedTransferOption& option = ChunkedTransferOption()) :
+        mOwnedData(std::move(data)), mSendFunc(sendFunc), mOption(option)
+    {
+        mData = mOwnedData.data();
+        mSize = mOwnedData.size();
+        Prepare();
+    }
+
+    ~ChunkedTransfer()
+    {
+        Cancel();
+
+        for (auto& threadPtr : mThreadList)
+        {
+            threadPtr->Wait();
+        }
+    }
+
+    void Start()
+    {
+        common::LockGuard<common::MutexCond> lock(mMutexCond);
+
+        if (mCount == 0)
+        {
+            mDone = true;
+            return;
+        }
+
+        mRunning = std::min<uint32_t>((uint32_t)mOption.mWindow, mCount);
+        for (uint32_t i=0; i<mRunning; i++)
+        {
+            mThreadList.push_back(common::CreateThreadEx("chunk_tx", UT_CPU_ID_NONE, &ChunkedTransfer::SenderFunc, this));
+        }
+    }
+
+    /*
+     * Wait transfer done. microsec <= 0 waits forever.
+     */
+    bool Wait(int64_t microsec = 0)
+    {
+        int64_t deadline = (int64_t)common::GetCurrentMonotonicTimeMicrosecond() + microsec;
+
+        common::LockGuard<common::MutexCond> lock(mMutexCond);
+        while (!mDone)
+        {
+            /*
+             * every acknowledged chunk wakes waiters, so the budget is
+             * checked against the clock instead of counted per wakeup.
+             */
+            int64_t waitTime = ROBOT_CHUNK_WAIT_TIME;
+            if (microsec > 0)
+            {
+                int64_t remain = deadline - (int64_t)common::GetCurrentMonotonicTimeMicrosecond();
+                if (remain <= 0)
+                {
+                    return false;
+                }
+
+                waitTime = std::min(waitTime, remain);
+            }
+
+            mMutexCond.Wait(waitTime);
+        }
+
+        return true;
+    }
+
+    bool IsDone()
+    {
+        common::LockGuard<common::MutexCond> lock(mMutexCond);
+        return mDone;
+    }
+
+    /*
+     * Result of transfer: 0, or the first error of a chunk.
+     */
+    int32_t GetResult()
+    {
+        common::LockGuard<common::MutexCond> lock(mMutexCond);
+        return mResult;
+    }
+
+    uint64_t GetAckedSize()
+    {
+        common::LockGuard<common::MutexCond> lock(mMutexCond);
+        return mAckedSize;
+    }
+
+    uint64_t GetSize() const
+    {
+        return mSize;
+    }
+
+    void Cancel()
+    {
+        common::LockGuard<common::MutexCond> lock(mMutexCond);
+        mCancel = true;
+        mMutexCond.NotifyAll();
+    }
+
+private:
+    void Prepare()
+    {
+        if (mOption.mChunkSize == 0)
+        {
+            mOption.mChunkSize = ROBOT_CHUNK_SIZE;
+        }
+
+        if (mOption.mWindow <= 0)
+        {
+            mOption.mWindow = 1;
+        }
+
+        mCount = (uint32_t)((mSize + mOption.mChunkSize - 1) / mOption.mChunkSize);
+        mNext = 0;
+        mAckBase = 0;
+        mAckedSize = 0;
+        mAcked.assign(mCount, false);
+        mResult = UT_ROBOT_OK;
+        mRunning = 0;
+        mCancel = false;
+        mDone = false;
+    }
+
+    bool IsStopped() const
+    {
+        return mCancel || mResult != UT_ROBOT_OK;
+    }
+
+    int32_t SenderFunc()
+    {
+        while (true)
+        {
+            ChunkView chunk;
+
+            {
+                common::LockGuard<common::MutexCond> lock(mMutexCond);
+
+                while (!IsStopped() && mNext < mCount && mNext >= mAckBase + (uint32_t)mOption.mWindow)
+                {
+                    mMutexCond.Wait(ROBOT_CHUNK_WAIT_TIME);
+                }
+
+                if (IsStopped() || mNext >= mCount)
+                {
+                    break;
+                }
+
+                chunk.mSeq = mNext++;
+            }
+
+            chunk.mOffset = (uint64_t)chunk.mSeq * mOption.mChunkSize;
+            chunk.mData = mData + chunk.mOffset;
+            chunk.mSize = std::min<uint64_t>(mOption.mChunkSize, mSize - chunk.mOffset);
+            chunk.mCount = mCount;
+            chunk.mTotalSize = mSize;
+
+            int32_t ret = SendChunk(chunk);
+
+            common::LockGuard<common::MutexCond> lock(mMutexCond);
+
+            if (ret == UT_ROBOT_OK)
+            {
+                mAcked[chunk.mSeq] = true;
+                mAckedSize += chunk.mSize;
+
+                while (mAckBase < mCount && mAcked[mAckBase])
+                {
+                    mAckBase++;
+                }
+            }
+            else if (mResult == UT_ROBOT_OK)
+            {
+                mResult = ret;
+            }
+
+            mMutexCond.NotifyAll();
+        }
+
+        common::LockGuard<common::MutexCond> lock(mMutexCond);
+
+        if (--mRunning == 0)
+        {
+            if (mResult == UT_ROBOT_OK && mAckBase < mCount)
+            {
+                mResult = UT_ROBOT_ERR_CLIENT_CHUNK_CANCELED;
+            }
+
+            mDone = true;
+        }
+
+        mMutexCond.NotifyAll();
+
+        return 0;
+    }
+
+    int32_t SendChunk(const ChunkView& chunk)
+    {
+        int32_t ret = UT_ROBOT_ERR_CLIENT_SEND;
+
+        for (int32_t attempt=0; attempt<std::max(mOption.mRetry, 1); attempt++)
+        {
+            if (mCancel)
+            {
+                return UT_ROBOT_ERR_CLIENT_CHUNK_CANCELED;
+            }
+
+            ret = mSendFunc(chunk);
+
+            /*
+             * server api errors are final, transport errors and window
+             * rejections are retried.
+             */
+            if (ret == UT_ROBOT_OK || !(ret == UT_ROBOT_ERR_SERVER_CHUNK_WINDOW ||
+                ret == UT_ROBOT_ERR_CLIENT_SEND || ret == UT_ROBOT_ERR_CLIENT_API_TIMEOUT))
+            {
+                break;
+            }
+
+            common::MicroSleep(ROBOT_CHUNK_RETRY_INTERVAL);
+        }
+
+        return ret;
+    }
+
+private:
+    const uint8_t* mData;
+    uint64_t mSize;
+    std::vector<uint8_t> mOwnedData;
+
+    ChunkSendFunc mSendFunc;
+    ChunkedTransferOption mOption;
+
+    uint32_t mCount;
+    uint32_t mNext;
+    uint32_t mAckBase;
+    uint64_t mAckedSize;
+    std::vector<bool> mAcked;
+
+    int32_t mResult;
+    uint32_t mRunning;
+    volatile bool mCancel;
+    bool mDone;
+
+    common::MutexCond mMutexCond;
+    std::vector<common::ThreadPtr> mThreadList;
+};
+
+using ChunkedTransferPtr = std::shared_ptr<ChunkedTransfer>;
+
+/*
+ * Id of a chunked transfer, unique among the clients of a service.
+ */
+inline uint64_t MakeChunkedTransferId(const void* owner)
+{
+    static std::atomic<uint64_t> sequence(0);
+    return (common::GetCurrentTimeNanosecond() ^ ((uint64_t)(uintptr_t)owner << 16)) + (++sequence);
+}
+
+}
+}
+
+#endif//__UT_ROBOT_SDK_CHUNKED_TRANSFER_HPP__
@@ -3,6 +3,7 @@
 
 #include <unitree/robot/client/client_base.hpp>
 #include <unitree/robot/client/lease_client.hpp>
+#include <unitree/robot/client/chunked_transfer.hpp>
 
 #define UT_ROBOT_CLIENT_REG_API_NO_PROI(apiId) \
     UT_ROBOT_CLIENT_REG_API(apiId, 0)
@@ -43,6 +44,25 @@ protected:
 
     int32_t Call(int32_t apiId, const std::string& parameter, const std::vector<uint8_t>& binary);
 
+    /*
+     * Send binary in chunk frames to a server api registered by RegistChunkedHandler.
+     * Returns the started transfer. data and this client must outlive it.
+     */
+    ChunkedTransferPtr CallChunked(int32_t apiId, const std::string& parameter, const uint8_t* data, size_t size,
+        const ChunkedTransferOption& option = ChunkedTransferOption())
+    {
+        uint64_t transferId = MakeChunkedTransferId(this);
+
+        ChunkedTransferPtr transferPtr(new ChunkedTransfer(data, size, [this, apiId, parameter, transferId](const ChunkView& chunk) {
+            std::vector<uint8_t> frame, reply;
+            EncodeChunkFrame(transferId, parameter, chunk, frame);
+            return Call(apiId, frame, reply);
+        }, option));
+
+        transferPtr->Start();
+        return transferPtr;
+    }
+
     void RegistApi(int32_t apiId, int32_t priority = 0);
     int32_t CheckApi(int32_t apiId, int32_t& priority, int64_t& leaseId);
 
@@ -0,0 +1,276 @@
+#ifndef __UT_ROBOT_SDK_CLIENT_CACHE_HPP__
+#define __UT_ROBOT_SDK_CLIENT_CACHE_HPP__
+
+#include <unitree/common/any.hpp>
+#include <unitree/common/lock/lock.hpp>
+#include <unitree/common/time/time_tool.hpp>
+#include <unitree/robot/client/client_base.hpp>
+
+namespace unitree
+{
+namespace robot
+{
+/*
+ * @brief: default ttl of cached api result. 200ms
+ */
+const int64_t ROBOT_CLIENT_CACHE_TTL = 200000;
+
+/*
+ * @brief
+ * @class: ClientCacheStatistics
+ */
+class ClientCacheStatistics
+{
+public:
+    ClientCacheStatistics() :
+        mHitCount(0), mMissCount(0), mCoalesceCount(0), mInvalidateCount(0)
+    {}
+
+public:
+    uint64_t mHitCount;
+    uint64_t mMissCount;
+    uint64_t mCoalesceCount;
+    uint64_t mInvalidateCount;
+};
+
+/*
+ * @brief
+ * @class: ClientCache
+ *
+ * Read-through cache for polling style Get apis.
+ * A result is cached for the ttl of its api. Concurrent readers of the same
+ * api and key share one in-flight call, and a successful call of a Set api
+ * invalidates the Get apis it affects.
+ * Apis without ttl are always passed through to the loader.
+ */
+class ClientCache
+{
+public:
+    using Key = std::pair<int32_t,std::string>;
+
+    explicit ClientCache()
+    {}
+
+    ~ClientCache()
+    {}
+
+    /*
+     * Cache result of apiId for ttl microseconds.
+     */
+    void SetApiTtl(int32_t apiId, int64_t ttl = ROBOT_CLIENT_CACHE_TTL)
+    {
+        common::LockGuard<common::MutexCond> lock(mMutexCond);
+        mApiTtlMap[apiId] = ttl;
+    }
+
+    /*
+     * Successful call of apiId invalidates cached result of cachedApiId.
+     */
+    void SetApiInvalidation(int32_t apiId, int32_t cachedApiId)
+    {
+        common::LockGuard<common::MutexCond> lock(mMutexCond);
+        mInvalidationMap.insert(std::make_pair(apiId, cachedApiId));
+    }
+
+    bool IsCacheApi(int32_t apiId)
+    {
+        common::LockGuard<common::MutexCond> lock(mMutexCond);
+        return mApiTtlMap.find(apiId) != mApiTtlMap.end();
+    }
+
+    /*
+     * Get value of apiId from cache, or by loader when missing or expired.
+     * key distinguishes calls of the same api with different parameters.
+     */
+    template<typename T>
+    int32_t Get(int32_t apiId, T& value, const std::function<int32_t(T&)>& loader, const std::string& key = "")
+    {
+        mMutexCond.Lock();
+
+        auto ttlIter = mApiTtlMap.find(apiId);
+        if (ttlIter == mApiTtlMap.end())
+        {
+            mMutexCond.Unlock();
+            return loader(value);
+        }
+
+        int64_t ttl = ttlIter->second;
+        Entry& entry = mEntryMap[Key(apiId, key)];
+
+        /*
+         * join the in-flight call
+         */
+        if (entry.mLoading)
+        {
+            mStatistics.mCoalesceCount++;
+        }
+
+        while (entry.mLoading)
+        {
+            uint64_t sequence = entry.mSequence;
+            if (!mMutexCond.Wait(ROBOT_CLIENT_TIMEOUT))
+            {
+                break;
+            }
+
+            if (!entry.mLoading && entry.mSequence != sequence)
+            {
+                int32_t ret = entry.mRet;
+                if (ret == 0)
+                {
+                    value = common::AnyCast<T>(entry.mValue);
+                }
+
+                mMutexCond.Unlock();
+                return ret;
+            }
+        }
+
+        if (entry.mValid && (int64_t)common::GetCurrentMonotonicTimeMicrosecond() < entry.mExpireTime)
+        {
+            mStatistics.mHitCount++;
+            value = common::AnyCast<T>(entry.mValue);
+
+            mMutexCond.Unlock();
+            return 0;
+        }
+
+        mStatistics.mMissCount++;
+
+        entry.mLoading = true;
+        uint64_t generation = entry.mGeneration;
+
+        mMutexCond.Unlock();
+
+        T result = value;
+        int32_t ret = UT_ROBOT_ERR_UNKNOWN;
+
+        try
+        {
+            ret = loader(result);
+        }
+        catch (...)
+        {
+            /*
+             * release joined readers with an error, they would wait on
+             * mLoading forever otherwise.
+             */
+            common::LockGuard<common::MutexCond> lock(mMutexCond);
+
+            Entry& failed = mEntryMap[Key(apiId, key)];
+            failed.mLoading = false;
+            failed.mSequence++;
+            failed.mRet = UT_ROBOT_ERR_UNKNOWN;
+
+            mMutexCond.NotifyAll();
+            throw;
+        }
+
+        common::LockGuard<common::MutexCond> lock(mMutexCond);
+
+        Entry& loaded = mEntryMap[Key(apiId, key)];
+        loaded.mLoading = false;
+        loaded.mSequence++;
+        loaded.mRet = ret;
+
+        if (ret == 0)
+        {
+            loaded.mValue = result;
+            value = result;
+
+            /*
+             * result loaded across an invalidation may be stale: hand it to
+             * joined readers but do not keep it.
+             */
+            loaded.mValid = (loaded.mGeneration == generation);
+            loaded.mExpireTime = (int64_t)common::GetCurrentMonotonicTimeMicrosecond() + ttl;
+        }
+
+        mMutexCond.NotifyAll();
+
+        return ret;
+    }
+
+    /*
+     * Report result of a call. Successful call invalidates affected apis.
+     */
+    void Notify(int32_t apiId, int32_t ret)
+    {
+        if (ret != 0)
+        {
+            return;
+        }
+
+        common::LockGuard<common::MutexCond> lock(mMutexCond);
+
+        auto range = mInvalidationMap.equal_range(apiId);
+        for (auto iter = range.first; iter != range.second; ++iter)
+        {
+            InvalidateApi(iter->second);
+        }
+    }
+
+    void Invalidate(int32_t apiId)
+    {
+        common::LockGuard<common::MutexCond> lock(mMutexCond);
+        InvalidateApi(apiId);
+    }
+
+    void Clear()
+    {
+        common::LockGuard<common::MutexCond> lock(mMutexCond);
+        for (auto& item : mEntryMap)
+        {
+            item.second.mValid = false;
+            item.second.mGeneration++;
+        }
+    }
+
+    ClientCacheStatistics GetStatistics()
+    {
+        common::LockGuard<common::MutexCond> lock(mMutexCond);
+        return mStatistics;
+    }
+
+private:
+    struct Entry
+    {
+        Entry() :
+            mValid(false), mLoading(false), mRet(0), mExpireTime(0), mSequence(0), mGeneration(0)
+        {}
+
+        bool mValid;
+        bool mLoading;
+        int32_t mRet;
+        int64_t mExpireTime;
+        uint64_t mSequence;
+        uint64_t mGeneration;
+        common::Any mValue;
+    };
+
+    void InvalidateApi(int32_t apiId)
+    {
+        auto iter = mEntryMap.lower_bound(Key(apiId, ""));
+        for (; iter != mEntryMap.end() && iter->first.first == apiId; ++iter)
+        {
+            iter->second.mValid = false;
+            iter->second.mGeneration++;
+        }
+
+        mStatistics.mInvalidateCount++;
+    }
+
+private:
+    common::MutexCond mMutexCond;
+    std::map<Key,Entry> mEntryMap;
+    std::unordered_map<int32_t,int64_t> mApiTtlMap;
+    std::unordered_multimap<int32_t,int32_t> mInvalidationMap;
+    ClientCacheStatistics mStatistics;
+};
+
+using ClientCachePtr = std::shared_ptr<ClientCache>;
+
+}
+}
+
+#endif//__UT_ROBOT_SDK_CLIENT_CACHE_HPP__
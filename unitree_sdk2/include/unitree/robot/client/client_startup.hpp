@@ -0,0 +1,263 @@
+#ifndef __UT_ROBOT_SDK_CLIENT_STARTUP_HPP__
+#define __UT_ROBOT_SDK_CLIENT_STARTUP_HPP__
+
+#include <unitree/common/lock/lock.hpp>
+#include <unitree/common/thread/thread.hpp>
+#include <unitree/common/time/time_tool.hpp>
+#include <unitree/robot/client/client.hpp>
+#include <algorithm>
+#include <iomanip>
+
+namespace unitree
+{
+namespace robot
+{
+/*
+ * @brief
+ * @class: StartupEvent
+ * One step of startup. Times are microseconds since ClientStartup creation.
+ */
+class StartupEvent
+{
+public:
+    StartupEvent() :
+        mBeginTime(0), mEndTime(0), mSuccess(true)
+    {}
+
+public:
+    std::string mPhase;
+    std::string mName;
+    int64_t mBeginTime;
+    int64_t mEndTime;
+    bool mSuccess;
+    std::string mError;
+};
+
+/*
+ * @brief
+ * @class: ClientStartup
+ *
+ * Runs startup steps (client Init, channel creation, lease wait, ...)
+ * grouped in phases. Phases run in the order they are first added, steps
+ * of one phase run concurrently, so the channel matching waits of all
+ * clients overlap instead of adding up. Each step is recorded in a
+ * timeline.
+ *
+ *   ClientStartup startup;
+ *   startup.AddClient("init", "loco", loco);
+ *   startup.AddClient("init", "audio", audio);
+ *   startup.Add("init", "lowcmd", [&]() { publisher->InitChannel(); });
+ *   startup.Run();
+ *   startup.Mark("first command");
+ *   std::cout << startup.ToString();
+ */
+class ClientStartup
+{
+public:
+    using StartupFunc = std::function<void()>;
+
+    explicit ClientStartup() :
+        mBeginTime(common::GetCurrentMonotonicTimeMicrosecond())
+    {}
+
+    ~ClientStartup()
+    {}
+
+    void Add(const std::string& phase, const std::string& name, const StartupFunc& func)
+    {
+        auto iter = std::find(mPhaseList.begin(), mPhaseList.end(), phase);
+        if (iter == mPhaseList.end())
+        {
+            mPhaseList.push_back(phase);
+        }
+
+        mStepList.push_back(Step(phase, name, func));
+    }
+
+    void AddClient(const std::string& phase, const std::string& name, ClientBase& client)
+    {
+        Add(phase, name, [&client]() {
+            client.Init();
+        });
+    }
+
+    void AddLease(const std::string& phase, const std::string& name, Client& client)
+    {
+        Add(phase, name, [&client]() {
+            client.WaitLeaseApplied();
+        });
+    }
+
+    /*
+     * Run all phases. Returns false if any step threw; later phases still run.
+     */
+    bool Run()
+    {
+        bool success = true;
+
+        for (const std::string& phase : mPhaseList)
+        {
+            std::vector<size_t> indexList;
+            for (size_t i=0; i<mStepList.size(); i++)
+            {
+                if (mStepList[i].mPhase == phase)
+                {
+                    indexList.push_back(i);
+                }
+            }
+
+            std::vector<StartupEvent> eventList(indexList.size());
+            std::vector<common::ThreadPtr> threadList;
+
+            int64_t phaseBegin = Now();
+
+            for (size_t i=1; i<indexList.size(); i++)
+            {
+                threadList.push_back(common::CreateThreadEx("startup", UT_CPU_ID_NONE,
+                    &ClientStartup::RunStep, this, std::cref(mStepList[indexList[i]]), std::ref(eventList[i])));
+            }
+
+            /*
+             * first step runs on the calling thread
+             */
+            if (!indexList.empty())
+            {
+                RunStep(mStepList[indexList[0]], eventList[0]);
+            }
+
+            for (auto& threadPtr : threadList)
+            {
+                threadPtr->Wait();
+            }
+
+            StartupEvent phaseEvent;
+            phaseEvent.mPhase = phase;
+            phaseEvent.mBeginTime = phaseBegin;
+            phaseEvent.mEndTime = Now();
+
+            for (const StartupEvent& event : eventList)
+            {
+                phaseEvent.mSuccess = phaseEvent.mSuccess && event.mSuccess;
+            }
+
+            success = success && phaseEvent.mSuccess;
+
+            common::LockGuard<common::Mutex> lock(mMutex);
+            mTimeline.insert(mTimeline.end(), eventList.begin(), eventList.end());
+            mTimeline.push_back(phaseEvent);
+        }
+
+        mPhaseList.clear();
+        mStepList.clear();
+
+        return success;
+    }
+
+    /*
+     * Record an instant event, e.g. first accepted command.
+     */
+    void Mark(const std::string& name)
+    {
+        StartupEvent event;
+        event.mName = name;
+        event.mBeginTime = event.mEndTime = Now();
+
+        common::LockGuard<common::Mutex> lock(mMutex);
+        mTimeline.push_back(event);
+    }
+
+    std::vector<StartupEvent> GetTimeline()
+    {
+        common::LockGuard<common::Mutex> lock(mMutex);
+        return mTimeline;
+    }
+
+    std::string ToString()
+    {
+        common::LockGuard<common::Mutex> lock(mMutex);
+
+        std::ostringstream os;
+        os << "startup timeline (ms)" << std::endl;
+
+        for (const StartupEvent& event : mTimeline)
+        {
+            os << "  " << std::fixed << std::setprecision(1)
+                << std::setw(8) << event.mBeginTime / 1000.0 << " "
+                << std::setw(8) << event.mEndTime / 1000.0 << " "
+                << std::setw(8) << (event.mEndTime - event.mBeginTime) / 1000.0 << "  ";
+
+            if (event.mName.empty())
+            {
+                os << "[" << event.mPhase << "]";
+            }
+            else if (event.mPhase.empty())
+            {
+                os << "* " << event.mName;
+            }
+            else
+            {
+                os << "  " << event.mPhase << "/" << event.mName;
+            }
+
+            if (!event.mSuccess)
+            {
+                os << " FAILED " << event.mError;
+            }
+
+            os << std::endl;
+        }
+
+        return os.str();
+    }
+
+private:
+    struct Step
+    {
+        Step(const std::string& phase, const std::string& name, const StartupFunc& func) :
+            mPhase(phase), mName(name), mFunc(func)
+        {}
+
+        std::string mPhase;
+        std::string mName;
+        StartupFunc mFunc;
+    };
+
+    int64_t Now() const
+    {
+        return (int64_t)common::GetCurrentMonotonicTimeMicrosecond() - mBeginTime;
+    }
+
+    int32_t RunStep(const Step& step, StartupEvent& event)
+    {
+        event.mPhase = step.mPhase;
+        event.mName = step.mName;
+        event.mBeginTime = Now();
+
+        try
+        {
+            step.mFunc();
+        }
+        catch (const std::exception& e)
+        {
+            event.mSuccess = false;
+            event.mError = e.what();
+        }
+
+        event.mEndTime = Now();
+
+        return 0;
+    }
+
+private:
+    int64_t mBeginTime;
+    std::vector<std::string> mPhaseList;
+    std::vector<Step> mStepList;
+
+    common::Mutex mMutex;
+    std::vector<StartupEvent> mTimeline;
+};
+
+}
+}
+
+#endif//__UT_ROBOT_SDK_CLIENT_STARTUP_HPP__
@@ -0,0 +1,516 @@
+#ifndef __UT_ROBOT_SDK_ROUTED_CLIENT_HPP__
+#define __UT_ROBOT_SDK_ROUTED_CLIENT_HPP__
+
+#include <unitree/robot/client/client.hpp>
+#include <unitree/robot/client/routed_client_stub.hpp>
+#include <unitree/common/thread/recurrent_thread.hpp>
+
+namespace unitree
+{
+namespace robot
+{
+/*
+ * @brief  tick of the traffic lease thread of RoutedClient.
+ * @value: 50000 us
+ */
+const int64_t ROBOT_CLIENT_LEASE_INTERVAL = 50000;
+
+/*
+ * @brief
+ * @class: RoutedClient
+ *
+ * Client that can send its api calls through a RoutedClientStub instead of
+ * the broadcast ClientStub of ClientBase. Routing is off until
+ * EnableResponseRouting is called, so the default behaviour is unchanged.
+ *
+ * Routing does not save cpu: ClientBase always creates its ClientStub,
+ * which stays subscribed to the shared response topic and still takes
+ * every response. A routed client adds a second, filtered reader on top.
+ * What routing gives is request ids tagged per client and a response
+ * path that only completes this client's own requests.
+ *
+ * EnableTrafficLease takes the lease of an ExecutorServer over the service
+ * channel. Every request carries the lease id and renews it on the server,
+ * so the renewal request is only sent when the client has been idle.
+ *
+ * Client and ClientBase are implemented in the prebuilt library and their
+ * layout is fixed, so the routed stub lives in this derived class and the
+ * Call overloads used by service clients are shadowed here.
+ */
+class RoutedClient : public Client
+{
+public:
+    explicit RoutedClient(const std::string& name, bool enableLease = false) :
+        Client(name, enableLease), mName(name), mTimeout(ROBOT_CLIENT_TIMEOUT), mTrafficLease(false),
+        mLeaseId(0), mLeaseTerm(0), mLeaseSendTime(0), mRenewalTime(0), mRenewalCount(0), mRenewalSkipCount(0)
+    {}
+
+    virtual ~RoutedClient()
+    {
+        mLeaseThreadPtr.reset();
+    }
+
+    /*
+     * Create the routed response reader. Call before the client is used
+     * from more than one thread.
+     */
+    void EnableResponseRouting()
+    {
+        if (!mRoutedStubPtr)
+        {
+            mRoutedStubPtr = RoutedClientStubPtr(new RoutedClientStub());
+            mRoutedStubPtr->Init(mName);
+        }
+    }
+
+    bool IsResponseRouting() const
+    {
+        return (bool)mRoutedStubPtr;
+    }
+
+    /*
+     * Take the lease of an ExecutorServer started with StartLease, instead
+     * of the LeaseServer of Server. Construct with enableLease false. Call
+     * after EnableResponseRouting, if used, and before the client is used.
+     */
+    void EnableTrafficLease()
+    {
+        if (mTrafficLease)
+        {
+            return;
+        }
+
+        mTrafficLease = true;
+        mLeaseThreadPtr = common::CreateRecurrentThreadEx(mName.substr(0, 8) + "_ls", UT_CPU_ID_NONE,
+            ROBOT_CLIENT_LEASE_INTERVAL, &RoutedClient::LeaseThreadFunction, this);
+    }
+
+    bool IsTrafficLease() const
+    {
+        return mTrafficLease;
+    }
+
+    void WaitLeaseApplied()
+    {
+        if (!mTrafficLease)
+        {
+            Client::WaitLeaseApplied();
+            return;
+        }
+
+        while (mLeaseId.load() == 0)
+        {
+            common::MicroSleep(ROBOT_CLIENT_LEASE_INTERVAL);
+        }
+    }
+
+    int64_t GetLeaseId()
+    {
+        return mTrafficLease ? mLeaseId.load() : Client::GetLeaseId();
+    }
+
+    /*
+     * explicit renewals sent, and skipped because requests renewed the lease.
+     */
+    uint64_t GetLeaseRenewalCount() const
+    {
+        return mRenewalCount.load(std::memory_order_relaxed);
+    }
+
+    uint64_t GetLeaseRenewalSkipCount() const
+    {
+        return mRenewalSkipCount.load(std::memory_order_relaxed);
+    }
+
+    const RoutedClientStubPtr& GetRoutedStub() const
+    {
+        return mRoutedStubPtr;
+    }
+
+    void SetTimeout(int64_t timeout)
+    {
+        mTimeout = timeout;
+        Client::SetTimeout(timeout);
+    }
+
+    void SetTimeout(float timeout)
+    {
+        mTimeout = (int64_t)(timeout * 1000000);
+        Client::SetTimeout(timeout);
+    }
+
+protected:
+    int32_t Call(int32_t apiId, const std::string& parameter, std::string& data)
+    {
+        if (!mRoutedStubPtr && !mTrafficLease)
+        {
+            return Client::Call(apiId, parameter, data);
+        }
+
+        int32_t priority = 0;
+        int64_t leaseId = 0;
+
+        int32_t ret = GetCallContext(apiId, priority, leaseId);
+        if (ret != UT_ROBOT_OK)
+        {
+            return ret;
+        }
+
+        if (!mRoutedStubPtr)
+        {
+            return CheckLeaseResult(ClientBase::Call(apiId, parameter, data, priority, leaseId), leaseId);
+        }
+
+        Request req;
+        SetRequestHeader(req, apiId, priority, leaseId, false);
+        req.parameter(parameter);
+
+        ResponsePtr response;
+        ret = CallRouted(req, apiId, response);
+        if (ret == UT_ROBOT_OK)
+        {
+            data = response->data();
+        }
+
+        return CheckLeaseResult(ret, leaseId);
+    }
+
+    int32_t Call(int32_t apiId, const std::string& parameter)
+    {
+        if (!mRoutedStubPtr && !mTrafficLease)
+        {
+            return Client::Call(apiId, parameter);
+        }
+
+        int32_t priority = 0;
+        int64_t leaseId = 0;
+
+        int32_t ret = GetCallContext(apiId, priority, leaseId);
+        if (ret != UT_ROBOT_OK)
+        {
+            return ret;
+        }
+
+        if (!mRoutedStubPtr)
+        {
+            return ClientBase::Call(apiId, parameter, priority, leaseId);
+        }
+
+        Request req;
+        SetRequestHeader(req, apiId, priority, leaseId, true);
+        req.parameter(parameter);
+
+        return mRoutedStubPtr->Send(req, mTimeout) ? UT_ROBOT_OK : UT_ROBOT_ERR_CLIENT_SEND;
+    }
+
+    int32_t Call(int32_t apiId, const std::vector<uint8_t>& parameter, std::vector<uint8_t>& data)
+    {
+        if (!mRoutedStubPtr && !mTrafficLease)
+        {
+            return Client::Call(apiId, parameter, data);
+        }
+
+        int32_t priority = 0;
+        int64_t leaseId = 0;
+
+        int32_t ret = GetCallContext(apiId, priority, leaseId);
+        if (ret != UT_ROBOT_OK)
+        {
+            return ret;
+        }
+
+        if (!mRoutedStubPtr)
+        {
+            return CheckLeaseResult(ClientBase::Call(apiId, parameter, data, priority, leaseId), leaseId);
+        }
+
+        Request req;
+        SetRequestHeader(req, apiId, priority, leaseId, false);
+        req.binary(parameter);
+
+        ResponsePtr response;
+        ret = CallRouted(req, apiId, response);
+        if (ret == UT_ROBOT_OK)
+        {
+            data = response->binary();
+        }
+
+        return CheckLeaseResult(ret, leaseId);
+    }
+
+    int32_t Call(int32_t apiId, const std::vector<uint8_t>& parameter)
+    {
+        if (!mRoutedStubPtr && !mTrafficLease)
+        {
+            return Client::Call(apiId, parameter);
+        }
+
+        int32_t priority = 0;
+        int64_t leaseId = 0;
+
+        int32_t ret = GetCallContext(apiId, priority, leaseId);
+        if (ret != UT_ROBOT_OK)
+        {
+            return ret;
+        }
+
+        if (!mRoutedStubPtr)
+        {
+            return ClientBase::Call(apiId, parameter, priority, leaseId);
+        }
+
+        Request req;
+        SetRequestHeader(req, apiId, priority, leaseId, true);
+        req.binary(parameter);
+
+        return mRoutedStubPtr->Send(req, mTimeout) ? UT_ROBOT_OK : UT_ROBOT_ERR_CLIENT_SEND;
+    }
+
+    int32_t Call(int32_t apiId, const std::string& parameter, const std::vector<uint8_t>& binary)
+    {
+        if (!mRoutedStubPtr && !mTrafficLease)
+        {
+            return Client::Call(apiId, parameter, binary);
+        }
+
+        int32_t priority = 0;
+        int64_t leaseId = 0;
+
+        int32_t ret = GetCallContext(apiId, priority, leaseId);
+        if (ret != UT_ROBOT_OK)
+        {
+            return ret;
+        }
+
+        if (!mRoutedStubPtr)
+        {
+            return CheckLeaseResult(ClientBase::Call(apiId, parameter, binary, priority, leaseId), leaseId);
+        }
+
+        Request req;
+        SetRequestHeader(req, apiId, priority, leaseId, false);
+        req.parameter(parameter);
+        req.binary(binary);
+
+        ResponsePtr response;
+        return CheckLeaseResult(CallRouted(req, apiId, response), leaseId);
+    }
+
+    /*
+     * Call with binary in caller memory, e.g. a ChunkView. The routed path
+     * copies it once, into the request. ClientBase::Call of the broadcast
+     * path takes a vector, so the binary is staged in a per-thread buffer
+     * that is reused across calls.
+     */
+    int32_t Call(int32_t apiId, const std::string& parameter, const uint8_t* binary, size_t size)
+    {
+        if (!mRoutedStubPtr)
+        {
+            thread_local std::vector<uint8_t> buffer;
+            buffer.assign(binary, binary + size);
+            return Call(apiId, parameter, buffer);
+        }
+
+        int32_t priority = 0;
+        int64_t leaseId = 0;
+
+        int32_t ret = GetCallContext(apiId, priority, leaseId);
+        if (ret != UT_ROBOT_OK)
+        {
+            return ret;
+        }
+
+        Request req;
+        SetRequestHeader(req, apiId, priority, leaseId, false);
+        req.parameter(parameter);
+        req.binary().assign(binary, binary + size);
+
+        ResponsePtr response;
+        return CheckLeaseResult(CallRouted(req, apiId, response), leaseId);
+    }
+
+    /*
+     * Client::CallChunked, sending its frames through the Call overloads
+     * of this class.
+     */
+    ChunkedTransferPtr CallChunked(int32_t apiId, const std::string& parameter, const uint8_t* data, size_t size,
+        const ChunkedTransferOption& option = ChunkedTransferOption())
+    {
+        uint64_t transferId = MakeChunkedTransferId(this);
+
+        ChunkedTransferPtr transferPtr(new ChunkedTransfer(data, size, [this, apiId, parameter, transferId](const ChunkView& chunk) {
+            std::vector<uint8_t> frame, reply;
+            EncodeChunkFrame(transferId, parameter, chunk, frame);
+            return Call(apiId, frame, reply);
+        }, option));
+
+        transferPtr->Start();
+        return transferPtr;
+    }
+
+private:
+    /*
+     * CheckApi, with the traffic lease id in place of the Client lease.
+     */
+    int32_t GetCallContext(int32_t apiId, int32_t& priority, int64_t& leaseId)
+    {
+        int32_t ret = CheckApi(apiId, priority, leaseId);
+        if (ret != UT_ROBOT_OK)
+        {
+            return ret;
+        }
+
+        if (mTrafficLease)
+        {
+            leaseId = mLeaseId.load();
+            if (leaseId != 0)
+            {
+                mLeaseSendTime.store((int64_t)common::GetCurrentMonotonicTimeMicrosecond(), std::memory_order_relaxed);
+            }
+        }
+
+        return UT_ROBOT_OK;
+    }
+
+    /*
+     * A denied lease is dropped, so the lease thread applies again.
+     */
+    int32_t CheckLeaseResult(int32_t ret, int64_t leaseId)
+    {
+        if (ret == UT_ROBOT_ERR_SERVER_LEASE_DENIED && mTrafficLease && leaseId != 0)
+        {
+            mLeaseId.compare_exchange_strong(leaseId, 0);
+        }
+
+        return ret;
+    }
+
+    void SetRequestHeader(Request& req, int32_t apiId, int32_t priority, int64_t leaseId, bool noReply)
+    {
+        SetHeader(req.header(), apiId, leaseId, priority, noReply);
+        req.header().identity().id(mRoutedStubPtr->GenerateRequestId());
+    }
+
+    int32_t CallRouted(const Request& req, int32_t apiId, ResponsePtr& response)
+    {
+        int32_t ret = mRoutedStubPtr->Call(req, response, mTimeout);
+        if (ret != UT_ROBOT_OK)
+        {
+            return ret;
+        }
+
+        if (response->header().identity().api_id() != apiId)
+        {
+            return UT_ROBOT_ERR_CLIENT_API_NOT_MATCH;
+        }
+
+        return response->header().status().code();
+    }
+
+    /*
+     * Lease apply and renewal are not registered apis, so they skip CheckApi.
+     */
+    int32_t CallLease(int32_t apiId, const std::string& parameter, std::string& data, int64_t leaseId)
+    {
+        if (!mRoutedStubPtr)
+        {
+            return ClientBase::Call(apiId, parameter, data, 0, leaseId);
+        }
+
+        Request req;
+        SetRequestHeader(req, apiId, 0, leaseId, false);
+        req.parameter(parameter);
+
+        ResponsePtr response;
+        int32_t ret = CallRouted(req, apiId, response);
+        if (ret == UT_ROBOT_OK)
+        {
+            data = response->data();
+        }
+
+        return ret;
+    }
+
+    void ApplyLease(int64_t now)
+    {
+        ApplyLeaseParameter parameter;
+        parameter.name = mName + "/" + std::to_string(getpid()) + "/" + std::to_string((uintptr_t)this);
+
+        std::string data;
+        if (CallLease(ROBOT_API_ID_LEASE_APPLY, common::ToJsonString(parameter), data, 0) != UT_ROBOT_OK)
+        {
+            return;
+        }
+
+        ApplyLeaseData leaseData;
+        try
+        {
+            common::FromJsonString(data, leaseData);
+        }
+        catch(const common::Exception& e)
+        {
+            return;
+        }
+
+        mRenewalTime = now;
+        mLeaseTerm.store(leaseData.term);
+        mLeaseId.store(leaseData.id);
+    }
+
+    /*
+     * Renew once a third of the term has passed, unless a request carried
+     * the lease within that time and renewed it on the server already.
+     */
+    void LeaseThreadFunction()
+    {
+        int64_t now = (int64_t)common::GetCurrentMonotonicTimeMicrosecond();
+        int64_t leaseId = mLeaseId.load();
+
+        if (leaseId == 0)
+        {
+            ApplyLease(now);
+            return;
+        }
+
+        int64_t interval = mLeaseTerm.load() / 3;
+        if (now - mRenewalTime < interval)
+        {
+            return;
+        }
+
+        mRenewalTime = now;
+
+        if (now - mLeaseSendTime.load(std::memory_order_relaxed) < interval)
+        {
+            mRenewalSkipCount.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        std::string data;
+        int32_t ret = CallLease(ROBOT_API_ID_LEASE_RENEWAL, "", data, leaseId);
+        mRenewalCount.fetch_add(1, std::memory_order_relaxed);
+
+        CheckLeaseResult(ret, leaseId);
+    }
+
+private:
+    std::string mName;
+    int64_t mTimeout;
+    RoutedClientStubPtr mRoutedStubPtr;
+
+    bool mTrafficLease;
+    std::atomic<int64_t> mLeaseId;
+    std::atomic<int64_t> mLeaseTerm;
+    std::atomic<int64_t> mLeaseSendTime;
+    int64_t mRenewalTime;
+    std::atomic<uint64_t> mRenewalCount;
+    std::atomic<uint64_t> mRenewalSkipCount;
+    common::ThreadPtr mLeaseThreadPtr;
+};
+
+using RoutedClientPtr = std::shared_ptr<RoutedClient>;
+
+}
+}
+
+#endif//__UT_ROBOT_SDK_ROUTED_CLIENT_HPP__
@@ -0,0 +1,228 @@
+#ifndef __UT_ROBOT_SDK_ROUTED_CLIENT_STUB_HPP__
+#define __UT_ROBOT_SDK_ROUTED_CLIENT_STUB_HPP__
+
+#include <unitree/robot/future/request_future.hpp>
+#include <unitree/robot/channel/channel_factory.hpp>
+#include <unitree/robot/channel/channel_namer.hpp>
+#include <unitree/common/time/time_tool.hpp>
+#include <unistd.h>
+
+namespace unitree
+{
+namespace robot
+{
+/*
+ * @brief: bits of request id used as client tag.
+ * @value: 16
+ */
+const int32_t ROBOT_CLIENT_TAG_BITS = 16;
+
+/*
+ * @brief: shift of client tag in request id. keep the sign bit clear.
+ * @value: 47
+ */
+const int32_t ROBOT_CLIENT_TAG_SHIFT = 63 - ROBOT_CLIENT_TAG_BITS;
+
+/*
+ * @brief: mask of the sequence part of request id.
+ * @value: (1 << 47) - 1
+ */
+const int64_t ROBOT_CLIENT_SEQUENCE_MASK = (int64_t(1) << ROBOT_CLIENT_TAG_SHIFT) - 1;
+
+/*
+ * @brief: RequestIdentity helpers.
+ *         request id = [0][client tag:16][sequence:47]
+ */
+inline int32_t GetRequestClientTag(int64_t requestId)
+{
+    return (int32_t)((requestId >> ROBOT_CLIENT_TAG_SHIFT) & ((1 << ROBOT_CLIENT_TAG_BITS) - 1));
+}
+
+inline int64_t MakeRequestId(int32_t clientTag, int64_t sequence)
+{
+    return ((int64_t)(clientTag & ((1 << ROBOT_CLIENT_TAG_BITS) - 1)) << ROBOT_CLIENT_TAG_SHIFT) | (sequence & ROBOT_CLIENT_SEQUENCE_MASK);
+}
+
+/*
+ * @brief
+ * @class: RoutedClientStub
+ *
+ * Client stub whose response reader only accepts responses for requests
+ * it has in flight. The pending request set is checked by a dds content
+ * filter, so this reader drops foreign responses before its history,
+ * listener, copy and future lookup. The filter runs on the deserialized
+ * sample, so foreign responses are still decoded once.
+ *
+ * This only saves cpu in a process where no ClientStub subscribes the
+ * same service. RoutedClient keeps the ClientStub of ClientBase, so it
+ * still receives every response through that reader as well.
+ *
+ * Request ids carry a client tag in the high bits, which keeps ids of
+ * different processes disjoint and lets servers identify the requester.
+ */
+class RoutedClientStub
+{
+public:
+    explicit RoutedClientStub() :
+        mClientTag(0), mSequence(0), mRejectCount(0)
+    {}
+
+    ~RoutedClientStub()
+    {
+        mRecvChannelPtr.reset();
+        mSendChannelPtr.reset();
+    }
+
+    void Init(const std::string& name)
+    {
+        mClientTag = (int32_t)((getpid() * 2654435761u) ^ (uintptr_t)this) & ((1 << ROBOT_CLIENT_TAG_BITS) - 1);
+        mSequence = common::GetCurrentMonotonicTimeNanosecond() & ROBOT_CLIENT_SEQUENCE_MASK;
+
+        std::string sendChannelName = ROBOT_SDK_CHANNEL_PREFIX + name + ROBOT_SDK_CHANNEL_SUFFIX_CLIENT;
+        std::string recvChannelName = ROBOT_SDK_CHANNEL_PREFIX + name + ROBOT_SDK_CHANNEL_SUFFIX_SERVER;
+
+        mSendChannelPtr = ChannelFactory::Instance()->CreateSendChannel<Request>(sendChannelName);
+        mRecvChannelPtr = ChannelFactory::Instance()->CreateRecvChannel<Response>(recvChannelName,
+            std::bind(&RoutedClientStub::ResponseFilter, this, std::placeholders::_1),
+            std::bind(&RoutedClientStub::ResponseFunc, this, std::placeholders::_1));
+    }
+
+    int32_t GetClientTag() const
+    {
+        return mClientTag;
+    }
+
+    /*
+     * Next request id of this client.
+     */
+    int64_t GenerateRequestId()
+    {
+        return MakeRequestId(mClientTag, ++mSequence);
+    }
+
+    bool Send(const Request& req, int64_t waitTimeout)
+    {
+        return mSendChannelPtr->Write(req, waitTimeout);
+    }
+
+    /*
+     * Send request and return its future, or an empty pointer if write failed.
+     * A future whose response never arrives must be released by Cancel.
+     */
+    RequestFuturePtr SendRequest(const Request& req, int64_t waitTimeout)
+    {
+        int64_t requestId = req.header().identity().id();
+        RequestFuturePtr futurePtr(new RequestFuture(requestId));
+
+        {
+            common::LockGuard<common::Mutex> lock(mMutex);
+            mFutureMap[requestId] = futurePtr;
+        }
+
+        if (!mSendChannelPtr->Write(req, waitTimeout))
+        {
+            Cancel(requestId);
+            return RequestFuturePtr();
+        }
+
+        return futurePtr;
+    }
+
+    void Cancel(int64_t requestId)
+    {
+        common::LockGuard<common::Mutex> lock(mMutex);
+        mFutureMap.erase(requestId);
+    }
+
+    /*
+     * Send request and wait response.
+     */
+    int32_t Call(const Request& req, ResponsePtr& response, int64_t timeout)
+    {
+        RequestFuturePtr futurePtr = SendRequest(req, timeout);
+        if (!futurePtr)
+        {
+            return UT_ROBOT_ERR_CLIENT_SEND;
+        }
+
+        response = futurePtr->GetResponse(timeout);
+        Cancel(req.header().identity().id());
+
+        if (!response)
+        {
+            return UT_ROBOT_ERR_CLIENT_API_TIMEOUT;
+        }
+
+        return UT_ROBOT_OK;
+    }
+
+    size_t GetPendingSize()
+    {
+        common::LockGuard<common::Mutex> lock(mMutex);
+        return mFutureMap.size();
+    }
+
+    /*
+     * Responses of other clients dropped by the filter.
+     */
+    uint64_t GetRejectCount() const
+    {
+        return mRejectCount.load(std::memory_order_relaxed);
+    }
+
+private:
+    bool ResponseFilter(const Response& response)
+    {
+        int64_t requestId = response.header().identity().id();
+        if (GetRequestClientTag(requestId) == mClientTag)
+        {
+            common::LockGuard<common::Mutex> lock(mMutex);
+            if (mFutureMap.find(requestId) != mFutureMap.end())
+            {
+                return true;
+            }
+        }
+
+        mRejectCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    void ResponseFunc(const void* message)
+    {
+        const Response* response = (const Response*)message;
+        int64_t requestId = response->header().identity().id();
+
+        RequestFuturePtr futurePtr;
+        {
+            common::LockGuard<common::Mutex> lock(mMutex);
+            auto iter = mFutureMap.find(requestId);
+            if (iter == mFutureMap.end())
+            {
+                return;
+            }
+
+            futurePtr = iter->second;
+            mFutureMap.erase(iter);
+        }
+
+        futurePtr->Ready(ResponsePtr(new Response(*response)));
+    }
+
+private:
+    int32_t mClientTag;
+    std::atomic<int64_t> mSequence;
+    std::atomic<uint64_t> mRejectCount;
+
+    common::Mutex mMutex;
+    std::unordered_map<int64_t,RequestFuturePtr> mFutureMap;
+
+    ChannelPtr<Request> mSendChannelPtr;
+    ChannelPtr<Response> mRecvChannelPtr;
+};
+
+using RoutedClientStubPtr = std::shared_ptr<RoutedClientStub>;
+
+}
+}
+
+#endif//__UT_ROBOT_SDK_ROUTED_CLIENT_STUB_HPP__
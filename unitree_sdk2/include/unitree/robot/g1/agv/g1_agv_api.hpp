@@ -1,7 +1,7 @@
 #ifndef __UT_ROBOT_G1_AGV_API_HPP__
 #define __UT_ROBOT_G1_AGV_API_HPP__
 
-#include <unitree/common/json/jsonize.hpp>
+#include <unitree/common/json/json_binding.hpp>
 
 using namespace unitree::common;
 
@@ -33,19 +33,15 @@ public:
     {}
 
 public:
-    void fromJson(JsonMap& json)
+    template<typename Binder>
+    void jsonFields(Binder& b)
     {
-        FromJson(json["vx"], vx);
-        FromJson(json["vy"], vy);
-        FromJson(json["vyaw"], vyaw);
+        b("vx", vx);
+        b("vy", vy);
+        b("vyaw", vyaw);
     }
 
-    void toJson(JsonMap& json) const
-    {
-        ToJson(vx, json["vx"]);
-        ToJson(vy, json["vy"]);
-        ToJson(vyaw, json["vyaw"]);
-    }
+    UT_JSONIZE_FIELDS()
 
 public:
     float vx;
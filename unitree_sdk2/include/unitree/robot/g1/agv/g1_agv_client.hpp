@@ -1,7 +1,7 @@
 #ifndef __UT_ROBOT_G1_AGV_CLIENT_HPP__
 #define __UT_ROBOT_G1_AGV_CLIENT_HPP__
 
-#include <unitree/robot/client/client.hpp>
+#include <unitree/robot/client/routed_client.hpp>
 #include <unitree/robot/go2/public/jsonize_type.hpp>
 #include "g1_agv_api.hpp"
 
@@ -10,9 +10,9 @@ namespace robot {
 namespace g1 {
 
 
-class AgvClient : public Client {
+class AgvClient : public RoutedClient {
 public:
-    AgvClient() : Client(AGV_SERVICE_NAME, false) {}
+    AgvClient() : RoutedClient(AGV_SERVICE_NAME, false) {}
     ~AgvClient() {}
 
     /*Init*/
@@ -60,7 +60,7 @@ public:
         param.vy = vy;
         param.vyaw = vyaw;
 
-        std::string parameter = common::ToJsonString(param);
+        std::string parameter = common::ToJsonStringDirect(param);
         std::string data;
 
         return Call(ROBOT_API_ID_AGV_MOVE, parameter, data);
@@ -96,7 +96,7 @@ public:
         go2::JsonizeDataFloat json;
         json.data = vz;
 
-        parameter = common::ToJsonString(json);
+        parameter = common::ToJsonStringDirect(json);
 
         return Call(ROBOT_API_ID_AGV_HEIGHT_ADJUST, parameter, data);
     }
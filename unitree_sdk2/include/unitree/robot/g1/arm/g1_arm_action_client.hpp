@@ -1,6 +1,6 @@
 #pragma once
 
-#include <unitree/robot/client/client.hpp>
+#include <unitree/robot/client/routed_client.hpp>
 #include <unitree/robot/go2/public/jsonize_type.hpp>
 #include "g1_arm_action_api.hpp"
 
@@ -21,9 +21,9 @@ namespace g1 {
    *   "name": "release_arm" # Current action name
    * }
    */
-class G1ArmActionClient : public Client {
+class G1ArmActionClient : public RoutedClient {
   public:
-    G1ArmActionClient() : Client(ARM_ACTION_SERVICE_NAME, false) {}
+    G1ArmActionClient() : RoutedClient(ARM_ACTION_SERVICE_NAME, false) {}
     ~G1ArmActionClient() {}
   
     /*Init*/
@@ -1,7 +1,7 @@
 #ifndef __UT_ROBOT_G1_AUDIO_API_HPP__
 #define __UT_ROBOT_G1_AUDIO_API_HPP__
 
-#include <unitree/common/json/jsonize.hpp>
+#include <unitree/common/json/json_binding.hpp>
 // #include <variant>
 
 namespace unitree {
@@ -22,19 +22,23 @@ const int32_t ROBOT_API_ID_AUDIO_GET_VOLUME = 1005;
 const int32_t ROBOT_API_ID_AUDIO_SET_VOLUME = 1006;
 const int32_t ROBOT_API_ID_AUDIO_SET_RGB_LED = 1010;
 
+/*stream chunk size: 3 seconds of 16kHz mono 16bit pcm*/
+const size_t AUDIO_STREAM_CHUNK_SIZE = 96000;
+
 class TtsMakerParameter : public common::Jsonize {
  public:
   TtsMakerParameter() {}
   ~TtsMakerParameter() {}
 
-  void fromJson(common::JsonMap &json) {}
-
-  void toJson(common::JsonMap &json) const {
-    common::ToJson(index, json["index"]);
-    common::ToJson(speaker_id, json["speaker_id"]);
-    common::ToJson(text, json["text"]);
+  template <typename Binder>
+  void jsonFields(Binder &b) {
+    b("index", index);
+    b("speaker_id", speaker_id);
+    b("text", text);
   }
 
+  UT_JSONIZE_FIELDS()
+
   int32_t index = 0;
   uint16_t speaker_id = 0;
   std::string text;
@@ -45,13 +49,14 @@ class PlayStreamParameter : public common::Jsonize {
   PlayStreamParameter() {}
   ~PlayStreamParameter() {}
 
-  void fromJson(common::JsonMap &json) {}
-
-  void toJson(common::JsonMap &json) const {
-    common::ToJson(app_name, json["app_name"]);
-    common::ToJson(stream_id, json["stream_id"]);
+  template <typename Binder>
+  void jsonFields(Binder &b) {
+    b("app_name", app_name);
+    b("stream_id", stream_id);
   }
 
+  UT_JSONIZE_FIELDS()
+
   std::string app_name;
   std::string stream_id;
 };
@@ -61,12 +66,13 @@ class PlayStopParameter : public common::Jsonize {
   PlayStopParameter() {}
   ~PlayStopParameter() {}
 
-  void fromJson(common::JsonMap &json) {}
-
-  void toJson(common::JsonMap &json) const {
-    common::ToJson(app_name, json["app_name"]);
+  template <typename Binder>
+  void jsonFields(Binder &b) {
+    b("app_name", app_name);
   }
 
+  UT_JSONIZE_FIELDS()
+
   std::string app_name;
 };
 
@@ -75,14 +81,15 @@ class LedControlParameter : public common::Jsonize {
   LedControlParameter() {}
   ~LedControlParameter() {}
 
-  void fromJson(common::JsonMap &json) {}
-
-  void toJson(common::JsonMap &json) const {
-    common::ToJson(R, json["R"]);
-    common::ToJson(G, json["G"]);
-    common::ToJson(B, json["B"]);
+  template <typename Binder>
+  void jsonFields(Binder &b) {
+    b("R", R);
+    b("G", G);
+    b("B", B);
   }
 
+  UT_JSONIZE_FIELDS()
+
   uint8_t R;
   uint8_t G;
   uint8_t B;
@@ -2,7 +2,8 @@
 #define __UT_ROBOT_G1_AUDIO_CLIENT_HPP__
 
 #include <limits>
-#include <unitree/robot/client/client.hpp>
+#include <unitree/robot/client/routed_client.hpp>
+#include <unitree/robot/client/client_cache.hpp>
 #include <unitree/robot/go2/public/jsonize_type.hpp>
 
 #include "g1_audio_api.hpp"
@@ -10,9 +11,9 @@
 namespace unitree {
 namespace robot {
 namespace g1 {
-class AudioClient : public Client {
+class AudioClient : public RoutedClient {
  public:
-  AudioClient() : Client(AUDIO_SERVICE_NAME, false) {}
+  AudioClient() : RoutedClient(AUDIO_SERVICE_NAME, false) {}
   ~AudioClient() {}
 
   /*Init*/
@@ -25,8 +26,20 @@ class AudioClient : public Client {
     UT_ROBOT_CLIENT_REG_API_NO_PROI(ROBOT_API_ID_AUDIO_GET_VOLUME);
     UT_ROBOT_CLIENT_REG_API_NO_PROI(ROBOT_API_ID_AUDIO_SET_VOLUME);
     UT_ROBOT_CLIENT_REG_API_NO_PROI(ROBOT_API_ID_AUDIO_SET_RGB_LED);
+
+    cache_.SetApiInvalidation(ROBOT_API_ID_AUDIO_SET_VOLUME, ROBOT_API_ID_AUDIO_GET_VOLUME);
   };
 
+  /*
+   * Serve GetVolume from a client side cache refreshed at most once per
+   * ttl (microseconds). SetVolume of this client invalidates it.
+   */
+  void EnableCache(int64_t ttl = ROBOT_CLIENT_CACHE_TTL) {
+    cache_.SetApiTtl(ROBOT_API_ID_AUDIO_GET_VOLUME, ttl);
+  }
+
+  ClientCache& GetCache() { return cache_; }
+
   /*API Call*/
   int32_t TtsMaker(const std::string& text, int32_t speaker_id) {
     std::string parameter, data;
@@ -35,23 +48,25 @@ class AudioClient : public Client {
     json.index = tts_index++;
     json.text = text;
     json.speaker_id = speaker_id;
-    parameter = common::ToJsonString(json);
+    parameter = common::ToJsonStringDirect(json);
 
     return Call(ROBOT_API_ID_AUDIO_TTS, parameter, data);
   }
 
   int32_t GetVolume(uint8_t& volume) {
-    std::string parameter, data;
-
-    int32_t ret = Call(ROBOT_API_ID_AUDIO_GET_VOLUME, parameter, data);
-    if (ret == 0) {
-      unitree::robot::go2::JsonizeCommObjInt json;
-      json.name = "volume";
-      common::FromJsonString(data, json);
-      volume = json.value;
-    }
-
-    return ret;
+    return cache_.Get<uint8_t>(ROBOT_API_ID_AUDIO_GET_VOLUME, volume, [this](uint8_t& value) {
+      std::string parameter, data;
+
+      int32_t ret = Call(ROBOT_API_ID_AUDIO_GET_VOLUME, parameter, data);
+      if (ret == 0) {
+        unitree::robot::go2::JsonizeCommObjInt json;
+        json.name = "volume";
+        common::FromJsonStringDirect(data, json);
+        value = json.value;
+      }
+
+      return ret;
+    });
   }
 
   int32_t SetVolume(uint8_t volume) {
@@ -60,29 +75,66 @@ class AudioClient : public Client {
 
     json.value = volume;
     json.name = "volume";
-    parameter = common::ToJsonString(json);
+    parameter = common::ToJsonStringDirect(json);
 
-    return Call(ROBOT_API_ID_AUDIO_SET_VOLUME, parameter, data);
+    int32_t ret = Call(ROBOT_API_ID_AUDIO_SET_VOLUME, parameter, data);
+    cache_.Notify(ROBOT_API_ID_AUDIO_SET_VOLUME, ret);
+
+    return ret;
   }
 
-  int32_t PlayStream(std::string app_name, std::string stream_id,
-                     std::vector<uint8_t> pcm_data) {
+  int32_t PlayStream(const std::string& app_name, const std::string& stream_id,
+                     const std::vector<uint8_t>& pcm_data) {
     std::string parameter;
     PlayStreamParameter json;
 
     json.app_name = app_name;
     json.stream_id = stream_id;
-    parameter = common::ToJsonString(json);
+    parameter = common::ToJsonStringDirect(json);
 
     return Call(ROBOT_API_ID_AUDIO_START_PLAY, parameter, pcm_data);
   }
 
+  /*
+   * Stream pcm_data in chunks of chunk_size without blocking the caller.
+   * Chunks are sent in order, each one after the previous is accepted.
+   * The returned transfer is the completion future; the client keeps the
+   * latest stream alive until the next one starts or PlayStop is called.
+   */
+  ChunkedTransferPtr PlayStreamAsync(const std::string& app_name,
+                                     const std::string& stream_id,
+                                     std::vector<uint8_t> pcm_data,
+                                     size_t chunk_size = AUDIO_STREAM_CHUNK_SIZE) {
+    PlayStreamParameter json;
+
+    json.app_name = app_name;
+    json.stream_id = stream_id;
+    std::string parameter = common::ToJsonStringDirect(json);
+
+    ChunkedTransferPtr transfer(new ChunkedTransfer(
+        std::move(pcm_data),
+        [this, parameter](const ChunkView& chunk) {
+          return Call(ROBOT_API_ID_AUDIO_START_PLAY, parameter, chunk.mData, chunk.mSize);
+        },
+        ChunkedTransferOption(chunk_size, 1)));
+
+    stream_transfer_ = transfer;
+    transfer->Start();
+
+    return transfer;
+  }
+
   int32_t PlayStop(std::string app_name) {
     std::string parameter, data;
+
+    if (stream_transfer_) {
+      stream_transfer_->Cancel();
+      stream_transfer_.reset();
+    }
     PlayStopParameter json;
 
     json.app_name = app_name;
-    parameter = common::ToJsonString(json);
+    parameter = common::ToJsonStringDirect(json);
 
     Call(ROBOT_API_ID_AUDIO_STOP_PLAY, parameter, data);
     return 0;
@@ -95,12 +147,14 @@ class AudioClient : public Client {
     json.R = R;
     json.G = G;
     json.B = B;
-    parameter = common::ToJsonString(json);
+    parameter = common::ToJsonStringDirect(json);
 
     return Call(ROBOT_API_ID_AUDIO_SET_RGB_LED, parameter, data);
   }
 
  private:
+  ClientCache cache_;
+  ChunkedTransferPtr stream_transfer_;
   uint32_t tts_index = 0;
 };
 }  // namespace g1
@@ -9,6 +9,8 @@
 #include <unitree/idl/hg/LowState_.hpp>
 #include <unitree/idl/hg/BmsState_.hpp>
 #include <unitree/robot/channel/channel_subscriber.hpp>
+#include <unitree/common/telemetry/flight_recorder.hpp>
+#include <unitree/idl/reflect/hg_reflect.hpp>
 
 namespace unitree {
 namespace robot {
@@ -85,6 +87,24 @@ inline bool lost_connection(unitree::robot::ChannelSubscriberPtr<unitree_hg::msg
     return elasped_ms > timeout_ms;
 }
 
+/**
+ * @brief Run a termination check and dump the flight recorder when it fires
+ * The recorder keeps the last seconds of LowState_, LowCmd_ and user records in memory,
+ * so the dump holds what led to the termination. Triggering only sets a flag;
+ * the dump is written by the recorder thread.
+ *
+ * e.g. record_termination(recorder, "bad_orientation", bad_orientation, lowstate, 1.0f)
+ */
+template <typename Check, typename... Args>
+inline bool record_termination(unitree::common::FlightRecorder & recorder, const char * reason, Check && check, Args &&... args)
+{
+    bool fired = check(std::forward<Args>(args)...);
+    if (fired) {
+        recorder.Trigger(reason);
+    }
+    return fired;
+}
+
 }
 }
 }
\ No newline at end of file
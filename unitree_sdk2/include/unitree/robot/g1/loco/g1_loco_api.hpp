@@ -1,7 +1,7 @@
 #ifndef __UT_ROBOT_G1_LOCO_API_HPP__
 #define __UT_ROBOT_G1_LOCO_API_HPP__
 
-#include <unitree/common/json/jsonize.hpp>
+#include <unitree/common/json/json_binding.hpp>
 #include <variant>
 
 namespace unitree {
@@ -37,11 +37,9 @@ public:
   JsonizeDataVecFloat() {}
   ~JsonizeDataVecFloat() {}
 
-  void fromJson(common::JsonMap &json) { common::FromJson(json["data"], data); }
+  template <typename Binder> void jsonFields(Binder &b) { b("data", data); }
 
-  void toJson(common::JsonMap &json) const {
-    common::ToJson(data, json["data"]);
-  }
+  UT_JSONIZE_FIELDS()
 
   std::vector<float> data;
 };
@@ -51,15 +49,12 @@ public:
   JsonizeVelocityCommand() {}
   ~JsonizeVelocityCommand() {}
 
-  void fromJson(common::JsonMap &json) {
-    common::FromJson(json["velocity"], velocity);
-    common::FromJson(json["duration"], duration);
+  template <typename Binder> void jsonFields(Binder &b) {
+    b("velocity", velocity);
+    b("duration", duration);
   }
 
-  void toJson(common::JsonMap &json) const {
-    common::ToJson(velocity, json["velocity"]);
-    common::ToJson(duration, json["duration"]);
-  }
+  UT_JSONIZE_FIELDS()
 
   std::vector<float> velocity;
   float duration;
@@ -3,15 +3,16 @@
 
 #include "g1_loco_api.hpp"
 #include <limits>
-#include <unitree/robot/client/client.hpp>
+#include <unitree/robot/client/routed_client.hpp>
+#include <unitree/robot/client/client_cache.hpp>
 #include <unitree/robot/go2/public/jsonize_type.hpp>
 
 namespace unitree {
 namespace robot {
 namespace g1 {
-class LocoClient : public Client {
+class LocoClient : public RoutedClient {
  public:
-  LocoClient() : Client(LOCO_SERVICE_NAME, false) {}
+  LocoClient() : RoutedClient(LOCO_SERVICE_NAME, false) {}
   ~LocoClient() {}
 
   /*Init*/
@@ -31,77 +32,109 @@ class LocoClient : public Client {
     UT_ROBOT_CLIENT_REG_API_NO_PROI(ROBOT_API_ID_LOCO_SET_VELOCITY);
     UT_ROBOT_CLIENT_REG_API_NO_PROI(ROBOT_API_ID_LOCO_SET_ARM_TASK);
     UT_ROBOT_CLIENT_REG_API_NO_PROI(ROBOT_API_ID_LOCO_SET_SPEED_MODE);
+
+    cache_.SetApiInvalidation(ROBOT_API_ID_LOCO_SET_FSM_ID, ROBOT_API_ID_LOCO_GET_FSM_ID);
+    cache_.SetApiInvalidation(ROBOT_API_ID_LOCO_SET_FSM_ID, ROBOT_API_ID_LOCO_GET_FSM_MODE);
+    cache_.SetApiInvalidation(ROBOT_API_ID_LOCO_SET_VELOCITY, ROBOT_API_ID_LOCO_GET_FSM_MODE);
+    cache_.SetApiInvalidation(ROBOT_API_ID_LOCO_SET_BALANCE_MODE, ROBOT_API_ID_LOCO_GET_BALANCE_MODE);
+    cache_.SetApiInvalidation(ROBOT_API_ID_LOCO_SET_SWING_HEIGHT, ROBOT_API_ID_LOCO_GET_SWING_HEIGHT);
+    cache_.SetApiInvalidation(ROBOT_API_ID_LOCO_SET_STAND_HEIGHT, ROBOT_API_ID_LOCO_GET_STAND_HEIGHT);
   };
 
+  /*
+   * Serve Get* state apis from a client side cache refreshed at most once
+   * per ttl (microseconds). Set* calls of this client invalidate the state
+   * they change; changes made by other clients show up after ttl.
+   */
+  void EnableCache(int64_t ttl = ROBOT_CLIENT_CACHE_TTL) {
+    cache_.SetApiTtl(ROBOT_API_ID_LOCO_GET_FSM_ID, ttl);
+    cache_.SetApiTtl(ROBOT_API_ID_LOCO_GET_FSM_MODE, ttl);
+    cache_.SetApiTtl(ROBOT_API_ID_LOCO_GET_BALANCE_MODE, ttl);
+    cache_.SetApiTtl(ROBOT_API_ID_LOCO_GET_SWING_HEIGHT, ttl);
+    cache_.SetApiTtl(ROBOT_API_ID_LOCO_GET_STAND_HEIGHT, ttl);
+  }
+
+  ClientCache& GetCache() { return cache_; }
+
   /*Low Level API Call*/
   int32_t GetFsmId(int& fsm_id) {
-    std::string parameter, data;
+    return cache_.Get<int>(ROBOT_API_ID_LOCO_GET_FSM_ID, fsm_id, [this](int& value) {
+      std::string parameter, data;
 
-    int32_t ret = Call(ROBOT_API_ID_LOCO_GET_FSM_ID, parameter, data);
+      int32_t ret = Call(ROBOT_API_ID_LOCO_GET_FSM_ID, parameter, data);
 
-    if (ret == 0) {
-      go2::JsonizeDataInt json;
-      common::FromJsonString(data, json);
-      fsm_id = json.data;
-    }
+      if (ret == 0) {
+        go2::JsonizeDataInt json;
+        common::FromJsonStringDirect(data, json);
+        value = json.data;
+      }
 
-    return ret;
+      return ret;
+    });
   }
 
   int32_t GetFsmMode(int& fsm_mode) {
-    std::string parameter, data;
+    return cache_.Get<int>(ROBOT_API_ID_LOCO_GET_FSM_MODE, fsm_mode, [this](int& value) {
+      std::string parameter, data;
 
-    int32_t ret = Call(ROBOT_API_ID_LOCO_GET_FSM_MODE, parameter, data);
+      int32_t ret = Call(ROBOT_API_ID_LOCO_GET_FSM_MODE, parameter, data);
 
-    if (ret == 0) {
-      go2::JsonizeDataInt json;
-      common::FromJsonString(data, json);
-      fsm_mode = json.data;
-    }
+      if (ret == 0) {
+        go2::JsonizeDataInt json;
+        common::FromJsonStringDirect(data, json);
+        value = json.data;
+      }
 
-    return ret;
+      return ret;
+    });
   }
 
   int32_t GetBalanceMode(int& balance_mode) {
-    std::string parameter, data;
+    return cache_.Get<int>(ROBOT_API_ID_LOCO_GET_BALANCE_MODE, balance_mode, [this](int& value) {
+      std::string parameter, data;
 
-    int32_t ret = Call(ROBOT_API_ID_LOCO_GET_BALANCE_MODE, parameter, data);
+      int32_t ret = Call(ROBOT_API_ID_LOCO_GET_BALANCE_MODE, parameter, data);
 
-    if (ret == 0) {
-      go2::JsonizeDataInt json;
-      common::FromJsonString(data, json);
-      balance_mode = json.data;
-    }
+      if (ret == 0) {
+        go2::JsonizeDataInt json;
+        common::FromJsonStringDirect(data, json);
+        value = json.data;
+      }
 
-    return ret;
+      return ret;
+    });
   }
 
   int32_t GetSwingHeight(float& swing_height) {
-    std::string parameter, data;
+    return cache_.Get<float>(ROBOT_API_ID_LOCO_GET_SWING_HEIGHT, swing_height, [this](float& value) {
+      std::string parameter, data;
 
-    int32_t ret = Call(ROBOT_API_ID_LOCO_GET_SWING_HEIGHT, parameter, data);
+      int32_t ret = Call(ROBOT_API_ID_LOCO_GET_SWING_HEIGHT, parameter, data);
 
-    if (ret == 0) {
-      go2::JsonizeDataFloat json;
-      common::FromJsonString(data, json);
-      swing_height = json.data;
-    }
+      if (ret == 0) {
+        go2::JsonizeDataFloat json;
+        common::FromJsonStringDirect(data, json);
+        value = json.data;
+      }
 
-    return ret;
+      return ret;
+    });
   }
 
   int32_t GetStandHeight(float& stand_height) {
-    std::string parameter, data;
+    return cache_.Get<float>(ROBOT_API_ID_LOCO_GET_STAND_HEIGHT, stand_height, [this](float& value) {
+      std::string parameter, data;
 
-    int32_t ret = Call(ROBOT_API_ID_LOCO_GET_STAND_HEIGHT, parameter, data);
+      int32_t ret = Call(ROBOT_API_ID_LOCO_GET_STAND_HEIGHT, parameter, data);
 
-    if (ret == 0) {
-      go2::JsonizeDataFloat json;
-      common::FromJsonString(data, json);
-      stand_height = json.data;
-    }
+      if (ret == 0) {
+        go2::JsonizeDataFloat json;
+        common::FromJsonStringDirect(data, json);
+        value = json.data;
+      }
 
-    return ret;
+      return ret;
+    });
   }
 
   int32_t GetPhase(std::vector<float>& phase) {
@@ -111,7 +144,7 @@ class LocoClient : public Client {
 
     if (ret == 0) {
       JsonizeDataVecFloat json;
-      common::FromJsonString(data, json);
+      common::FromJsonStringDirect(data, json);
       phase = json.data;
     }
 
@@ -123,9 +156,12 @@ class LocoClient : public Client {
 
     go2::JsonizeDataInt json;
     json.data = fsm_id;
-    parameter = common::ToJsonString(json);
+    parameter = common::ToJsonStringDirect(json);
 
-    return Call(ROBOT_API_ID_LOCO_SET_FSM_ID, parameter, data);
+    int32_t ret = Call(ROBOT_API_ID_LOCO_SET_FSM_ID, parameter, data);
+    cache_.Notify(ROBOT_API_ID_LOCO_SET_FSM_ID, ret);
+
+    return ret;
   }
 
   int32_t SetBalanceMode(int balance_mode) {
@@ -133,9 +169,12 @@ class LocoClient : public Client {
 
     go2::JsonizeDataInt json;
     json.data = balance_mode;
-    parameter = common::ToJsonString(json);
+    parameter = common::ToJsonStringDirect(json);
 
-    return Call(ROBOT_API_ID_LOCO_SET_BALANCE_MODE, parameter, data);
+    int32_t ret = Call(ROBOT_API_ID_LOCO_SET_BALANCE_MODE, parameter, data);
+    cache_.Notify(ROBOT_API_ID_LOCO_SET_BALANCE_MODE, ret);
+
+    return ret;
   }
 
   int32_t SetSwingHeight(float swing_height) {
@@ -143,9 +182,12 @@ class LocoClient : public Client {
 
     go2::JsonizeDataFloat json;
     json.data = swing_height;
-    parameter = common::ToJsonString(json);
+    parameter = common::ToJsonStringDirect(json);
 
-    return Call(ROBOT_API_ID_LOCO_SET_SWING_HEIGHT, parameter, data);
+    int32_t ret = Call(ROBOT_API_ID_LOCO_SET_SWING_HEIGHT, parameter, data);
+    cache_.Notify(ROBOT_API_ID_LOCO_SET_SWING_HEIGHT, ret);
+
+    return ret;
   }
 
   int32_t SetStandHeight(float stand_height) {
@@ -153,9 +195,12 @@ class LocoClient : public Client {
 
     go2::JsonizeDataFloat json;
     json.data = stand_height;
-    parameter = common::ToJsonString(json);
+    parameter = common::ToJsonStringDirect(json);
 
-    return Call(ROBOT_API_ID_LOCO_SET_STAND_HEIGHT, parameter, data);
+    int32_t ret = Call(ROBOT_API_ID_LOCO_SET_STAND_HEIGHT, parameter, data);
+    cache_.Notify(ROBOT_API_ID_LOCO_SET_STAND_HEIGHT, ret);
+
+    return ret;
   }
 
   int32_t SetVelocity(float vx, float vy, float omega, float duration = 1.f) {
@@ -165,9 +210,12 @@ class LocoClient : public Client {
     std::vector<float> velocity = {vx, vy, omega};
     json.velocity = velocity;
     json.duration = duration;
-    parameter = common::ToJsonString(json);
+    parameter = common::ToJsonStringDirect(json);
 
-    return Call(ROBOT_API_ID_LOCO_SET_VELOCITY, parameter, data);
+    int32_t ret = Call(ROBOT_API_ID_LOCO_SET_VELOCITY, parameter, data);
+    cache_.Notify(ROBOT_API_ID_LOCO_SET_VELOCITY, ret);
+
+    return ret;
   }
 
   int32_t SetTaskId(int task_id) {
@@ -175,7 +223,7 @@ class LocoClient : public Client {
 
     go2::JsonizeDataInt json;
     json.data = task_id;
-    parameter = common::ToJsonString(json);
+    parameter = common::ToJsonStringDirect(json);
 
     return Call(ROBOT_API_ID_LOCO_SET_ARM_TASK, parameter, data);
   }
@@ -237,12 +285,13 @@ class LocoClient : public Client {
 
     go2::JsonizeDataInt json;
     json.data = speed_mode;
-    parameter = common::ToJsonString(json);
+    parameter = common::ToJsonStringDirect(json);
 
     return Call(ROBOT_API_ID_LOCO_SET_SPEED_MODE, parameter, data);
   }
 
 private:
+  ClientCache cache_;
   bool continous_move_ = false;
   bool first_shake_hand_stage_ = true;
 };
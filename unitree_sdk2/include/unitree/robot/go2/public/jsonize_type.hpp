@@ -1,7 +1,7 @@
 #ifndef __UT_ROBOT_GO2_SDK_JSON_DATA_TYPE_HPP__
 #define __UT_ROBOT_GO2_SDK_JSON_DATA_TYPE_HPP__
 
-#include <unitree/common/json/jsonize.hpp>
+#include <unitree/common/json/json_binding.hpp>
 
 namespace unitree
 {
@@ -21,15 +21,13 @@ public:
     ~JsonizeFlagBool()
     {}
 
-    void fromJson(common::JsonMap& json)
+    template<typename Binder>
+    void jsonFields(Binder& b)
     {
-        common::FromJson(json["flag"], flag);
+        b("flag", flag);
     }
 
-    void toJson(common::JsonMap& json) const
-    {
-        common::ToJson(flag, json["flag"]);
-    }
+    UT_JSONIZE_FIELDS()
 
 public:
     bool flag;
@@ -47,15 +45,13 @@ public:
     ~JsonizeDataBool()
     {}
 
-    void fromJson(common::JsonMap& json)
+    template<typename Binder>
+    void jsonFields(Binder& b)
     {
-        common::FromJson(json["data"], data);
+        b("data", data);
     }
 
-    void toJson(common::JsonMap& json) const
-    {
-        common::ToJson(data, json["data"]);
-    }
+    UT_JSONIZE_FIELDS()
 
 public:
     bool data;
@@ -73,15 +69,13 @@ public:
     ~JsonizeDataInt()
     {}
 
-    void fromJson(common::JsonMap& json)
+    template<typename Binder>
+    void jsonFields(Binder& b)
     {
-        common::FromJson(json["data"], data);
+        b("data", data);
     }
 
-    void toJson(common::JsonMap& json) const
-    {
-        common::ToJson(data, json["data"]);
-    }
+    UT_JSONIZE_FIELDS()
 
 public:
     int data;
@@ -99,15 +93,13 @@ public:
     ~JsonizeDataFloat()
     {}
 
-    void fromJson(common::JsonMap& json)
+    template<typename Binder>
+    void jsonFields(Binder& b)
     {
-        common::FromJson(json["data"], data);
+        b("data", data);
     }
 
-    void toJson(common::JsonMap& json) const
-    {
-        common::ToJson(data, json["data"]);
-    }
+    UT_JSONIZE_FIELDS()
 
 public:
     float data;
@@ -125,15 +117,13 @@ public:
     ~JsonizeDataDouble()
     {}
 
-    void fromJson(common::JsonMap& json)
+    template<typename Binder>
+    void jsonFields(Binder& b)
     {
-        common::FromJson(json["data"], data);
+        b("data", data);
     }
 
-    void toJson(common::JsonMap& json) const
-    {
-        common::ToJson(data, json["data"]);
-    }
+    UT_JSONIZE_FIELDS()
 
 public:
     double data;
@@ -151,15 +141,13 @@ public:
     ~JsonizeDataString()
     {}
 
-    void fromJson(common::JsonMap& json)
+    template<typename Binder>
+    void jsonFields(Binder& b)
     {
-        common::FromJson(json["data"], data);
+        b("data", data);
     }
 
-    void toJson(common::JsonMap& json) const
-    {
-        common::ToJson(data, json["data"]);
-    }
+    UT_JSONIZE_FIELDS()
 
 public:
     std::string data;
@@ -177,19 +165,15 @@ public:
     ~JsonizeVec3()
     {}
 
-    void fromJson(common::JsonMap& json)
+    template<typename Binder>
+    void jsonFields(Binder& b)
     {
-        common::FromJson(json["x"], x);
-        common::FromJson(json["y"], y);
-        common::FromJson(json["z"], z);
+        b("x", x);
+        b("y", y);
+        b("z", z);
     }
 
-    void toJson(common::JsonMap& json) const
-    {
-        common::ToJson(x, json["x"]);
-        common::ToJson(y, json["y"]);
-        common::ToJson(z, json["z"]);
-    }
+    UT_JSONIZE_FIELDS()
 
 public:
     float x;
@@ -209,21 +193,16 @@ public:
     ~JsonizeQuat()
     {}
 
-    void fromJson(common::JsonMap& json)
+    template<typename Binder>
+    void jsonFields(Binder& b)
     {
-        common::FromJson(json["x"], x);
-        common::FromJson(json["y"], y);
-        common::FromJson(json["z"], z);
-        common::FromJson(json["w"], w);
+        b("x", x);
+        b("y", y);
+        b("z", z);
+        b("w", w);
     }
 
-    void toJson(common::JsonMap& json) const
-    {
-        common::ToJson(x, json["x"]);
-        common::ToJson(y, json["y"]);
-        common::ToJson(z, json["z"]);
-        common::ToJson(w, json["w"]);
-    }
+    UT_JSONIZE_FIELDS()
 
 public:
     float x;
@@ -246,27 +225,19 @@ public:
     {}
 
 public:
-    void fromJson(common::JsonMap& json)
+    template<typename Binder>
+    void jsonFields(Binder& b)
     {
-        common::FromJson(json["t_from_start"], timeFromStart);
-        common::FromJson(json["x"], x);
-        common::FromJson(json["y"], y);
-        common::FromJson(json["yaw"], yaw);
-        common::FromJson(json["vx"], vx);
-        common::FromJson(json["vy"], vy);
-        common::FromJson(json["vyaw"], vyaw);
+        b("t_from_start", timeFromStart);
+        b("x", x);
+        b("y", y);
+        b("yaw", yaw);
+        b("vx", vx);
+        b("vy", vy);
+        b("vyaw", vyaw);
     }
 
-    void toJson(common::JsonMap& json) const
-    {
-        common::ToJson(timeFromStart, json["t_from_start"]);
-        common::ToJson(x, json["x"]);
-        common::ToJson(y, json["y"]);
-        common::ToJson(yaw, json["yaw"]);
-        common::ToJson(vx, json["vx"]);
-        common::ToJson(vy, json["vy"]);
-        common::ToJson(vyaw, json["vyaw"]);
-  }
+    UT_JSONIZE_FIELDS()
 
 public:
     float timeFromStart;
@@ -290,15 +261,13 @@ public:
     ~JsonizeCommObjInt()
     {}
 
-    void fromJson(common::JsonMap& json)
+    template<typename Binder>
+    void jsonFields(Binder& b)
     {
-        common::FromJson(json[name], value);
+        b(name.c_str(), value);
     }
 
-    void toJson(common::JsonMap& json) const
-    {
-        common::ToJson(value, json[name]);
-    }
+    UT_JSONIZE_FIELDS()
 
 public:
     int value;
@@ -3,15 +3,15 @@
 
 #include "h1_loco_api.hpp"
 #include <limits>
-#include <unitree/robot/client/client.hpp>
+#include <unitree/robot/client/routed_client.hpp>
 #include <unitree/robot/go2/public/jsonize_type.hpp>
 
 namespace unitree {
 namespace robot {
 namespace h1 {
-class LocoClient : public Client {
+class LocoClient : public RoutedClient {
  public:
-  LocoClient() : Client(LOCO_SERVICE_NAME, false) {}
+  LocoClient() : RoutedClient(LOCO_SERVICE_NAME, false) {}
   ~LocoClient() {}
 
   /*Init*/
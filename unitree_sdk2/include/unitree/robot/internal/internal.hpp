@@ -3,6 +3,7 @@
 
 #include <unitree/robot/internal/internal_api.hpp>
 #include <unitree/robot/internal/internal_error.hpp>
+#include <unitree/robot/internal/internal_chunk.hpp>
 #include <unitree/robot/internal/internal_request_response.hpp>
 
 namespace unitree
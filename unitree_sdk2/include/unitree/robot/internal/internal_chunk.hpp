@@ -0,0 +1,171 @@
+#ifndef __UT_ROBOT_SDK_INERNAL_CHUNK_HPP__
+#define __UT_ROBOT_SDK_INERNAL_CHUNK_HPP__
+
+#include <unitree/common/decl.hpp>
+
+namespace unitree
+{
+namespace robot
+{
+/*
+ * @brief  default chunk size of chunked transfer.
+ * @value: 65536
+ */
+const size_t ROBOT_CHUNK_SIZE                       = 65536;
+
+/*
+ * @brief  default number of unacknowledged chunks in flight.
+ * @value: 4
+ */
+const int32_t ROBOT_CHUNK_WINDOW                    = 4;
+
+/*
+ * @brief  default send attempts of one chunk.
+ * @value: 3
+ */
+const int32_t ROBOT_CHUNK_RETRY                     = 3;
+
+/*
+ * @brief  idle time after which receiver drops an incomplete transfer.
+ * @value: 10000000 us
+ */
+const int64_t ROBOT_CHUNK_EXPIRE_TIME               = 10000000;
+
+/*
+ * @brief  default max binary size of one chunked transfer accepted by receiver.
+ * @value: 64MB
+ */
+const uint64_t ROBOT_CHUNK_MAX_TOTAL_SIZE           = 64 * 1024 * 1024;
+
+/*
+ * @brief  max bytes of all incomplete transfers of all receivers in a process.
+ * @value: 128MB
+ */
+const uint64_t ROBOT_CHUNK_MAX_PENDING_SIZE         = 128 * 1024 * 1024;
+
+/*
+ * @brief  default max chunk count of one chunked transfer accepted by receiver.
+ * @value: 65536
+ */
+const uint32_t ROBOT_CHUNK_MAX_COUNT                = 65536;
+
+/*
+ * @brief  chunk frame magic. "UTCK"
+ */
+const uint32_t ROBOT_CHUNK_FRAME_MAGIC              = 0x4b435455;
+
+/*
+ * @brief
+ * @class: ChunkView
+ * View of one chunk in caller memory.
+ */
+class ChunkView
+{
+public:
+    ChunkView() :
+        mData(NULL), mSize(0), mOffset(0), mSeq(0), mCount(0), mTotalSize(0)
+    {}
+
+public:
+    const uint8_t* mData;
+    size_t mSize;
+    uint64_t mOffset;
+    uint32_t mSeq;
+    uint32_t mCount;
+    uint64_t mTotalSize;
+};
+
+/*
+ * @brief
+ * @class: ChunkFrameHeader
+ * Header prepended to chunk data in a binary request:
+ * [ChunkFrameHeader][parameter][data]
+ */
+#pragma pack(push, 1)
+struct ChunkFrameHeader
+{
+    uint32_t mMagic;
+    uint32_t mSeq;
+    uint32_t mCount;
+    uint32_t mParameterSize;
+    uint64_t mTransferId;
+    uint64_t mOffset;
+    uint64_t mTotalSize;
+};
+#pragma pack(pop)
+
+/*
+ * Build chunk frame. The chunk data is copied once, into the frame.
+ */
+inline void EncodeChunkFrame(uint64_t transferId, const std::string& parameter, const ChunkView& chunk, std::vector<uint8_t>& frame)
+{
+    ChunkFrameHeader header;
+    header.mMagic = ROBOT_CHUNK_FRAME_MAGIC;
+    header.mSeq = chunk.mSeq;
+    header.mCount = chunk.mCount;
+    header.mParameterSize = (uint32_t)parameter.size();
+    header.mTransferId = transferId;
+    header.mOffset = chunk.mOffset;
+    header.mTotalSize = chunk.mTotalSize;
+
+    frame.resize(sizeof(ChunkFrameHeader) + parameter.size() + chunk.mSize);
+
+    uint8_t* p = frame.data();
+    memcpy(p, &header, sizeof(ChunkFrameHeader));
+    p += sizeof(ChunkFrameHeader);
+
+    if (!parameter.empty())
+    {
+        memcpy(p, parameter.data(), parameter.size());
+        p += parameter.size();
+    }
+
+    if (chunk.mSize > 0)
+    {
+        memcpy(p, chunk.mData, chunk.mSize);
+    }
+}
+
+/*
+ * Parse chunk frame. chunk.mData points into frame.
+ */
+inline bool DecodeChunkFrame(const std::vector<uint8_t>& frame, uint64_t& transferId, std::string& parameter, ChunkView& chunk)
+{
+    if (frame.size() < sizeof(ChunkFrameHeader))
+    {
+        return false;
+    }
+
+    ChunkFrameHeader header;
+    memcpy(&header, frame.data(), sizeof(ChunkFrameHeader));
+
+    size_t dataOffset = sizeof(ChunkFrameHeader) + header.mParameterSize;
+
+    if (header.mMagic != ROBOT_CHUNK_FRAME_MAGIC || header.mCount == 0 || header.mSeq >= header.mCount ||
+        dataOffset > frame.size())
+    {
+        return false;
+    }
+
+    chunk.mData = frame.data() + dataOffset;
+    chunk.mSize = frame.size() - dataOffset;
+    chunk.mOffset = header.mOffset;
+    chunk.mSeq = header.mSeq;
+    chunk.mCount = header.mCount;
+    chunk.mTotalSize = header.mTotalSize;
+
+    if (chunk.mOffset > chunk.mTotalSize || chunk.mSize > chunk.mTotalSize - chunk.mOffset)
+    {
+        return false;
+    }
+
+    transferId = header.mTransferId;
+    parameter.assign((const char*)frame.data() + sizeof(ChunkFrameHeader), header.mParameterSize);
+
+    return true;
+}
+
+}
+}
+
+#endif//__UT_ROBOT_SDK_INERNAL_CHUNK_HPP__
@@ -15,6 +15,7 @@ UT_DECL_ERR(UT_ROBOT_ERR_CLIENT_API_TIMEOUT,        3104,   "Call api timeout er
 UT_DECL_ERR(UT_ROBOT_ERR_CLIENT_API_NOT_MATCH,      3105,   "Response api not match error.")
 UT_DECL_ERR(UT_ROBOT_ERR_CLIENT_API_DATA,           3106,   "Response data error.")
 UT_DECL_ERR(UT_ROBOT_ERR_CLIENT_LEASE_INVALID,      3107,   "Lease is invalid.")
+UT_DECL_ERR(UT_ROBOT_ERR_CLIENT_CHUNK_CANCELED,     3108,   "Chunked transfer canceled.")
 
 UT_DECL_ERR(UT_ROBOT_ERR_SERVER_SEND,               3201,   "Send response error.")
 UT_DECL_ERR(UT_ROBOT_ERR_SERVER_INTERNAL,           3202,   "Server internal error.")
@@ -23,6 +24,9 @@ UT_DECL_ERR(UT_ROBOT_ERR_SERVER_API_PARAMETER,      3204,   "Api parameter error
 UT_DECL_ERR(UT_ROBOT_ERR_SERVER_LEASE_DENIED,       3205,   "Request denied by lease.")
 UT_DECL_ERR(UT_ROBOT_ERR_SERVER_LEASE_NOT_EXIST,    3206,   "Lease not exist in server cache.")
 UT_DECL_ERR(UT_ROBOT_ERR_SERVER_LEASE_EXIST,        3207,   "Lease is already exist in server cache.")
+UT_DECL_ERR(UT_ROBOT_ERR_SERVER_CHUNK_WINDOW,       3208,   "Chunk is beyond receive window.")
+UT_DECL_ERR(UT_ROBOT_ERR_SERVER_CHUNK_FRAME,        3209,   "Chunk frame error.")
+UT_DECL_ERR(UT_ROBOT_ERR_SERVER_API_EXPIRED,        3210,   "Request expired in server queue.")
 }
 }
 
@@ -0,0 +1,180 @@
+#ifndef __UT_ROBOT_SDK_JOINT_VECTOR_HPP__
+#define __UT_ROBOT_SDK_JOINT_VECTOR_HPP__
+
+#include <unitree/idl/hg/LowState_.hpp>
+#include <unitree/idl/hg/LowCmd_.hpp>
+#include <unitree/idl/go2/LowState_.hpp>
+#include <unitree/idl/go2/LowCmd_.hpp>
+#include <array>
+
+namespace unitree
+{
+namespace robot
+{
+/*
+ * Strided motor message fields to contiguous float arrays and back, for a
+ * joint count fixed at compile time. The loops are fully unrolled with no
+ * bounds checks, so the compiler turns the contiguous side into vector
+ * stores/loads and the strided side into straight scalar moves; the dds
+ * motor structs are 28 to 56 bytes wide, which no gather instruction
+ * loads faster than that.
+ */
+template<size_t N, typename MOTOR_STATE, size_t M>
+inline void PackMotorState(const std::array<MOTOR_STATE, M>& motors,
+    float* __restrict q, float* __restrict dq)
+{
+    static_assert(N <= M, "joint number exceeds motor message size");
+
+#pragma GCC unroll 32
+    for (size_t i=0; i<N; i++)
+    {
+        const MOTOR_STATE& m = motors[i];
+        q[i] = m.q();
+        dq[i] = m.dq();
+    }
+}
+
+template<size_t N, typename MOTOR_STATE, size_t M>
+inline void PackMotorState(const std::array<MOTOR_STATE, M>& motors,
+    float* __restrict q, float* __restrict dq, float* __restrict tau)
+{
+    static_assert(N <= M, "joint number exceeds motor message size");
+
+#pragma GCC unroll 32
+    for (size_t i=0; i<N; i++)
+    {
+        const MOTOR_STATE& m = motors[i];
+        q[i] = m.q();
+        dq[i] = m.dq();
+        tau[i] = m.tau_est();
+    }
+}
+
+template<size_t N, typename MOTOR_STATE, size_t M>
+inline void PackMotorState(const std::array<MOTOR_STATE, M>& motors,
+    float* __restrict q, float* __restrict dq, float* __restrict ddq, float* __restrict tau)
+{
+    static_assert(N <= M, "joint number exceeds motor message size");
+
+#pragma GCC unroll 32
+    for (size_t i=0; i<N; i++)
+    {
+        const MOTOR_STATE& m = motors[i];
+        q[i] = m.q();
+        dq[i] = m.dq();
+        ddq[i] = m.ddq();
+        tau[i] = m.tau_est();
+    }
+}
+
+template<size_t N, typename MOTOR_CMD, size_t M>
+inline void UnpackMotorCmd(std::array<MOTOR_CMD, M>& motors,
+    const float* __restrict q, const float* __restrict dq, const float* __restrict kp,
+    const float* __restrict kd, const float* __restrict tau)
+{
+    static_assert(N <= M, "joint number exceeds motor message size");
+
+#pragma GCC unroll 32
+    for (size_t i=0; i<N; i++)
+    {
+        MOTOR_CMD& m = motors[i];
+        m.q() = q[i];
+        m.dq() = dq[i];
+        m.kp() = kp[i];
+        m.kd() = kd[i];
+        m.tau() = tau[i];
+    }
+}
+
+template<size_t N, typename MOTOR_CMD, size_t M>
+inline void FillMotorCmdMode(std::array<MOTOR_CMD, M>& motors, uint8_t mode)
+{
+    static_assert(N <= M, "joint number exceeds motor message size");
+
+#pragma GCC unroll 32
+    for (size_t i=0; i<N; i++)
+    {
+        motors[i].mode() = mode;
+    }
+}
+
+/*
+ * @brief
+ * @class: JointState
+ *
+ * Joint feedback as structure of arrays. Each array is 32 byte aligned,
+ * map it with Eigen::Map<Eigen::Matrix<float, N, 1>, Eigen::Aligned32>.
+ */
+template<size_t N>
+class JointState
+{
+public:
+    enum { NUMBER = N };
+
+    alignas(32) std::array<float, N> q = {};
+    alignas(32) std::array<float, N> dq = {};
+    alignas(32) std::array<float, N> ddq = {};
+    alignas(32) std::array<float, N> tau = {};
+};
+
+/*
+ * @brief
+ * @class: JointCommand
+ *
+ * Joint command as structure of arrays, aligned like JointState.
+ */
+template<size_t N>
+class JointCommand
+{
+public:
+    enum { NUMBER = N };
+
+    alignas(32) std::array<float, N> q = {};
+    alignas(32) std::array<float, N> dq = {};
+    alignas(32) std::array<float, N> kp = {};
+    alignas(32) std::array<float, N> kd = {};
+    alignas(32) std::array<float, N> tau = {};
+};
+
+/*
+ * @brief
+ * @class: JointLayout
+ *
+ * Joint count and low level message types of one robot, with the pack and
+ * unpack kernels specialized for them.
+ *
+ *   G1JointLayout::State state;
+ *   G1JointLayout::Pack(lowstate, state);
+ */
+template<size_t N, typename LOW_STATE, typename LOW_CMD>
+class JointLayout
+{
+public:
+    enum { NUMBER = N };
+
+    typedef LOW_STATE LowState;
+    typedef LOW_CMD LowCmd;
+    typedef JointState<N> State;
+    typedef JointCommand<N> Command;
+
+    static void Pack(const LowState& msg, State& state)
+    {
+        PackMotorState<N>(msg.motor_state(), state.q.data(), state.dq.data(), state.ddq.data(), state.tau.data());
+    }
+
+    static void Unpack(const Command& command, LowCmd& msg)
+    {
+        UnpackMotorCmd<N>(msg.motor_cmd(), command.q.data(), command.dq.data(), command.kp.data(),
+            command.kd.data(), command.tau.data());
+    }
+};
+
+typedef JointLayout<29, unitree_hg::msg::dds_::LowState_, unitree_hg::msg::dds_::LowCmd_> G1JointLayout;
+typedef JointLayout<27, unitree_hg::msg::dds_::LowState_, unitree_hg::msg::dds_::LowCmd_> H1_2JointLayout;
+typedef JointLayout<20, unitree_go::msg::dds_::LowState_, unitree_go::msg::dds_::LowCmd_> H1JointLayout;
+typedef JointLayout<12, unitree_go::msg::dds_::LowState_, unitree_go::msg::dds_::LowCmd_> Go2JointLayout;
+
+}
+}
+
+#endif//__UT_ROBOT_SDK_JOINT_VECTOR_HPP__
@@ -0,0 +1,366 @@
+#ifndef __UT_ROBOT_SDK_CHUNKED_RECEIVER_HPP__
+#define __UT_ROBOT_SDK_CHUNKED_RECEIVER_HPP__
+
+#include <atomic>
+#include <unitree/common/lock/lock.hpp>
+#include <unitree/common/time/time_tool.hpp>
+#include <unitree/robot/internal/internal.hpp>
+
+namespace unitree
+{
+namespace robot
+{
+/*
+ * @brief: handler of a completely received chunked request.
+ */
+using ChunkedRequestHandler = std::function<int32_t(const std::string& parameter, const std::vector<uint8_t>& binary, std::vector<uint8_t>& data)>;
+
+/*
+ * @brief
+ * @class: ChunkedReceiver
+ *
+ * Reassembles chunk frames sent by ChunkedTransfer. Every accepted chunk is
+ * acknowledged by its response. Chunks more than window ahead of the first
+ * missing chunk are rejected with UT_ROBOT_ERR_SERVER_CHUNK_WINDOW and
+ * resent by the client, which bounds the memory one transfer can occupy
+ * before it is complete. The handler runs once per transfer, for the last
+ * chunk, and its result answers that chunk.
+ * A completed transfer keeps its handler result for expireTime, so a resent
+ * last chunk, e.g. after the client timed out on a slow handler, is answered
+ * from that record instead of running the handler again. A resend that
+ * arrives while the handler still runs waits for its result.
+ * Size and chunk count of a transfer come from the peer; transfers above
+ * maxTotalSize or maxCount, or whose header is inconsistent, are rejected
+ * with UT_ROBOT_ERR_SERVER_CHUNK_FRAME before anything is allocated. A new
+ * transfer that would take the incomplete transfers of the process above
+ * ROBOT_CHUNK_MAX_PENDING_SIZE is rejected with
+ * UT_ROBOT_ERR_SERVER_CHUNK_WINDOW, so the client retries it later.
+ */
+class ChunkedReceiver
+{
+public:
+    explicit ChunkedReceiver(const ChunkedRequestHandler& handler, int32_t window = ROBOT_CHUNK_WINDOW, int64_t expireTime = ROBOT_CHUNK_EXPIRE_TIME,
+        uint64_t maxTotalSize = ROBOT_CHUNK_MAX_TOTAL_SIZE, uint32_t maxCount = ROBOT_CHUNK_MAX_COUNT) :
+        mHandler(handler), mWindow(window > 0 ? window : 1), mExpireTime(expireTime),
+        mMaxTotalSize(maxTotalSize), mMaxCount(maxCount)
+    {}
+
+    ~ChunkedReceiver()
+    {
+        common::LockGuard<common::MutexCond> lock(mMutexCond);
+        for (const auto& item : mAssemblyMap)
+        {
+            ReleasePending(item.second->mData.size());
+        }
+    }
+
+    int32_t OnChunk(const std::vector<uint8_t>& frame, std::vector<uint8_t>& data)
+    {
+        uint64_t transferId = 0;
+        std::string parameter;
+        ChunkView chunk;
+
+        if (!DecodeChunkFrame(frame, transferId, parameter, chunk))
+        {
+            return UT_ROBOT_ERR_SERVER_CHUNK_FRAME;
+        }
+
+        int64_t now = (int64_t)common::GetCurrentMonotonicTimeMicrosecond();
+        bool last = (chunk.mSeq + 1 == chunk.mCount);
+
+        std::shared_ptr<Assembly> assemblyPtr;
+
+        {
+            common::LockGuard<common::MutexCond> lock(mMutexCond);
+
+            Expire(now);
+
+            auto doneIter = mCompletionMap.find(transferId);
+            if (doneIter != mCompletionMap.end())
+            {
+                return AnswerCompleted(doneIter->second, last, data);
+            }
+
+            auto iter = mAssemblyMap.find(transferId);
+            if (iter == mAssemblyMap.end())
+            {
+                if (chunk.mSeq >= (uint32_t)mWindow)
+                {
+                    return UT_ROBOT_ERR_SERVER_CHUNK_WINDOW;
+                }
+
+                uint64_t chunkSize = 0;
+                if (!CheckTransfer(chunk, chunkSize))
+                {
+                    return UT_ROBOT_ERR_SERVER_CHUNK_FRAME;
+                }
+
+                if (!AcquirePending(chunk.mTotalSize))
+                {
+                    return UT_ROBOT_ERR_SERVER_CHUNK_WINDOW;
+                }
+
+                assemblyPtr.reset(new Assembly(chunk.mCount, chunk.mTotalSize, chunkSize));
+                mAssemblyMap[transferId] = assemblyPtr;
+            }
+            else
+            {
+                assemblyPtr = iter->second;
+            }
+
+            Assembly& assembly = *assemblyPtr;
+
+            if (assembly.mCount != chunk.mCount || assembly.mData.size() != chunk.mTotalSize ||
+                chunk.mOffset != (uint64_t)chunk.mSeq * assembly.mChunkSize)
+            {
+                return UT_ROBOT_ERR_SERVER_CHUNK_FRAME;
+            }
+
+            /*
+             * resent chunk of a transfer whose handler is running
+             */
+            if (assembly.mRunning)
+            {
+                if (!last)
+                {
+                    return UT_ROBOT_OK;
+                }
+
+                return WaitCompleted(transferId, now, data);
+            }
+
+            if (chunk.mSeq >= assembly.mNext + (uint32_t)mWindow)
+            {
+                return UT_ROBOT_ERR_SERVER_CHUNK_WINDOW;
+            }
+
+            assembly.mLastTime = now;
+
+            /*
+             * duplicate of an acknowledged chunk
+             */
+            if (assembly.mReceived[chunk.mSeq])
+            {
+                return UT_ROBOT_OK;
+            }
+
+            if (chunk.mSize > 0)
+            {
+                memcpy(assembly.mData.data() + chunk.mOffset, chunk.mData, chunk.mSize);
+            }
+
+            assembly.mReceived[chunk.mSeq] = true;
+            while (assembly.mNext < assembly.mCount && assembly.mReceived[assembly.mNext])
+            {
+                assembly.mNext++;
+            }
+
+            if (assembly.mNext < assembly.mCount)
+            {
+                return UT_ROBOT_OK;
+            }
+
+            assembly.mRunning = true;
+        }
+
+        int32_t ret = mHandler(parameter, assemblyPtr->mData, data);
+
+        common::LockGuard<common::MutexCond> lock(mMutexCond);
+
+        Completion& completion = mCompletionMap[transferId];
+        completion.mResult = ret;
+        completion.mData = data;
+        completion.mTime = (int64_t)common::GetCurrentMonotonicTimeMicrosecond();
+
+        mAssemblyMap.erase(transferId);
+        ReleasePending(assemblyPtr->mData.size());
+
+        mMutexCond.NotifyAll();
+
+        return ret;
+    }
+
+    size_t GetPendingSize()
+    {
+        common::LockGuard<common::MutexCond> lock(mMutexCond);
+        return mAssemblyMap.size();
+    }
+
+private:
+    struct Assembly
+    {
+        Assembly(uint32_t count, uint64_t size, uint64_t chunkSize) :
+            mCount(count), mNext(0), mLastTime(0), mChunkSize(chunkSize), mRunning(false), mReceived(count, false), mData(size)
+        {}
+
+        uint32_t mCount;
+        uint32_t mNext;
+        int64_t mLastTime;
+        uint64_t mChunkSize;
+        bool mRunning;
+        std::vector<bool> mReceived;
+        std::vector<uint8_t> mData;
+    };
+
+    struct Completion
+    {
+        int32_t mResult;
+        int64_t mTime;
+        std::vector<uint8_t> mData;
+    };
+
+    /*
+     * Earlier chunks were acknowledged with UT_ROBOT_OK, the last one with
+     * the handler result.
+     */
+    int32_t AnswerCompleted(const Completion& completion, bool last, std::vector<uint8_t>& data)
+    {
+        if (!last)
+        {
+            return UT_ROBOT_OK;
+        }
+
+        data = completion.mData;
+        return completion.mResult;
+    }
+
+    /*
+     * Called locked. Wait at most expire time for the running handler.
+     */
+    int32_t WaitCompleted(uint64_t transferId, int64_t now, std::vector<uint8_t>& data)
+    {
+        int64_t deadline = now + mExpireTime;
+
+        while (true)
+        {
+            auto doneIter = mCompletionMap.find(transferId);
+            if (doneIter != mCompletionMap.end())
+            {
+                return AnswerCompleted(doneIter->second, true, data);
+            }
+
+            int64_t remain = deadline - (int64_t)common::GetCurrentMonotonicTimeMicrosecond();
+            if (remain <= 0)
+            {
+                return UT_ROBOT_ERR_SERVER_CHUNK_WINDOW;
+            }
+
+            mMutexCond.Wait(remain);
+        }
+    }
+
+    /*
+     * Check header of the first chunk of a transfer and derive its chunk
+     * size. Every chunk but the last has chunk size bytes, so count chunks
+     * must cover total size and count - 1 chunks must not.
+     */
+    bool CheckTransfer(const ChunkView& chunk, uint64_t& chunkSize) const
+    {
+        if (chunk.mTotalSize == 0 || chunk.mTotalSize > mMaxTotalSize || chunk.mCount > mMaxCount)
+        {
+            return false;
+        }
+
+        if (chunk.mSeq + 1 < chunk.mCount)
+        {
+            chunkSize = chunk.mSize;
+        }
+        else if (chunk.mCount > 1)
+        {
+            chunkSize = chunk.mOffset / (chunk.mCount - 1);
+        }
+        else
+        {
+            chunkSize = chunk.mTotalSize;
+        }
+
+        if (chunkSize == 0 || chunk.mOffset != (uint64_t)chunk.mSeq * chunkSize)
+        {
+            return false;
+        }
+
+        return (uint64_t)chunk.mCount * chunkSize >= chunk.mTotalSize &&
+            (uint64_t)(chunk.mCount - 1) * chunkSize < chunk.mTotalSize;
+    }
+
+    /*
+     * bytes of incomplete transfers of all receivers in the process
+     */
+    static std::atomic<uint64_t>& PendingSize()
+    {
+        static std::atomic<uint64_t> size(0);
+        return size;
+    }
+
+    static bool AcquirePending(uint64_t size)
+    {
+        std::atomic<uint64_t>& pending = PendingSize();
+
+        uint64_t current = pending.load();
+        do
+        {
+            if (current + size > ROBOT_CHUNK_MAX_PENDING_SIZE)
+            {
+                return false;
+            }
+        }
+        while (!pending.compare_exchange_weak(current, current + size));
+
+        return true;
+    }
+
+    static void ReleasePending(uint64_t size)
+    {
+        PendingSize().fetch_sub(size);
+    }
+
+    /*
+     * Drop idle incomplete transfers and old completion records. Transfers
+     * whose handler runs are kept.
+     */
+    void Expire(int64_t now)
+    {
+        for (auto iter = mAssemblyMap.begin(); iter != mAssemblyMap.end(); )
+        {
+            if (!iter->second->mRunning && now - iter->second->mLastTime > mExpireTime)
+            {
+                ReleasePending(iter->second->mData.size());
+                iter = mAssemblyMap.erase(iter);
+            }
+            else
+            {
+                ++iter;
+            }
+        }
+
+        for (auto iter = mCompletionMap.begin(); iter != mCompletionMap.end(); )
+        {
+            if (now - iter->second.mTime > mExpireTime)
+            {
+                iter = mCompletionMap.erase(iter);
+            }
+            else
+            {
+                ++iter;
+            }
+        }
+    }
+
+private:
+    ChunkedRequestHandler mHandler;
+    int32_t mWindow;
+    int64_t mExpireTime;
+    uint64_t mMaxTotalSize;
+    uint32_t mMaxCount;
+
+    common::MutexCond mMutexCond;
+    std::unordered_map<uint64_t,std::shared_ptr<Assembly>> mAssemblyMap;
+    std::unordered_map<uint64_t,Completion> mCompletionMap;
+};
+
+using ChunkedReceiverPtr = std::shared_ptr<ChunkedReceiver>;
+
+}
+}
+
+#endif//__UT_ROBOT_SDK_CHUNKED_RECEIVER_HPP__
@@ -0,0 +1,242 @@
+#ifndef __UT_ROBOT_SDK_LEASE_STATE_HPP__
+#define __UT_ROBOT_SDK_LEASE_STATE_HPP__
+
+#include <atomic>
+#include <unitree/common/lock/lock.hpp>
+#include <unitree/robot/internal/internal.hpp>
+
+namespace unitree
+{
+namespace robot
+{
+/*
+ * @brief
+ * @class: LeaseStatistics
+ */
+class LeaseStatistics
+{
+public:
+    LeaseStatistics() :
+        mAcquireCount(0), mAcceptCount(0), mRenewCount(0), mRenewalCount(0), mExpireCount(0), mDenyCount(0)
+    {}
+
+public:
+    /*
+     * lease granted by an apply request
+     */
+    uint64_t mAcquireCount;
+
+    /*
+     * leased request accepted
+     */
+    uint64_t mAcceptCount;
+
+    /*
+     * lease term extended by a leased request, explicit renewals included
+     */
+    uint64_t mRenewCount;
+
+    /*
+     * explicit renewal requests accepted
+     */
+    uint64_t mRenewalCount;
+
+    /*
+     * current lease found past its term
+     */
+    uint64_t mExpireCount;
+
+    /*
+     * leased request denied
+     */
+    uint64_t mDenyCount;
+};
+
+/*
+ * @brief
+ * @class: LeaseState
+ *
+ * Lease of a server: current lease id and its expire time as two atomics.
+ * Check is the only lease check of a leased request and is lock-free; a
+ * request holding the current lease renews the term, so a client sending
+ * leased requests keeps its lease without explicit renewals. The expire
+ * time is only rewritten once a quarter of the term has passed, so high
+ * rate callers do not bounce its cache line between cores.
+ *
+ * Apply grants a new lease and is the only locked operation.
+ */
+class LeaseState
+{
+public:
+    explicit LeaseState(int64_t term = ROBOT_LEASE_TERM) :
+        mTerm(term), mId(0), mExpireTime(0), mAcquireCount(0), mAcceptCount(0), mRenewCount(0),
+        mRenewalCount(0), mExpireCount(0), mDenyCount(0)
+    {}
+
+    ~LeaseState()
+    {}
+
+    int64_t GetTerm() const
+    {
+        return mTerm;
+    }
+
+    /*
+     * Grant a lease to name. Fails with UT_ROBOT_ERR_SERVER_LEASE_EXIST while
+     * another name holds a lease within its term; the same name gets a new
+     * id, which revokes its old one.
+     */
+    int32_t Apply(const std::string& name, int64_t now, int64_t& leaseId)
+    {
+        common::LockGuard<common::Mutex> lock(mMutex);
+
+        if (mId.load() != 0 && now <= mExpireTime.load() && name != mName)
+        {
+            return UT_ROBOT_ERR_SERVER_LEASE_EXIST;
+        }
+
+        leaseId = GenerateId(name, now);
+
+        /*
+         * clear the id first: Check reads id, expire time, id, so it never
+         * pairs the new expire time with the old id.
+         */
+        mId.store(0);
+        mExpireTime.store(now + mTerm);
+        mId.store(leaseId);
+        mName = name;
+
+        mAcquireCount.fetch_add(1, std::memory_order_relaxed);
+
+        return UT_ROBOT_OK;
+    }
+
+    /*
+     * true if leaseId is the current lease and within its term. Renews the
+     * term on success.
+     */
+    bool Check(int64_t leaseId, int64_t now)
+    {
+        if (!Renew(leaseId, now))
+        {
+            mDenyCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        mAcceptCount.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /*
+     * Renew the term if leaseId is the current lease, for requests of apis
+     * that do not check the lease but still carry it.
+     */
+    void Touch(int64_t leaseId, int64_t now)
+    {
+        if (leaseId != 0)
+        {
+            Renew(leaseId, now);
+        }
+    }
+
+    /*
+     * Explicit renewal; same check as a leased request.
+     */
+    bool Renewal(int64_t leaseId, int64_t now)
+    {
+        if (!Check(leaseId, now))
+        {
+            return false;
+        }
+
+        mRenewalCount.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /*
+     * Current lease id, 0 if none was granted or it expired.
+     */
+    int64_t GetId() const
+    {
+        return mId.load(std::memory_order_acquire);
+    }
+
+    LeaseStatistics GetStatistics() const
+    {
+        LeaseStatistics statistics;
+        statistics.mAcquireCount = mAcquireCount.load(std::memory_order_relaxed);
+        statistics.mAcceptCount = mAcceptCount.load(std::memory_order_relaxed);
+        statistics.mRenewCount = mRenewCount.load(std::memory_order_relaxed);
+        statistics.mRenewalCount = mRenewalCount.load(std::memory_order_relaxed);
+        statistics.mExpireCount = mExpireCount.load(std::memory_order_relaxed);
+        statistics.mDenyCount = mDenyCount.load(std::memory_order_relaxed);
+        return statistics;
+    }
+
+private:
+    bool Renew(int64_t leaseId, int64_t now)
+    {
+        int64_t id = mId.load();
+        int64_t expireTime = mExpireTime.load();
+
+        if (leaseId == 0 || id != leaseId || mId.load() != id)
+        {
+            return false;
+        }
+
+        if (now > expireTime)
+        {
+            if (mId.compare_exchange_strong(id, 0))
+            {
+                mExpireCount.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            return false;
+        }
+
+        /*
+         * a failed exchange means another request renewed, or Apply replaced
+         * the lease; both leave a fresh expire time.
+         */
+        if (now + mTerm - expireTime > mTerm / 4 && mExpireTime.compare_exchange_strong(expireTime, now + mTerm))
+        {
+            mRenewCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        return true;
+    }
+
+    int64_t GenerateId(const std::string& name, int64_t now)
+    {
+        int64_t id = (int64_t)((std::hash<std::string>()(name) * 31 + (uint64_t)now) & INT64_MAX);
+        if (id == 0 || id == mId.load())
+        {
+            id = (id + 1) & INT64_MAX;
+        }
+
+        return id == 0 ? 1 : id;
+    }
+
+private:
+    int64_t mTerm;
+
+    std::atomic<int64_t> mId;
+    std::atomic<int64_t> mExpireTime;
+
+    common::Mutex mMutex;
+    std::string mName;
+
+    std::atomic<uint64_t> mAcquireCount;
+    std::atomic<uint64_t> mAcceptCount;
+    std::atomic<uint64_t> mRenewCount;
+    std::atomic<uint64_t> mRenewalCount;
+    std::atomic<uint64_t> mExpireCount;
+    std::atomic<uint64_t> mDenyCount;
+};
+
+using LeaseStatePtr = std::shared_ptr<LeaseState>;
+
+}
+}
+
+#endif//__UT_ROBOT_SDK_LEASE_STATE_HPP__
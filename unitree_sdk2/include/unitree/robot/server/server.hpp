@@ -3,6 +3,7 @@
 
 #include <unitree/robot/server/server_base.hpp>
 #include <unitree/robot/server/lease_server.hpp>
+#include <unitree/robot/server/chunked_receiver.hpp>
 
 #define UT_ROBOT_SERVER_REG_API_HANDLER_NO_LEASE(apiId, handler)            \
     UT_ROBOT_SERVER_REG_API_HANDLER(apiId, handler, false)
@@ -47,6 +48,19 @@ protected:
     void RegistHandler(int32_t apiId, const RequestHandler& handler, bool checkLease = false);
     void RegistBinaryHandler(int32_t apiId, const BinaryRequestHandler& binaryHandler, bool checkLease = false);
 
+    /*
+     * Regist handler of binary sent by Client::CallChunked. handler runs
+     * once the whole binary is received. Binaries above maxTotalSize are rejected.
+     */
+    void RegistChunkedHandler(int32_t apiId, const ChunkedRequestHandler& handler, bool checkLease = false, int32_t window = ROBOT_CHUNK_WINDOW,
+        uint64_t maxTotalSize = ROBOT_CHUNK_MAX_TOTAL_SIZE)
+    {
+        ChunkedReceiverPtr receiverPtr(new ChunkedReceiver(handler, window, ROBOT_CHUNK_EXPIRE_TIME, maxTotalSize));
+        RegistBinaryHandler(apiId, [receiverPtr](const std::vector<uint8_t>& parameter, std::vector<uint8_t>& data) {
+            return receiverPtr->OnChunk(parameter, data);
+        }, checkLease);
+    }
+
     bool IsBinary(int32_t apiId);
 
     RequestHandler GetHandler(int32_t apiId, bool& ignoreLease) const;
@@ -0,0 +1,686 @@
+#ifndef __UT_ROBOT_SDK_SERVER_EXECUTOR_HPP__
+#define __UT_ROBOT_SDK_SERVER_EXECUTOR_HPP__
+
+#include <deque>
+#include <unordered_set>
+#include <unitree/robot/server/server.hpp>
+#include <unitree/robot/server/lease_state.hpp>
+#include <unitree/robot/serialize/serialize.hpp>
+
+namespace unitree
+{
+namespace robot
+{
+/*
+ * @brief  default worker number of server executor.
+ * @value: 1
+ */
+const uint32_t ROBOT_SERVER_EXECUTOR_WORKER_NUMBER = 1;
+
+/*
+ * @brief  default in queue time of request before it is treated as expired.
+ *         same as client default timeout, caller already gave up after it.
+ * @value: 1000000 us
+ */
+const int64_t ROBOT_SERVER_REQUEST_EXPIRE_TIME = 1000000;
+
+/*
+ * @brief  wait slice of executor thread.
+ * @value: 100000 us
+ */
+const int64_t ROBOT_SERVER_EXECUTOR_WAIT_TIME = 100000;
+
+/*
+ * @brief
+ * @class: ServerExecutorConfig
+ */
+class ServerExecutorConfig
+{
+public:
+    explicit ServerExecutorConfig(uint32_t workerNumber = ROBOT_SERVER_EXECUTOR_WORKER_NUMBER,
+        int64_t expireMicrosec = ROBOT_SERVER_REQUEST_EXPIRE_TIME) :
+        mWorkerNumber(workerNumber), mExpireMicrosec(expireMicrosec)
+    {}
+
+    /*
+     * max concurrent running requests of api. 0 means unlimited.
+     */
+    ServerExecutorConfig& SetApiConcurrency(int32_t apiId, uint32_t concurrency)
+    {
+        mApiConcurrencyMap[apiId] = concurrency;
+        return *this;
+    }
+
+    /*
+     * requests of api are executed one by one in arrival order.
+     */
+    ServerExecutorConfig& SetApiOrdered(int32_t apiId)
+    {
+        return SetApiConcurrency(apiId, 1);
+    }
+
+    /*
+     * requests of api bypass worker queue and run in priority lane.
+     * requests sent with priority (UT_ROBOT_CLIENT_REG_API) always do.
+     */
+    ServerExecutorConfig& SetApiPriority(int32_t apiId)
+    {
+        mPriorityApiSet.insert(apiId);
+        return *this;
+    }
+
+    /*
+     * in queue time after which request of api is not run but answered with
+     * UT_ROBOT_ERR_SERVER_API_EXPIRED. 0 means never.
+     */
+    ServerExecutorConfig& SetApiExpireTime(int32_t apiId, int64_t microsec)
+    {
+        mApiExpireMap[apiId] = microsec;
+        return *this;
+    }
+
+    uint32_t GetApiConcurrency(int32_t apiId) const
+    {
+        auto iter = mApiConcurrencyMap.find(apiId);
+        return iter == mApiConcurrencyMap.end() ? 0 : iter->second;
+    }
+
+    int64_t GetApiExpireTime(int32_t apiId) const
+    {
+        auto iter = mApiExpireMap.find(apiId);
+        return iter == mApiExpireMap.end() ? mExpireMicrosec : iter->second;
+    }
+
+    bool IsPriorityApi(int32_t apiId) const
+    {
+        return mPriorityApiSet.find(apiId) != mPriorityApiSet.end();
+    }
+
+public:
+    uint32_t mWorkerNumber;
+    int64_t mExpireMicrosec;
+    std::unordered_map<int32_t,uint32_t> mApiConcurrencyMap;
+    std::unordered_map<int32_t,int64_t> mApiExpireMap;
+    std::set<int32_t> mPriorityApiSet;
+};
+
+/*
+ * @brief
+ * @class: ServerApiStatistics
+ */
+class ServerApiStatistics
+{
+public:
+    ServerApiStatistics() :
+        mExecuteCount(0), mExpireCount(0), mQueueTimeTotal(0), mQueueTimeMax(0),
+        mExecuteTimeTotal(0), mExecuteTimeMax(0)
+    {}
+
+public:
+    uint64_t mExecuteCount;
+    uint64_t mExpireCount;
+    int64_t mQueueTimeTotal;
+    int64_t mQueueTimeMax;
+    int64_t mExecuteTimeTotal;
+    int64_t mExecuteTimeMax;
+};
+
+using ServerExecuteHandler = std::function<void(const RequestPtr& requestPtr)>;
+
+/*
+ * @brief
+ * @class: ServerExecutor
+ */
+class ServerExecutor
+{
+public:
+    explicit ServerExecutor() :
+        mQuit(false)
+    {}
+
+    ~ServerExecutor()
+    {
+        Stop();
+    }
+
+    /*
+     * expireHandler is called instead of handler for requests that expired
+     * in queue.
+     */
+    void Init(const std::string& name, const ServerExecutorConfig& config, const ServerExecuteHandler& handler,
+        const ServerExecuteHandler& expireHandler = ServerExecuteHandler())
+    {
+        mConfig = config;
+        mHandler = handler;
+        mExpireHandler = expireHandler;
+
+        uint32_t i, number = mConfig.mWorkerNumber;
+        if (number == 0)
+        {
+            number = ROBOT_SERVER_EXECUTOR_WORKER_NUMBER;
+        }
+
+        for (i=0; i<number; i++)
+        {
+            mThreadList.push_back(common::CreateThreadEx(name.substr(0, 8) + "_w", UT_CPU_ID_NONE,
+                &ServerExecutor::WorkerThreadFunction, this));
+        }
+
+        mProiThreadPtr = common::CreateThreadEx(name.substr(0, 8) + "_p", UT_CPU_ID_NONE,
+            &ServerExecutor::ProiThreadFunction, this);
+    }
+
+    void Submit(const RequestPtr& request)
+    {
+        if (mQuit)
+        {
+            return;
+        }
+
+        Task task;
+        task.mRequestPtr = request;
+        task.mEnqueueTime = (int64_t)common::GetCurrentMonotonicTimeMicrosecond();
+
+        int32_t apiId = (int32_t)request->header().identity().api_id();
+
+        if (request->header().policy().priority() > 0 || mConfig.IsPriorityApi(apiId))
+        {
+            common::LockGuard<common::MutexCond> guard(mProiMutexCond);
+            mProiQueue.push_back(std::move(task));
+            mProiMutexCond.Notify();
+            return;
+        }
+
+        common::LockGuard<common::MutexCond> guard(mMutexCond);
+        ApiState& state = GetApiState(apiId);
+
+        if (state.mConcurrency == 0 || state.mRunning < state.mConcurrency)
+        {
+            state.mRunning ++;
+            mReadyQueue.push_back(std::move(task));
+            mMutexCond.Notify();
+        }
+        else
+        {
+            state.mPending.push_back(std::move(task));
+        }
+    }
+
+    void Stop()
+    {
+        if (mQuit)
+        {
+            return;
+        }
+
+        mQuit = true;
+
+        {
+            common::LockGuard<common::MutexCond> guard(mMutexCond);
+            mMutexCond.NotifyAll();
+        }
+        {
+            common::LockGuard<common::MutexCond> guard(mProiMutexCond);
+            mProiMutexCond.NotifyAll();
+        }
+
+        for (const common::ThreadPtr& threadPtr : mThreadList)
+        {
+            threadPtr->Wait();
+        }
+
+        if (mProiThreadPtr)
+        {
+            mProiThreadPtr->Wait();
+        }
+    }
+
+    bool GetApiStatistics(int32_t apiId, ServerApiStatistics& statistics)
+    {
+        common::LockGuard<common::MutexCond> guard(mMutexCond);
+
+        auto iter = mApiStateMap.find(apiId);
+        if (iter == mApiStateMap.end())
+        {
+            return false;
+        }
+
+        statistics = iter->second.mStatistics;
+        return true;
+    }
+
+    void GetStatistics(std::map<int32_t,ServerApiStatistics>& statisticsMap)
+    {
+        common::LockGuard<common::MutexCond> guard(mMutexCond);
+
+        for (const auto& item : mApiStateMap)
+        {
+            statisticsMap[item.first] = item.second.mStatistics;
+        }
+    }
+
+    size_t GetQueueSize()
+    {
+        common::LockGuard<common::MutexCond> guard(mMutexCond);
+
+        size_t size = mReadyQueue.size();
+        for (const auto& item : mApiStateMap)
+        {
+            size += item.second.mPending.size();
+        }
+
+        return size;
+    }
+
+private:
+    struct Task
+    {
+        RequestPtr mRequestPtr;
+        int64_t mEnqueueTime;
+    };
+
+    struct ApiState
+    {
+        uint32_t mRunning;
+        uint32_t mConcurrency;
+        int64_t mExpireMicrosec;
+        std::deque<Task> mPending;
+        ServerApiStatistics mStatistics;
+    };
+
+    ApiState& GetApiState(int32_t apiId)
+    {
+        auto iter = mApiStateMap.find(apiId);
+        if (iter != mApiStateMap.end())
+        {
+            return iter->second;
+        }
+
+        ApiState& state = mApiStateMap[apiId];
+        state.mRunning = 0;
+        state.mConcurrency = mConfig.GetApiConcurrency(apiId);
+        state.mExpireMicrosec = mConfig.GetApiExpireTime(apiId);
+
+        return state;
+    }
+
+    bool IsExpired(const Task& task, int64_t expireMicrosec, int64_t now)
+    {
+        return expireMicrosec > 0 && now - task.mEnqueueTime > expireMicrosec;
+    }
+
+    /*
+     * run task outside lock, return execute time or -1 if task expired.
+     */
+    int64_t Execute(const Task& task, int64_t expireMicrosec, int64_t now)
+    {
+        if (IsExpired(task, expireMicrosec, now))
+        {
+            if (mExpireHandler)
+            {
+                mExpireHandler(task.mRequestPtr);
+            }
+
+            return -1;
+        }
+
+        mHandler(task.mRequestPtr);
+        return (int64_t)common::GetCurrentMonotonicTimeMicrosecond() - now;
+    }
+
+    void Account(ServerApiStatistics& statistics, int64_t queueTime, int64_t executeTime)
+    {
+        if (executeTime < 0)
+        {
+            statistics.mExpireCount ++;
+            return;
+        }
+
+        statistics.mExecuteCount ++;
+        statistics.mQueueTimeTotal += queueTime;
+        statistics.mExecuteTimeTotal += executeTime;
+
+        if (queueTime > statistics.mQueueTimeMax)
+        {
+            statistics.mQueueTimeMax = queueTime;
+        }
+
+        if (executeTime > statistics.mExecuteTimeMax)
+        {
+            statistics.mExecuteTimeMax = executeTime;
+        }
+    }
+
+    int32_t WorkerThreadFunction()
+    {
+        while (true)
+        {
+            Task task;
+            int32_t apiId;
+            int64_t expireMicrosec;
+
+            {
+                common::LockGuard<common::MutexCond> guard(mMutexCond);
+                while (!mQuit && mReadyQueue.empty())
+                {
+                    mMutexCond.Wait(ROBOT_SERVER_EXECUTOR_WAIT_TIME);
+                }
+
+                if (mQuit)
+                {
+                    break;
+                }
+
+                task = std::move(mReadyQueue.front());
+                mReadyQueue.pop_front();
+
+                apiId = (int32_t)task.mRequestPtr->header().identity().api_id();
+                expireMicrosec = GetApiState(apiId).mExpireMicrosec;
+            }
+
+            int64_t now = (int64_t)common::GetCurrentMonotonicTimeMicrosecond();
+            int64_t executeTime = Execute(task, expireMicrosec, now);
+
+            common::LockGuard<common::MutexCond> guard(mMutexCond);
+            ApiState& state = GetApiState(apiId);
+            Account(state.mStatistics, now - task.mEnqueueTime, executeTime);
+
+            /*
+             * hand the slot to next pending request of the same api.
+             */
+            if (state.mPending.empty())
+            {
+                state.mRunning --;
+            }
+            else
+            {
+                mReadyQueue.push_back(std::move(state.mPending.front()));
+                state.mPending.pop_front();
+                mMutexCond.Notify();
+            }
+        }
+
+        return 0;
+    }
+
+    int32_t ProiThreadFunction()
+    {
+        while (true)
+        {
+            Task task;
+
+            {
+                common::LockGuard<common::MutexCond> guard(mProiMutexCond);
+                while (!mQuit && mProiQueue.empty())
+                {
+                    mProiMutexCond.Wait(ROBOT_SERVER_EXECUTOR_WAIT_TIME);
+                }
+
+                if (mQuit)
+                {
+                    break;
+                }
+
+                task = std::move(mProiQueue.front());
+                mProiQueue.pop_front();
+            }
+
+            int32_t apiId = (int32_t)task.mRequestPtr->header().identity().api_id();
+            int64_t expireMicrosec = mConfig.GetApiExpireTime(apiId);
+
+            int64_t now = (int64_t)common::GetCurrentMonotonicTimeMicrosecond();
+            int64_t executeTime = Execute(task, expireMicrosec, now);
+
+            common::LockGuard<common::MutexCond> guard(mMutexCond);
+            Account(GetApiState(apiId).mStatistics, now - task.mEnqueueTime, executeTime);
+        }
+
+        return 0;
+    }
+
+private:
+    volatile bool mQuit;
+    ServerExecutorConfig mConfig;
+    ServerExecuteHandler mHandler;
+    ServerExecuteHandler mExpireHandler;
+
+    std::deque<Task> mReadyQueue;
+    std::unordered_map<int32_t,ApiState> mApiStateMap;
+    common::MutexCond mMutexCond;
+
+    std::deque<Task> mProiQueue;
+    common::MutexCond mProiMutexCond;
+
+    std::vector<common::ThreadPtr> mThreadList;
+    common::ThreadPtr mProiThreadPtr;
+};
+
+using ServerExecutorPtr = std::shared_ptr<ServerExecutor>;
+
+/*
+ * @brief  Server whose api handlers run on ServerExecutor workers instead of
+ *         the single server stub queue thread.
+ * @class: ExecutorServer
+ */
+class ExecutorServer : public Server
+{
+public:
+    explicit ExecutorServer(const std::string& name) :
+        Server(name)
+    {}
+
+    virtual ~ExecutorServer()
+    {
+        if (mExecutorPtr)
+        {
+            mExecutorPtr->Stop();
+        }
+    }
+
+    using Server::Start;
+
+    void Start(const ServerExecutorConfig& config, bool enableProiQueue = false)
+    {
+        mExecutorPtr = ServerExecutorPtr(new ServerExecutor());
+        mExecutorPtr->Init(GetName(), config, [this](const RequestPtr& request) {
+            Dispatch(request);
+        }, [this](const RequestPtr& request) {
+            SendStatus(request, UT_ROBOT_ERR_SERVER_API_EXPIRED);
+        });
+
+        Server::Start(enableProiQueue);
+    }
+
+    /*
+     * Start lease. The lease is kept in LeaseState, the only lease check of
+     * leased requests, instead of the LeaseServer of Server. Apply and renewal
+     * are served on the service channel as ROBOT_API_ID_LEASE_APPLY and
+     * ROBOT_API_ID_LEASE_RENEWAL; use a RoutedClient with EnableTrafficLease.
+     * Call before Start.
+     * leaseTerm: microseconds / seconds.
+     */
+    void StartLease(int64_t leaseTerm)
+    {
+        mLeaseStatePtr = LeaseStatePtr(new LeaseState(leaseTerm));
+
+        Server::RegistHandler(ROBOT_API_ID_LEASE_APPLY, std::bind(&ExecutorServer::LeaseApply, this,
+            std::placeholders::_1, std::placeholders::_2), false);
+        Server::RegistHandler(ROBOT_API_ID_LEASE_RENEWAL, std::bind(&ExecutorServer::LeaseRenewal, this,
+            std::placeholders::_1, std::placeholders::_2), false);
+        mLeaseApiSet.insert(ROBOT_API_ID_LEASE_RENEWAL);
+    }
+
+    void StartLease(float leaseTerm)
+    {
+        StartLease((int64_t)(leaseTerm * 1000000));
+    }
+
+    bool GetLeaseStatistics(LeaseStatistics& statistics)
+    {
+        if (!mLeaseStatePtr)
+        {
+            return false;
+        }
+
+        statistics = mLeaseStatePtr->GetStatistics();
+        return true;
+    }
+
+    bool GetApiStatistics(int32_t apiId, ServerApiStatistics& statistics)
+    {
+        return mExecutorPtr ? mExecutorPtr->GetApiStatistics(apiId, statistics) : false;
+    }
+
+    void GetStatistics(std::map<int32_t,ServerApiStatistics>& statisticsMap)
+    {
+        if (mExecutorPtr)
+        {
+            mExecutorPtr->GetStatistics(statisticsMap);
+        }
+    }
+
+protected:
+    /*
+     * Regist functions of Server, keeping the lease checked apis for
+     * Dispatch. Server itself never checks leases of this server.
+     */
+    void RegistHandler(int32_t apiId, const RequestHandler& handler, bool checkLease = false)
+    {
+        if (checkLease)
+        {
+            mLeaseApiSet.insert(apiId);
+        }
+
+        Server::RegistHandler(apiId, handler, false);
+    }
+
+    void RegistBinaryHandler(int32_t apiId, const BinaryRequestHandler& binaryHandler, bool checkLease = false)
+    {
+        if (checkLease)
+        {
+            mLeaseApiSet.insert(apiId);
+        }
+
+        Server::RegistBinaryHandler(apiId, binaryHandler, false);
+    }
+
+    void RegistChunkedHandler(int32_t apiId, const ChunkedRequestHandler& handler, bool checkLease = false, int32_t window = ROBOT_CHUNK_WINDOW,
+        uint64_t maxTotalSize = ROBOT_CHUNK_MAX_TOTAL_SIZE)
+    {
+        ChunkedReceiverPtr receiverPtr(new ChunkedReceiver(handler, window, ROBOT_CHUNK_EXPIRE_TIME, maxTotalSize));
+        RegistBinaryHandler(apiId, [receiverPtr](const std::vector<uint8_t>& parameter, std::vector<uint8_t>& data) {
+            return receiverPtr->OnChunk(parameter, data);
+        }, checkLease);
+    }
+
+    void ServerRequestHandler(const RequestPtr& request)
+    {
+        if (mExecutorPtr)
+        {
+            mExecutorPtr->Submit(request);
+        }
+        else
+        {
+            Dispatch(request);
+        }
+    }
+
+    void Dispatch(const RequestPtr& request)
+    {
+        if (mLeaseStatePtr && !CheckLease(request))
+        {
+            SendStatus(request, UT_ROBOT_ERR_SERVER_LEASE_DENIED);
+            return;
+        }
+
+        Server::ServerRequestHandler(request);
+    }
+
+    /*
+     * Answer request with status code only, so the caller does not wait for
+     * its own timeout.
+     */
+    void SendStatus(const RequestPtr& request, int32_t code)
+    {
+        const RequestHeader& header = request->header();
+        if (header.policy().noreply())
+        {
+            return;
+        }
+
+        Response response;
+        response.header().identity(header.identity());
+        response.header().status().code(code);
+
+        SendResponse(response);
+    }
+
+private:
+    /*
+     * Lock-free: mLeaseApiSet is only written before Start.
+     */
+    bool CheckLease(const RequestPtr& request)
+    {
+        const RequestHeader& header = request->header();
+        int32_t apiId = (int32_t)header.identity().api_id();
+
+        int64_t now = (int64_t)common::GetCurrentMonotonicTimeMicrosecond();
+
+        if (mLeaseApiSet.find(apiId) == mLeaseApiSet.end())
+        {
+            mLeaseStatePtr->Touch(header.lease().id(), now);
+            return true;
+        }
+
+        if (apiId == ROBOT_API_ID_LEASE_RENEWAL)
+        {
+            return mLeaseStatePtr->Renewal(header.lease().id(), now);
+        }
+
+        return mLeaseStatePtr->Check(header.lease().id(), now);
+    }
+
+    int32_t LeaseApply(const std::string& parameter, std::string& data)
+    {
+        ApplyLeaseParameter applyParameter;
+        try
+        {
+            common::FromJsonString(parameter, applyParameter);
+        }
+        catch(const common::Exception& e)
+        {
+            return UT_ROBOT_ERR_SERVER_API_PARAMETER;
+        }
+
+        ApplyLeaseData applyData;
+        int32_t ret = mLeaseStatePtr->Apply(applyParameter.name, (int64_t)common::GetCurrentMonotonicTimeMicrosecond(), applyData.id);
+        if (ret != UT_ROBOT_OK)
+        {
+            return ret;
+        }
+
+        applyData.term = mLeaseStatePtr->GetTerm();
+
+        return Serialize(applyData, data) ? UT_ROBOT_OK : UT_ROBOT_ERR_SERVER_INTERNAL;
+    }
+
+    /*
+     * The renewal itself is done by CheckLease.
+     */
+    int32_t LeaseRenewal(const std::string& parameter, std::string& data)
+    {
+        return UT_ROBOT_OK;
+    }
+
+private:
+    ServerExecutorPtr mExecutorPtr;
+    LeaseStatePtr mLeaseStatePtr;
+    std::unordered_set<int32_t> mLeaseApiSet;
+};
+
+using ExecutorServerPtr = std::shared_ptr<ExecutorServer>;
+
+}
+}
+
+#endif//__UT_ROBOT_SDK_SERVER_EXECUTOR_HPP__
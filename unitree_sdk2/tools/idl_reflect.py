@@ -0,0 +1,190 @@
+#!/usr/bin/env python3
+"""
+Generate reflection tables for the IDL types under include/unitree/idl.
+
+For every idl directory a header include/unitree/idl/reflect/<dir>_reflect.hpp
+is written, holding a TypeReflection specialization per message type (see
+include/unitree/common/reflect/reflect.hpp) and a Check<Dir>ReflectLayout
+function that compares the table offsets with the accessors of the real
+types at runtime. Run it again after
+regenerating the IDL headers:
+
+    python3 tools/idl_reflect.py
+"""
+import os
+import re
+import sys
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "include")
+IDL_DIR = os.path.join(ROOT, "unitree", "idl")
+OUT_DIR = os.path.join(IDL_DIR, "reflect")
+
+MEMBER_RE = re.compile(r"^\s*(.+?)\s+(\w+_)(\s*=.*)?;\s*$")
+STRUCT_RE = re.compile(r"::(\w+)::msg::dds_::(\w+)")
+
+
+def parse_header(path):
+    namespaces = []
+    types = []
+    current = None
+    in_private = False
+
+    with open(path) as f:
+        for line in f:
+            line = line.rstrip("\n")
+            m = re.match(r"^namespace (\w+)$", line)
+            if m and current is None:
+                namespaces.append(m.group(1))
+                continue
+            if line == "}" and current is None and namespaces:
+                namespaces.pop()
+                continue
+            m = re.match(r"^class (\w+)$", line)
+            if m:
+                current = {"name": "::".join(namespaces + [m.group(1)]), "members": []}
+                continue
+            if current is None:
+                continue
+            if line.startswith("private:"):
+                in_private = True
+                continue
+            if line.startswith("public:"):
+                in_private = False
+                types.append(current)
+                current = None
+                continue
+            if in_private and line.strip():
+                m = MEMBER_RE.match(line)
+                if not m:
+                    sys.exit("unknown member line in %s: %s" % (path, line))
+                current["members"].append((m.group(1), m.group(2)))
+
+    return types
+
+
+def sort_types(types):
+    names = {t["name"] for t in types}
+    done = set()
+    result = []
+
+    def visit(t, stack):
+        if t["name"] in done:
+            return
+        if t["name"] in stack:
+            sys.exit("recursive type " + t["name"])
+        for member_type, _ in t["members"]:
+            for ns, name in STRUCT_RE.findall(member_type):
+                dep = "%s::msg::dds_::%s" % (ns, name)
+                if dep in names:
+                    visit(next(x for x in types if x["name"] == dep), stack + [t["name"]])
+        done.add(t["name"])
+        result.append(t)
+
+    for t in types:
+        visit(t, [])
+
+    return result
+
+
+def generate(directory):
+    files = sorted(f for f in os.listdir(os.path.join(IDL_DIR, directory)) if f.endswith(".hpp"))
+    types = []
+    for f in files:
+        types.extend(parse_header(os.path.join(IDL_DIR, directory, f)))
+
+    guard = "__UT_IDL_REFLECT_%s_HPP__" % directory.upper()
+    out = []
+    out.append("/*")
+    out.append(" * Generated by tools/idl_reflect.py from include/unitree/idl/%s. Do not edit." % directory)
+    out.append(" */")
+    out.append("#ifndef %s" % guard)
+    out.append("#define %s" % guard)
+    out.append("")
+    out.append("#include <unitree/common/reflect/reflect.hpp>")
+    for f in files:
+        out.append("#include <unitree/idl/%s/%s>" % (directory, f))
+    out.append("")
+    out.append("#pragma GCC diagnostic push")
+    out.append("#pragma GCC diagnostic ignored \"-Winvalid-offsetof\"")
+    out.append("")
+    out.append("namespace unitree")
+    out.append("{")
+    out.append("namespace common")
+    out.append("{")
+
+    for t in sort_types(types):
+        name = "::" + t["name"]
+        out.append("template<>")
+        out.append("struct TypeReflection<%s>" % name)
+        out.append("{")
+        out.append("    struct Layout")
+        out.append("    {")
+        for member_type, member in t["members"]:
+            out.append("        %s %s;" % (member_type, member))
+        out.append("    };")
+        out.append("")
+        out.append("    static constexpr bool VALID = true;")
+        out.append("")
+        out.append("    static constexpr FieldDescriptor FIELDS[] =")
+        out.append("    {")
+        for member_type, member in t["members"]:
+            out.append("        UT_REFLECT_FIELD(Layout, %s, \"%s\")," % (member, member[:-1]))
+        out.append("    };")
+        out.append("")
+        out.append("    static constexpr TypeDescriptor TYPE =")
+        out.append("    {")
+        out.append("        \"%s\", sizeof(%s), FIELDS, sizeof(FIELDS) / sizeof(FIELDS[0])" % (t["name"], name))
+        out.append("    };")
+        out.append("")
+        out.append("    static bool CheckLayout()")
+        out.append("    {")
+        out.append("        %s obj;" % name)
+        out.append("        return")
+        checks = ["            UT_REFLECT_CHECK_FIELD(Layout, obj, %s, %s)" % (member, member[:-1])
+                  for _, member in t["members"]]
+        out.append(" &&\n".join(checks) + ";")
+        out.append("    }")
+        out.append("};")
+        out.append("")
+        out.append("static_assert(sizeof(TypeReflection<%s>::Layout) == sizeof(%s)," % (name, name))
+        out.append("    \"layout of %s changed, run tools/idl_reflect.py\");" % t["name"])
+        out.append("")
+
+    func = "Check%sReflectLayout" % "".join(part.capitalize() for part in directory.split("_"))
+    out.append("/*")
+    out.append(" * Check field offsets of every table against the accessors of the real")
+    out.append(" * types. failed is set to the first type whose layout does not match.")
+    out.append(" */")
+    out.append("inline bool %s(std::string& failed)" % func)
+    out.append("{")
+    for t in sort_types(types):
+        name = "::" + t["name"]
+        out.append("    if (!TypeReflection<%s>::CheckLayout())" % name)
+        out.append("    {")
+        out.append("        failed = \"%s\";" % t["name"])
+        out.append("        return false;")
+        out.append("    }")
+        out.append("")
+    out.append("    return true;")
+    out.append("}")
+    out.append("")
+    out.append("}")
+    out.append("}")
+    out.append("")
+    out.append("#pragma GCC diagnostic pop")
+    out.append("")
+    out.append("#endif//%s" % guard)
+
+    with open(os.path.join(OUT_DIR, "%s_reflect.hpp" % directory), "w") as f:
+        f.write("\n".join(out) + "\n")
+
+
+def main():
+    os.makedirs(OUT_DIR, exist_ok=True)
+    for directory in sorted(os.listdir(IDL_DIR)):
+        if directory != "reflect" and os.path.isdir(os.path.join(IDL_DIR, directory)):
+            generate(directory)
+
+
+if __name__ == "__main__":
+    main()